@@ -24,6 +24,9 @@
  */
 #include "links.h"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace osp;
 
 using osp::link::MachTypeReg_t;
@@ -63,5 +66,51 @@ float thruster_influence(Vector3 const pos, Vector3 const dir, Vector3 const cmd
     return std::clamp(influence, 0.0f, 1.0f);
 }
 
+void thruster_influence_block(RcsDriverBlock &rBlock, std::size_t const count) noexcept
+{
+    using namespace ports_rcsdriver;
+
+    auto const &posX    = rBlock.in[gc_posXIn.port];
+    auto const &posY    = rBlock.in[gc_posYIn.port];
+    auto const &posZ    = rBlock.in[gc_posZIn.port];
+    auto const &dirX    = rBlock.in[gc_dirXIn.port];
+    auto const &dirY    = rBlock.in[gc_dirYIn.port];
+    auto const &dirZ    = rBlock.in[gc_dirZIn.port];
+    auto const &linX    = rBlock.in[gc_cmdLinXIn.port];
+    auto const &linY    = rBlock.in[gc_cmdLinYIn.port];
+    auto const &linZ    = rBlock.in[gc_cmdLinZIn.port];
+    auto const &angX    = rBlock.in[gc_cmdAngXIn.port];
+    auto const &angY    = rBlock.in[gc_cmdAngYIn.port];
+    auto const &angZ    = rBlock.in[gc_cmdAngZIn.port];
+
+    // Both terms are always calculated then selected, instead of branching like
+    // thruster_influence. Unselected terms may be NaN from normalizing zero vectors.
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        float const torqueX     = posY[i] * dirZ[i] - posZ[i] * dirY[i];
+        float const torqueY     = posZ[i] * dirX[i] - posX[i] * dirZ[i];
+        float const torqueZ     = posX[i] * dirY[i] - posY[i] * dirX[i];
+        float const torqueInv   = 1.0f / std::sqrt(torqueX * torqueX + torqueY * torqueY + torqueZ * torqueZ);
+
+        float const angLenSq    = angX[i] * angX[i] + angY[i] * angY[i] + angZ[i] * angZ[i];
+        float const angInv      = 1.0f / std::sqrt(angLenSq);
+        float const angTerm     = (torqueX * torqueInv) * (angX[i] * angInv)
+                                + (torqueY * torqueInv) * (angY[i] * angInv)
+                                + (torqueZ * torqueInv) * (angZ[i] * angInv);
+
+        float const linLenSq    = linX[i] * linX[i] + linY[i] * linY[i] + linZ[i] * linZ[i];
+        float const linInv      = 1.0f / std::sqrt(linLenSq);
+        float const linTerm     = dirX[i] * (linX[i] * linInv)
+                                + dirY[i] * (linY[i] * linInv)
+                                + dirZ[i] * (linZ[i] * linInv);
+
+        float const influence   = (angLenSq > 0.0f ? angTerm : 0.0f)
+                                + (linLenSq > 0.0f ? linTerm : 0.0f);
+
+        // Small contributions are ignored. Comparisons with NaN are false, so NaN gives 0 too.
+        rBlock.influence[i] = (influence >= 0.01f) ? std::min(influence, 1.0f) : 0.0f;
+    }
+}
+
 
 } // namespace adera
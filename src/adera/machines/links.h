@@ -29,6 +29,9 @@
 #include <osp/link/machines.h>
 #include <osp/link/signal.h>
 
+#include <array>
+#include <cstddef>
+
 namespace adera
 {
 
@@ -76,4 +79,28 @@ PortEntry const gc_throttleOut      { gc_ntSigFloat, 12, gc_sigOut };
 
 float thruster_influence(osp::Vector3 pos, osp::Vector3 dir, osp::Vector3 cmdLin, osp::Vector3 cmdAng) noexcept;
 
+/// Number of RCS drivers evaluated at once by thruster_influence_block
+constexpr std::size_t gc_rcsBlockSize = 64;
+
+/**
+ * @brief Inputs and outputs of many RCS drivers, with each value in a separate array
+ */
+struct RcsDriverBlock
+{
+    /// Float inputs indexed by port, see ports_rcsdriver. Unconnected inputs are 0.
+    alignas(64) std::array<std::array<float, gc_rcsBlockSize>, 12> in;
+
+    alignas(64) std::array<float, gc_rcsBlockSize> influence;
+
+    std::array<osp::link::NodeId, gc_rcsBlockSize> throttleOut;
+};
+
+/**
+ * @brief thruster_influence for the first count RCS drivers in a block, written to influence
+ *
+ * Gives the same results as thruster_influence, but without branches, so the compiler can
+ * vectorize it.
+ */
+void thruster_influence_block(RcsDriverBlock &rBlock, std::size_t count) noexcept;
+
 } // namespace adera
@@ -24,13 +24,18 @@
  */
 #include "simulations.h"
 
+#include <osp/executor/worker_pool.h>
+
 #include <Magnum/Math/Math.h>
 #include <Magnum/Math/Functions.h>
 
+#include <algorithm>
+
 using osp::Quaternion;
 using osp::Vector3d;
 using osp::universe::Vector3g;
 using osp::universe::spaceint_t;
+using osp::exec::WorkerPool;
 
 namespace adera
 {
@@ -73,7 +78,7 @@ void ConstantSpinSim::update(std::uint64_t deltaTime) noexcept
 }
 
 
-void SimpleGravitySim::update(std::uint64_t deltaTime) noexcept
+void SimpleGravitySim::update(std::uint64_t deltaTime, WorkerPool *pPool) noexcept
 {
     double const deltaTimeSec = deltaTime * m_secPerTimeUnit;
 
@@ -81,6 +86,20 @@ void SimpleGravitySim::update(std::uint64_t deltaTime) noexcept
     // Used to get position delta from velocity: (m/s) * PosUnit/(m/s) = PosUnit
     double const velocityScale = deltaTimeSec / m_metersPerPosUnit;
 
+    if (m_method == Method::BarnesHut)
+    {
+        // Unlike DirectSum below, all accelerations are calculated from positions at the start of
+        // the step. Satellites don't see each other's positions change mid-step.
+        calc_accel_barnes_hut(pPool);
+
+        for (SatData &rSat : m_data)
+        {
+            rSat.position += Vector3g(rSat.velocity * velocityScale);
+            rSat.velocity += rSat.accel * deltaTimeSec; // m/s/s * s = m/s
+        }
+        return;
+    }
+
     auto const count = m_data.size();
     for (std::size_t i = 0; i < count; ++i)
     {
@@ -107,7 +126,281 @@ void SimpleGravitySim::update(std::uint64_t deltaTime) noexcept
     }
 }
 
+// Satellites are split into blocks of this size to run in parallel
+static constexpr std::uint32_t gc_gravityBlockSize = 256;
+
+/**
+ * @brief Call func(i) for each satellite index, split into blocks over the worker pool
+ */
+template <typename FUNC_T>
+static void for_each_sat_parallel(WorkerPool *pPool, std::size_t const count, FUNC_T &&func)
+{
+    auto const blockCount = std::uint32_t((count + gc_gravityBlockSize - 1) / gc_gravityBlockSize);
 
+    osp::exec::parallel_for(pPool, blockCount, [count, &func] (std::uint32_t const block)
+    {
+        std::size_t const first = std::size_t(block) * gc_gravityBlockSize;
+        std::size_t const last  = std::min(first + gc_gravityBlockSize, count);
+        for (std::size_t i = first; i < last; ++i)
+        {
+            func(i);
+        }
+    });
+}
+
+/**
+ * @return Acceleration towards a mass, G=1 like SimpleGravitySim. Zero if at the same position.
+ */
+static Vector3d accel_towards(Vector3d const relPos, double const mass) noexcept
+{
+    double const rSq = relPos.dot();
+    if (rSq == 0.0)
+    {
+        return {};
+    }
+    return relPos * (mass / (rSq * std::sqrt(rSq)));
+}
+
+void SimpleGravitySim::calc_accel_direct(WorkerPool *pPool) noexcept
+{
+    std::size_t const count = m_data.size();
 
+    for_each_sat_parallel(pPool, count, [this, count] (std::size_t const i)
+    {
+        SatData &rISat = m_data[i];
+
+        Vector3d accel{};
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            if (i == j) { continue; }
+
+            SatData const &rJSat = m_data[j];
+            accel += accel_towards(Vector3d(rJSat.position - rISat.position) * m_metersPerPosUnit, rJSat.mass);
+        }
+        rISat.accel = accel;
+    });
+}
+
+static std::array<spaceint_t, 3> octant_offset(int const octant, spaceint_t const quarter) noexcept
+{
+    return { (octant & 1) ? quarter : -quarter,
+             (octant & 2) ? quarter : -quarter,
+             (octant & 4) ? quarter : -quarter };
+}
+
+static int octant_of(Vector3g const center, Vector3g const pos) noexcept
+{
+    return   int(pos.x() >= center.x())
+           | int(pos.y() >= center.y()) << 1
+           | int(pos.z() >= center.z()) << 2;
+}
+
+static bool node_contains(GravityOctree::Node const &node, Vector3g const pos) noexcept
+{
+    Vector3g const rel = pos - node.center;
+    return    rel.x() >= -node.halfSize && rel.x() < node.halfSize
+           && rel.y() >= -node.halfSize && rel.y() < node.halfSize
+           && rel.z() >= -node.halfSize && rel.z() < node.halfSize;
+}
+
+static void octree_build(GravityOctree &rTree, std::vector<SimpleGravitySim::SatData> const &data, double const metersPerPosUnit)
+{
+    using Node = GravityOctree::Node;
+    constexpr std::uint32_t null = GravityOctree::smc_null;
+
+    rTree.nodes.clear();
+    rTree.bodyNext.assign(data.size(), null);
+
+    if (data.empty())
+    {
+        return;
+    }
+
+    // Root cube is centered on the bounding box, with a power-of-two half size so that children
+    // can be split evenly all the way down to a half size of 1.
+    Vector3g lo = data[0].position;
+    Vector3g hi = data[0].position;
+    for (SimpleGravitySim::SatData const &sat : data)
+    {
+        lo = Magnum::Math::min(lo, sat.position);
+        hi = Magnum::Math::max(hi, sat.position);
+    }
+    Vector3g   const rootCenter = lo + (hi - lo) / 2;
+    spaceint_t const extent     = std::max((hi - rootCenter).max(), (rootCenter - lo).max());
+    spaceint_t       rootHalf   = 1;
+    while (rootHalf <= extent)
+    {
+        rootHalf <<= 1;
+    }
+
+    rTree.nodes.push_back(Node{ .center = rootCenter, .halfSize = rootHalf });
+
+    auto const add_leaf = [&rTree] (std::uint32_t const parent, int const octant, std::uint32_t const body) -> std::uint32_t
+    {
+        Node const &rParent = rTree.nodes[parent];
+        spaceint_t const quarter = rParent.halfSize / 2;
+        auto const offset = octant_offset(octant, quarter);
+        Vector3g const center = rParent.center + Vector3g{offset[0], offset[1], offset[2]};
+
+        auto const index = std::uint32_t(rTree.nodes.size());
+        rTree.nodes.push_back(Node{ .center = center, .halfSize = quarter, .firstBody = body });
+        rTree.nodes[parent].children[octant] = index;
+        return index;
+    };
+
+    for (std::uint32_t body = 0; body < data.size(); ++body)
+    {
+        Vector3g const pos = data[body].position;
+        std::uint32_t nodeIdx = 0;
+
+        while (true)
+        {
+            Node &rNode = rTree.nodes[nodeIdx];
+
+            if (rNode.isBranch)
+            {
+                int const octant = octant_of(rNode.center, pos);
+                std::uint32_t const child = rNode.children[octant];
+                if (child == null)
+                {
+                    add_leaf(nodeIdx, octant, body);
+                    break;
+                }
+                nodeIdx = child;
+            }
+            else if (rNode.firstBody == null)
+            {
+                rNode.firstBody = body;
+                break;
+            }
+            else if (rNode.halfSize == 1)
+            {
+                // Can't split any further, satellites share the same leaf
+                rTree.bodyNext[body] = rNode.firstBody;
+                rNode.firstBody = body;
+                break;
+            }
+            else
+            {
+                // Turn leaf into a branch, push its existing satellite down a level, then
+                // try again on this same node
+                std::uint32_t const existing = rNode.firstBody;
+                rNode.firstBody = null;
+                rNode.isBranch  = true;
+                add_leaf(nodeIdx, octant_of(rNode.center, data[existing].position), existing);
+            }
+        }
+    }
+
+    // Accumulate mass bottom-up. Children always have higher indices than their parents.
+    for (std::size_t i = rTree.nodes.size(); i-- != 0; )
+    {
+        Node &rNode = rTree.nodes[i];
+
+        double   mass = 0.0;
+        Vector3d weighted{};
+
+        if (rNode.isBranch)
+        {
+            for (std::uint32_t const child : rNode.children)
+            {
+                if (child != null)
+                {
+                    Node const &rChild = rTree.nodes[child];
+                    mass     += rChild.mass;
+                    weighted += rChild.centerOfMass * rChild.mass;
+                }
+            }
+        }
+        else
+        {
+            for (std::uint32_t body = rNode.firstBody; body != null; body = rTree.bodyNext[body])
+            {
+                double const bodyMass = data[body].mass;
+                mass     += bodyMass;
+                weighted += Vector3d(data[body].position - rootCenter) * metersPerPosUnit * bodyMass;
+            }
+        }
+
+        rNode.mass = mass;
+        rNode.centerOfMass = (mass != 0.0) ? (weighted / mass)
+                                           : Vector3d(rNode.center - rootCenter) * metersPerPosUnit;
+    }
+}
+
+void SimpleGravitySim::calc_accel_barnes_hut(WorkerPool *pPool) noexcept
+{
+    using Node = GravityOctree::Node;
+    constexpr std::uint32_t null = GravityOctree::smc_null;
+
+    octree_build(m_octree, m_data, m_metersPerPosUnit);
+
+    if (m_data.empty())
+    {
+        return;
+    }
+
+    Vector3g const rootCenter = m_octree.nodes[0].center;
+    double   const thetaSq    = m_openingAngle * m_openingAngle;
+
+    for_each_sat_parallel(pPool, m_data.size(), [this, rootCenter, thetaSq] (std::size_t const i)
+    {
+        SatData &rISat = m_data[i];
+        Vector3d const pos = Vector3d(rISat.position - rootCenter) * m_metersPerPosUnit;
+
+        // Tree depth is at most 64 (one level per bit of spaceint_t), each level pushes at most 8
+        std::array<std::uint32_t, 64 * 8> stack;
+        std::size_t stackSize = 0;
+        stack[stackSize++] = 0;
+
+        Vector3d accel{};
+
+        while (stackSize != 0)
+        {
+            Node const &node = m_octree.nodes[stack[--stackSize]];
+
+            if (node.mass == 0.0)
+            {
+                continue;
+            }
+
+            if ( ! node.isBranch )
+            {
+                for (std::uint32_t body = node.firstBody; body != null; body = m_octree.bodyNext[body])
+                {
+                    if (body != i)
+                    {
+                        SatData const &rJSat = m_data[body];
+                        accel += accel_towards(Vector3d(rJSat.position - rISat.position) * m_metersPerPosUnit, rJSat.mass);
+                    }
+                }
+                continue;
+            }
+
+            Vector3d const relPos = node.centerOfMass - pos;
+            double   const size   = double(node.halfSize) * 2.0 * m_metersPerPosUnit;
+
+            // Approximate node as a single mass if far enough away. Never for nodes containing
+            // this satellite, as that would include its own mass.
+            if (   size * size < thetaSq * relPos.dot()
+                && ! node_contains(node, rISat.position) )
+            {
+                accel += accel_towards(relPos, node.mass);
+            }
+            else
+            {
+                for (std::uint32_t const child : node.children)
+                {
+                    if (child != null)
+                    {
+                        stack[stackSize++] = child;
+                    }
+                }
+            }
+        }
+
+        rISat.accel = accel;
+    });
+}
 
 } // namespace adera::sims
@@ -27,6 +27,15 @@
 #include <osp/universe/universe.h>
 #include <osp/core/math_types.h>
 
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace osp::exec
+{
+    class WorkerPool;
+}
+
 namespace adera
 {
 
@@ -66,8 +75,48 @@ struct ConstantSpinSim
 };
 
 
+/**
+ * @brief Octree over satellite positions used by SimpleGravitySim's Barnes-Hut method
+ *
+ * Nodes are axis-aligned cubes in integer position space, each split into 8 octants. Children
+ * always have higher indices than their parent, so mass can be accumulated bottom-up by iterating
+ * nodes in reverse. Rebuilt every step; kept around to reuse allocations.
+ */
+struct GravityOctree
+{
+    static constexpr std::uint32_t  smc_null = ~std::uint32_t(0);
+
+    struct Node
+    {
+        osp::universe::Vector3g         center;
+        osp::universe::spaceint_t       halfSize{};
+        std::array<std::uint32_t, 8>    children    { smc_null, smc_null, smc_null, smc_null,
+                                                      smc_null, smc_null, smc_null, smc_null };
+        /// First satellite of a leaf, continued through bodyNext. Null for branches and empty leaves.
+        std::uint32_t                   firstBody   { smc_null };
+        bool                            isBranch    { false };
+
+        double                          mass{};
+        /// Center of mass in meters, relative to the root node's center
+        osp::Vector3d                   centerOfMass;
+    };
+
+    std::vector<Node>               nodes;
+    std::vector<std::uint32_t>      bodyNext;
+};
+
 struct SimpleGravitySim
 {
+    enum class Method : std::uint8_t
+    {
+        /// Sum forces between every pair of satellites. O(n^2), fine for a handful of bodies.
+        DirectSum,
+
+        /// Approximate far-away groups of satellites as a single mass using an octree.
+        /// O(n log n), for thousands of bodies. Accuracy controlled by m_openingAngle.
+        BarnesHut
+    };
+
     struct SatData
     {
         osp::universe::Vector3g     position;
@@ -77,11 +126,36 @@ struct SimpleGravitySim
         osp::universe::SatelliteId  id;
     };
 
-    void update(std::uint64_t deltaTime) noexcept;
+    /**
+     * @brief Advance the simulation by deltaTime
+     *
+     * @param pPool [in] Optional pool to calculate accelerations in parallel, BarnesHut only
+     */
+    void update(std::uint64_t deltaTime, osp::exec::WorkerPool *pPool = nullptr) noexcept;
+
+    /**
+     * @brief Write the gravitational acceleration of every satellite to SatData::accel by summing
+     *        over every other satellite
+     */
+    void calc_accel_direct(osp::exec::WorkerPool *pPool = nullptr) noexcept;
+
+    /**
+     * @brief Write the gravitational acceleration of every satellite to SatData::accel using a
+     *        Barnes-Hut octree
+     */
+    void calc_accel_barnes_hut(osp::exec::WorkerPool *pPool = nullptr) noexcept;
 
     std::vector<SatData>            m_data;
     double                          m_metersPerPosUnit{};
     double                          m_secPerTimeUnit{};
+
+    Method                          m_method{Method::DirectSum};
+
+    /// Barnes-Hut opening angle (theta). A node is approximated as a single mass if
+    /// (node size / distance) < theta. 0 is equivalent to DirectSum, ~0.5 is typical.
+    double                          m_openingAngle{0.5};
+
+    GravityOctree                   m_octree;
 };
 
 
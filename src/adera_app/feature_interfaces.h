@@ -514,6 +514,7 @@ struct FISignalsFloat {
     struct DataIds {
         DataId sigValFloat;
         DataId sigUpdFloat;
+        DataId sigThreadsFloat;
     };
 
     struct Pipelines {
@@ -589,6 +590,14 @@ struct FITerrainIco {
     struct Pipelines { };
 };
 
+struct FITerrainFlyover {
+    struct DataIds {
+        DataId flyover;
+    };
+
+    struct Pipelines { };
+};
+
 struct FITerrainDbgDraw {
     struct DataIds {
         DataId draw;
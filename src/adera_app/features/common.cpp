@@ -389,10 +389,9 @@ FeatureDef const ftrSceneRenderer = feature_def("SceneRenderer", [] (
         .name       ("Calculate draw transforms")
         .sync_with  ({scnRender.pl.render(Run), comScn.pl.hierarchy(Ready), comScn.pl.transform(Ready), comScn.pl.activeEnt(Ready), scnRender.pl.drawTransforms(New), scnRender.pl.drawEnt(Ready), scnRender.pl.activeDrawTfs(Ready)})
         .args       ({           comScn.di.basic,           comScn.di.drawing,      scnRender.di.scnRender,                 scnRender.di.drawTfObservers })
-        .func       ([] (ACtxBasic const &rBasic, ACtxDrawing const &rDrawing, ACtxSceneRender &rScnRender, DrawTfObservers &rDrawTfObservers) noexcept
+        .func       ([] (ACtxBasic const &rBasic, ACtxDrawing const &rDrawing, ACtxSceneRender &rScnRender, DrawTfObservers &rDrawTfObservers, WorkerContext ctx) noexcept
     {
-        auto rootChildren = SysSceneGraph::children(rBasic.m_scnGraph);
-        SysRender::update_draw_transforms(
+        SysRender::update_draw_transforms_all(
                 {
                     .scnGraph     = rBasic    .m_scnGraph,
                     .transforms   = rBasic    .m_transform,
@@ -400,8 +399,7 @@ FeatureDef const ftrSceneRenderer = feature_def("SceneRenderer", [] (
                     .needDrawTf   = rScnRender.m_needDrawTf,
                     .rDrawTf      = rScnRender.m_drawTransform
                 },
-                rootChildren.begin(),
-                rootChildren.end(),
+                ctx.pPool,
                 [&rDrawTfObservers, &rScnRender] (Matrix4 const &transform, active::ActiveEnt ent, int depth)
         {
             auto const enableInt  = std::array{rScnRender.drawTfObserverEnable[ent]};
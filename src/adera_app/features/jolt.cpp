@@ -68,10 +68,13 @@ FeatureDef const ftrJolt = feature_def("Jolt", [] (
         DependOn<FIMainApp>         mainApp,
         DependOn<FIScene>           scn,
         DependOn<FICommonScene>     comScn,
-        DependOn<FIPhysics>         phys)
+        DependOn<FIPhysics>         phys,
+        entt::any                   userData)
 {
     using ospjolt::SysJolt;
 
+    JoltSettings const settings = userData ? entt::any_cast<JoltSettings>(userData) : JoltSettings{};
+
     //Mandatory Jolt setup steps (start of program)
     JoltGlobalInit::init_if_required();
     JPH_IF_ENABLE_ASSERTS(JPH::AssertFailed = AssertFailedImpl;)
@@ -79,7 +82,7 @@ FeatureDef const ftrJolt = feature_def("Jolt", [] (
     rFB.pipeline(jolt.pl.joltBody).parent(mainApp.loopblks.mainLoop);
 
     auto &rJolt = rFB.data_emplace< ACtxJoltWorld >(jolt.di.jolt);
-    setup_jolt_world(rJolt);
+    setup_jolt_world(rJolt, settings.threadCount, settings.tempAllocatorSize, settings.pSharedPool);
 
     rFB.task()
         .name       ("Delete Jolt components")
@@ -90,6 +93,15 @@ FeatureDef const ftrJolt = feature_def("Jolt", [] (
         SysJolt::update_delete (rJolt, rActiveEntDel.cbegin(), rActiveEntDel.cend());
     });
 
+    rFB.task()
+        .name       ("Apply dirty colliders to Jolt compound shapes")
+        .sync_with  ({jolt.pl.joltBody(Modify), phys.pl.mass(Modify), comScn.pl.transform(Modify)})
+        .args({                comScn.di.basic,             phys.di.phys,              jolt.di.jolt })
+        .func([] (ACtxBasic const& rBasic, ACtxPhysics& rPhys, ACtxJoltWorld& rJolt) noexcept
+    {
+        SysJolt::update_compounds(rBasic, rPhys, rJolt);
+    });
+
     rFB.task()
         .name       ("Update Jolt world")
         .sync_with  ({jolt.pl.joltBody(ReadyB4New), comScn.pl.translateOrigin(UseOrRun), phys.pl.mass(ReadyB4New), phys.pl.physUpdate(Run), comScn.pl.transform(Modify)})
@@ -119,29 +131,32 @@ ForceFactors_t add_constant_acceleration(
     auto       &rJolt       = rFW.data_get<ACtxJoltWorld>(jolt.di.jolt);
     auto       &rAccel      = rFW.data_get<ACtxConstAccel>(constAccel.di.accel);
 
-    ACtxJoltWorld::ForceFactorFunc factor
+    using UserData_t = ACtxJoltWorld::ForceFactorFunc::UserData_t;
+
+    auto const index = rJolt.m_factors.size();
+
+    ACtxConstAccel::Force &rAccelForce = rAccel.forces.emplace_back(ACtxConstAccel::Force{
+        .vec         = forceVec,
+        .factorIndex = static_cast<std::uint8_t>(index)
+    });
+
+    ACtxJoltWorld::ForceFactorFunc const factor
     {
-        .m_func = [] (BodyId const bodyId, ACtxJoltWorld const &rJolt, entt::any userData, Vector3& rForce, Vector3& rTorque) noexcept
+        .m_func = [] (JPH::Body const& rBody, BodyId const bodyId, ACtxJoltWorld const &rJolt, UserData_t const& data, Vector3& rForce, Vector3& rTorque) noexcept
         {
-            Vector3 const force = entt::any_cast<Vector3>(userData);
+            auto const& accel = *static_cast<ACtxConstAccel::Force const*>(data[0]);
 
-            float inv_mass = SysJolt::get_inverse_mass_no_lock(rJolt.m_physicsSystem, bodyId);
+            float const invMass = rBody.GetMotionProperties()->GetInverseMass();
 
-            rForce += force / inv_mass;
+            rForce += accel.vec / invMass;
         },
-        .m_userData = entt::make_any<Vector3>(forceVec)
+        .m_userData = {&rAccelForce}
     };
 
     // Register force
 
-    auto const index = rJolt.m_factors.size();
     rJolt.m_factors.emplace_back(factor);
 
-    rAccel.forces.push_back({
-        .vec         = forceVec,
-        .factorIndex = static_cast<std::uint8_t>(index)
-    });
-
     ForceFactors_t out;
     out.set(index);
     return out;
@@ -232,56 +247,6 @@ void set_phys_shape_factors(
 
 
 
-void compound_collect_recurse(
-        ACtxPhysics const&      rCtxPhys,
-        ACtxJoltWorld&          rCtxWorld,
-        ACtxBasic const&        rBasic,
-        ActiveEnt               ent,
-        Matrix4 const&          transform,
-        JPH::CompoundShapeSettings&  rCompound)
-{
-    EShape const shape = rCtxPhys.m_shape[ent];
-
-    if (shape != EShape::None)
-    {
-        bool entExists = rCtxWorld.m_shapes.contains(ent);
-        JPH::Ref<JPH::Shape> rShape = entExists
-                               ? rCtxWorld.m_shapes.get(ent)
-                               : rCtxWorld.m_shapes.emplace(ent);
-
-        if (!entExists)
-        {
-            rShape = SysJolt::create_primitive(rCtxWorld, shape, Vec3MagnumToJolt(transform.scaling()));
-        }
-        else 
-        {
-            SysJolt::scale_shape(rShape, Vec3MagnumToJolt(transform.scaling()));
-        }
-
-        rCompound.AddShape( Vec3MagnumToJolt(transform.translation()), 
-                            QuatMagnumToJolt(osp::Quaternion::fromMatrix(transform.rotation())), 
-                            rShape);
-    }
-
-    if ( ! rCtxPhys.m_hasColliders.contains(ent) )
-    {
-        return;
-    }
-
-    // Recurse into children if there are more colliders
-    for (ActiveEnt child : SysSceneGraph::children(rBasic.m_scnGraph, ent))
-    {
-        if (rBasic.m_transform.contains(child))
-        {
-            ACompTransform const &rChildTransform = rBasic.m_transform.get(child);
-
-            Matrix4 const childMatrix = transform * rChildTransform.m_transform;
-
-            compound_collect_recurse(
-                    rCtxPhys, rCtxWorld, rBasic, child, childMatrix, rCompound);
-        }
-    }
-} // void compound_collect_recurse
 
 
 FeatureDef const ftrVehicleSpawnJolt = feature_def("VehicleSpawnJolt", [] (
@@ -330,14 +295,18 @@ FeatureDef const ftrVehicleSpawnJolt = feature_def("VehicleSpawnJolt", [] (
     {
         LGRN_ASSERT(rVehicleSpawn.new_vehicle_count() != 0);
 
-        // ActiveEnts created for welds + ActiveEnts created for vehicle prefabs
-        std::size_t const totalEnts = rVehicleSpawn.rootEnts.size() + rPrefabs.newEnts.size();
-
         auto const& itWeldsFirst        = rVehicleSpawn.spawnedWelds.begin();
         auto const& itWeldOffsetsLast   = rVehicleSpawn.spawnedWeldOffsets.end();
         auto itWeldOffsets              = rVehicleSpawn.spawnedWeldOffsets.begin();
 
-        rBasic.m_scnGraph.resize(rBasic.m_activeIds.capacity());
+        // Each weld gets an ActiveEnt under the scene root, with the ActiveEnts of its prefabs
+        // under it. These are added in two batches, instead of growing the scene graph once per
+        // weld and prefab.
+        std::vector<SubtreeRequest> weldRequests(rVehicleSpawn.spawnedWelds.size(), SubtreeRequest{.descendantCount = 1});
+        std::vector<ActiveEnt>      weldEnts;
+        std::vector<uint32_t>       prefabInits;
+        std::vector<ActiveEnt>      prefabParents;
+        weldEnts.reserve(rVehicleSpawn.spawnedWelds.size());
 
         for (ACtxVehicleSpawn::TmpToInit const& toInit : rVehicleSpawn.spawnRequest)
         {
@@ -348,37 +317,34 @@ FeatureDef const ftrVehicleSpawnJolt = feature_def("VehicleSpawnJolt", [] (
 
             std::for_each(itWeldsFirst + std::ptrdiff_t{*itWeldOffsets},
                           itWeldsFirst + std::ptrdiff_t{weldOffsetNext},
-                          [&rBasic, &rScnParts, &rVehicleSpawn, &rPrefabs, &rResources, &toInit] (WeldId const weld)
+                          [&rBasic, &rScnParts, &rVehicleSpawn, &toInit, &weldEnts, &prefabInits, &prefabParents] (WeldId const weld)
             {
-                // Count parts in this weld first
-                std::size_t entCount = 0;
-                for (PartId const part : rScnParts.weldToParts[weld])
-                {
-                    SpPartId const newPart = rVehicleSpawn.partToSpawned[part];
-                    uint32_t const prefabInit = rVehicleSpawn.spawnedPrefabs[newPart];
-                    entCount += rPrefabs.spawnedEntsOffset[prefabInit].size();
-                }
-
                 ActiveEnt const weldEnt = rScnParts.weldToActive[weld];
 
                 rBasic.m_transform.emplace(weldEnt, Matrix4::from(toInit.rotation.toMatrix(), toInit.position));
 
-                SubtreeBuilder bldRoot = SysSceneGraph::add_descendants(rBasic.m_scnGraph, entCount + 1);
-                SubtreeBuilder bldWeld = bldRoot.add_child(weldEnt, entCount);
+                weldEnts.push_back(weldEnt);
 
                 for (PartId const part : rScnParts.weldToParts[weld])
                 {
-                    SpPartId const newPart      = rVehicleSpawn.partToSpawned[part];
-                    uint32_t const prefabInit   = rVehicleSpawn.spawnedPrefabs[newPart];
-                    auto const& basic           = rPrefabs.spawnRequest[prefabInit];
-                    auto const& ents            = rPrefabs.spawnedEntsOffset[prefabInit];
-
-                    SysPrefabInit::add_to_subtree(basic, ents, rResources, bldWeld);
+                    SpPartId const newPart = rVehicleSpawn.partToSpawned[part];
+                    prefabInits  .push_back(rVehicleSpawn.spawnedPrefabs[newPart]);
+                    prefabParents.push_back(weldEnt);
                 }
             });
 
             itWeldOffsets = itWeldOffsetsNext;
         }
+
+        rBasic.m_scnGraph.resize(rBasic.m_activeIds.capacity());
+
+        std::vector<SubtreeBuilder> weldBuilders = SysSceneGraph::add_descendants(rBasic.m_scnGraph, weldRequests);
+        for (std::size_t i = 0; i < weldEnts.size(); ++i)
+        {
+            weldBuilders[i].add_child(weldEnts[i]);
+        }
+
+        SysPrefabInit::add_to_scene_graph(rPrefabs, rResources, prefabInits, prefabParents, rBasic.m_scnGraph);
     });
 
 
@@ -413,40 +379,26 @@ FeatureDef const ftrVehicleSpawnJolt = feature_def("VehicleSpawnJolt", [] (
             {
                 ActiveEnt const weldEnt = rScnParts.weldToActive[weld];
 
-                JPH::MutableCompoundShapeSettings compound;
-
                 rPhys.m_hasColliders.insert(weldEnt);
 
-                // Collect all colliders from hierarchy.
-                compound_collect_recurse( rPhys, rJolt, rBasic, weldEnt, Matrix4{}, compound );
-
-                JPH::Ref<JPH::Shape> compoundShape = compound.Create().Get();
-                JPH::BodyCreationSettings bodyCreation(compoundShape, JPH::Vec3Arg::sZero(), JPH::Quat::sZero(), JPH::EMotionType::Dynamic, Layers::MOVING);
-                bodyCreation.mMaxLinearVelocity = 65536.0f;
-
                 BodyId const bodyId = rJolt.m_bodyIds.create();
 
                 rJolt.m_bodyToEnt[bodyId] = weldEnt;
                 rJolt.m_bodyFactors[bodyId] = factors;
                 rJolt.m_entToBody.emplace(weldEnt, bodyId);
 
-                float   totalMass = 0.0f;
-                Vector3 massPos{0.0f};
-                SysPhysics::calculate_subtree_mass_center(rBasic.m_transform, rPhys, rBasic.m_scnGraph, weldEnt, massPos, totalMass);
-
-                Vector3 const com = massPos / totalMass;
-                auto const comToOrigin = Matrix4::translation( - com );
-
-                Matrix3 inertiaTensor{0.0f};
-                SysPhysics::calculate_subtree_mass_inertia(rBasic.m_transform, rPhys, rBasic.m_scnGraph, weldEnt, inertiaTensor, comToOrigin);
-
-                Matrix4 const inertiaTensorMat4{inertiaTensor};
+                // Collect all colliders from hierarchy. Kept as a mutable compound, so later
+                // collider changes only add, move, or remove the affected sub-shapes.
+                JPH::Ref<JPH::MutableCompoundShape> const compoundShape
+                        = SysJolt::create_compound(rPhys, rJolt, rBasic, weldEnt, bodyId);
 
-                JPH::MassProperties massProp;
-                massProp.mMass = totalMass;
-                massProp.mInertia = JPH::Mat44::sLoadFloat4x4((JPH::Float4*) inertiaTensorMat4.data());
+                JPH::BodyCreationSettings bodyCreation(compoundShape, JPH::Vec3Arg::sZero(), JPH::Quat::sZero(), JPH::EMotionType::Dynamic, Layers::MOVING);
+                bodyCreation.mMaxLinearVelocity = 65536.0f;
 
-                bodyCreation.mMassPropertiesOverride = massProp;
+                // Inertia about the shape's center of mass, which the body rotates around
+                bodyCreation.mMassPropertiesOverride = SysJolt::compound_mass_properties(
+                        rJolt.m_compoundBodies.at(bodyId).mass,
+                        Vec3JoltToMagnum(compoundShape->GetCenterOfMass()));
                 bodyCreation.mOverrideMassProperties = JPH::EOverrideMassProperties::MassAndInertiaProvided;
 
                 bodyCreation.mLinearDamping = 0.0f;
@@ -607,31 +559,23 @@ static void assign_weld_rockets(
     }
 }
 
-struct RocketThrustUserData
-{
-    ACtxRocketsJolt       const &rRocketsJolt;
-    Machines              const &rMachines;
-    SignalValues_t<float> const &rSigValFloat;
-};
-
 // ACtxjoltWorld::ForceFactorFunc::Func_t
-static void rocket_thrust_force(BodyId const bodyId, ACtxJoltWorld const& rJolt, entt::any userData, Vector3& rForce, Vector3& rTorque) noexcept
+static void rocket_thrust_force(JPH::Body const& rBody, BodyId const bodyId, ACtxJoltWorld const& rJolt, ACtxJoltWorld::ForceFactorFunc::UserData_t const& data, Vector3& rForce, Vector3& rTorque) noexcept
 {
-    auto const [rRocketsJolt, rMachines, rSigValFloat] = entt::any_cast<RocketThrustUserData>(userData);
-    auto &rBodyRockets = rRocketsJolt.m_bodyRockets[bodyId.value];
+    auto const& rRocketsJolt    = *static_cast<ACtxRocketsJolt const*>             (data[0]);
+    auto const& rMachines       = *static_cast<Machines const*>                    (data[1]);
+    auto const& rSigValFloat    = *static_cast<SignalValues_t<float> const*>       (data[2]);
 
-    //no lock as all bodies are locked in callbacks
-    JPH::BodyInterface const &bodyInterface = rJolt.m_physicsSystem.GetBodyInterfaceNoLock();
+    auto &rBodyRockets = rRocketsJolt.m_bodyRockets[bodyId.value];
 
     if (rBodyRockets.empty())
     {
         return;
     }
 
-    JPH::BodyID joltBodyId = BToJolt(bodyId);
-    Quaternion const rot = QuatJoltToMagnum(bodyInterface.GetRotation(joltBodyId));
+    Quaternion const rot = QuatJoltToMagnum(rBody.GetRotation());
 
-    JPH::Shape const* shape = bodyInterface.GetShape(joltBodyId).GetPtr();
+    JPH::Shape const* shape = rBody.GetShape();
     if (shape == nullptr)
     {
         return;
@@ -708,7 +652,7 @@ FeatureDef const ftrRocketThrustJolt = feature_def("RocketThrustJolt", [] (
     ACtxJoltWorld::ForceFactorFunc const factor
     {
         .m_func     = &rocket_thrust_force,
-        .m_userData = RocketThrustUserData{ rRocketsJolt, rMachines, rSigValFloat }
+        .m_userData = { &rRocketsJolt, &rMachines, &rSigValFloat }
     };
 
     auto &rJolt = rFB.data_get<ACtxJoltWorld>(jolt.di.jolt);
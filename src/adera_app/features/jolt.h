@@ -30,6 +30,13 @@
 
 #include <ospjolt/activescene/forcefactors.h>
 
+#include <cstddef>
+#include <deque>
+
+namespace osp::exec
+{
+    class WorkerPool;
+}
 
 namespace adera
 {
@@ -42,7 +49,24 @@ struct ACtxConstAccel
         std::uint8_t factorIndex;
     };
 
-    std::vector<Force> forces;
+    // deque, as ForceFactorFunc user data points to these
+    std::deque<Force> forces;
+};
+
+/**
+ * @brief Jolt world settings, optionally passed to ftrJolt as feature user data
+ */
+struct JoltSettings
+{
+    /// Number of threads for Jolt's own job system. -1 uses all cores but one.
+    int                     threadCount         {2};
+
+    /// Size of the temporary allocator used each physics step, in bytes
+    std::size_t             tempAllocatorSize   {10 * 1024 * 1024};
+
+    /// If set, Jolt jobs run on this pool instead of threadCount threads of its own. Must outlive
+    /// the scene.
+    osp::exec::WorkerPool   *pSharedPool        {nullptr};
 };
 
 /**
@@ -52,6 +52,7 @@ FeatureDef const ftrCameraFree = feature_def("CameraFree", [] (
 {
     rFB.task()
         .name       ("Move Camera controller")
+        .main_thread(true)
         .sync_with  ({windowApp.pl.inputs(Run), camCtrl.pl.camCtrl(Modify)})
         .args       ({                 camCtrl.di.camCtrl,           scn.di.deltaTimeIn })
         .func([] (ACtxCameraController& rCamCtrl, float const deltaTimeIn) noexcept
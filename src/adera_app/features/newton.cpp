@@ -149,7 +149,7 @@ osp::Session setup_newton_force_accel(
             float dummy = 0.0f;
             NewtonBodyGetMass(pBody, &mass, &dummy, &dummy, &dummy);
 
-            auto const& force = *reinterpret_cast<Vector3 const*>(data[0]);
+            auto const& force = *static_cast<Vector3 const*>(data[0]);
             rForce += force * mass;
         },
         .m_userData = {&rAccel}
@@ -342,14 +342,18 @@ Session setup_vehicle_spawn_newton(
     {
         LGRN_ASSERT(rVehicleSpawn.new_vehicle_count() != 0);
 
-        // ActiveEnts created for welds + ActiveEnts created for vehicle prefabs
-        std::size_t const totalEnts = rVehicleSpawn.rootEnts.size() + rPrefabs.newEnts.size();
-
         auto const& itWeldsFirst        = rVehicleSpawn.spawnedWelds.begin();
         auto const& itWeldOffsetsLast   = rVehicleSpawn.spawnedWeldOffsets.end();
         auto itWeldOffsets              = rVehicleSpawn.spawnedWeldOffsets.begin();
 
-        rBasic.m_scnGraph.resize(rBasic.m_activeIds.capacity());
+        // Each weld gets an ActiveEnt under the scene root, with the ActiveEnts of its prefabs
+        // under it. These are added in two batches, instead of growing the scene graph once per
+        // weld and prefab.
+        std::vector<SubtreeRequest> weldRequests(rVehicleSpawn.spawnedWelds.size(), SubtreeRequest{.descendantCount = 1});
+        std::vector<ActiveEnt>      weldEnts;
+        std::vector<uint32_t>       prefabInits;
+        std::vector<ActiveEnt>      prefabParents;
+        weldEnts.reserve(rVehicleSpawn.spawnedWelds.size());
 
         for (ACtxVehicleSpawn::TmpToInit const& toInit : rVehicleSpawn.spawnRequest)
         {
@@ -360,37 +364,34 @@ Session setup_vehicle_spawn_newton(
 
             std::for_each(itWeldsFirst + std::ptrdiff_t{*itWeldOffsets},
                           itWeldsFirst + std::ptrdiff_t{weldOffsetNext},
-                          [&rBasic, &rScnParts, &rVehicleSpawn, &rPrefabs, &rResources, &toInit] (WeldId const weld)
+                          [&rBasic, &rScnParts, &rVehicleSpawn, &toInit, &weldEnts, &prefabInits, &prefabParents] (WeldId const weld)
             {
-                // Count parts in this weld first
-                std::size_t entCount = 0;
-                for (PartId const part : rScnParts.weldToParts[weld])
-                {
-                    SpPartId const newPart = rVehicleSpawn.partToSpawned[part];
-                    uint32_t const prefabInit = rVehicleSpawn.spawnedPrefabs[newPart];
-                    entCount += rPrefabs.spawnedEntsOffset[prefabInit].size();
-                }
-
                 ActiveEnt const weldEnt = rScnParts.weldToActive[weld];
 
                 rBasic.m_transform.emplace(weldEnt, Matrix4::from(toInit.rotation.toMatrix(), toInit.position));
 
-                SubtreeBuilder bldRoot = SysSceneGraph::add_descendants(rBasic.m_scnGraph, entCount + 1);
-                SubtreeBuilder bldWeld = bldRoot.add_child(weldEnt, entCount);
+                weldEnts.push_back(weldEnt);
 
                 for (PartId const part : rScnParts.weldToParts[weld])
                 {
-                    SpPartId const newPart      = rVehicleSpawn.partToSpawned[part];
-                    uint32_t const prefabInit   = rVehicleSpawn.spawnedPrefabs[newPart];
-                    auto const& basic           = rPrefabs.spawnRequest[prefabInit];
-                    auto const& ents            = rPrefabs.spawnedEntsOffset[prefabInit];
-
-                    SysPrefabInit::add_to_subtree(basic, ents, rResources, bldWeld);
+                    SpPartId const newPart = rVehicleSpawn.partToSpawned[part];
+                    prefabInits  .push_back(rVehicleSpawn.spawnedPrefabs[newPart]);
+                    prefabParents.push_back(weldEnt);
                 }
             });
 
             itWeldOffsets = itWeldOffsetsNext;
         }
+
+        rBasic.m_scnGraph.resize(rBasic.m_activeIds.capacity());
+
+        std::vector<SubtreeBuilder> weldBuilders = SysSceneGraph::add_descendants(rBasic.m_scnGraph, weldRequests);
+        for (std::size_t i = 0; i < weldEnts.size(); ++i)
+        {
+            weldBuilders[i].add_child(weldEnts[i]);
+        }
+
+        SysPrefabInit::add_to_scene_graph(rPrefabs, rResources, prefabInits, prefabParents, rBasic.m_scnGraph);
     });
 
     rFB.task()
@@ -594,9 +595,9 @@ static void assign_rockets(
 // ACtxNwtWorld::ForceFactorFunc::Func_t
 static void rocket_thrust_force(NewtonBody const* pBody, BodyId const body, ACtxNwtWorld const& rNwt, ACtxNwtWorld::ForceFactorFunc::UserData_t data, Vector3& rForce, Vector3& rTorque) noexcept
 {
-    auto const& rRocketsNwt     = *reinterpret_cast<ACtxRocketsNwt const*>          (data[0]);
-    auto const& rMachines       = *reinterpret_cast<Machines const*>                (data[1]);
-    auto const& rSigValFloat    = *reinterpret_cast<SignalValues_t<float> const*>   (data[2]);
+    auto const& rRocketsNwt     = *static_cast<ACtxRocketsNwt const*>              (data[0]);
+    auto const& rMachines       = *static_cast<Machines const*>                    (data[1]);
+    auto const& rSigValFloat    = *static_cast<SignalValues_t<float> const*>       (data[2]);
 
     auto &rBodyRockets = rRocketsNwt.m_bodyRockets[body];
 
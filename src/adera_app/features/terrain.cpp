@@ -36,11 +36,14 @@
 #include <osp/core/math_2pow.h>
 #include <osp/core/math_int64.h>
 #include <osp/drawing/drawing.h>
+#include <osp/executor/worker_pool.h>
 #include <osp/framework/builder.h>
 #include <osp/util/logging.h>
 
 #include <longeron/utility/asserts.hpp>
 
+#include <algorithm>
+
 using namespace adera;
 using namespace ftr_inter::stages;
 using namespace ftr_inter;
@@ -136,6 +139,10 @@ FeatureDef const ftrTerrainSubdivDist = feature_def("TerrainSubdivDist", [] (
 
         Vector3l const& viewerPos = rTerrain.scratchpad.viewerPosition;
 
+        // Unsubdivide and subdivide share the same per-frame budget. If it runs out, remaining
+        // triangles are found and processed again next frame.
+        subdiv_budget_begin(rSkSP);
+
         // ## Unsubdivide triangles that are too far away
 
         // Unsubdivide is performed first, since it's better to remove stuff before adding new
@@ -185,8 +192,12 @@ FeatureDef const ftrTerrainSubdivDist = feature_def("TerrainSubdivDist", [] (
         .name       ("Update Terrain Chunks")
         .sync_with  ({terrain.pl.terrainFrame(Ready), terrain.pl.skeleton(Ready), terrain.pl.surfaceChanges(UseOrRun), terrain.pl.chunkMesh(Modify)})
         .args       ({           terrain.di.terrainFrame,    terrain.di.terrain,    terrainIco.di.terrainIco })
-        .func       ([] (ACtxTerrainFrame &rTerrainFrame, ACtxTerrain &rTerrain, ACtxTerrainIco &rTerrainIco) noexcept
+        .func       ([] (ACtxTerrainFrame &rTerrainFrame, ACtxTerrain &rTerrain, ACtxTerrainIco &rTerrainIco, WorkerContext ctx) noexcept
     {
+        // Renderers upload whatever is recorded from here
+        rTerrain.chunkGeom.vrtxDirty.clear();
+        rTerrain.chunkGeom.indxDirty.clear();
+
         if ( ! rTerrainFrame.active )
         {
             return;
@@ -197,6 +208,7 @@ FeatureDef const ftrTerrainSubdivDist = feature_def("TerrainSubdivDist", [] (
         ChunkSkeleton              &rSkCh      = rTerrain.skChunks;
         ChunkMeshBufferInfo        &rChInfo    = rTerrain.chunkInfo;
         BasicChunkMeshGeometry     &rChGeo     = rTerrain.chunkGeom;
+        ChunkMeshCache             &rChCache   = rTerrain.chunkCache;
         ChunkScratchpad            &rChSP      = rTerrain.chunkSP;
         SkeletonSubdivScratchpad   &rSkSP      = rTerrain.scratchpad;
 
@@ -212,6 +224,7 @@ FeatureDef const ftrTerrainSubdivDist = feature_def("TerrainSubdivDist", [] (
             ChunkId const chunkId = rSkCh.m_triToChunk[sktriId];
             if (chunkId.has_value())
             {
+                rChCache.store(chunkId, rChGeo, rChInfo, rSkCh);
                 subtract_normal_contrib(chunkId, false, rChGeo, rChInfo, rChSP, rSkCh);
                 rSkCh.chunk_remove(chunkId, sktriId, rChSP.sharedRemoved, rSkel);
                 rChSP.chunksRemoved.insert(chunkId);
@@ -244,6 +257,8 @@ FeatureDef const ftrTerrainSubdivDist = feature_def("TerrainSubdivDist", [] (
             rSkData.resize(rSkel);
             rSkSP.resize(rSkel);
 
+            rChCache.set_chunk_key(chunkId, ChunkMeshCache::make_key(sktriId, rSkel, rSkData));
+
             // Calculates positions and normals with spherical curvature
             ico_calc_chunk_edge(rTerrainIco.radius, chLevel, corners[0], corners[1], edgeLft, rSkData);
             ico_calc_chunk_edge(rTerrainIco.radius, chLevel, corners[1], corners[2], edgeBtm, rSkData);
@@ -260,25 +275,35 @@ FeatureDef const ftrTerrainSubdivDist = feature_def("TerrainSubdivDist", [] (
         auto const vbufPosView = rChGeo.vbufPositions.view(rChGeo.vrtxBuffer, rChInfo.vrtxTotal);
         auto const vbufNrmView = rChGeo.vbufNormals  .view(rChGeo.vrtxBuffer, rChInfo.vrtxTotal);
 
-        // TODO: temporary code of course
-        auto const heightmap = [scale, h = rTerrainIco.height] (Vector3l posl) -> float
-        {
-            return h * std::clamp<double>(    0.1*(0.5 - 0.5*std::cos(0.000050*posl.x()*scale*2.0*3.14159))
-                                            + 0.9*(0.5 - 0.5*std::cos(0.000005*posl.y()*scale*2.0*3.14159)) , 0.0, 1.0 );
-        };
+        ITerrainGenerator const &rGenerator = *rTerrainIco.generator;
 
-        auto const update_shared_vrtx_position
-                = [&vbufPosView, &heightmap, scale, &rSkCh, &rChInfo, &rSkData, &rChGeo, &rTerrainIco]
-                  (SharedVrtxId const sharedVrtxId)
+        // Heights of shared vertices are calculated in one batch
+        auto const update_shared_vrtx_positions
+                = [&vbufPosView, &rGenerator, scale, &rSkCh, &rChInfo, &rSkData, &rChGeo, &rChSP, &rTerrainIco]
+                  (auto const& sharedVrtxIds)
         {
-            SkVrtxId  const skelVrtx   = rSkCh.m_sharedToSkVrtx[sharedVrtxId];
-            VertexIdx const vbufVertex = rChInfo.vbufSharedOffset + sharedVrtxId.value;
-            Vector3l  const skPos      = rSkData.positions[skelVrtx];
-            Vector3   const posOut     = Vector3{skPos - rChGeo.originSkelPos} * scale;
-            Vector3   const radialDir  = Vector3{Vector3d(skPos) * scale / rTerrainIco.radius};
-
-            rChGeo.sharedPosNoHeightmap[sharedVrtxId] = posOut;
-            vbufPosView[vbufVertex]                   = posOut + radialDir * heightmap(skPos);
+            rChSP.sharedHeightPos.clear();
+            for (SharedVrtxId const sharedVrtxId : sharedVrtxIds)
+            {
+                rChSP.sharedHeightPos.push_back(rSkData.positions[rSkCh.m_sharedToSkVrtx[sharedVrtxId]]);
+            }
+
+            rChSP.sharedHeights.resize(rChSP.sharedHeightPos.size());
+            rGenerator.heights(rChSP.sharedHeightPos, rSkData.precision, rChSP.sharedHeights, {});
+
+            std::size_t i = 0;
+            for (SharedVrtxId const sharedVrtxId : sharedVrtxIds)
+            {
+                VertexIdx const vbufVertex = rChInfo.vbufSharedOffset + sharedVrtxId.value;
+                Vector3l  const skPos      = rChSP.sharedHeightPos[i];
+                Vector3   const posOut     = Vector3{skPos - rChGeo.originSkelPos} * scale;
+                Vector3   const radialDir  = Vector3{Vector3d(skPos) * scale / rTerrainIco.radius};
+
+                rChGeo.sharedPosNoHeightmap[sharedVrtxId] = posOut;
+                vbufPosView[vbufVertex]                   = posOut + radialDir * rChSP.sharedHeights[i];
+                rChGeo.positions_dirty(vbufVertex, 1);
+                ++i;
+            }
         };
 
         // TODO: Limit rChGeo.originSkelPos to always be near the surface. There isn't a point in
@@ -291,10 +316,7 @@ FeatureDef const ftrTerrainSubdivDist = feature_def("TerrainSubdivDist", [] (
         {
             // Copy offsetted positions from the skeleton for newly added shared vertices
 
-            for (SharedVrtxId const sharedVrtxId : rChSP.sharedAdded)
-            {
-                update_shared_vrtx_position(sharedVrtxId);
-            }
+            update_shared_vrtx_positions(rChSP.sharedAdded);
         }
         else
         {
@@ -305,11 +327,11 @@ FeatureDef const ftrTerrainSubdivDist = feature_def("TerrainSubdivDist", [] (
             Vector3  const deltaOffsetF = Vector3(deltaOffset) * scale;
             rChGeo.originSkelPos = rTerrainFrame.position;
 
+            // Every vertex position moves
+            rChGeo.vrtxDirty.add_all(rChGeo.vrtxBuffer.size());
+
             // Refresh all shared vertex positions
-            for (SharedVrtxId const sharedVrtxId : rSkCh.m_sharedIds)
-            {
-                update_shared_vrtx_position(sharedVrtxId);
-            }
+            update_shared_vrtx_positions(rSkCh.m_sharedIds);
 
             // Translate all existing chunk fill vertices
             for (ChunkId const chunkId : rSkCh.m_chunkIds)
@@ -329,12 +351,19 @@ FeatureDef const ftrTerrainSubdivDist = feature_def("TerrainSubdivDist", [] (
 
         Vector3d const center = -Vector3d(rChGeo.originSkelPos) * scale;
 
-        // Calculate new fill vertex positions
-        for (ChunkId const chunkId : rChSP.chunksAdded)
+        // Calculate new fill vertex positions and write fill faces. Each chunk only writes to its
+        // own range of the vertex and index buffers, so chunks are done in parallel.
+        auto const generate_fill = [&] (ChunkId const chunkId, ChunkScratchpad::FillHeightBuffers &rBuf)
         {
             std::size_t const fillOffset = rChInfo.vbufFillOffset + chunkId.value*rChInfo.fillVrtxCount;
             osp::ArrayView<SharedVrtxOwner_t const> sharedUsed = rSkCh.shared_vertices_used(chunkId);
 
+            if (rChSP.chunksRestored.contains(chunkId))
+            {
+                update_fill_faces(chunkId, rChGeo, rChInfo, rSkCh, true);
+                return;
+            }
+
             // Use ChunkFillSubdivLUT to generate a spherically curved triangle fill through
             // building up and subdividing pairs of vertices. Don't apply heightmap yet, as this
             // will interfere with middle position and curvature calculations.
@@ -357,37 +386,95 @@ FeatureDef const ftrTerrainSubdivDist = feature_def("TerrainSubdivDist", [] (
                 vbufPosView[fillOffset + toSubdiv.fillOut] = Vector3(posOut);
             }
 
-            // Apply heightmap afterwards
-            for (Vector3 &rPos : vbufPosView.sliceSize(fillOffset, rChInfo.fillVrtxCount))
+            // Apply heightmap afterwards, calculating heights for the whole chunk at once
+            auto const fillPosView = vbufPosView.sliceSize(fillOffset, rChInfo.fillVrtxCount);
+
+            rBuf.skelPos.resize(rChInfo.fillVrtxCount);
+            rBuf.heights.resize(rChInfo.fillVrtxCount);
+
+            for (std::size_t i = 0; i < rChInfo.fillVrtxCount; ++i)
+            {
+                rBuf.skelPos[i] = Vector3l(fillPosView[i] / scale) + rChGeo.originSkelPos;
+            }
+
+            rGenerator.heights(rBuf.skelPos, rSkData.precision, rBuf.heights, {});
+
+            for (std::size_t i = 0; i < rChInfo.fillVrtxCount; ++i)
             {
+                Vector3          &rPos      = fillPosView[i];
                 Vector3d   const centerDiff = Vector3d(rPos) - center;
                 double     const centerDist = centerDiff.length();
                 Vector3    const radialDir  = Vector3{centerDiff / centerDist};
 
-                Vector3l const bigpos = Vector3l(rPos / scale) + rChGeo.originSkelPos;
+                rPos += radialDir * rBuf.heights[i];
+            }
+
+            update_fill_faces(chunkId, rChGeo, rChInfo, rSkCh);
+        };
+
+        rChSP.chunksAddedList.assign(rChSP.chunksAdded.begin(), rChSP.chunksAdded.end());
 
-                rPos += radialDir * heightmap(bigpos);
+        // Chunks revisited recently don't need to generate fill vertices again
+        rChSP.chunksRestored.clear();
+        for (ChunkId const chunkId : rChSP.chunksAddedList)
+        {
+            if (rChCache.restore(chunkId, rChGeo, rChInfo, rSkCh, scale))
+            {
+                rChSP.chunksRestored.insert(chunkId);
+            }
+        }
+
+        // Split chunks into a few contiguous ranges per thread for load balancing. Each range has
+        // its own buffers, reused instead of allocating new ones per chunk. Buffers can't be
+        // picked by thread, as any thread helping the pool (not just the one calling this) may
+        // run a range.
+        std::size_t const threadCount   = 1 + ((ctx.pPool != nullptr) ? ctx.pPool->thread_count() : 0);
+        std::size_t const chunkCount    = rChSP.chunksAddedList.size();
+        std::size_t const rangeCount    = std::min(chunkCount, 4 * threadCount);
+
+        if (rChSP.fillHeightBuffers.size() < rangeCount)
+        {
+            rChSP.fillHeightBuffers.resize(rangeCount);
+        }
+
+        osp::exec::parallel_for(ctx.pPool, std::uint32_t(rangeCount),
+                                [&generate_fill, &rChSP, chunkCount, rangeCount] (std::uint32_t const range)
+        {
+            std::size_t const first = chunkCount * range / rangeCount;
+            std::size_t const last  = chunkCount * (range + 1) / rangeCount;
+            for (std::size_t i = first; i < last; ++i)
+            {
+                generate_fill(rChSP.chunksAddedList[i], rChSP.fillHeightBuffers[range]);
             }
+        });
+
+        for (ChunkId const chunkId : rChSP.chunksAddedList)
+        {
+            fill_dirty(chunkId, rChGeo, rChInfo);
         }
 
         // Normal is not cleaned up by the previous user; Initially set them to zero.
-        // Face normals added in update_faces(...) will accumulate here.
+        // Face normals added below will accumulate here.
         for (SharedVrtxId const sharedVrtxId : rChSP.sharedAdded)
         {
             rChGeo.sharedNormalSum[sharedVrtxId] = Vector3{ZeroInit};
         }
 
+        // Everything from here modifies shared vertices, and is done serially
+
+        for (ChunkId const chunkId : rChSP.chunksAddedList)
+        {
+            add_fill_shared_normals(chunkId, rChGeo, rChSP, rSkCh);
+        }
+
         // Update Index buffer
 
-        // Add or remove faces according to chunk changes. This also calculates normals.
+        // Add or replace fan faces according to chunk changes. This also calculates normals.
         // Vertex normals are calculated from a weighted sum of face normals of connected faces.
         // For shared vertices, we add or subtract face normals from rChGeo.sharedNormalSum.
         for (ChunkId const chunkId : rSkCh.m_chunkIds)
         {
-            SkTriId const sktriId    = rSkCh.m_chunkToTri[chunkId];
-            bool    const newlyAdded = rSkSP.surfaceAdded.contains(sktriId);
-
-            update_faces(chunkId, sktriId, newlyAdded, rSkel, rSkData, rChGeo, rChInfo, rChSP, rSkCh);
+            update_fan_faces(chunkId, rSkCh.m_chunkToTri[chunkId], rSkel, rChGeo, rChInfo, rChSP, rSkCh);
         }
         std::fill(rChSP.stitchCmds.begin(), rChSP.stitchCmds.end(), ChunkStitch{});
 
@@ -400,6 +487,7 @@ FeatureDef const ftrTerrainSubdivDist = feature_def("TerrainSubdivDist", [] (
             {
                 auto const indicesView = ibuf2d.row(chunkId.value);
                 std::fill(indicesView.begin(), indicesView.end(), Vector3u{0, 0, 0});
+                rChGeo.faces_dirty(chunkId.value*rChInfo.chunkMaxFaceCount, rChInfo.chunkMaxFaceCount);
             }
         }
 
@@ -408,8 +496,13 @@ FeatureDef const ftrTerrainSubdivDist = feature_def("TerrainSubdivDist", [] (
         {
             Vector3 const normalSum = rChGeo.sharedNormalSum[sharedId];
             vbufNrmView[rChInfo.vbufSharedOffset + sharedId.value] = normalSum.normalized();
+            rChGeo.normals_dirty(rChInfo.vbufSharedOffset + sharedId.value, 1);
         }
 
+        // Many of these are single vertices next to each other
+        rChGeo.vrtxDirty.coalesce();
+        rChGeo.indxDirty.coalesce();
+
         // Uncomment these if some new change breaks something
         //debug_check_invariants(rChGeo, rChInfo, rSkCh);
 
@@ -424,10 +517,13 @@ FeatureDef const ftrTerrainSubdivDist = feature_def("TerrainSubdivDist", [] (
                          "* Skeleton Triangles:   {}\n"
                          "* Skeleton Vertices:    {}\n"
                          "* Chunks:               {}/{}\n"
-                         "* Shared Vertices:      {}/{}\n",
+                         "* Shared Vertices:      {}/{}\n"
+                         "* Chunk Cache:          {} chunks, {}/{} bytes, {} hits, {} misses\n",
                          rSkel.tri_group_ids().size()*4, rSkel.vrtx_ids().size(),
                          rSkCh.m_chunkIds.size(), rSkCh.m_chunkIds.capacity(),
-                         rSkCh.m_sharedIds.size(), rSkCh.m_sharedIds.capacity());
+                         rSkCh.m_sharedIds.size(), rSkCh.m_sharedIds.capacity(),
+                         rChCache.entry_count(), rChCache.size_bytes(), rChCache.max_bytes(),
+                         rChCache.hits(), rChCache.misses());
         }
 
         /*
@@ -452,6 +548,33 @@ FeatureDef const ftrTerrainSubdivDist = feature_def("TerrainSubdivDist", [] (
     });
 }); // ftrTerrainSubdivDist
 
+FeatureDef const ftrTerrainFlyover = feature_def("TerrainFlyover", [] (
+        FeatureBuilder              &rFB,
+        Implement<FITerrainFlyover> terrainFlyover,
+        DependOn<FIScene>           scn,
+        DependOn<FITerrain>         terrain,
+        DependOn<FITerrainIco>      terrainIco,
+        entt::any                   data)
+{
+    rFB.data_emplace< TerrainFlyover >(terrainFlyover.di.flyover, entt::any_cast<TerrainFlyover>(data));
+
+    rFB.task()
+        .name       ("Move terrain viewer along flyover path")
+        .sync_with  ({terrain.pl.terrainFrame(Modify)})
+        .args       ({           terrainFlyover.di.flyover,   scn.di.deltaTimeIn,  terrain.di.terrain,    terrainIco.di.terrainIco })
+        .func       ([] (TerrainFlyover &rFlyover, float const deltaTimeIn, ACtxTerrain &rTerrain, ACtxTerrainIco const &rTerrainIco) noexcept
+    {
+        double const distance = rTerrainIco.radius + rTerrainIco.height + rFlyover.altitude;
+        double const scale    = std::exp2(double(rTerrain.skData.precision));
+
+        rFlyover.angle += rFlyover.speed * double(deltaTimeIn) / distance;
+
+        // Starts above the north pole (0, 0, 1), same as where terrain scenarios place the scene
+        Vector3d const dir{std::sin(rFlyover.angle), 0.0, std::cos(rFlyover.angle)};
+        rTerrain.scratchpad.viewerPosition = Vector3l(dir * distance * scale);
+    });
+}); // ftrTerrainFlyover
+
 void initialize_ico_terrain(
         osp::fw::Framework          &rFW,
         osp::fw::ContextId          sceneCtx,
@@ -470,6 +593,11 @@ void initialize_ico_terrain(
 
     rTerrainIco.radius          = specs.radius;
     rTerrainIco.height          = specs.height;
+    rTerrainIco.generator       = std::move(specs.generator);
+    if (rTerrainIco.generator == nullptr)
+    {
+        rTerrainIco.generator = std::make_unique<CosineTerrainGenerator>(specs.height);
+    }
     rTerrain.skData.precision   = specs.skelPrecision;
     rTerrain.skeleton = create_skeleton_icosahedron(
             rTerrainIco.radius,
@@ -572,6 +700,7 @@ void initialize_ico_terrain(
 
     rTerrain.chunkInfo = make_chunk_mesh_buffer_info(rTerrain.skChunks);
     rTerrain.chunkGeom.resize(rTerrain.skChunks, rTerrain.chunkInfo);
+    rTerrain.chunkCache.set_max_bytes(specs.chunkCacheMaxBytes);
 
     // ## Prepare Chunk scratchpad
 
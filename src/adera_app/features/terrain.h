@@ -24,8 +24,12 @@
  */
 #pragma once
 
+#include <planet-a/terrain_generator.h>
+
 #include <osp/framework/builder.h>
 
+#include <memory>
+
 namespace adera
 {
 
@@ -63,6 +67,13 @@ struct TerrainTestPlanetSpecs
     /// Number of times an initial triangle is subdivided to form a chunk.
     /// Due to bugs (LOL XD): Minimum is 2, Maximum is 8.
     std::uint8_t    chunkSubdivLevels   {};
+
+    /// Memory cap for fill vertices of recently removed chunks, see planeta::ChunkMeshCache.
+    /// 0 disables the cache.
+    std::size_t     chunkCacheMaxBytes  {};
+
+    /// Terrain heights, see planeta::ITerrainGenerator. Placeholder cosine waves if null.
+    std::unique_ptr<planeta::ITerrainGenerator> generator;
 };
 
 
@@ -75,6 +86,26 @@ void initialize_ico_terrain(
         TerrainTestPlanetSpecs      specs);
 
 
+struct TerrainFlyover
+{
+    /// Speed along the surface in meters per second
+    double  speed       {};
+
+    /// Meters above the highest mountain
+    double  altitude    {};
+
+    /// How far the viewer has flown around the planet so far, in radians
+    double  angle       {};
+};
+
+/**
+ * @brief Moves the terrain viewer in a circle around an icosahedron planet at a constant speed
+ *
+ * Setup data is a TerrainFlyover. Intended for benchmarking terrain LOD changes with --headless,
+ * as it fights with ftrTerrainDebugDraw over the viewer position.
+ */
+extern osp::fw::FeatureDef const ftrTerrainFlyover;
+
 /**
  * @brief Uses camera target as position relative to planet, and visualizes terrain skeleton.
  */
@@ -76,19 +76,14 @@ SatelliteTransform get_satellite_transform(
 
         UCtxStolenSatellites::OfAccessor const& stolen = rStolenSats.of[entry.accessor];
 
-        auto iter = rAccessor.iterate(std::array{
-            dc.posX,  dc.posY,  dc.posZ,            // 0, 1, 2
-            dc.velX,  dc.velY,  dc.velZ,            // 3, 4, 5
-            dc.velXd, dc.velYd, dc.velZd,           // 6, 7, 8
-            dc.rotX,  dc.rotY,  dc.rotZ, dc.rotW,   // 9, 10, 11, 12
-            dc.satId});                             // 13
+        DefaultComponentViews const v = view_defaults(rAccessor, dc);
 
-        bool const hasPosXYZ  = iter.has(0) && iter.has(1) && iter.has(2);
-        bool const hasVelXYZ  = iter.has(3) && iter.has(4) && iter.has(5);
-        bool const hasVelXYZd = iter.has(6) && iter.has(7) && iter.has(8);
-        bool const hasRotXYZW = iter.has(9) && iter.has(10) && iter.has(11) && iter.has(12);
+        bool const hasPosXYZ  = v.has_pos();
+        bool const hasVelXYZ  = v.has_vel();
+        bool const hasVelXYZd = v.has_veld();
+        bool const hasRotXYZW = v.has_rot();
 
-        LGRN_ASSERTM(iter.has(13), "SatelliteId missing");
+        LGRN_ASSERTM(v.satId.has_value(), "SatelliteId missing");
 
         if ( ! (hasPosXYZ || hasVelXYZ || hasVelXYZd || hasRotXYZW) )
         {
@@ -97,30 +92,30 @@ SatelliteTransform get_satellite_transform(
 
         out.timeBehind = rAccessor.owner.has_value() ? rSimulations.simulationOf[rAccessor.owner].timeBehindBy : 0;
 
-        for (std::size_t i = 0; i < rAccessor.count; ++i, iter.next())
+        for (std::size_t i = 0; i < rAccessor.count; ++i)
         {
-            SatelliteId const iterSatId = iter.get<SatelliteId>(13);
+            SatelliteId const iterSatId = v.satId[i];
 
-            if (iterSatId == satId && !stolen.has(iterSatId))
+            if (iterSatId == satId && !stolen.has(i))
             {
                 if (hasVelXYZ)
                 {
-                    out.velocity = Vector3{iter.get<float>(3), iter.get<float>(4), iter.get<float>(5)};
+                    out.velocity = Vector3{v.velX[i], v.velY[i], v.velZ[i]};
                 }
 
                 if (hasVelXYZd)
                 {
-                    out.velocity = Vector3(Vector3d{iter.get<double>(6), iter.get<double>(7), iter.get<double>(8)});
+                    out.velocity = Vector3(Vector3d{v.velXd[i], v.velYd[i], v.velZd[i]});
                 }
 
                 if (hasPosXYZ)
                 {
-                    out.position = Vector3g{iter.get<spaceint_t>(0), iter.get<spaceint_t>(1), iter.get<spaceint_t>(2)};
+                    out.position = Vector3g{v.posX[i], v.posY[i], v.posZ[i]};
                 }
 
                 if (hasRotXYZW)
                 {
-                    out.rotation = Quaterniond{ {iter.get<float>(9), iter.get<float>(10), iter.get<float>(11)}, iter.get<float>(12)};
+                    out.rotation = Quaterniond{ {v.rotX[i], v.rotY[i], v.rotZ[i]}, v.rotW[i]};
                 }
 
                 break; // satellite only appears once per accessor
@@ -173,14 +168,20 @@ FeatureDef const ftrUniverseCore = feature_def("UniverseCore", [] (
 
     rFB.task()
         .name       ("Delete DataAccessors and DataAccessorIds using accessorDelete")
-        .sync_with  ({uniCore.pl.accessorDelete(UseOrRun), uniCore.pl.accessors(Delete), uniCore.pl.accessorIds(Delete)})
-        .args       ({            uniCore.di.dataAccessors})
-        .func       ([] (UCtxDataAccessors &rDataAccessors) noexcept
+        .sync_with  ({uniCore.pl.accessorDelete(UseOrRun), uniCore.pl.accessors(Delete), uniCore.pl.accessorIds(Delete), uniCore.pl.stolenSats(Delete)})
+        .args       ({            uniCore.di.dataAccessors,           uniCore.di.stolenSats})
+        .func       ([] (UCtxDataAccessors &rDataAccessors, UCtxStolenSatellites &rStolenSats) noexcept
     {
         for (DataAccessorId const id : rDataAccessors.accessorDelete)
         {
             rDataAccessors.instances[id] = {};
             rDataAccessors.ids.remove(id);
+
+            // Don't let a new accessor reusing this ID inherit stolen satellites
+            if (id.value < rStolenSats.of.size())
+            {
+                rStolenSats.of[id].clear();
+            }
         }
     });
 
@@ -283,100 +284,7 @@ FeatureDef const ftrUniverseCore = feature_def("UniverseCore", [] (
         .args       ({          uniCore.di.dataSrcs })
         .func       ([] (UCtxDataSources &rDataSrcs) noexcept
     {
-        if (rDataSrcs.changes.empty()) { return; }
-
-        // keep a scratchpad component list
-        // iterate satsAffected.
-        //    copy existing datasource component list to scratchpad
-        //    apply changes
-        //    remove from datasource
-        //    find/create new datasource
-        // optimization: temporary oldDatasrc->newDatasrc map, to prevent searching too much
-
-        DataSource scratchpad;
-
-        for (DataSourceChange const& dsc : rDataSrcs.changes)
-        {
-            for (SatelliteId const satId : dsc.satsAffected)
-            {
-                DataSourceOwner_t &rSatDsOwner = rDataSrcs.datasrcOf[satId];
-                DataSourceId newDsId;
-
-                scratchpad.entries.clear();
-
-                if (rSatDsOwner.has_value())
-                {
-                    // Satellite already has a DataSource, copy it into scratchpad then modify it.
-
-                    DataSourceId const satDsId = rSatDsOwner.value();
-                    rDataSrcs.refCounts.ref_release(std::exchange(rSatDsOwner, {}));
-                    auto const refCount = rDataSrcs.refCounts[satDsId.value];
-
-                    DataSource &rSatDs = rDataSrcs.instances[satDsId];
-
-                    scratchpad.entries.assign(rSatDs.entries.begin(), rSatDs.entries.end());
-
-                    bool added = false;
-
-                    // remove occurances of ComponentTypeIds used in dsc.components from scratchpad
-                    auto const newLast = std::remove_if(
-                            scratchpad.entries.begin(),
-                            scratchpad.entries.end(),
-                            [&dsc, &added] (DataSource::Entry &rSpEntry) -> bool
-                    {
-                        if (rSpEntry.accessor == dsc.accessor)
-                        {
-                            for (ComponentTypeId const ctId : dsc.components)
-                            {
-                                rSpEntry.components.insert(ctId);
-                            }
-                            LGRN_ASSERT(added == false);
-                            added = true;
-
-                            return false;
-                        }
-                        else
-                        {
-                            for (ComponentTypeId const ctId : dsc.components)
-                            {
-                                rSpEntry.components.erase(ctId);
-                            }
-
-                            return rSpEntry.components.empty(); // remove if true
-                        }
-                    });
-                    scratchpad.entries.resize(std::distance(scratchpad.entries.begin(), newLast));
-
-                    if ( ! added )
-                    {
-                        scratchpad.entries.push_back(DataSource::Entry{
-                            .components = dsc.components,
-                            .accessor   = dsc.accessor
-                        });
-                    }
-                    scratchpad.sort();
-                }
-                else
-                {
-                    // No existing data source, likely that the satellite is newly added.
-                    scratchpad.entries.push_back(DataSource::Entry{
-                        .components = dsc.components,
-                        .accessor   = dsc.accessor
-                    });
-                }
-
-                newDsId = rDataSrcs.find_datasource(scratchpad);
-
-                if ( ! newDsId.has_value() )
-                {
-                    newDsId = rDataSrcs.ids.create();
-                    rDataSrcs.instances.resize(rDataSrcs.ids.capacity());
-                    rDataSrcs.instances[newDsId] = std::exchange(scratchpad, {});
-                }
-
-                rDataSrcs.datasrcOf[satId] = rDataSrcs.refCounts.ref_add(newDsId);
-            }
-        }
+        rDataSrcs.apply_changes();
     });
 
     rFB.task()
@@ -579,6 +487,11 @@ struct PlanetDraw
 
     std::vector<DataAccessorId> accessorsByCospace;
 
+    /// Scratch space for satellite positions transformed to the scene's coordinate space
+    std::vector<Vector3g>   scnPositions;
+    /// Scratch space for which elements of an accessor have non-null satellites
+    osp::BitVector_t        nonNullSats;
+
     DrawEntVec_t            drawEnts;
     std::array<DrawEnt, 3>  axis;
     DrawEnt                 attractor;
@@ -887,50 +800,50 @@ FeatureDef const ftrUniverseTestPlanetsDraw = feature_def("UniverseTestPlanetsDr
 
             if (rAccessor.iterMethod == DataAccessor::IterationMethod::SkipNullSatellites)
             {
-                auto iter = rAccessor.iterate(std::array{
-                        dc.posX,  dc.posY,  dc.posZ,            // 0, 1, 2
-                        dc.velX,  dc.velY,  dc.velZ,            // 3, 4, 5
-                        dc.velXd, dc.velYd, dc.velZd,           // 6, 7, 8
-                        dc.rotX,  dc.rotY,  dc.rotZ, dc.rotW,   // 9, 10, 11, 12
-                        dc.satId});                             // 13
+                DefaultComponentViews const v = view_defaults(rAccessor, dc);
 
-                bool const hasPosXYZ  = iter.has(0) && iter.has(1) && iter.has(2);
-                bool const hasVelXYZ  = iter.has(3) && iter.has(4) && iter.has(5);
-                bool const hasVelXYZd = iter.has(6) && iter.has(7) && iter.has(8);
-                bool const hasRotXYZW = iter.has(9) && iter.has(10) && iter.has(11) && iter.has(12);
+                bool const hasPosXYZ  = v.has_pos();
+                bool const hasVelXYZ  = v.has_vel();
+                bool const hasVelXYZd = v.has_veld();
+                bool const hasRotXYZW = v.has_rot();
 
-                LGRN_ASSERTM(iter.has(13), "SatelliteId missing");
+                LGRN_ASSERTM(v.satId.has_value(), "SatelliteId missing");
 
                 float const timeBehindBy = rAccessor.owner.has_value() ? float(rSimulations.simulationOf[rAccessor.owner].timeBehindBy) * 0.001f : 0.0f;
 
-
-                for (std::size_t i = 0; i < rAccessor.count; ++i, iter.next())
+                if (hasPosXYZ)
                 {
-                    SatelliteId const satId = iter.get<SatelliteId>(13);
+                    rPlanetDraw.scnPositions.resize(rAccessor.count);
+                    transformer.transform_positions(
+                            { .pos    = {v.posX.pos,    v.posY.pos,    v.posZ.pos},
+                              .stride = {v.posX.stride, v.posY.stride, v.posZ.stride} },
+                            rPlanetDraw.scnPositions);
+                }
 
-                    if (deleted.dirty && deleted.sats.contains(satId))
-                    {
-                        continue;
-                    }
+                non_null_satellite_mask(v.satId, rAccessor.count, rPlanetDraw.nonNullSats);
+                deleted.remove_stolen(rPlanetDraw.nonNullSats);
+
+                for (std::size_t const i : rPlanetDraw.nonNullSats.ones())
+                {
+                    SatelliteId const satId = v.satId[i];
 
                     Vector3 moved{0.0f, 0.0f, 0.0f};
 
                     if (hasVelXYZ)
                     {
-                        Vector3 const velocity {iter.get<float>(3), iter.get<float>(4), iter.get<float>(5)};
+                        Vector3 const velocity {v.velX[i], v.velY[i], v.velZ[i]};
                         moved = velocity * timeBehindBy;
                     }
 
                     if (hasVelXYZd)
                     {
-                        Vector3d const velocity {iter.get<double>(6), iter.get<double>(7), iter.get<double>(8)};
+                        Vector3d const velocity {v.velXd[i], v.velYd[i], v.velZd[i]};
                         moved = Vector3(velocity * timeBehindBy);
                     }
 
                     if (hasPosXYZ)
                     {
-                        Vector3g const pos {iter.get<spaceint_t>(0), iter.get<spaceint_t>(1), iter.get<spaceint_t>(2)};
-                        Vector3d const d = Vector3d(transformer.transform_position(pos));
+                        Vector3d const d = Vector3d(rPlanetDraw.scnPositions[i]);
                         Vector3 const qux = Vector3(d / 1024.0) + moved;
 
                         PlanetDraw::TrackedSatellite &rTrackedSat = rPlanetDraw.trackedSats[satId];
@@ -942,7 +855,7 @@ FeatureDef const ftrUniverseTestPlanetsDraw = feature_def("UniverseTestPlanetsDr
 
                     if (hasRotXYZW)
                     {
-                        Quaternion const rot { {iter.get<float>(9), iter.get<float>(10), iter.get<float>(11)}, iter.get<float>(12)};
+                        Quaternion const rot { {v.rotX[i], v.rotY[i], v.rotZ[i]}, v.rotW[i]};
 
                         PlanetDraw::TrackedSatellite &rTrackedSat = rPlanetDraw.trackedSats[satId];
 
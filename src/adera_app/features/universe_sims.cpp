@@ -270,7 +270,8 @@ FeatureDef const ftrUniverseSimpleSimulators = feature_def("UniverseSimpleSimula
             UCtxTransferBuffers         &rTransferBufs,
             UCtxCirclePathSims          &rCirclePath,
             UCtxConstantSpinSims        &rConstantSpin,
-            UCtxSimpleGravitySims       &rSimpleGravity) noexcept
+            UCtxSimpleGravitySims       &rSimpleGravity,
+            WorkerContext               ctx) noexcept
     {
         DefaultComponents const &dc = rCompTypes.defaults;
 
@@ -309,7 +310,7 @@ FeatureDef const ftrUniverseSimpleSimulators = feature_def("UniverseSimpleSimula
             {
                 rTimeBehindBy -= rInst.updateInterval;
 
-                rInst.sim.update(rInst.updateInterval);
+                rInst.sim.update(rInst.updateInterval, ctx.pPool);
 
                 std::vector<MidTransfer> &rTransfers = rTransferBufs.midTransfersOf[rInst.simId];
 
@@ -510,14 +510,15 @@ FeatureDef const ftrSignalsFloat = feature_def("SignalsFloat", [] (
     rFB.data_emplace< SignalValues_t<float> >    (sigFloat.di.sigValFloat);
     rFB.data_emplace< UpdateNodes<float> >       (sigFloat.di.sigUpdFloat);
 
-    // NOTE: Consider supporting per-thread UpdateNodes<float> to allow multiple threads to write
-    //       new float values in parallel.
+    // Per-thread UpdateNodes<float> and dirty machines, for machine and node updates to split
+    // their work across threads. See update_machines and update_signal_nodes.
+    rFB.data_emplace< SignalThreads<float> >     (sigFloat.di.sigThreadsFloat);
 
     rFB.task()
         .name       ("Update Signal<float> Nodes")
         .sync_with  ({links.pl.linkLoop(EStgLink::NodeUpd), sigFloat.pl.sigValFloatLoop(Modify), links.pl.requestMachUpdLoop(Modify_)})
-        .args       ({            sigFloat.di.sigUpdFloat,             sigFloat.di.sigValFloat,         links.di.updMach,          links.di.links})
-        .func       ([] (UpdateNodes<float>& rSigUpdFloat, SignalValues_t<float>& rSigValFloat, MachineUpdater& rUpdMach, ACtxLinks const& rLinks) noexcept
+        .args       ({            sigFloat.di.sigUpdFloat,             sigFloat.di.sigValFloat,         links.di.updMach,          links.di.links,      sigFloat.di.sigThreadsFloat})
+        .func       ([] (UpdateNodes<float>& rSigUpdFloat, SignalValues_t<float>& rSigValFloat, MachineUpdater& rUpdMach, ACtxLinks const& rLinks, SignalThreads<float>& rSigThreads, WorkerContext ctx) noexcept
     {
         if ( ! rSigUpdFloat.dirty )
         {
@@ -536,16 +537,15 @@ FeatureDef const ftrSignalsFloat = feature_def("SignalsFloat", [] (
         rUpdMach.machTypesDirty.clear();
 
         // Sees which nodes changed, and writes into rUpdMach set dirty which MACHINES
-        // must be updated next
+        // must be updated next. Large numbers of dirty nodes are split across threads.
         update_signal_nodes<float>(
-                rSigUpdFloat.nodeDirty,
+                rSigUpdFloat,
+                rSigThreads,
                 rFloatNodes.nodeToMach,
                 rLinks.machines,
-                arrayView(rSigUpdFloat.nodeNewValues),
                 rSigValFloat,
-                rUpdMach);
-        rSigUpdFloat.nodeDirty.clear();
-        rSigUpdFloat.dirty = false;
+                rUpdMach,
+                ctx.pPool);
 
         // Run tasks needed to update machine types that are dirty
         bool anyMachineNotified = false;
@@ -258,64 +258,66 @@ FeatureDef const ftrMachRCSDriver = feature_def("RCSDriver", [] (
     rFB.task()
         .name       ("RCS Drivers calculate new values")
         .sync_with  ({links.pl.linkLoop(MachUpd), sigFloat.pl.sigValFloatExt(LoopRunning), sigFloat.pl.sigValFloatLoop(Modify)})
-        .args       ({      links.di.links,         links.di.updMach,             sigFloat.di.sigValFloat,          sigFloat.di.sigUpdFloat})
-        .func       ([] (ACtxLinks& rLinks, MachineUpdater& rUpdMach, SignalValues_t<float>& rSigValFloat, UpdateNodes<float>& rSigUpdFloat) noexcept
+        .args       ({      links.di.links,         links.di.updMach,             sigFloat.di.sigValFloat,          sigFloat.di.sigUpdFloat,             sigFloat.di.sigThreadsFloat})
+        .func       ([] (ACtxLinks& rLinks, MachineUpdater& rUpdMach, SignalValues_t<float>& rSigValFloat, UpdateNodes<float>& rSigUpdFloat, SignalThreads<float>& rSigThreads, WorkerContext ctx) noexcept
     {
-        Nodes const &rFloatNodes = rLinks.nodePerType[gc_ntSigFloat];
-        PerMachType &rRockets    = rLinks.machines.perType[gc_mtRcsDriver];
+        Nodes const         &rFloatNodes = rLinks.nodePerType[gc_ntSigFloat];
+        PerMachType const   &rRockets    = rLinks.machines.perType[gc_mtRcsDriver];
 
-        for (MachLocalId const local : rUpdMach.localDirty[gc_mtRcsDriver])
+        // Drivers only read shared data, and each thread writes into its own UpdateNodes
+        update_machines<float>(rUpdMach.localDirty[gc_mtRcsDriver], rSigUpdFloat, rSigThreads, ctx.pPool,
+                               [&rFloatNodes, &rRockets, &rSigValFloat, &rUpdMach] (ArrayView<MachLocalId const> const locals, UpdateNodes<float>& rUpdFloat)
         {
-            MachAnyId const mach     = rRockets.localToAny[local];
-            auto const      portSpan = lgrn::Span<NodeId const>{rFloatNodes.machToNode[mach]};
-
-            NodeId const thrNode = connected_node(portSpan, ports_rcsdriver::gc_throttleOut.port);
-            if (thrNode == lgrn::id_null<NodeId>())
-            {
-                continue; // Throttle Output not connected, calculations below are useless
-            }
+            // Inputs are gathered into blocks of separate arrays, evaluated all at once, then
+            // only outputs that changed are written back
+            RcsDriverBlock block;
+            std::size_t    count = 0;
 
-            auto const rcs_read = [&rSigValFloat, portSpan] (float& rDstVar, PortEntry const& entry)
+            auto const evaluate_block = [&block, &count, &rSigValFloat, &rUpdMach, &rUpdFloat] ()
             {
-                NodeId const node = connected_node(portSpan, entry.port);
+                thruster_influence_block(block, count);
 
-                if (node != lgrn::id_null<NodeId>())
+                for (std::size_t i = 0; i < count; ++i)
                 {
-                    rDstVar = rSigValFloat[node];
+                    NodeId const thrNode = block.throttleOut[i];
+                    float  const thrNew  = block.influence[i];
+
+                    if (rSigValFloat[thrNode] != thrNew)
+                    {
+                        rUpdFloat.assign(thrNode, thrNew);
+                        rUpdMach.requestMachineUpdateLoop = true;
+                    }
                 }
+                count = 0;
             };
 
-            Vector3 pos     {0.0f};
-            Vector3 dir     {0.0f};
-            Vector3 cmdLin  {0.0f};
-            Vector3 cmdAng  {0.0f};
-
-            rcs_read( pos.x(),    ports_rcsdriver::gc_posXIn    );
-            rcs_read( pos.y(),    ports_rcsdriver::gc_posYIn    );
-            rcs_read( pos.z(),    ports_rcsdriver::gc_posZIn    );
-            rcs_read( dir.x(),    ports_rcsdriver::gc_dirXIn    );
-            rcs_read( dir.y(),    ports_rcsdriver::gc_dirYIn    );
-            rcs_read( dir.z(),    ports_rcsdriver::gc_dirZIn    );
-            rcs_read( cmdLin.x(), ports_rcsdriver::gc_cmdLinXIn );
-            rcs_read( cmdLin.y(), ports_rcsdriver::gc_cmdLinYIn );
-            rcs_read( cmdLin.z(), ports_rcsdriver::gc_cmdLinZIn );
-            rcs_read( cmdAng.x(), ports_rcsdriver::gc_cmdAngXIn );
-            rcs_read( cmdAng.y(), ports_rcsdriver::gc_cmdAngYIn );
-            rcs_read( cmdAng.z(), ports_rcsdriver::gc_cmdAngZIn );
-
-            OSP_LOG_TRACE("RCS controller {} pitch = {}", local, cmdAng.x());
-            OSP_LOG_TRACE("RCS controller {} yaw = {}", local, cmdAng.y());
-            OSP_LOG_TRACE("RCS controller {} roll = {}", local, cmdAng.z());
-
-            float const thrCurr = rSigValFloat[thrNode];
-            float const thrNew = thruster_influence(pos, dir, cmdLin, cmdAng);
-
-            if (thrCurr != thrNew)
+            for (MachLocalId const local : locals)
             {
-                rSigUpdFloat.assign(thrNode, thrNew);
-                rUpdMach.requestMachineUpdateLoop = true;
+                MachAnyId const mach     = rRockets.localToAny[local];
+                auto const      portSpan = lgrn::Span<NodeId const>{rFloatNodes.machToNode[mach]};
+
+                NodeId const thrNode = connected_node(portSpan, ports_rcsdriver::gc_throttleOut.port);
+                if (thrNode == lgrn::id_null<NodeId>())
+                {
+                    continue; // Throttle Output not connected, calculations are useless
+                }
+
+                for (PortId port = 0; port < block.in.size(); ++port)
+                {
+                    NodeId const node = connected_node(portSpan, port);
+                    block.in[port][count] = (node != lgrn::id_null<NodeId>()) ? rSigValFloat[node] : 0.0f;
+                }
+                block.throttleOut[count] = thrNode;
+
+                ++count;
+                if (count == gc_rcsBlockSize)
+                {
+                    evaluate_block();
+                }
             }
-        }
+
+            evaluate_block();
+        });
     });
 }); // ftrRCSDriver
 
@@ -489,6 +491,7 @@ FeatureDef const ftrVehicleCamera = feature_def("VehicleCamera", [] (
     // a few separate ones.
     rFB.task()
         .name       ("Update vehicle camera")
+        .main_thread(true)
         .sync_with  ({windowApp.pl.sync(Run), camCtrl.pl.camCtrl(Modify), phys.pl.physUpdate(Done), parts.pl.mapWeldActive(Ready)})
         .args       ({               camCtrl.di.camCtrl,      scn.di.deltaTimeIn,         comScn.di.basic,       vhclCtrl.di.vhControls,          parts.di.scnParts,          links.di.links})
         .func       ([] (ACtxCameraController& rCamCtrl, float const deltaTimeIn, ACtxBasic const& rBasic, VehicleControls& rVhControls, ACtxParts const& rScnParts, ACtxLinks const& rLinks) noexcept
@@ -74,6 +74,15 @@ struct ACtxSceneGraph
 
     std::vector<TreePos_t>  m_delete;
 
+    /// Scratch space used by SysSceneGraph::add_descendants for batched insertions
+    struct Insert
+    {
+        TreePos_t   pos;
+        TreePos_t   rootPos;
+        uint32_t    request;
+    };
+    std::vector<Insert>     m_insert;
+
     void resize(std::size_t ents)
     {
         m_treeToEnt         .reserve(ents);
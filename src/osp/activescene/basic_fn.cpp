@@ -26,6 +26,8 @@
 
 #include <Corrade/Containers/ArrayViewStl.h>
 
+#include <longeron/utility/asserts.hpp>
+
 #include <algorithm>
 
 using namespace osp;
@@ -101,6 +103,116 @@ SubtreeBuilder SysSceneGraph::add_descendants(ACtxSceneGraph& rScnGraph, uint32_
     return out;
 }
 
+std::vector<SubtreeBuilder> SysSceneGraph::add_descendants(ACtxSceneGraph& rScnGraph, ArrayView<SubtreeRequest const> requests)
+{
+    std::vector<SubtreeBuilder> out;
+    out.reserve(requests.size());
+
+    if (requests.size() == 0)
+    {
+        return out;
+    }
+
+    // Find where each subtree is inserted in the current tree; directly after the last
+    // descendant of its root.
+
+    std::vector<ACtxSceneGraph::Insert> &rInsert = rScnGraph.m_insert;
+    rInsert.clear();
+    rInsert.reserve(requests.size());
+
+    uint32_t total = 0;
+
+    for (uint32_t i = 0; i < requests.size(); ++i)
+    {
+        ActiveEnt const root    = requests[i].root;
+        TreePos_t const rootPos = (root == lgrn::id_null<ActiveEnt>())
+                                ? 0
+                                : rScnGraph.m_entToTreePos[root];
+
+        rInsert.push_back({rootPos + 1 + rScnGraph.m_treeDescendants[rootPos], rootPos, i});
+        total += requests[i].descendantCount;
+    }
+
+    // Subtrees of nested roots can end at the same position. The deeper root must come first,
+    // so its new children are placed within its own subtree. Requests for the same root keep
+    // their given order.
+    std::sort(rInsert.begin(), rInsert.end(), [] (ACtxSceneGraph::Insert const& lhs, ACtxSceneGraph::Insert const& rhs)
+    {
+        return (lhs.pos != rhs.pos)         ? (lhs.pos < rhs.pos)
+             : (lhs.rootPos != rhs.rootPos) ? (lhs.rootPos > rhs.rootPos)
+             :                                (lhs.request < rhs.request);
+    });
+
+    // Update descendant counts of roots and ancestors, while tree positions are still valid
+    for (SubtreeRequest const& request : requests)
+    {
+        ActiveEnt parent = request.root;
+        bool parentNotNull = true;
+        while (parentNotNull)
+        {
+            parentNotNull = (parent != lgrn::id_null<ActiveEnt>());
+            TreePos_t const parentPos = parentNotNull ? rScnGraph.m_entToTreePos[parent] : 0;
+            rScnGraph.m_treeDescendants[parentPos] += request.descendantCount;
+            parent = parentNotNull ? rScnGraph.m_entParent[parent] : parent;
+        }
+    }
+
+    TreePos_t const treeOldSize = rScnGraph.m_treeDescendants[0] + 1 - total;
+    TreePos_t const treeNewSize = treeOldSize + total;
+
+    rScnGraph.m_treeToEnt.resize(treeNewSize);
+    rScnGraph.m_treeDescendants.resize(treeNewSize);
+
+    // Make space for all subtrees by shifting elements right. Each element is moved at most
+    // once, in a single right->left swoop.
+
+    auto const& itTreeDescFirst = rScnGraph.m_treeDescendants.begin();
+    auto const& itTreeEntsFirst = rScnGraph.m_treeToEnt.begin();
+
+    std::vector<TreePos_t> subFirsts(requests.size());
+
+    uint32_t  shift    = total;
+    TreePos_t keepLast = treeOldSize;
+
+    for (auto itInsert = rInsert.rbegin(); itInsert != rInsert.rend(); ++itInsert)
+    {
+        // State of array each iteration:
+        //
+        // [Untouched] [Keep] [New space] [Prev. shifted] [New space] ...
+        //             |----|---SHIFT--->
+
+        TreePos_t const keepFirst = itInsert->pos;
+        LGRN_ASSERT(keepFirst <= keepLast);
+
+        if (keepFirst != keepLast && shift != 0)
+        {
+            // Update tree positions for elements to shift
+            std::for_each(itTreeEntsFirst + keepFirst, itTreeEntsFirst + keepLast,
+                          [&rScnGraph, shift] (ActiveEnt const ent)
+            {
+                rScnGraph.m_entToTreePos[ent] += shift;
+            });
+
+            // Shift over tree data
+            std::move_backward(itTreeDescFirst + keepFirst, itTreeDescFirst + keepLast, itTreeDescFirst + keepLast + shift);
+            std::move_backward(itTreeEntsFirst + keepFirst, itTreeEntsFirst + keepLast, itTreeEntsFirst + keepLast + shift);
+        }
+
+        shift -= requests[itInsert->request].descendantCount;
+        subFirsts[itInsert->request] = keepFirst + shift;
+        keepLast = keepFirst;
+    }
+
+    for (uint32_t i = 0; i < requests.size(); ++i)
+    {
+        out.emplace_back(rScnGraph, requests[i].root, subFirsts[i], subFirsts[i] + requests[i].descendantCount);
+    }
+
+    rInsert.clear();
+
+    return out;
+}
+
 ArrayView<ActiveEnt const> SysSceneGraph::descendants(ACtxSceneGraph const& rScnGraph, ActiveEnt root)
 {
     TreePos_t const rootPos = rScnGraph.m_entToTreePos[root];
@@ -167,7 +279,7 @@ void SysSceneGraph::do_delete(ACtxSceneGraph& rScnGraph)
 
         TreePos_t const keepFirst   = (*itDel) + removeTotal;
         TreePos_t const keepLast    = (notLast) ? (*itDelNext) : (treeLast);
-        assert(keepFirst <= keepLast);
+        LGRN_ASSERT(keepFirst <= keepLast);
 
         std::ptrdiff_t const shift  = keepFirst - done;
 
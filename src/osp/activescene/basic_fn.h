@@ -31,6 +31,8 @@
 
 #include <algorithm>
 #include <compare>
+#include <utility>
+#include <vector>
 
 namespace osp::active
 {
@@ -50,7 +52,16 @@ public:
      , m_first{first}
      , m_last{last}
     { }
-    OSP_MOVE_ONLY_CTOR_CONSTEXPR_NOEXCEPT(SubtreeBuilder)
+    constexpr SubtreeBuilder(SubtreeBuilder const& copy) noexcept = delete;
+
+    // Moved-from builders are left empty, so they don't assert on destruction
+    constexpr SubtreeBuilder(SubtreeBuilder&& move) noexcept
+     : m_root{move.m_root}
+     , m_first{std::exchange(move.m_first, move.m_last)}
+     , m_last{move.m_last}
+     , m_rScnGraph{move.m_rScnGraph}
+    { }
+
     ~SubtreeBuilder() { assert(m_first == m_last); }
 
     /**
@@ -124,6 +135,15 @@ private:
 
 using ChildRange_t = lgrn::IteratorPair<ChildIterator, ChildIterator>;
 
+/**
+ * @brief Request to add a subtree of new entities, see SysSceneGraph::add_descendants
+ */
+struct SubtreeRequest
+{
+    ActiveEnt   root            {lgrn::id_null<ActiveEnt>()};
+    uint32_t    descendantCount {0};
+};
+
 class SysSceneGraph
 {
 public:
@@ -135,6 +155,16 @@ public:
      */
     [[nodiscard]] static SubtreeBuilder add_descendants(ACtxSceneGraph& rScnGraph, uint32_t descendantCount, ActiveEnt root = lgrn::id_null<ActiveEnt>());
 
+    /**
+     * @brief Add new entities under multiple roots at once
+     *
+     * Same result as calling add_descendants for each request in order, but existing tree
+     * elements are only shifted once, instead of once per request.
+     *
+     * @return SubtreeBuilders for each request, in the same order as requests
+     */
+    [[nodiscard]] static std::vector<SubtreeBuilder> add_descendants(ACtxSceneGraph& rScnGraph, ArrayView<SubtreeRequest const> requests);
+
     /**
      * @return Iterable range of an entity's descendants
      */
@@ -114,6 +114,34 @@ void SysPrefabInit::add_to_subtree(
     assert(itEnt == std::end(ents));
 }
 
+void SysPrefabInit::add_to_scene_graph(
+        ACtxPrefabs const&                  rPrefabs,
+        Resources const&                    rResources,
+        ArrayView<uint32_t const>           prefabInits,
+        ArrayView<ActiveEnt const>          parents,
+        ACtxSceneGraph&                     rScnGraph) noexcept
+{
+    assert(prefabInits.size() == parents.size());
+
+    std::vector<SubtreeRequest> requests;
+    requests.reserve(prefabInits.size());
+    for (std::size_t i = 0; i < prefabInits.size(); ++i)
+    {
+        requests.push_back({
+            .root               = parents[i],
+            .descendantCount    = uint32_t(rPrefabs.spawnedEntsOffset[prefabInits[i]].size())
+        });
+    }
+
+    std::vector<SubtreeBuilder> builders = SysSceneGraph::add_descendants(rScnGraph, requests);
+
+    for (std::size_t i = 0; i < prefabInits.size(); ++i)
+    {
+        uint32_t const prefabInit = prefabInits[i];
+        add_to_subtree(rPrefabs.spawnRequest[prefabInit], rPrefabs.spawnedEntsOffset[prefabInit], rResources, builders[i]);
+    }
+}
+
 void SysPrefabInit::init_transforms(
         ACtxPrefabs const&                  rPrefabs,
         Resources const&                    rResources,
@@ -85,6 +85,21 @@ public:
             Resources const&            rResources,
             SubtreeBuilder&             rSubtree) noexcept;
 
+    /**
+     * @brief Add entities of many spawned prefabs to the scene graph with a single batched
+     *        SysSceneGraph::add_descendants
+     *
+     * @param prefabInits   [in] Indices to rPrefabs.spawnRequest of prefabs to add
+     * @param parents       [in] Parent of each prefab's root entity, parallel to prefabInits. Null
+     *                           adds it to the scene root.
+     */
+    static void add_to_scene_graph(
+            ACtxPrefabs const&          rPrefabs,
+            Resources const&            rResources,
+            ArrayView<uint32_t const>   prefabInits,
+            ArrayView<ActiveEnt const>  parents,
+            ACtxSceneGraph&             rScnGraph) noexcept;
+
     static void init_transforms(
             ACtxPrefabs const&          rPrefabs,
             Resources const&            rResources,
@@ -28,6 +28,10 @@
 
 #include "../activescene/basic.h"
 #include "../activescene/basic_fn.h"
+#include "../executor/worker_pool.h"
+
+#include <utility>
+#include <vector>
 
 namespace osp::draw
 {
@@ -47,6 +51,11 @@ namespace osp::draw
  * To use, write into DrawTfObservers::observers[i]
  * Enable per-DrawEnt by setting ACtxSceneRender::drawTfObserverEnable[drawEnt] bit [i]
  *
+ * Observers are passed the entity's depth within the traversal: 1 for a root the traversal
+ * started from (or a child of the scene root), 2 for its children, and so on.
+ *
+ * Observers may be called concurrently for different entities, so they should only write to
+ * data owned by the entity they're called for.
  */
 struct DrawTfObservers
 {
@@ -178,6 +187,11 @@ public:
         DrawTransforms_t&                           rDrawTf;
     };
 
+    /**
+     * @brief Calculate draw transforms of entities in subtrees of the given root entities
+     *
+     * Roots are treated as if they have no parent.
+     */
     template<typename IT_T, typename ITB_T, typename FUNC_T = UpdDrawTransformNoOp>
     static void update_draw_transforms(
             ArgsForUpdDrawTransform     args,
@@ -185,18 +199,38 @@ public:
             ITB_T const&                last,
             FUNC_T                      func = {});
 
+    /**
+     * @brief Calculate draw transforms of all entities in the scene graph
+     *
+     * Streams through the scene graph's depth-first tree arrays instead of recursing. Subtrees
+     * of the scene root are independent, and are split across threads if pPool is not null. In
+     * that case, func must be safe to call concurrently for different entities.
+     */
+    template<typename FUNC_T = UpdDrawTransformNoOp>
+    static void update_draw_transforms_all(
+            ArgsForUpdDrawTransform     args,
+            exec::WorkerPool            *pPool = nullptr,
+            FUNC_T                      func = {});
+
     static MeshIdOwner_t add_drawable_mesh(ACtxDrawing& rDrawing, ACtxDrawingRes& rDrawingRes, Resources& rResources, PkgId const pkg, std::string_view const name);
 
     static constexpr decltype(auto) gen_drawable_mesh_adder(ACtxDrawing& rDrawing, ACtxDrawingRes& rDrawingRes, Resources& rResources, PkgId const pkg);
 
 private:
 
+    /// Draw transforms of ancestors of the current entity, and where their subtrees end
+    using DrawTfStack_t = std::vector< std::pair<active::TreePos_t, Matrix4> >;
+
+    /**
+     * @brief Calculate draw transforms for tree positions [first, last), which must be a
+     *        sequence of whole subtrees. Each subtree root is treated as if it has no parent.
+     */
     template<typename FUNC_T>
-    static void update_draw_transforms_recurse(
+    static void update_draw_transforms_range(
             ArgsForUpdDrawTransform     args,
-            active::ActiveEnt           ent,
-            Matrix4 const&              parentTf,
-            int                         depth,
+            active::TreePos_t           first,
+            active::TreePos_t           last,
+            DrawTfStack_t               &rStack,
             FUNC_T&                     func);
 
 }; // class SysRender
@@ -217,6 +251,25 @@ void SysRender::needs_draw_transforms(
     }
 }
 
+/**
+ * @return parent * child, same as Magnum's Matrix4 multiply
+ *
+ * Written as a sum of parent's columns scaled by each element of child's columns, so each
+ * output column is four 4-wide multiply-adds that the compiler can vectorize.
+ */
+inline Matrix4 mul_draw_transform(Matrix4 const& parent, Matrix4 const& child) noexcept
+{
+    Matrix4 out{Magnum::Math::ZeroInit};
+    for (std::size_t col = 0; col < 4; ++col)
+    {
+        out[col] = parent[0] * child[col][0]
+                 + parent[1] * child[col][1]
+                 + parent[2] * child[col][2]
+                 + parent[3] * child[col][3];
+    }
+    return out;
+}
+
 template<typename IT_T, typename ITB_T, typename FUNC_T>
 void SysRender::update_draw_transforms(
         ArgsForUpdDrawTransform     args,
@@ -224,7 +277,7 @@ void SysRender::update_draw_transforms(
         ITB_T const&                last,
         FUNC_T                      func)
 {
-    static constexpr Matrix4 const identity{};
+    DrawTfStack_t stack;
 
     while (first != last)
     {
@@ -232,7 +285,8 @@ void SysRender::update_draw_transforms(
 
         if (args.needDrawTf.contains(ent))
         {
-            update_draw_transforms_recurse(args, ent, identity, true, func);
+            active::TreePos_t const pos = args.scnGraph.m_entToTreePos[ent];
+            update_draw_transforms_range(args, pos, pos + 1 + args.scnGraph.m_treeDescendants[pos], stack, func);
         }
 
         std::advance(first, 1);
@@ -240,33 +294,102 @@ void SysRender::update_draw_transforms(
 }
 
 template<typename FUNC_T>
-void SysRender::update_draw_transforms_recurse(
+void SysRender::update_draw_transforms_all(
         ArgsForUpdDrawTransform     args,
-        active::ActiveEnt           ent,
-        Matrix4 const&              parentTf,
-        int                         depth,
-        FUNC_T&                     func)
+        exec::WorkerPool            *pPool,
+        FUNC_T                      func)
 {
-    using namespace osp::active;
+    using active::TreePos_t;
 
-    Matrix4 const& entTf        = args.transforms.get(ent).m_transform;
-    Matrix4 const& entDrawTf    = (depth == 0) ? (entTf) : (parentTf * entTf);
+    // Position 0 is the scene root, not an entity
+    TreePos_t const treeLast = 1 + args.scnGraph.m_treeDescendants[0];
 
-    func(entDrawTf, ent, depth);
+    std::size_t const threads = (pPool != nullptr) ? pPool->thread_count() : 0;
 
-    DrawEnt const drawEnt = args.activeToDraw[ent];
-    if (drawEnt != lgrn::id_null<DrawEnt>())
+    // Not worth splitting up small scenes
+    constexpr TreePos_t c_minPerThread = 1024;
+
+    if (threads == 0 || treeLast < 2 * c_minPerThread)
     {
-        args.rDrawTf[drawEnt] = entDrawTf;
+        DrawTfStack_t stack;
+        update_draw_transforms_range(args, 1, treeLast, stack, func);
+        return;
     }
 
-    for (ActiveEnt entChild : SysSceneGraph::children(args.scnGraph, ent))
+    // Group root subtrees into contiguous chunks of tree positions. Aim for a few chunks per
+    // thread so uneven subtree sizes still balance out.
+    TreePos_t const targetSize = std::max<TreePos_t>(c_minPerThread, treeLast / TreePos_t(threads * 4));
+
+    std::vector< std::pair<TreePos_t, TreePos_t> > chunks;
+    TreePos_t chunkFirst = 1;
+    for (TreePos_t pos = 1; pos != treeLast; pos += 1 + args.scnGraph.m_treeDescendants[pos])
     {
-        if (args.needDrawTf.contains(entChild))
+        if (pos - chunkFirst >= targetSize)
         {
-            update_draw_transforms_recurse(args, entChild, entDrawTf, depth + 1, func);
+            chunks.emplace_back(chunkFirst, pos);
+            chunkFirst = pos;
         }
     }
+    chunks.emplace_back(chunkFirst, treeLast);
+
+    exec::parallel_for(pPool, std::uint32_t(chunks.size()), [&args, &chunks, &func] (std::uint32_t const i)
+    {
+        DrawTfStack_t stack;
+        update_draw_transforms_range(args, chunks[i].first, chunks[i].second, stack, func);
+    });
+}
+
+template<typename FUNC_T>
+void SysRender::update_draw_transforms_range(
+        ArgsForUpdDrawTransform     args,
+        active::TreePos_t           first,
+        active::TreePos_t   const   last,
+        DrawTfStack_t               &rStack,
+        FUNC_T&                     func)
+{
+    using namespace osp::active;
+
+    rStack.clear();
+
+    TreePos_t pos = first;
+    while (pos != last)
+    {
+        ActiveEnt const ent     = args.scnGraph.m_treeToEnt[pos];
+        TreePos_t const subLast = pos + 1 + args.scnGraph.m_treeDescendants[pos];
+
+        // Leave subtrees of ancestors that ended
+        while ( ! rStack.empty() && rStack.back().first <= pos )
+        {
+            rStack.pop_back();
+        }
+
+        if ( ! args.needDrawTf.contains(ent) )
+        {
+            // Descendants don't need draw transforms either, see needs_draw_transforms
+            pos = subLast;
+            continue;
+        }
+
+        // Subtree roots are depth 1, their children are depth 2, and so on
+        int     const  depth     = 1 + int(rStack.size());
+        Matrix4 const& entTf     = args.transforms.get(ent).m_transform;
+        Matrix4 const  entDrawTf = rStack.empty() ? entTf : mul_draw_transform(rStack.back().second, entTf);
+
+        func(entDrawTf, ent, depth);
+
+        DrawEnt const drawEnt = args.activeToDraw[ent];
+        if (drawEnt != lgrn::id_null<DrawEnt>())
+        {
+            args.rDrawTf[drawEnt] = entDrawTf;
+        }
+
+        if (subLast != pos + 1)
+        {
+            rStack.emplace_back(subLast, entDrawTf);
+        }
+
+        ++pos;
+    }
 }
 
 
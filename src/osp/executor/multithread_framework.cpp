@@ -0,0 +1,216 @@
+/**
+ * Open Space Program
+ * Copyright © 2019-2025 Open Space Program Project
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "multithread_framework.h"
+
+#include <algorithm>
+
+namespace osp::exec
+{
+
+MultithreadFWExecutor::MultithreadFWExecutor(std::shared_ptr<WorkerPool> pPool)
+ : m_pPool{std::move(pPool)}
+{
+    LGRN_ASSERT(m_pPool != nullptr);
+    set_worker_pool(m_pPool.get());
+}
+
+void MultithreadFWExecutor::load(osp::fw::Framework& rFW)
+{
+    LGRN_ASSERTM(m_dispatched.empty(), "load must not be called while tasks are running");
+
+    m_running.clear();
+    m_running.resize(rFW.m_tasks.taskIds.capacity());
+
+    m_dataAccess.clear();
+    m_dataAccess.resize(rFW.m_data.size(), EDataAccess::None);
+
+    SinglethreadFWExecutor::load(rFW);
+}
+
+void MultithreadFWExecutor::run_task(TaskToRun const& run, osp::fw::Framework& rFW)
+{
+    bool const isSchedule = run.pipeline.has_value() || run.loopblk.has_value();
+
+    // Schedule tasks affect how the rest of the syncs aligned alongside them are processed, so
+    // they must finish immediately
+    if (   isSchedule
+        || ! run.taskId.has_value()
+        || rFW.m_taskImpl[run.taskId].func == nullptr
+        || rFW.m_taskImpl[run.taskId].mainThread
+        || m_pPool->thread_count() == 0)
+    {
+        SinglethreadFWExecutor::run_task(run, rFW);
+        return;
+    }
+
+    RunningTask &rRunning = m_running[run.taskId];
+    rRunning.run        = run;
+    rRunning.status     = {};
+    rRunning.aligned    = profiler_now();
+
+    m_dispatched.push_back(run.taskId);
+}
+
+void MultithreadFWExecutor::join_tasks(osp::fw::Framework& rFW)
+{
+    if (m_dispatched.empty())
+    {
+        return;
+    }
+
+    m_pFW = &rFW;
+
+    // Data may have been added since load
+    if (m_dataAccess.size() < rFW.m_data.size())
+    {
+        m_dataAccess.resize(rFW.m_data.size(), EDataAccess::None);
+    }
+
+    m_pending.assign(m_dispatched.begin(), m_dispatched.end());
+    while ( ! m_pending.empty() )
+    {
+        m_wave.clear();
+        m_deferred.clear();
+        for (TaskId const taskId : m_pending)
+        {
+            if (try_add_to_wave(taskId, rFW))
+            {
+                m_wave.push_back(taskId);
+            }
+            else
+            {
+                m_deferred.push_back(taskId);
+            }
+        }
+
+        run_wave(rFW);
+        std::swap(m_pending, m_deferred);
+    }
+
+    // Finish in the order they were dispatched, keeping m_tasksWaiting order the same as the
+    // singlethreaded executor
+    for (TaskId const taskId : m_dispatched)
+    {
+        RunningTask const &rRunning = m_running[taskId];
+        finish_task(rRunning.run, rRunning.status, rFW);
+    }
+
+    m_dispatched.clear();
+    m_pFW = nullptr;
+}
+
+bool MultithreadFWExecutor::try_add_to_wave(TaskId const taskId, osp::fw::Framework const& rFW)
+{
+    fw::TaskImpl const &taskImpl = rFW.m_taskImpl[taskId];
+
+    auto const writes = [&taskImpl] (std::size_t const index) -> bool
+    {
+        return taskImpl.writesArg == nullptr || taskImpl.writesArg(index);
+    };
+
+    for (std::size_t i = 0; i < taskImpl.args.size(); ++i)
+    {
+        fw::DataId const dataId = taskImpl.args[i];
+        if ( ! dataId.has_value() )
+        {
+            continue;
+        }
+
+        EDataAccess const access = m_dataAccess[dataId];
+        if (access == EDataAccess::Write || (access == EDataAccess::Read && writes(i)))
+        {
+            return false;
+        }
+    }
+
+    for (std::size_t i = 0; i < taskImpl.args.size(); ++i)
+    {
+        fw::DataId const dataId = taskImpl.args[i];
+        if ( ! dataId.has_value() )
+        {
+            continue;
+        }
+
+        EDataAccess &rAccess = m_dataAccess[dataId];
+        rAccess = writes(i) ? EDataAccess::Write : std::max(rAccess, EDataAccess::Read);
+    }
+
+    return true;
+}
+
+void MultithreadFWExecutor::run_wave(osp::fw::Framework const& rFW)
+{
+    m_notFinished = m_wave.size();
+
+    // Not worth a trip to the workers for a single task
+    if (m_wave.size() == 1)
+    {
+        run_task_job(this, m_wave[0].value);
+    }
+    else
+    {
+        for (TaskId const taskId : m_wave)
+        {
+            m_pPool->submit({.func = &run_task_job, .pUserData = this, .index = taskId.value});
+        }
+
+        // Help out instead of sitting idle
+        while (m_pPool->try_run_one())
+        { }
+
+        std::unique_lock<std::mutex> lock(m_joinMtx);
+        m_joinCv.wait(lock, [this] () { return m_notFinished == 0; });
+    }
+
+    for (TaskId const taskId : m_wave)
+    {
+        for (fw::DataId const dataId : rFW.m_taskImpl[taskId].args)
+        {
+            if (dataId.has_value())
+            {
+                m_dataAccess[dataId] = EDataAccess::None;
+            }
+        }
+    }
+}
+
+void MultithreadFWExecutor::run_task_job(void *const pThis, std::uint32_t const taskIdValue) noexcept
+{
+    auto         &rThis     = *static_cast<MultithreadFWExecutor*>(pThis);
+    TaskId const taskId     = TaskId{taskIdValue};
+    RunningTask  &rRunning  = rThis.m_running[taskId];
+
+    rRunning.status = rThis.call_task_func(taskId, rRunning.argumentRefs, *rThis.m_pFW, rRunning.aligned);
+
+    // Notify while locked; the executor may be destroyed as soon as join_tasks sees 0
+    std::lock_guard<std::mutex> lock(rThis.m_joinMtx);
+    -- rThis.m_notFinished;
+    if (rThis.m_notFinished == 0)
+    {
+        rThis.m_joinCv.notify_one();
+    }
+}
+
+} // namespace osp::exec
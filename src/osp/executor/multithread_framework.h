@@ -0,0 +1,118 @@
+/**
+ * Open Space Program
+ * Copyright © 2019-2025 Open Space Program Project
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include "singlethread_framework.h"
+#include "worker_pool.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace osp::exec
+{
+
+/**
+ * @brief Framework executor that runs aligned tasks in parallel on a WorkerPool
+ *
+ * Scheduling (the SyncGraph and all loopblock/pipeline bookkeeping) still happens on the thread
+ * that calls wait(), exactly the same as SinglethreadFWExecutor. Every time the graph is updated,
+ * the regular tasks that just aligned are sent off to the workers, then joined before the next
+ * update. Finishing a regular task only unlocks its own sync, so any order is valid for them.
+ *
+ * Aligned tasks can still access the same data, such as several tasks syncing to the same Modify
+ * stage. These are run in waves: a task that modifies data (see TaskImpl::writesArg) is not run
+ * alongside any other task that reads or modifies the same data, and waits for a later wave.
+ *
+ * Schedule tasks and tasks marked with TaskImpl::mainThread (eg. anything touching the GL context)
+ * run inline on the thread calling wait().
+ */
+class MultithreadFWExecutor final : public SinglethreadFWExecutor
+{
+public:
+
+    /**
+     * @param pPool [in] Pool to run tasks on; may be shared with other users
+     */
+    explicit MultithreadFWExecutor(std::shared_ptr<WorkerPool> pPool);
+
+    explicit MultithreadFWExecutor(std::size_t threadCount = WorkerPool::default_thread_count())
+     : MultithreadFWExecutor(std::make_shared<WorkerPool>(threadCount))
+    { }
+
+    void load(osp::fw::Framework& rFW) override;
+
+    [[nodiscard]] WorkerPool& pool() noexcept { return *m_pPool; }
+
+protected:
+
+    void run_task(TaskToRun const& run, osp::fw::Framework& rFW) override;
+
+    void join_tasks(osp::fw::Framework& rFW) override;
+
+private:
+
+    struct RunningTask
+    {
+        TaskToRun               run;
+        TaskActions             status;
+        TaskProfiler::Time_t    aligned{0};
+        std::vector<entt::any>  argumentRefs;
+    };
+
+    enum class EDataAccess : std::uint8_t { None, Read, Write };
+
+    /**
+     * @brief Mark data accessed by a task for the current wave
+     *
+     * @return false if the task conflicts with a task already in the wave, marking nothing
+     */
+    bool try_add_to_wave(TaskId taskId, osp::fw::Framework const& rFW);
+
+    void run_wave(osp::fw::Framework const& rFW);
+
+    static void run_task_job(void *pThis, std::uint32_t taskIdValue) noexcept;
+
+    std::shared_ptr<WorkerPool>         m_pPool;
+
+    /// Each is only written to by the worker running its task. Stable while tasks are running.
+    KeyedVec<TaskId, RunningTask>       m_running;
+    std::vector<TaskId>                 m_dispatched;
+
+    /// Access to each DataId by tasks in m_wave. Reset to None after each wave.
+    KeyedVec<fw::DataId, EDataAccess>   m_dataAccess;
+    std::vector<TaskId>                 m_wave;
+    std::vector<TaskId>                 m_pending;
+    std::vector<TaskId>                 m_deferred;
+    osp::fw::Framework                  *m_pFW{nullptr};
+
+    std::mutex                          m_joinMtx;
+    std::condition_variable             m_joinCv;
+    std::size_t                         m_notFinished{0};
+};
+
+} // namespace osp::exec
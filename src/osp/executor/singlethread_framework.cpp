@@ -43,38 +43,31 @@ static constexpr LocalCycleId cycle(std::size_t index) { return LocalCycleId::fr
 
 void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
 {
-    Tasks const &tasks      = rFW.m_tasks;
-    auto  const &pltypereg  = PipelineTypeIdReg::instance();
+    resolve_arguments(rFW);
 
-    for (LoopBlockId const loopblkId : tasks.loopblkIds)
+    if (load_incremental(rFW))
     {
-        if (tasks.loopblkInst[loopblkId].parent.has_value())
-        {
-            continue;
-        }
+        ++m_loadStats.incremental;
 
-        lgrn::IdSetStl<LoopBlockId> loopblkFamily;
-        loopblkFamily.resize(tasks.loopblkIds.capacity());
-        loopblkFamily.insert(loopblkId);
-
-        for (LoopBlockId const mightBeChild : tasks.loopblkIds)
+        if (m_execStateValid)
         {
-            if (tasks.loopblkInst[mightBeChild].parent == loopblkId)
-            {
-                loopblkFamily.insert(mightBeChild);
-            }
+            ++m_loadStats.keptState;
+            wait(rFW);
+            return;
         }
+    }
+    else
+    {
+        ++m_loadStats.everything;
+        load_everything(rFW);
+    }
 
-        TaskOrderReport report;
-        check_task_order(tasks, report, std::move(loopblkFamily));
-
-        if (m_log)
-        {
-            SPDLOG_LOGGER_INFO(m_log, "LoopBlock{} task order report\n{}\n", loopblkId.value, visualize_task_order(report, tasks));
-        }
+    restart(rFW);
+}
 
-        LGRN_ASSERTM(report.failedNotAdded.empty() && report.failedLocked.empty(), "deadlock");
-    }
+void SinglethreadFWExecutor::load_everything(osp::fw::Framework& rFW)
+{
+    Tasks const &tasks = rFW.m_tasks;
 
     // IdRegistryStl doesn't have a clear() yet. just leak implmentation details and set all bits to 1.
 
@@ -84,17 +77,360 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
     m_graph.subgraphs   .clear();
     m_graph.syncIds     .bitview().set();
     m_graph.syncs       .clear();
-    m_exec.perSubgraph  .clear();
-    m_exec.perSync      .clear();
-    m_exec.subgraphsMoving.clear();
-    m_exec.justMoved    .clear();
     m_roxLoopblkOf      .clear();
     m_roxPipelineOf     .clear();
     m_roxSyncOf         .clear();
     m_wtxSubgraphOf     .clear();
     m_wtxSyncOf         .clear();
     m_roxTaskOf         .clear();
-    m_tasksWaiting      .clear();
+    m_roxPltypeOf       .clear();
+    m_sgtBlkCtrl        = {};
+    m_sgtSingleStat     = {};
+    m_execStateValid    = false;
+
+    std::vector<LoopBlockId> loopblks;
+    std::vector<PipelineId>  pipelines;
+    std::vector<TaskId>      taskIds;
+    loopblks .reserve(tasks.loopblkIds .size());
+    pipelines.reserve(tasks.pipelineIds.size());
+    taskIds  .reserve(tasks.taskIds    .size());
+    for (LoopBlockId const loopblkId  : tasks.loopblkIds)  { loopblks .push_back(loopblkId);  }
+    for (PipelineId  const pipelineId : tasks.pipelineIds) { pipelines.push_back(pipelineId); }
+    for (TaskId      const taskId     : tasks.taskIds)     { taskIds  .push_back(taskId);     }
+
+    m_touchedSyncs      .clear();
+    m_touchedSubgraphs  .clear();
+
+    add_to_graph(rFW, loopblks, pipelines, taskIds, tasks.syncs);
+
+    m_graph.debug_verify();
+
+    m_canLoadIncremental = track_loaded(rFW);
+}
+
+bool SinglethreadFWExecutor::track_loaded(osp::fw::Framework const& rFW)
+{
+    m_loadedSessions.clear();
+    m_loadedSessions.resize(rFW.m_fsessionIds.capacity());
+    m_loadedTasksOf .clear();
+    m_loadedTasksOf .resize(rFW.m_fsessionIds.capacity());
+    m_loadedFIInsts .clear();
+    m_loadedFIInsts .resize(rFW.m_fiinstIds.capacity());
+    m_loadedFIInstOf.clear();
+    m_loadedFIInstOf.resize(rFW.m_fiinstIds.capacity());
+
+    std::size_t taskCount       = 0;
+    std::size_t pipelineCount   = 0;
+    std::size_t loopblkCount    = 0;
+
+    for (fw::ContextId const ctx : rFW.m_contextIds)
+    {
+        fw::FeatureContext const &ftrCtx = rFW.m_contextData[ctx];
+
+        for (fw::FSessionId const sessionId : ftrCtx.sessions)
+        {
+            m_loadedSessions.insert(sessionId);
+            m_loadedTasksOf[sessionId] = rFW.m_fsessionData[sessionId].tasks;
+            taskCount += m_loadedTasksOf[sessionId].size();
+        }
+
+        for (fw::FIInstanceId const fiinstId : ftrCtx.finterSlots)
+        {
+            if (fiinstId.has_value())
+            {
+                fw::FeatureInterface const &fiinst = rFW.m_fiinstData[fiinstId];
+                m_loadedFIInsts.insert(fiinstId);
+                m_loadedFIInstOf[fiinstId] = { .loopblks = fiinst.loopblks, .pipelines = fiinst.pipelines };
+                loopblkCount  += fiinst.loopblks.size();
+                pipelineCount += fiinst.pipelines.size();
+            }
+        }
+    }
+
+    m_loadedCounts = {
+        .tasks      = rFW.m_tasks.taskIds.size(),
+        .pipelines  = rFW.m_tasks.pipelineIds.size(),
+        .loopblks   = rFW.m_tasks.loopblkIds.size(),
+        .syncs      = rFW.m_tasks.syncs.size()
+    };
+
+    // Tasks added directly to Framework::m_tasks can't be tracked
+    return    taskCount     == m_loadedCounts.tasks
+           && pipelineCount == m_loadedCounts.pipelines
+           && loopblkCount  == m_loadedCounts.loopblks;
+}
+
+bool SinglethreadFWExecutor::load_incremental(osp::fw::Framework& rFW)
+{
+    if ( ! m_canLoadIncremental )
+    {
+        return false;
+    }
+
+    Tasks const &tasks = rFW.m_tasks;
+
+    m_loadedSessions.resize(rFW.m_fsessionIds.capacity());
+    m_loadedTasksOf .resize(rFW.m_fsessionIds.capacity());
+    m_loadedFIInsts .resize(rFW.m_fiinstIds.capacity());
+    m_loadedFIInstOf.resize(rFW.m_fiinstIds.capacity());
+
+    // FSessionIds and FIInstanceIds are never reused, so anything not seen before is new
+    lgrn::IdSetStl<fw::FSessionId>   liveSessions;
+    lgrn::IdSetStl<fw::FIInstanceId> liveFIInsts;
+    liveSessions.resize(rFW.m_fsessionIds.capacity());
+    liveFIInsts .resize(rFW.m_fiinstIds.capacity());
+
+    std::vector<TaskId>         addedTasks;
+    std::vector<PipelineId>     addedPipelines;
+    std::vector<LoopBlockId>    addedLoopblks;
+    std::vector<fw::FSessionId>   addedSessions;
+    std::vector<fw::FIInstanceId> addedFIInsts;
+
+    for (fw::ContextId const ctx : rFW.m_contextIds)
+    {
+        fw::FeatureContext const &ftrCtx = rFW.m_contextData[ctx];
+
+        for (fw::FSessionId const sessionId : ftrCtx.sessions)
+        {
+            liveSessions.insert(sessionId);
+            if ( ! m_loadedSessions.contains(sessionId) )
+            {
+                addedSessions.push_back(sessionId);
+                auto const &sessionTasks = rFW.m_fsessionData[sessionId].tasks;
+                addedTasks.insert(addedTasks.end(), sessionTasks.begin(), sessionTasks.end());
+            }
+        }
+
+        for (fw::FIInstanceId const fiinstId : ftrCtx.finterSlots)
+        {
+            if ( ! fiinstId.has_value() )
+            {
+                continue;
+            }
+            liveFIInsts.insert(fiinstId);
+            if ( ! m_loadedFIInsts.contains(fiinstId) )
+            {
+                addedFIInsts.push_back(fiinstId);
+                fw::FeatureInterface const &fiinst = rFW.m_fiinstData[fiinstId];
+                addedLoopblks .insert(addedLoopblks .end(), fiinst.loopblks .begin(), fiinst.loopblks .end());
+                addedPipelines.insert(addedPipelines.end(), fiinst.pipelines.begin(), fiinst.pipelines.end());
+            }
+        }
+    }
+
+    std::vector<TaskId>             removedTasks;
+    std::vector<PipelineId>         removedPipelines;
+    std::vector<LoopBlockId>        removedLoopblks;
+    std::vector<fw::FSessionId>     removedSessions;
+    std::vector<fw::FIInstanceId>   removedFIInsts;
+
+    for (fw::FSessionId const sessionId : m_loadedSessions)
+    {
+        if ( ! liveSessions.contains(sessionId) )
+        {
+            removedSessions.push_back(sessionId);
+            auto const &sessionTasks = m_loadedTasksOf[sessionId];
+            removedTasks.insert(removedTasks.end(), sessionTasks.begin(), sessionTasks.end());
+        }
+    }
+
+    for (fw::FIInstanceId const fiinstId : m_loadedFIInsts)
+    {
+        if ( ! liveFIInsts.contains(fiinstId) )
+        {
+            removedFIInsts.push_back(fiinstId);
+            LoadedFIInstance const &loaded = m_loadedFIInstOf[fiinstId];
+            removedLoopblks .insert(removedLoopblks .end(), loaded.loopblks .begin(), loaded.loopblks .end());
+            removedPipelines.insert(removedPipelines.end(), loaded.pipelines.begin(), loaded.pipelines.end());
+        }
+    }
+
+    lgrn::IdSetStl<TaskId> addedTaskSet;
+    addedTaskSet.resize(tasks.taskIds.capacity());
+    for (TaskId const taskId : addedTasks)
+    {
+        addedTaskSet.insert(taskId);
+    }
+
+    std::vector<TaskSyncToPipeline> newSyncs;
+    if ( ! addedTasks.empty() )
+    {
+        for (TaskSyncToPipeline const& taskSync : tasks.syncs)
+        {
+            if (addedTaskSet.contains(taskSync.task))
+            {
+                newSyncs.push_back(taskSync);
+            }
+        }
+    }
+
+    // Removed loop blocks and pipelines must not be used by anything that stays
+    lgrn::IdSetStl<TaskId> removedTaskSet;
+    removedTaskSet.resize(m_roxTaskOf.size());
+    KeyedVec<PipelineId, unsigned int> removedSyncsTo;
+    removedSyncsTo.resize(m_roxPipelineOf.size(), 0u);
+    std::size_t removedSyncCount = 0;
+    for (TaskId const taskId : removedTasks)
+    {
+        removedTaskSet.insert(taskId);
+        for (PipelineId const pipelineId : m_roxTaskOf[taskId].syncedTo)
+        {
+            ++removedSyncsTo[pipelineId];
+            ++removedSyncCount;
+        }
+    }
+
+    auto const schedule_task_stays = [this, &removedTaskSet] (SynchronizerId const scheduleSync) -> bool
+    {
+        TaskId const scheduleTask = scheduleSync.has_value() ? m_roxSyncOf[scheduleSync].taskId : TaskId{};
+        return scheduleTask.has_value() && ! removedTaskSet.contains(scheduleTask);
+    };
+
+    for (PipelineId const pipelineId : removedPipelines)
+    {
+        RoxPipeline const &roxPl = m_roxPipelineOf[pipelineId];
+        bool const hasScheduleTask = roxPl.schedule.has_value() && m_roxSyncOf[roxPl.schedule].taskId.has_value();
+        if (   schedule_task_stays(roxPl.schedule)
+            || roxPl.syncCount != removedSyncsTo[pipelineId] + (hasScheduleTask ? 1u : 0u))
+        {
+            return false;
+        }
+    }
+    for (LoopBlockId const loopblkId : removedLoopblks)
+    {
+        if (schedule_task_stays(m_roxLoopblkOf[loopblkId].schedule))
+        {
+            return false;
+        }
+    }
+
+    // ...and removed schedule tasks must not be used by a loop block or pipeline that stays
+    lgrn::IdSetStl<PipelineId>  removedPipelineSet;
+    lgrn::IdSetStl<LoopBlockId> removedLoopblkSet;
+    removedPipelineSet.resize(m_roxPipelineOf.size());
+    removedLoopblkSet .resize(m_roxLoopblkOf.size());
+    for (PipelineId const pipelineId : removedPipelines)
+    {
+        removedPipelineSet.insert(pipelineId);
+    }
+    for (LoopBlockId const loopblkId : removedLoopblks)
+    {
+        removedLoopblkSet.insert(loopblkId);
+    }
+    for (TaskId const taskId : removedTasks)
+    {
+        RoxSync const &roxSync = m_roxSyncOf[m_roxTaskOf[taskId].main];
+        if (   (roxSync.tag == ESyncType::PlSchedule  && ! removedPipelineSet.contains(roxSync.pipelineId))
+            || (roxSync.tag == ESyncType::BlkSchedule && ! removedLoopblkSet .contains(roxSync.loopBlk)))
+        {
+            return false;
+        }
+    }
+
+    // Only syncs of added tasks are added, and everything must be owned by a feature session or
+    // feature interface. Otherwise, something was added directly to Framework::m_tasks.
+    if (   m_loadedCounts.syncs     - removedSyncCount        + newSyncs.size()       != tasks.syncs.size()
+        || m_loadedCounts.tasks     - removedTasks.size()     + addedTasks.size()     != tasks.taskIds.size()
+        || m_loadedCounts.pipelines - removedPipelines.size() + addedPipelines.size() != tasks.pipelineIds.size()
+        || m_loadedCounts.loopblks  - removedLoopblks.size()  + addedLoopblks.size()  != tasks.loopblkIds.size())
+    {
+        return false;
+    }
+
+    if (   addedTasks.empty() && addedPipelines.empty() && addedLoopblks.empty()
+        && removedTasks.empty() && removedPipelines.empty() && removedLoopblks.empty())
+    {
+        return true; // nothing changed
+    }
+
+    m_touchedSyncs      .clear();
+    m_touchedSubgraphs  .clear();
+
+    remove_from_graph(removedLoopblks, removedPipelines, removedTasks);
+    add_to_graph(rFW, addedLoopblks, addedPipelines, addedTasks, newSyncs);
+
+    // # Keep execution state of everything that stayed
+
+    if (m_execStateValid)
+    {
+        m_exec.load_changes(m_touchedSubgraphs, m_touchedSyncs, m_graph);
+
+        // New tasks start off canceled by all canceled pipelines that can cancel them, same as
+        // restart() does for everything
+        lgrn::IdSetStl<PipelineId> syncedPipelines;
+        syncedPipelines.resize(tasks.pipelineIds.capacity());
+        for (TaskSyncToPipeline const& taskSync : newSyncs)
+        {
+            syncedPipelines.insert(taskSync.pipeline);
+        }
+        for (PipelineId const pipelineId : syncedPipelines)
+        {
+            if ( ! m_wtxPipelineOf[pipelineId].isCanceled )
+            {
+                continue;
+            }
+            for (TaskId const taskId : m_roxPipelineOf[pipelineId].cancelsTasks)
+            {
+                if (addedTaskSet.contains(taskId))
+                {
+                    ++ m_wtxSyncOf[m_roxTaskOf[taskId].main].canceledByPipelines;
+                }
+            }
+        }
+
+        m_exec.batch(SetEnable, m_pausedSyncs, m_graph);
+        m_pausedSyncs.clear();
+
+        for (LoopBlockId const loopblkId : addedLoopblks)
+        {
+            if ( ! tasks.loopblkInst[loopblkId].parent.has_value() )
+            {
+                enable_top_level_loopblk(loopblkId);
+            }
+        }
+    }
+
+    for (fw::FSessionId const sessionId : removedSessions)
+    {
+        m_loadedSessions.erase(sessionId);
+        m_loadedTasksOf[sessionId].clear();
+    }
+    for (fw::FIInstanceId const fiinstId : removedFIInsts)
+    {
+        m_loadedFIInsts.erase(fiinstId);
+        m_loadedFIInstOf[fiinstId] = {};
+    }
+
+    for (fw::FSessionId const sessionId : addedSessions)
+    {
+        m_loadedSessions.insert(sessionId);
+        m_loadedTasksOf[sessionId] = rFW.m_fsessionData[sessionId].tasks;
+    }
+    for (fw::FIInstanceId const fiinstId : addedFIInsts)
+    {
+        fw::FeatureInterface const &fiinst = rFW.m_fiinstData[fiinstId];
+        m_loadedFIInsts.insert(fiinstId);
+        m_loadedFIInstOf[fiinstId] = { .loopblks = fiinst.loopblks, .pipelines = fiinst.pipelines };
+    }
+
+    m_loadedCounts = {
+        .tasks      = tasks.taskIds.size(),
+        .pipelines  = tasks.pipelineIds.size(),
+        .loopblks   = tasks.loopblkIds.size(),
+        .syncs      = tasks.syncs.size()
+    };
+
+    return true;
+}
+
+void SinglethreadFWExecutor::add_to_graph(
+        osp::fw::Framework const&                   rFW,
+        ArrayView<LoopBlockId const>                loopblks,
+        ArrayView<PipelineId const>                 pipelines,
+        ArrayView<TaskId const>                     taskIds,
+        ArrayView<TaskSyncToPipeline const>         newSyncs)
+{
+    Tasks const &tasks = rFW.m_tasks;
 
     m_roxTaskOf         .resize(tasks.taskIds.capacity());
     m_wtxTaskOf         .resize(tasks.taskIds.capacity());
@@ -103,11 +439,60 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
     m_roxPipelineOf     .resize(tasks.pipelineIds.capacity());
     m_wtxPipelineOf     .resize(tasks.pipelineIds.capacity());
 
-    // # Make SubgraphTypes: BlockController and Status
+    // # Check task order of each top-level loop block family that changed
+
+    lgrn::IdSetStl<LoopBlockId> changedRoots;
+    changedRoots.resize(tasks.loopblkIds.capacity());
+
+    auto const root_of = [&tasks] (LoopBlockId const loopblkId) noexcept
+    {
+        LoopBlockId const parent = tasks.loopblkInst[loopblkId].parent;
+        return parent.has_value() ? parent : loopblkId;
+    };
+    for (LoopBlockId const loopblkId : loopblks)
+    {
+        changedRoots.insert(root_of(loopblkId));
+    }
+    for (PipelineId const pipelineId : pipelines)
+    {
+        changedRoots.insert(root_of(tasks.pipelineInst[pipelineId].block));
+    }
+    for (TaskSyncToPipeline const& taskSync : newSyncs)
+    {
+        changedRoots.insert(root_of(tasks.pipelineInst[taskSync.pipeline].block));
+    }
+
+    for (LoopBlockId const loopblkId : changedRoots)
+    {
+        if (tasks.loopblkInst[loopblkId].parent.has_value())
+        {
+            continue;
+        }
+
+        lgrn::IdSetStl<LoopBlockId> loopblkFamily;
+        loopblkFamily.resize(tasks.loopblkIds.capacity());
+        loopblkFamily.insert(loopblkId);
+
+        for (LoopBlockId const mightBeChild : tasks.loopblkIds)
+        {
+            if (tasks.loopblkInst[mightBeChild].parent == loopblkId)
+            {
+                loopblkFamily.insert(mightBeChild);
+            }
+        }
+
+        TaskOrderReport report;
+        check_task_order(tasks, report, std::move(loopblkFamily));
+
+        if (m_log)
+        {
+            SPDLOG_LOGGER_INFO(m_log, "LoopBlock{} task order report\n{}\n", loopblkId.value, visualize_task_order(report, tasks));
+        }
+
+        LGRN_ASSERTM(report.failedNotAdded.empty() && report.failedLocked.empty(), "deadlock");
+    }
 
-    SubgraphTypeId const sgtBlkCtrlId    = m_graph.sgtypeIds.create();
-    SubgraphTypeId const sgtSingleStatId = m_graph.sgtypeIds.create();
-    m_graph.sgtypes.resize(m_graph.sgtypeIds.capacity());
+    // # Make SubgraphTypes: BlockController and Status
 
     LocalPointId const blkctrlStart     = point(0);
     LocalPointId const blkctrlSchedule  = point(1);
@@ -115,47 +500,54 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
     LocalPointId const blkctrlBlkExit   = point(3);
     LocalPointId const blkctrlFinish    = point(4);
 
+    if ( ! m_sgtBlkCtrl.has_value() )
     {
-        SubgraphType &rSgtype = m_graph.sgtypes[sgtBlkCtrlId];
-        rSgtype.debugName = "BlockController";
-        rSgtype.points = {{
+        m_sgtBlkCtrl    = m_graph.sgtypeIds.create();
+        m_sgtSingleStat = m_graph.sgtypeIds.create();
+        m_graph.sgtypes.resize(m_graph.sgtypeIds.capacity());
+
+        SubgraphType &rBlkCtrl = m_graph.sgtypes[m_sgtBlkCtrl];
+        rBlkCtrl.debugName = "BlockController";
+        rBlkCtrl.points = {{
             {.debugName = "Start"},     // point(0)
             {.debugName = "Schedule"},  // point(1)
             {.debugName = "BlockRun"},  // point(2)
             {.debugName = "BlockExit"}, // point(3)
             {.debugName = "Finish"}     // point(4)
         }};
-        rSgtype.cycles = {{
+        rBlkCtrl.cycles = {{
             {.debugName = "Control",    .path = {blkctrlStart,    blkctrlFinish}},
             {.debugName = "Run",        .path = {blkctrlSchedule, blkctrlBlkRun, blkctrlBlkExit}}
         }};
-        rSgtype.initialCycle = cycle(0);
-        rSgtype.initialPos   = 0;
-    }
+        rBlkCtrl.initialCycle = cycle(0);
+        rBlkCtrl.initialPos   = 0;
 
-    {
-        SubgraphType &rSgtype = m_graph.sgtypes[sgtSingleStatId];
-        rSgtype.debugName = "SingleTaskStatus";
-        rSgtype.points = {{
+        SubgraphType &rSingleStat = m_graph.sgtypes[m_sgtSingleStat];
+        rSingleStat.debugName = "SingleTaskStatus";
+        rSingleStat.points = {{
             {.debugName = "Run"},       // point(0)
             {.debugName = "Done"},      // point(1)
         }};
-        rSgtype.cycles = {{
+        rSingleStat.cycles = {{
             {.debugName = "Control",  .path = {point(0), point(1)}}
         }};
-        rSgtype.initialCycle = cycle(0);
-        rSgtype.initialPos   = 0;
+        rSingleStat.initialCycle = cycle(0);
+        rSingleStat.initialPos   = 0;
     }
 
-    // # Add SubgraphType corresponding to each global PipelineType
+    // # Add SubgraphType corresponding to each global PipelineType not added yet
 
     auto const &rPltypeReg = PipelineTypeIdReg::instance();
 
-    KeyedVec<PipelineTypeId, RoxPltype> roxPltypeOf;
-    roxPltypeOf.resize(rPltypeReg.ids().size());
+    m_roxPltypeOf.resize(rPltypeReg.ids().capacity());
 
     for (PipelineTypeId pltypeId : rPltypeReg.ids())
     {
+        if (m_roxPltypeOf[pltypeId].sgtype.has_value())
+        {
+            continue;
+        }
+
         PipelineTypeInfo const &rPltypeInfo = rPltypeReg.get(pltypeId);
         auto             const stageCount   = rPltypeInfo.stages.size();
 
@@ -201,19 +593,16 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
         rSgtype.initialCycle = cycle(0);
         rSgtype.initialPos   = 0;
 
-        roxPltypeOf[pltypeId] = {
+        m_roxPltypeOf[pltypeId] = {
             .sgtype         = sgtypeId,
             .schedulePoint  = schedulePoint,
             .scheduleStage  = scheduleStage
         };
     }
 
-    // Done adding sgtypes. References from here are now stable.
-    SubgraphType &rBlkCtrl = m_graph.sgtypes[sgtBlkCtrlId];
-
     // # Add BlockController Subgraph for each task LoopBlock
 
-    for (LoopBlockId const loopblkId : tasks.loopblkIds)
+    for (LoopBlockId const loopblkId : loopblks)
     {
         LoopBlock     const &loopblk           = tasks.loopblkInst[loopblkId];
         bool          const hasDefaultSchedule = ! loopblk.scheduleCondition.has_value();
@@ -224,25 +613,25 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
             .schedule       = hasDefaultSchedule ? m_graph.syncIds.create() : SynchronizerId{},
             .checkstop      = m_graph.syncIds.create(),
             .left           = m_graph.syncIds.create(),
-            .right          = m_graph.syncIds.create()
+            .right          = m_graph.syncIds.create(),
+            .parent         = loopblk.parent
         };
-
     }
 
     resize_fit_syncs();
     resize_fit_subgraphs();
 
-    for (LoopBlockId const loopblkId : tasks.loopblkIds)
+    for (LoopBlockId const loopblkId : loopblks)
     {
         LoopBlock     const &loopblk           = tasks.loopblkInst[loopblkId];
         bool          const hasDefaultSchedule = ! loopblk.scheduleCondition.has_value();
         RoxLoopblk    const &roxLoopblk     = m_roxLoopblkOf[loopblkId];
 
         Subgraph &rSubgraph         = m_graph.subgraphs[roxLoopblk.subgraph];
-        rSubgraph.instanceOf        = sgtBlkCtrlId;
+        rSubgraph.instanceOf        = m_sgtBlkCtrl;
         rSubgraph.debugName         = fmt::format("BC{}", loopblkId.value);
         rSubgraph.points.clear();
-        rSubgraph.points.resize(m_graph.sgtypes[sgtBlkCtrlId].points.size());
+        rSubgraph.points.resize(m_graph.sgtypes[m_sgtBlkCtrl].points.size());
         m_wtxSubgraphOf[roxLoopblk.subgraph] = {
             .tag        = WtxSubgraph::ETag::LoopBlock,
             .loopblkId  = loopblkId.value
@@ -250,7 +639,7 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
 
         Subgraph &rSgScheduleStat   = m_graph.subgraphs[roxLoopblk.scheduleStatus];
         rSgScheduleStat.debugName   = fmt::format("for BC{}", loopblkId.value);
-        rSgScheduleStat.instanceOf  = sgtSingleStatId;
+        rSgScheduleStat.instanceOf  = m_sgtSingleStat;
         rSgScheduleStat.points.resize(2);
         m_wtxSubgraphOf[roxLoopblk.scheduleStatus] = { .tag = WtxSubgraph::ETag::ScheduleStatus };
 
@@ -281,12 +670,12 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
         m_roxSyncOf[roxLoopblk.left]        = {.tag = ESyncType::BlkLeft,      .loopBlk = loopblkId};
         m_roxSyncOf[roxLoopblk.right]       = {.tag = ESyncType::BlkRight,     .loopBlk = loopblkId};
 
-        m_graph.connect({.sync = roxLoopblk.left,   .subgraphPoint = {roxLoopblk.subgraph, blkctrlBlkRun}});
-        m_graph.connect({.sync = roxLoopblk.right,  .subgraphPoint = {roxLoopblk.subgraph, blkctrlBlkRun}});
+        connect({.sync = roxLoopblk.left,   .subgraphPoint = {roxLoopblk.subgraph, blkctrlBlkRun}});
+        connect({.sync = roxLoopblk.right,  .subgraphPoint = {roxLoopblk.subgraph, blkctrlBlkRun}});
     }
 
     // Add loopblock parent - loopblock child connections
-    for (LoopBlockId const loopblkId : tasks.loopblkIds)
+    for (LoopBlockId const loopblkId : loopblks)
     {
         LoopBlock const &loopblk  = tasks.loopblkInst[loopblkId];
 
@@ -295,26 +684,46 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
             RoxLoopblk const &child  = m_roxLoopblkOf[loopblkId];
             RoxLoopblk const &parent = m_roxLoopblkOf[loopblk.parent];
 
-            m_graph.connect({.sync = parent.left,      .subgraphPoint = {child.subgraph, blkctrlStart}});
-            m_graph.connect({.sync = parent.right,     .subgraphPoint = {child.subgraph, blkctrlFinish}});
-            m_graph.connect({.sync = parent.checkstop, .subgraphPoint = {child.subgraph, blkctrlBlkExit}});
-            m_graph.connect({.sync = parent.checkstop, .subgraphPoint = {child.scheduleStatus, point(1)}});
+            connect({.sync = parent.left,      .subgraphPoint = {child.subgraph, blkctrlStart}});
+            connect({.sync = parent.right,     .subgraphPoint = {child.subgraph, blkctrlFinish}});
+            connect({.sync = parent.checkstop, .subgraphPoint = {child.subgraph, blkctrlBlkExit}});
+            connect({.sync = parent.checkstop, .subgraphPoint = {child.scheduleStatus, point(1)}});
         }
     }
 
     // # Add pipelines
 
+    // New pipelines, and existing pipelines that didn't have any tasks until now
+    lgrn::IdSetStl<PipelineId> maybeNewPipelines;
+    maybeNewPipelines.resize(tasks.pipelineIds.capacity());
+
+    for (PipelineId const pipelineId : pipelines)
+    {
+        Pipeline const &pipeline = tasks.pipelineInst[pipelineId];
+        RoxPipeline    &rRoxPl   = m_roxPipelineOf[pipelineId];
+
+        rRoxPl = { .block = pipeline.block };
+
+        if (pipeline.scheduleCondition.has_value())
+        {
+            rRoxPl.syncCount += 1;
+        }
+        maybeNewPipelines.insert(pipelineId);
+    }
+
     // Count number syncs to each pipeline
-    for (TaskSyncToPipeline const& taskSync : tasks.syncs)
+    for (TaskSyncToPipeline const& taskSync : newSyncs)
     {
         ++ m_roxPipelineOf[taskSync.pipeline].syncCount;
+        maybeNewPipelines.insert(taskSync.pipeline);
     }
 
     // reserve new pipeline subgraph IDs
-    for (PipelineId const pipelineId : tasks.pipelineIds)
+    std::vector<PipelineId> newPipelines;
+    for (PipelineId const pipelineId : maybeNewPipelines)
     {
         Pipeline  const &pipeline       = tasks.pipelineInst[pipelineId];
-        RoxPltype const &roxPltype      = roxPltypeOf[pipeline.type];
+        RoxPltype const &roxPltype      = m_roxPltypeOf[pipeline.type];
         RoxPipeline     &rRoxPl         = m_roxPipelineOf[pipelineId];
 
         bool      const hasSchedulePoint   = roxPltype.schedulePoint.has_value();
@@ -322,17 +731,13 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
 
         LGRN_ASSERTM(pipeline.initialStage.has_value(), "pipeline has no initial stage set");
 
-        if (pipeline.scheduleCondition.has_value())
-        {
-            rRoxPl.syncCount += 1;
-        }
-
-        if (rRoxPl.syncCount != 0)
+        if (rRoxPl.syncCount != 0 && ! rRoxPl.main.has_value())
         {
             rRoxPl.main             = m_graph.subgraphIds.create();
             rRoxPl.scheduleStatus   = hasSchedulePoint ? m_graph.subgraphIds.create() : SubgraphId{};
             rRoxPl.schedule         = hasDefaultSchedule ? m_graph.syncIds.create() : SynchronizerId{};
             rRoxPl.initialStage     = pipeline.initialStage;
+            newPipelines.push_back(pipelineId);
         }
         // else, this pipeline has no tasks. Don't create it as it will just infinite loop and hang
     }
@@ -340,14 +745,11 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
     resize_fit_subgraphs();
     resize_fit_syncs();
 
-    for (PipelineId const pipelineId : tasks.pipelineIds)
+    for (PipelineId const pipelineId : newPipelines)
     {
         RoxPipeline   const &roxPl          = m_roxPipelineOf[pipelineId];
-
-        if ( ! roxPl.main.has_value() ) { continue; }
-
         Pipeline      const &pipeline       = tasks.pipelineInst[pipelineId];
-        RoxPltype     const &roxPltype      = roxPltypeOf[pipeline.type];
+        RoxPltype     const &roxPltype      = m_roxPltypeOf[pipeline.type];
         SubgraphType  const &sgtype         = m_graph.sgtypes[roxPltype.sgtype];
         bool          const hasDefaultSchedule = roxPltype.schedulePoint.has_value() && ! pipeline.scheduleCondition.has_value();
         RoxLoopblk          &rRoxLoopblk    = m_roxLoopblkOf[pipeline.block];
@@ -365,8 +767,8 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
         rSgMain        .points.resize(pointCount);
 
         // Connect pipeline main subgraph to its parent BlockCtrl's subgraph
-        m_graph.connect({.sync = rRoxLoopblk.left,      .subgraphPoint = {roxPl.main, start}});
-        m_graph.connect({.sync = rRoxLoopblk.right,     .subgraphPoint = {roxPl.main, finish}});
+        connect({.sync = rRoxLoopblk.left,      .subgraphPoint = {roxPl.main, start}});
+        connect({.sync = rRoxLoopblk.right,     .subgraphPoint = {roxPl.main, finish}});
 
         m_wtxSubgraphOf[roxPl.main] = {
             .tag        = WtxSubgraph::ETag::Pipeline,
@@ -377,10 +779,10 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
         {
             Subgraph &rSgScheduleStat       = m_graph.subgraphs[roxPl.scheduleStatus];
             rSgScheduleStat.debugName       = fmt::format("for PL{}", pipelineId.value);
-            rSgScheduleStat.instanceOf      = sgtSingleStatId;
+            rSgScheduleStat.instanceOf      = m_sgtSingleStat;
             rSgScheduleStat.points.resize(2);
 
-            m_graph.connect({.sync = rRoxLoopblk.checkstop, .subgraphPoint = {roxPl.scheduleStatus, point(1)}});
+            connect({.sync = rRoxLoopblk.checkstop, .subgraphPoint = {roxPl.scheduleStatus, point(1)}});
 
             m_wtxSubgraphOf[roxPl.scheduleStatus] = {
                 .tag        = WtxSubgraph::ETag::ScheduleStatus
@@ -395,7 +797,6 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
                 .taskId         = TaskId{},
                 .pipelineId     = pipelineId,
             };
-            m_wtxSyncOf[roxPl.schedule] = {  };
 
             m_graph.syncs[roxPl.schedule].debugName = fmt::format("PL{} DefaultSchedule", pipelineId.value);
         }
@@ -403,15 +804,15 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
 
     // # Add tasks
 
-    for (TaskId const task : tasks.taskIds)
+    for (TaskId const task : taskIds)
     {
         SynchronizerId const syncId = m_graph.syncIds.create();
-        m_roxTaskOf[task].main = syncId;
+        m_roxTaskOf[task] = { .main = syncId };
     }
 
     resize_fit_syncs();
 
-    for (TaskId const taskId : tasks.taskIds)
+    for (TaskId const taskId : taskIds)
     {
         RoxTask &rRoxTask = m_roxTaskOf[taskId];
         Synchronizer &rTaskMain = m_graph.syncs[rRoxTask.main];
@@ -421,19 +822,14 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
             .tag                    = ESyncType::Task,
             .taskId                 = taskId,
         };
-
-        m_wtxSyncOf[rRoxTask.main] = {
-            .canceledByPipelines    = 0
-        };
     }
 
     // Connect LoopBlock schedule tasks
-    for (LoopBlockId const loopblkId : tasks.loopblkIds)
+    for (LoopBlockId const loopblkId : loopblks)
     {
         LoopBlock     const &loopBlk        = tasks.loopblkInst[loopblkId];
         bool          const hasCustomScheduleTask = loopBlk.scheduleCondition.has_value();
         RoxLoopblk          &rRoxLoopblk    = m_roxLoopblkOf[loopblkId];
-        Subgraph            &rSubgraph      = m_graph.subgraphs[rRoxLoopblk.subgraph];
 
         if (hasCustomScheduleTask)
         {
@@ -455,8 +851,8 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
             LGRN_ASSERT(rRoxLoopblk.schedule.has_value());
         }
 
-        m_graph.connect({.sync = rRoxLoopblk.schedule, .subgraphPoint = {rRoxLoopblk.subgraph, blkctrlSchedule}});
-        m_graph.connect({.sync = rRoxLoopblk.schedule, .subgraphPoint = {rRoxLoopblk.scheduleStatus, point(0)}});
+        connect({.sync = rRoxLoopblk.schedule, .subgraphPoint = {rRoxLoopblk.subgraph, blkctrlSchedule}});
+        connect({.sync = rRoxLoopblk.schedule, .subgraphPoint = {rRoxLoopblk.scheduleStatus, point(0)}});
 
         if (loopBlk.parent.has_value())
         {
@@ -470,10 +866,10 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
     }
 
     // Connect pipeline schedule tasks
-    for (PipelineId const pipelineId : tasks.pipelineIds)
+    for (PipelineId const pipelineId : newPipelines)
     {
         Pipeline      const &pipeline       = tasks.pipelineInst[pipelineId];
-        RoxPltype     const &roxPltype      = roxPltypeOf[pipeline.type];
+        RoxPltype     const &roxPltype      = m_roxPltypeOf[pipeline.type];
         RoxPipeline         &rRoxPipeline   = m_roxPipelineOf[pipelineId];
 
         if (rRoxPipeline.scheduleStatus.has_value())
@@ -501,23 +897,21 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
                 LGRN_ASSERT(rRoxPipeline.schedule.has_value() );
             }
 
-            Subgraph            &rSgMain        = m_graph.subgraphs[rRoxPipeline.main];
-            Synchronizer        &rScheduleSync  = m_graph.syncs[rRoxPipeline.schedule];
-
-            m_graph.connect({.sync = rRoxPipeline.schedule, .subgraphPoint = {rRoxPipeline.main, roxPltype.schedulePoint}});
-            m_graph.connect({.sync = rRoxPipeline.schedule, .subgraphPoint = {rRoxPipeline.scheduleStatus, point(0)}});
+            connect({.sync = rRoxPipeline.schedule, .subgraphPoint = {rRoxPipeline.main, roxPltype.schedulePoint}});
+            connect({.sync = rRoxPipeline.schedule, .subgraphPoint = {rRoxPipeline.scheduleStatus, point(0)}});
 
             rRoxLoopblk.associatedTasks.push_back(rRoxPipeline.schedule);
         }
     }
 
     // assign rRoxTask.parent loopblocks, and detect tasks that span across multiple loopblocks
-    for (TaskSyncToPipeline const& taskSync : tasks.syncs)
+    for (TaskSyncToPipeline const& taskSync : newSyncs)
     {
         RoxTask                 &rRoxTask       = m_roxTaskOf[taskSync.task];
         Pipeline          const &pipeline       = tasks.pipelineInst[taskSync.pipeline];
         RoxLoopblk              &rRoxLoopblk    = m_roxLoopblkOf[pipeline.block];
-        WtxSync                 &rTaskWtxSync   = m_wtxSyncOf[rRoxTask.main];
+
+        rRoxTask.syncedTo.push_back(taskSync.pipeline);
 
         if ( ! vec_contains(rRoxLoopblk.associatedTasks, rRoxTask.main) )
         {
@@ -563,13 +957,12 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
 
     resize_fit_syncs();
 
-    for (TaskId const taskId : tasks.taskIds)
+    for (TaskId const taskId : taskIds)
     {
         RoxTask const &rRoxTask = m_roxTaskOf[taskId];
 
         if (rRoxTask.is_spanning_nested_loopblocks())
         {
-            RoxLoopblk const &rRoxLoopblk = m_roxLoopblkOf[rRoxTask.parent];
             bool const isSchedule = m_roxSyncOf[rRoxTask.main].tag == ESyncType::PlSchedule;
 
             Synchronizer    &rSustainer       = m_graph.syncs[rRoxTask.sustainer];
@@ -593,7 +986,7 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
     auto const& pltypeinfoReg = PipelineTypeIdReg::instance();
 
     // connect rRoxTask.main sync to pipeline stage points
-    for (TaskSyncToPipeline const& taskSync : tasks.syncs)
+    for (TaskSyncToPipeline const& taskSync : newSyncs)
     {
         RoxTask           const &rRoxTask       = m_roxTaskOf[taskSync.task];
         Pipeline          const &pipeline       = tasks.pipelineInst[taskSync.pipeline];
@@ -602,8 +995,6 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
         auto              const &stageInfo      = pltypeinfo.stages[taskSync.stage];
 
         RoxPipeline             &rRoxPipeline   = m_roxPipelineOf[taskSync.pipeline];
-        RoxLoopblk              &rRoxLoopblk    = m_roxLoopblkOf[pipeline.block];
-        WtxSync                 &rTaskWtxSync   = m_wtxSyncOf[rRoxTask.main];
 
         LocalPointId const stagePoint = point(1u + taskSync.stage.value);
 
@@ -613,21 +1004,20 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
             && ! vec_contains(rRoxPipeline.cancelsTasks, taskSync.task))
         {
             rRoxPipeline.cancelsTasks.push_back(taskSync.task);
-            ++rTaskWtxSync.canceledByPipelines;
         }
 
         if (pipeline.block == rRoxTask.parent)
         {
-            m_graph.connect({.sync = rRoxTask.main, .subgraphPoint = {rRoxPipeline.main, stagePoint}});
+            connect({.sync = rRoxTask.main, .subgraphPoint = {rRoxPipeline.main, stagePoint}});
         }
 
         if (rRoxTask.is_spanning_nested_loopblocks())
         {
-            m_graph.connect({.sync = rRoxTask.external, .subgraphPoint = {rRoxPipeline.main, stagePoint}});
+            connect({.sync = rRoxTask.external, .subgraphPoint = {rRoxPipeline.main, stagePoint}});
 
             if (pipeline.block == rRoxTask.parent)
             {
-                RoxPltype     const &roxPltype      = roxPltypeOf[pipeline.type];
+                RoxPltype     const &roxPltype      = m_roxPltypeOf[pipeline.type];
                 SubgraphType  const &sgtype         = m_graph.sgtypes[roxPltype.sgtype];
                 auto          const pointCount      = sgtype.points.size();
                 auto          const stageCount      = pointCount-2u;
@@ -635,23 +1025,27 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
 
                 if ( ! vec_contains(m_graph.subgraphs[rRoxPipeline.main].points[finish].connectedSyncs, rRoxTask.sustainer ) )
                 {
-                    m_graph.connect({.sync = rRoxTask.sustainer, .subgraphPoint = {rRoxPipeline.main, finish}});
+                    connect({.sync = rRoxTask.sustainer, .subgraphPoint = {rRoxPipeline.main, finish}});
                 }
             }
             else
             {
-                m_graph.connect({.sync = rRoxTask.sustainer, .subgraphPoint = {rRoxPipeline.main, stagePoint}});
+                connect({.sync = rRoxTask.sustainer, .subgraphPoint = {rRoxPipeline.main, stagePoint}});
             }
         }
     }
 
     // keep connectedSyncs and connectedPoints sorted
-    for (SynchronizerId const syncId : m_graph.syncIds)
+    std::sort(m_touchedSyncs.begin(), m_touchedSyncs.end());
+    m_touchedSyncs.erase(std::unique(m_touchedSyncs.begin(), m_touchedSyncs.end()), m_touchedSyncs.end());
+    for (SynchronizerId const syncId : m_touchedSyncs)
     {
         std::sort(m_graph.syncs[syncId].connectedPoints.begin(),
                   m_graph.syncs[syncId].connectedPoints.end());
     }
-    for (SubgraphId const subgraphId : m_graph.subgraphIds)
+    std::sort(m_touchedSubgraphs.begin(), m_touchedSubgraphs.end());
+    m_touchedSubgraphs.erase(std::unique(m_touchedSubgraphs.begin(), m_touchedSubgraphs.end()), m_touchedSubgraphs.end());
+    for (SubgraphId const subgraphId : m_touchedSubgraphs)
     {
         Subgraph &rSubgraph = m_graph.subgraphs[subgraphId];
         for (Subgraph::Point &rPoint : rSubgraph.points)
@@ -661,36 +1055,270 @@ void SinglethreadFWExecutor::load(osp::fw::Framework& rFW)
     }
 
     // verify there isn't any schedule tasks being cancelled
-    for (PipelineId const pipelineId : tasks.pipelineIds)
+    for (TaskSyncToPipeline const& taskSync : newSyncs)
     {
-        for (TaskId const taskId : m_roxPipelineOf[pipelineId].cancelsTasks)
+        for (TaskId const taskId : m_roxPipelineOf[taskSync.pipeline].cancelsTasks)
         {
             LGRN_ASSERTMV(m_roxSyncOf[m_roxTaskOf[taskId].main].tag != ESyncType::PlSchedule,
                           "schedule tasks can't be cancellable",
                           rFW.m_tasks.taskInst[taskId].debugName);
         }
     }
+}
 
-    m_graph.debug_verify();
+void SinglethreadFWExecutor::remove_from_graph(
+        ArrayView<LoopBlockId const>                loopblks,
+        ArrayView<PipelineId const>                 pipelines,
+        ArrayView<TaskId const>                     taskIds)
+{
+    lgrn::IdSetStl<SynchronizerId>  removedSyncs;
+    lgrn::IdSetStl<PipelineId>      removedPipelines;
+    lgrn::IdSetStl<LoopBlockId>     removedLoopblks;
+    lgrn::IdSetStl<TaskId>          removedTasks;
+    removedSyncs    .resize(m_graph.syncIds.capacity());
+    removedPipelines.resize(m_roxPipelineOf.size());
+    removedLoopblks .resize(m_roxLoopblkOf.size());
+    removedTasks    .resize(m_roxTaskOf.size());
+
+    for (PipelineId const pipelineId : pipelines)
+    {
+        removedPipelines.insert(pipelineId);
+    }
+    for (LoopBlockId const loopblkId : loopblks)
+    {
+        removedLoopblks.insert(loopblkId);
+    }
 
-    m_exec.load(m_graph);
+    // Loop blocks that stay, but had something removed from their children or associated syncs
+    lgrn::IdSetStl<LoopBlockId> affectedLoopblks;
+    affectedLoopblks.resize(m_roxLoopblkOf.size());
+
+    auto const remove_sync = [this, &removedSyncs] (SynchronizerId const syncId)
+    {
+        if (syncId.has_value() && ! removedSyncs.contains(syncId))
+        {
+            removedSyncs.insert(syncId);
+            forget_sync(syncId);
+            m_graph.remove_sync(syncId);
+            m_roxSyncOf[syncId] = {};
+        }
+    };
+
+    auto const remove_subgraph = [this] (SubgraphId const subgraphId)
+    {
+        if (subgraphId.has_value())
+        {
+            forget_subgraph(subgraphId);
+            m_graph.remove_subgraph(subgraphId);
+            m_wtxSubgraphOf[subgraphId] = {};
+        }
+    };
+
+    // Pipelines that stay, but had all of their tasks removed
+    std::vector<PipelineId> emptied;
+
+    for (TaskId const taskId : taskIds)
+    {
+        RoxTask &rRoxTask = m_roxTaskOf[taskId];
+        removedTasks.insert(taskId);
+
+        for (PipelineId const pipelineId : rRoxTask.syncedTo)
+        {
+            RoxPipeline &rRoxPl = m_roxPipelineOf[pipelineId];
+            -- rRoxPl.syncCount;
+
+            if (removedPipelines.contains(pipelineId))
+            {
+                continue;
+            }
+
+            if (rRoxPl.syncCount == 0 && rRoxPl.main.has_value())
+            {
+                emptied.push_back(pipelineId);
+            }
+
+            if ( ! removedLoopblks.contains(rRoxPl.block) )
+            {
+                affectedLoopblks.insert(rRoxPl.block);
+            }
+        }
+
+        remove_sync(rRoxTask.main);
+        remove_sync(rRoxTask.sustainer);
+        remove_sync(rRoxTask.external);
+
+        rRoxTask = {};
+        m_wtxTaskOf[taskId] = {};
+    }
+
+    auto const remove_pipeline_subgraphs = [&] (PipelineId const pipelineId)
+    {
+        RoxPipeline &rRoxPl = m_roxPipelineOf[pipelineId];
 
-    using ESyncAction = SyncGraphExecutor::ESyncAction;
+        // Custom schedule tasks were already removed above along with the other tasks
+        remove_sync(rRoxPl.schedule);
+        remove_subgraph(rRoxPl.main);
+        remove_subgraph(rRoxPl.scheduleStatus);
+
+        if ( rRoxPl.main.has_value() && ! removedLoopblks.contains(rRoxPl.block) )
+        {
+            affectedLoopblks.insert(rRoxPl.block);
+        }
+
+        rRoxPl.main             = {};
+        rRoxPl.scheduleStatus   = {};
+        rRoxPl.schedule         = {};
+        rRoxPl.cancelsTasks.clear();
+    };
+
+    for (PipelineId const pipelineId : emptied)
+    {
+        remove_pipeline_subgraphs(pipelineId);
+    }
+
+    for (PipelineId const pipelineId : pipelines)
+    {
+        remove_pipeline_subgraphs(pipelineId);
+        m_roxPipelineOf[pipelineId] = {};
+        m_wtxPipelineOf[pipelineId] = {};
+    }
+
+    for (LoopBlockId const loopblkId : loopblks)
+    {
+        RoxLoopblk &rRoxLoopblk = m_roxLoopblkOf[loopblkId];
+
+        remove_sync(rRoxLoopblk.schedule);
+        remove_sync(rRoxLoopblk.checkstop);
+        remove_sync(rRoxLoopblk.left);
+        remove_sync(rRoxLoopblk.right);
+        remove_subgraph(rRoxLoopblk.subgraph);
+        remove_subgraph(rRoxLoopblk.scheduleStatus);
+
+        if (rRoxLoopblk.parent.has_value() && ! removedLoopblks.contains(rRoxLoopblk.parent))
+        {
+            affectedLoopblks.insert(rRoxLoopblk.parent);
+        }
+
+        rRoxLoopblk = {};
+        m_wtxLoopblkOf[loopblkId] = {};
+    }
+
+    for (LoopBlockId const loopblkId : affectedLoopblks)
+    {
+        RoxLoopblk &rRoxLoopblk = m_roxLoopblkOf[loopblkId];
+
+        auto const is_removed_sync = [&removedSyncs] (SynchronizerId const syncId) { return removedSyncs.contains(syncId); };
+        std::erase_if(rRoxLoopblk.associatedTasks,  is_removed_sync);
+        std::erase_if(rRoxLoopblk.associatedOthers, is_removed_sync);
+        std::erase_if(rRoxLoopblk.externals,        is_removed_sync);
+        std::erase_if(rRoxLoopblk.loopblkChildren,  [&removedLoopblks] (LoopBlockId const id) { return removedLoopblks.contains(id); });
+        std::erase_if(rRoxLoopblk.pipelineChildren, [this] (PipelineId const id) { return ! m_roxPipelineOf[id].main.has_value(); });
+
+        for (PipelineId const pipelineId : rRoxLoopblk.pipelineChildren)
+        {
+            std::erase_if(m_roxPipelineOf[pipelineId].cancelsTasks, [&removedTasks] (TaskId const id) { return removedTasks.contains(id); });
+        }
+    }
+}
+
+void SinglethreadFWExecutor::restart(osp::fw::Framework& rFW)
+{
+    Tasks const &tasks = rFW.m_tasks;
+
+    m_exec.perSubgraph  .clear();
+    m_exec.perSync      .clear();
+    m_exec.subgraphsMoving.clear();
+    m_exec.justMoved    .clear();
+    m_tasksWaiting      .clear();
+
+    std::fill(m_wtxLoopblkOf .begin(), m_wtxLoopblkOf .end(), WtxLoopblk{});
+    std::fill(m_wtxPipelineOf.begin(), m_wtxPipelineOf.end(), WtxPipeline{});
+    std::fill(m_wtxTaskOf    .begin(), m_wtxTaskOf    .end(), WtxTask{});
+
+    // Tasks start off canceled by all pipelines that can cancel them
+    m_wtxSyncOf.assign(m_graph.syncIds.capacity(), WtxSync{});
+    for (PipelineId const pipelineId : tasks.pipelineIds)
+    {
+        for (TaskId const taskId : m_roxPipelineOf[pipelineId].cancelsTasks)
+        {
+            ++ m_wtxSyncOf[m_roxTaskOf[taskId].main].canceledByPipelines;
+        }
+    }
+
+    m_exec.load(m_graph);
 
     // enable top-level loop blocks
     for (LoopBlockId const loopblkId : tasks.loopblkIds)
     {
         if ( ! tasks.loopblkInst[loopblkId].parent.has_value() )
         {
-            RoxLoopblk const& rRoxLoopblk = m_roxLoopblkOf[loopblkId];
-            m_exec.batch(ESyncAction::SetEnable, {rRoxLoopblk.schedule, rRoxLoopblk.left, rRoxLoopblk.right}, m_graph);
-            m_exec.jump(rRoxLoopblk.subgraph, cycle(1) /*Running*/, 0, m_graph);
+            enable_top_level_loopblk(loopblkId);
         }
     }
 
+    m_pausedSyncs.clear();
+    m_execStateValid = true;
+
     wait(rFW);
 }
 
+void SinglethreadFWExecutor::enable_top_level_loopblk(LoopBlockId const loopblkId)
+{
+    RoxLoopblk const& rRoxLoopblk = m_roxLoopblkOf[loopblkId];
+    m_exec.batch(SetEnable, {rRoxLoopblk.schedule, rRoxLoopblk.left, rRoxLoopblk.right}, m_graph);
+    m_exec.jump(rRoxLoopblk.subgraph, cycle(1) /*Running*/, 0, m_graph);
+}
+
+void SinglethreadFWExecutor::pause_sync(SynchronizerId const syncId)
+{
+    if ( ! m_execStateValid || syncId.value >= m_exec.perSync.size() )
+    {
+        return; // not keeping state, or a new sync
+    }
+
+    switch (m_exec.perSync[syncId].state)
+    {
+    case SyncGraphExecutor::ESyncState::Inactive:
+        break;
+    case SyncGraphExecutor::ESyncState::WaitForAlign:
+        m_exec.batch(SetDisable, {syncId}, m_graph);
+        m_pausedSyncs.push_back(syncId);
+        break;
+    default:
+        m_execStateValid = false;
+        break;
+    }
+}
+
+void SinglethreadFWExecutor::forget_sync(SynchronizerId const syncId)
+{
+    pause_sync(syncId);
+
+    if (m_execStateValid)
+    {
+        std::erase(m_pausedSyncs, syncId);
+        m_exec.perSync[syncId] = {};
+        m_wtxSyncOf[syncId]    = {};
+    }
+}
+
+void SinglethreadFWExecutor::forget_subgraph(SubgraphId const subgraphId)
+{
+    for (Subgraph::Point const& point : m_graph.subgraphs[subgraphId].points)
+    {
+        for (SynchronizerId const syncId : point.connectedSyncs)
+        {
+            pause_sync(syncId);
+            m_touchedSyncs.push_back(syncId);
+        }
+    }
+
+    if (m_execStateValid)
+    {
+        m_exec.forget_subgraph(subgraphId);
+    }
+}
+
 void SinglethreadFWExecutor::task_finish(osp::fw::Framework &rFW, osp::TaskId taskId, bool overrideStatus, TaskActions status)
 {
     auto const &first = m_tasksWaiting.begin();
@@ -719,8 +1347,20 @@ void SinglethreadFWExecutor::task_finish(osp::fw::Framework &rFW, osp::TaskId ta
 
 void SinglethreadFWExecutor::wait(osp::fw::Framework& rFW)
 {
+    if (m_argTableGeneration != rFW.m_dataGeneration)
+    {
+        resolve_arguments(rFW);
+    }
+
+    if (m_pProfiler != nullptr)
+    {
+        m_pProfiler->begin_frame();
+    }
+
     while (true)
     {
+        TaskProfiler::Time_t const updateStart = profiler_now();
+
         for (int i = 0; i < 42; ++i)
         {
             LGRN_ASSERTM(i != 41, "Task graph updates not stopping; likely a pipeline is infinite looping.");
@@ -736,6 +1376,16 @@ void SinglethreadFWExecutor::wait(osp::fw::Framework& rFW)
             }
         }
 
+        if (m_pProfiler != nullptr)
+        {
+            m_pProfiler->record({
+                .frame      = m_pProfiler->frame(),
+                .start      = updateStart,
+                .end        = m_pProfiler->now(),
+                .type       = TaskProfiler::EEventType::GraphUpdate
+            });
+        }
+
         if (m_justAligned.empty())
         {
             break;
@@ -746,6 +1396,8 @@ void SinglethreadFWExecutor::wait(osp::fw::Framework& rFW)
             process_aligned_sync(alignedSyncId, rFW);
         }
 
+        join_tasks(rFW);
+
         m_exec.batch(SetDisable, m_disableSyncs, m_graph);
         m_disableSyncs.clear();
 
@@ -847,6 +1499,142 @@ void SinglethreadFWExecutor::finish_schedule_pipeline(PipelineId const pipelineI
 }
 
 
+void SinglethreadFWExecutor::run_task(TaskToRun const& run, osp::fw::Framework& rFW)
+{
+    TaskActions status;
+
+    if (run.taskId.has_value() && rFW.m_taskImpl[run.taskId].func != nullptr)
+    {
+        status = call_task_func(run.taskId, m_argumentRefs, rFW, profiler_now());
+    }
+
+    finish_task(run, status, rFW);
+}
+
+void SinglethreadFWExecutor::finish_task(TaskToRun const& run, TaskActions const status, osp::fw::Framework const& rFW)
+{
+    if (run.externalFinish)
+    {
+        m_tasksWaiting.push_back({
+            .taskId         = run.taskId,
+            .status         = status,
+            .syncId         = run.syncId,
+            .pipeline       = run.pipeline,
+            .loopblk        = run.loopblk
+        });
+    }
+    else
+    {
+        if (run.pipeline.has_value())
+        {
+            finish_schedule_pipeline(run.pipeline, run.taskId, status, false, rFW);
+        }
+        else if (run.loopblk.has_value())
+        {
+            finish_schedule_block(run.loopblk, status, rFW);
+        }
+
+        m_exec.batch(Unlock, {run.syncId}, m_graph);
+    }
+}
+
+void SinglethreadFWExecutor::resolve_arguments(osp::fw::Framework& rFW)
+{
+    m_argTable.clear();
+    m_argTableOffsetOf.clear();
+    m_argTableOffsetOf.resize(rFW.m_taskImpl.size(), smc_noArgTable);
+
+    for (TaskId const taskId : rFW.m_tasks.taskIds)
+    {
+        if (std::size_t(taskId.value) >= rFW.m_taskImpl.size())
+        {
+            continue;
+        }
+
+        fw::TaskImpl const &taskImpl = rFW.m_taskImpl[taskId];
+        if (taskImpl.fastFunc == nullptr)
+        {
+            continue;
+        }
+
+        auto const offset = static_cast<std::uint32_t>(m_argTable.size());
+        bool allResolved = true;
+
+        for (fw::DataId const dataId : taskImpl.args)
+        {
+            void *pData = dataId.has_value() ? rFW.m_data[dataId].data() : nullptr;
+            allResolved &= (pData != nullptr);
+            m_argTable.push_back(pData);
+        }
+
+        if ( ! allResolved )
+        {
+            // Not all data exists yet. Leave this task to the slow path, which asserts the same
+            // way it always did if this is still the case once the task runs.
+            m_argTable.resize(offset);
+            continue;
+        }
+
+        if (taskImpl.checkArgs != nullptr)
+        {
+            std::vector<entt::any> refs;
+            refs.reserve(taskImpl.args.size());
+            for (fw::DataId const dataId : taskImpl.args)
+            {
+                refs.push_back(rFW.m_data[dataId].as_ref());
+            }
+            taskImpl.checkArgs(refs);
+        }
+
+        m_argTableOffsetOf[taskId] = offset;
+    }
+
+    m_argTableGeneration = rFW.m_dataGeneration;
+}
+
+TaskActions SinglethreadFWExecutor::call_task_func(TaskId const taskId, std::vector<entt::any> &rArgumentRefs, osp::fw::Framework& rFW, TaskProfiler::Time_t const aligned) const
+{
+    fw::TaskImpl const &taskImpl = rFW.m_taskImpl[taskId];
+    fw::WorkerContext const ctx{.pPool = m_exec.pPool};
+
+    std::uint32_t const argTableOffset = (std::size_t(taskId.value) < m_argTableOffsetOf.size())
+                                       ? m_argTableOffsetOf[taskId] : smc_noArgTable;
+
+    auto const call = [&] () -> TaskActions
+    {
+        if (argTableOffset != smc_noArgTable)
+        {
+            return taskImpl.fastFunc(ctx, m_argTable.data() + argTableOffset);
+        }
+
+        rArgumentRefs.clear();
+        rArgumentRefs.reserve(taskImpl.args.size());
+        for (fw::DataId const dataId : taskImpl.args)
+        {
+            entt::any data = dataId.has_value() ? rFW.m_data[dataId].as_ref() : entt::any{};
+            LGRN_ASSERTV(data.data() != nullptr, rFW.m_tasks.taskInst[taskId].debugName, taskId.value, dataId.value);
+            rArgumentRefs.push_back(std::move(data));
+        }
+        return taskImpl.func(ctx, rArgumentRefs);
+    };
+
+    if (m_pProfiler == nullptr)
+    {
+        return call();
+    }
+
+    TaskProfiler::Time_t const start  = m_pProfiler->now();
+    TaskActions          const status = call();
+    m_pProfiler->record({
+        .taskId     = taskId,
+        .frame      = m_pProfiler->frame(),
+        .aligned    = (aligned != 0) ? aligned : start,
+        .start      = start,
+        .end        = m_pProfiler->now()
+    });
+    return status;
+}
+
 void SinglethreadFWExecutor::process_aligned_sync(SynchronizerId const alignedSyncId, osp::fw::Framework& rFW)
 {
     RoxSync const &alignedRoxSync = m_roxSyncOf[alignedSyncId];
@@ -916,54 +1704,19 @@ void SinglethreadFWExecutor::process_aligned_sync(SynchronizerId const alignedSy
 
         auto const taskId = TaskId{runTaskRoxSync.taskId};
 
-        bool externalFinish = false;
-
-        TaskActions status;
+        bool const externalFinish = taskId.has_value() && rFW.m_taskImpl[taskId].externalFinish;
 
-        if (taskId.has_value())
-        {
-            fw::TaskImpl const &taskImpl = rFW.m_taskImpl[taskId];
-
-            externalFinish = taskImpl.externalFinish;
-
-            if (taskImpl.func != nullptr)
-            {
-                m_argumentRefs.clear();
-                m_argumentRefs.reserve(taskImpl.args.size());
-                for (fw::DataId const dataId : taskImpl.args)
-                {
-                    entt::any data = dataId.has_value() ? rFW.m_data[dataId].as_ref() : entt::any{};
-                    LGRN_ASSERTV(data.data() != nullptr, rFW.m_tasks.taskInst[taskId].debugName, taskId.value, dataId.value);
-                    m_argumentRefs.push_back(std::move(data));
-                }
+        bool const schedulesPipeline = externalFinish
+                                     ? isPlSchedule
+                                     : (isPlSchedule || alignedRoxSync.tag == ESyncType::PlScheduleExt);
 
-                status = taskImpl.func(fw::WorkerContext{}, m_argumentRefs);
-            }
-        }
-
-        if (externalFinish)
-        {
-            m_tasksWaiting.push_back({
-                .taskId         = taskId,
-                .status         = status,
-                .syncId         = runTaskSync,
-                .pipeline       = isPlSchedule  ? PipelineId{runTaskRoxSync.pipelineId} : PipelineId{},
-                .loopblk        = isBlkSchedule ? LoopBlockId{runTaskRoxSync.loopBlk}   : LoopBlockId{}
-            });
-        }
-        else
-        {
-            if (isPlSchedule || alignedRoxSync.tag == ESyncType::PlScheduleExt)
-            {
-                finish_schedule_pipeline(PipelineId{runTaskRoxSync.pipelineId}, taskId,  status, false, rFW);
-            }
-            else if (isBlkSchedule)
-            {
-                finish_schedule_block(LoopBlockId{runTaskRoxSync.loopBlk}, status, rFW);
-            }
-
-            m_exec.batch(Unlock, {runTaskSync}, m_graph);
-        }
+        run_task({
+            .taskId         = taskId,
+            .syncId         = runTaskSync,
+            .pipeline       = schedulesPipeline ? PipelineId{runTaskRoxSync.pipelineId} : PipelineId{},
+            .loopblk        = isBlkSchedule     ? LoopBlockId{runTaskRoxSync.loopBlk}   : LoopBlockId{},
+            .externalFinish = externalFinish
+        }, rFW);
 
         return;
     }
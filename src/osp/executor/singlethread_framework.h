@@ -26,6 +26,7 @@
 
 #include "sync_graph.h"
 #include "singlethread_sync_graph.h"
+#include "task_profiler.h"
 
 #include <osp/framework/framework.h>
 #include <osp/core/keyed_vector.h>
@@ -36,7 +37,7 @@
 namespace osp::exec
 {
 
-class SinglethreadFWExecutor final : public osp::fw::IExecutor
+class SinglethreadFWExecutor : public osp::fw::IExecutor
 {
     using MaybeCancelId = osp::StrongId<std::uint32_t, struct DummyForMaybeCancelId>;
     using enum SyncGraphExecutor::ESyncAction;
@@ -68,6 +69,8 @@ class SinglethreadFWExecutor final : public osp::fw::IExecutor
         SynchronizerId      checkstop;
         SynchronizerId      left;
         SynchronizerId      right;
+
+        LoopBlockId         parent;
     };
     struct WtxLoopblk
     {
@@ -85,6 +88,9 @@ class SinglethreadFWExecutor final : public osp::fw::IExecutor
         SynchronizerId          schedule;
         StageId                 initialStage;
         unsigned int            syncCount{0};
+
+        /// Copy of Pipeline::block, still available after the pipeline is removed from Tasks
+        LoopBlockId             block;
     };
     struct WtxPipeline
     {
@@ -99,6 +105,9 @@ class SinglethreadFWExecutor final : public osp::fw::IExecutor
         SynchronizerId      sustainer;
         SynchronizerId      external;
 
+        /// Pipeline of each of this task's TaskSyncToPipeline, in case it needs to be removed
+        std::vector<PipelineId> syncedTo;
+
         bool const is_spanning_nested_loopblocks() const { return sustainer.has_value(); }
     };
     struct WtxTask
@@ -140,6 +149,13 @@ class SinglethreadFWExecutor final : public osp::fw::IExecutor
         std::uint32_t loopBlk;
     };
 
+    /// Loop blocks and pipelines of a FeatureInterface instance that were loaded
+    struct LoadedFIInstance
+    {
+        std::vector<LoopBlockId>    loopblks;
+        std::vector<PipelineId>     pipelines;
+    };
+
     struct TaskWaitingForExternal
     {
         SynchronizerId  syncId;
@@ -156,6 +172,16 @@ class SinglethreadFWExecutor final : public osp::fw::IExecutor
 
 public:
 
+    /**
+     * @brief Load or reload the Framework's tasks, and start new top-level loop blocks
+     *
+     * After the first load, only the loop blocks, pipelines, and tasks of feature sessions and
+     * feature interfaces that were added or removed since (eg. contexts added through
+     * ContextBuilder or closed with Framework::close_context) are added to or removed from the
+     * sync graph, and everything else keeps its execution state. Everything is rebuilt and all
+     * top-level loop blocks are restarted if that's not possible. Must only be called when no
+     * loop blocks are running.
+     */
     void load(osp::fw::Framework& rFW) override;
 
     void task_finish(osp::fw::Framework &rFW, osp::TaskId taskId, bool overrideStatus = false, TaskActions status = {}) override;
@@ -166,6 +192,75 @@ public:
 
     std::shared_ptr<spdlog::logger> m_log;
 
+    /// Optional. Records task timings if set
+    TaskProfiler                    *m_pProfiler{nullptr};
+
+    struct LoadStats
+    {
+        std::size_t everything  {0}; ///< Rebuilt the sync graph from scratch
+        std::size_t incremental {0}; ///< Only added and removed what changed in the sync graph
+        std::size_t keptState   {0}; ///< Incremental, and kept the execution state of what stayed
+    };
+
+    /// Number of times load() took each path
+    LoadStats                       m_loadStats;
+
+protected:
+
+    /**
+     * @brief A task (or schedule) that aligned and is ready to run
+     *
+     * Contains what's needed to finish it afterwards, so running and finishing can be split apart.
+     */
+    struct TaskToRun
+    {
+        TaskId          taskId;
+        SynchronizerId  syncId;
+        PipelineId      pipeline;   ///< Pipeline to schedule on finish, if this is a pipeline schedule task
+        LoopBlockId     loopblk;    ///< LoopBlock to schedule on finish, if this is a loopblock schedule task
+        bool            externalFinish{false};
+    };
+
+    /**
+     * @brief Run a task's function and finish it
+     *
+     * Called from within wait(). Overridable to run tasks elsewhere, in which case finish_task
+     * must be called from join_tasks.
+     */
+    virtual void run_task(TaskToRun const& run, osp::fw::Framework& rFW);
+
+    /**
+     * @brief Wait for and finish all tasks that run_task didn't finish immediately
+     *
+     * Called from within wait() after all syncs aligned by the same graph update are processed.
+     */
+    virtual void join_tasks(osp::fw::Framework&) { }
+
+    /**
+     * @brief Apply a task's returned status and unlock its sync, or leave it for task_finish if
+     *        the task has externalFinish set
+     */
+    void finish_task(TaskToRun const& run, TaskActions status, osp::fw::Framework const& rFW);
+
+    /**
+     * @brief Call a task's function with its arguments. Safe to call from any thread.
+     *
+     * @param rArgumentRefs [ref] Scratch space for argument references
+     * @param aligned       [in] Time the task became ready to run, for m_pProfiler
+     */
+    TaskActions call_task_func(TaskId taskId, std::vector<entt::any> &rArgumentRefs, osp::fw::Framework& rFW, TaskProfiler::Time_t aligned = 0) const;
+
+    [[nodiscard]] TaskProfiler::Time_t profiler_now() const noexcept
+    {
+        return (m_pProfiler != nullptr) ? m_pProfiler->now() : 0;
+    }
+
+    /**
+     * @brief Let the SyncGraphExecutor advance big graphs in parallel, and pass the pool to tasks
+     *        through WorkerContext::pPool
+     */
+    void set_worker_pool(WorkerPool *pPool) noexcept { m_exec.pPool = pPool; }
+
 private:
 
     void resize_fit_syncs();
@@ -178,12 +273,129 @@ private:
 
     void process_aligned_sync(SynchronizerId alignedSyncId, osp::fw::Framework& rFW);
 
+    /**
+     * @brief Clear the sync graph and build it again from every task in the Framework
+     */
+    void load_everything(osp::fw::Framework& rFW);
+
+    /**
+     * @brief Only add and remove what changed in the Framework since the last load
+     *
+     * @return false if this isn't possible, and nothing was modified
+     */
+    bool load_incremental(osp::fw::Framework& rFW);
+
+    /**
+     * @brief Add loop blocks, pipelines, and tasks that aren't part of the sync graph yet
+     *
+     * @param newSyncs [in] TaskSyncToPipeline of the added tasks
+     */
+    void add_to_graph(osp::fw::Framework const&                 rFW,
+                      ArrayView<LoopBlockId const>              loopblks,
+                      ArrayView<PipelineId const>               pipelines,
+                      ArrayView<TaskId const>                   tasks,
+                      ArrayView<TaskSyncToPipeline const>       newSyncs);
+
+    /**
+     * @brief Remove loop blocks, pipelines, and tasks from the sync graph
+     *
+     * Only reads data stored by the executor, as the Framework likely already removed these.
+     */
+    void remove_from_graph(ArrayView<LoopBlockId const>         loopblks,
+                           ArrayView<PipelineId const>          pipelines,
+                           ArrayView<TaskId const>              tasks);
+
+    /**
+     * @brief Remember which feature sessions and feature interfaces are loaded
+     *
+     * @return false if some tasks, pipelines, or loop blocks aren't owned by any of them
+     */
+    bool track_loaded(osp::fw::Framework const& rFW);
+
+    /**
+     * @brief Reset all sync graph execution state and enable top-level loop blocks
+     */
+    void restart(osp::fw::Framework& rFW);
+
+    void enable_top_level_loopblk(LoopBlockId loopblkId);
+
+    /**
+     * @brief Disable a sync that is about to have its connections changed, and enable it again
+     *        once load_incremental is done
+     *
+     * Only does anything if execution state is being kept. Gives up on keeping it if the sync is
+     * locked or advancing, as it can't be disabled without losing where it was.
+     */
+    void pause_sync(SynchronizerId syncId);
+
+    /**
+     * @brief Disable and clear the execution state of a sync about to be removed from the graph
+     */
+    void forget_sync(SynchronizerId syncId);
+
+    /**
+     * @brief Pause all syncs connected to a subgraph about to be removed from the graph, and clear
+     *        its execution state
+     */
+    void forget_subgraph(SubgraphId subgraphId);
+
+    /**
+     * @brief SyncGraph::connect, but also remember what to sort afterwards
+     */
+    void connect(SyncGraph::ConnectArgs connect)
+    {
+        pause_sync(connect.sync);
+        m_graph.connect(connect);
+        m_touchedSyncs    .push_back(connect.sync);
+        m_touchedSubgraphs.push_back(connect.subgraphPoint.subgraph);
+    }
+
+    /**
+     * @brief Resolve every task's TaskImpl::args into pointers in m_argTable
+     *
+     * Called by load(), and by wait() if Framework::m_dataGeneration changed since.
+     */
+    void resolve_arguments(osp::fw::Framework& rFW);
+
+    /// m_argTableOffsetOf value for tasks that must use TaskImpl::func instead of fastFunc
+    static constexpr std::uint32_t smc_noArgTable = 0xFFFFFFFF;
+
     SyncGraph                               m_graph;
     KeyedVec<LoopBlockId, RoxLoopblk>       m_roxLoopblkOf;
     KeyedVec<PipelineId, RoxPipeline>       m_roxPipelineOf;
     KeyedVec<TaskId, RoxTask>               m_roxTaskOf;
     KeyedVec<SynchronizerId, RoxSync>       m_roxSyncOf;
 
+    KeyedVec<PipelineTypeId, RoxPltype>     m_roxPltypeOf;
+    SubgraphTypeId                          m_sgtBlkCtrl;
+    SubgraphTypeId                          m_sgtSingleStat;
+
+    // What was loaded, to know what changed on the next load()
+    KeyedVec<fw::FSessionId, std::vector<TaskId>>           m_loadedTasksOf;
+    lgrn::IdSetStl<fw::FSessionId>                          m_loadedSessions;
+    KeyedVec<fw::FIInstanceId, LoadedFIInstance>            m_loadedFIInstOf;
+    lgrn::IdSetStl<fw::FIInstanceId>                        m_loadedFIInsts;
+    struct LoadedCounts
+    {
+        std::size_t tasks{0};
+        std::size_t pipelines{0};
+        std::size_t loopblks{0};
+        std::size_t syncs{0};
+    };
+    LoadedCounts                            m_loadedCounts;
+    bool                                    m_canLoadIncremental{false};
+
+    // Syncs and subgraphs that were added or had their connections changed by the current load
+    std::vector<SynchronizerId>             m_touchedSyncs;
+    std::vector<SubgraphId>                 m_touchedSubgraphs;
+
+    /// Set once restart() sets up m_exec and Wtx state to match m_graph, so load_incremental can
+    /// keep it. Cleared if there's something that can't be kept.
+    bool                                    m_execStateValid{false};
+
+    /// Syncs disabled by pause_sync, to enable again at the end of load_incremental
+    std::vector<SynchronizerId>             m_pausedSyncs;
+
     SyncGraphExecutor                       m_exec;
     std::vector<SynchronizerId>             m_justAligned;
     std::vector<SynchronizerId>             m_disableSyncs;
@@ -191,6 +403,11 @@ private:
     std::vector<TaskWaitingToFinish>        m_tasksWaiting;
 
     std::vector<entt::any>                  m_argumentRefs;
+
+    /// Data pointers of each task's arguments laid out contiguously, for TaskImpl::fastFunc
+    std::vector<void*>                      m_argTable;
+    KeyedVec<TaskId, std::uint32_t>         m_argTableOffsetOf;
+    std::uint64_t                           m_argTableGeneration{0};
     KeyedVec<LoopBlockId, WtxLoopblk>       m_wtxLoopblkOf;
     KeyedVec<PipelineId, WtxPipeline>       m_wtxPipelineOf;
     KeyedVec<TaskId, WtxTask>               m_wtxTaskOf;
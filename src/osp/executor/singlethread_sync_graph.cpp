@@ -23,6 +23,9 @@
  * SOFTWARE.
  */
 #include "singlethread_sync_graph.h"
+#include "worker_pool.h"
+
+#include <algorithm>
 
 #include <filesystem>
 #include <fstream>
@@ -107,39 +110,95 @@ private:
 };
 
 
+/**
+ * @return Index of the first connected point of subgraphId in sync.connectedPoints, which
+ *         SyncGraph::connect keeps sorted
+ */
+static std::size_t first_connection(Synchronizer const& sync, SubgraphId const subgraphId) noexcept
+{
+    auto const &first = sync.connectedPoints.begin();
+    auto const &last  = sync.connectedPoints.end();
+    auto const found  = std::lower_bound(first, last, subgraphId,
+            [] (SubgraphPointAddr const& addr, SubgraphId const id) { return addr.subgraph < id; });
+    LGRN_ASSERT(found != last && found->subgraph == subgraphId);
+    return std::size_t(std::distance(first, found));
+}
+
 void SyncGraphExecutor::load(SyncGraph const& graph) noexcept
 {
     auto const subgraphCapacity = graph.subgraphIds.capacity();
     perSubgraph     .resize(subgraphCapacity);
+    subgraphsMoving .clear();
+    justMoved       .clear();
     subgraphsMoving .resize(subgraphCapacity);
     justMoved       .resize(subgraphCapacity);
+    subgraphsMovingList.clear();
+    justMovedList   .clear();
 
     auto const syncCapacity = graph.syncIds.capacity();
     perSync         .resize(syncCapacity);
 
     for (SynchronizerId const syncId : graph.syncIds)
     {
-        perSync[syncId].needToAdvance.resize(syncCapacity);
+        PerSync &rExecSync = perSync[syncId];
+        rExecSync.needToAdvance.assign(graph.syncs[syncId].connectedPoints.size(), false);
+        rExecSync.needToAdvanceCount = 0;
     }
 
     for(SubgraphId const subgraphId : graph.subgraphIds)
     {
-        Subgraph      const &rSubgraph     = graph.subgraphs[subgraphId];
-        PerSubgraph         &rExecSubgraph = perSubgraph[subgraphId];
-        SubgraphType  const &sgtype        = graph.sgtypes[rSubgraph.instanceOf];
+        start_subgraph(subgraphId, graph);
+    }
+
+    startTime = std::chrono::high_resolution_clock::now();
+
+    SyncGraphExecutorDebugger::instance().write_new(*this, graph);
+}
 
-        rExecSubgraph.activeCycle = sgtype.initialCycle;
-        rExecSubgraph.position    = sgtype.initialPos;
-        rExecSubgraph.point       = sgtype.cycles[sgtype.initialCycle].path[sgtype.initialPos];
+void SyncGraphExecutor::load_changes(
+        osp::ArrayView<SubgraphId const>        touchedSubgraphs,
+        osp::ArrayView<SynchronizerId const>    touchedSyncs,
+        SyncGraph const&                        graph) noexcept
+{
+    auto const subgraphCapacity = graph.subgraphIds.capacity();
+    perSubgraph     .resize(subgraphCapacity);
+    subgraphsMoving .resize(subgraphCapacity);
+    justMoved       .resize(subgraphCapacity);
+    perSync         .resize(graph.syncIds.capacity());
 
-        justMoved.insert(subgraphId);
+    for (SynchronizerId const syncId : touchedSyncs)
+    {
+        PerSync &rExecSync = perSync[syncId];
+        LGRN_ASSERT(rExecSync.state == ESyncState::Inactive);
+        rExecSync.needToAdvance.assign(graph.syncs[syncId].connectedPoints.size(), false);
+        rExecSync.needToAdvanceCount = 0;
     }
 
-    startTime = std::chrono::high_resolution_clock::now();
+    for (SubgraphId const subgraphId : touchedSubgraphs)
+    {
+        // Subgraphs that are new, or reuse the ID of a forgotten subgraph, don't have a point yet
+        if ( ! perSubgraph[subgraphId].point.has_value() )
+        {
+            start_subgraph(subgraphId, graph);
+        }
+    }
 
     SyncGraphExecutorDebugger::instance().write_new(*this, graph);
 }
 
+void SyncGraphExecutor::start_subgraph(SubgraphId const subgraphId, SyncGraph const& graph) noexcept
+{
+    Subgraph      const &rSubgraph     = graph.subgraphs[subgraphId];
+    PerSubgraph         &rExecSubgraph = perSubgraph[subgraphId];
+    SubgraphType  const &sgtype        = graph.sgtypes[rSubgraph.instanceOf];
+
+    rExecSubgraph.activeCycle = sgtype.initialCycle;
+    rExecSubgraph.position    = sgtype.initialPos;
+    rExecSubgraph.point       = sgtype.cycles[sgtype.initialCycle].path[sgtype.initialPos];
+
+    add_just_moved(subgraphId);
+}
+
 bool SyncGraphExecutor::update(std::vector<SynchronizerId> &rJustAlignedOut, SyncGraph const& graph) noexcept
 {
     bool somethingHappened = false;
@@ -149,8 +208,17 @@ bool SyncGraphExecutor::update(std::vector<SynchronizerId> &rJustAlignedOut, Syn
     rJustAlignedOut.insert(rJustAlignedOut.end(), alignedDuringEnable.begin(), alignedDuringEnable.end());
     alignedDuringEnable.clear();
 
-    for (SubgraphId const subgraphId : justMoved)
+    // Visit in ID order so rJustAlignedOut is deterministic regardless of insertion order
+    std::sort(justMovedList.begin(), justMovedList.end());
+
+    for (SubgraphId const subgraphId : justMovedList)
     {
+        if ( ! justMoved.contains(subgraphId) )
+        {
+            continue; // stale or duplicate entry
+        }
+        justMoved.erase(subgraphId);
+
         Subgraph      const &rSubgraph     = graph.subgraphs[subgraphId];
         PerSubgraph   const &rExecSubgraph = perSubgraph[subgraphId];
         SubgraphType  const &sgtype        = graph.sgtypes[rSubgraph.instanceOf];
@@ -173,71 +241,145 @@ bool SyncGraphExecutor::update(std::vector<SynchronizerId> &rJustAlignedOut, Syn
             }
         }
     }
-    justMoved.clear();
+    justMovedList.clear();
 
-    // Eliminate invalid subgraphs from tryToAdvance
-    for (SubgraphId const subgraphId : subgraphsMoving)
+    // Take moving subgraphs out of the worklist, dropping stale and duplicate entries
+    scratchUpdating.clear();
+    for (SubgraphId const subgraphId : subgraphsMovingList)
     {
+        if (subgraphsMoving.contains(subgraphId))
+        {
+            subgraphsMoving.erase(subgraphId);
+            scratchUpdating.push_back(subgraphId);
+        }
+    }
+    subgraphsMovingList.clear();
+
+    std::size_t const updatingCount = scratchUpdating.size();
+    scratchFromPoint.resize(updatingCount);
+    scratchMoved    .resize(updatingCount);
+
+    // Moving subgraphs only read syncs and write to themselves, so they can be advanced in parallel
+    std::size_t const batchSize = std::max<std::size_t>(parallelBatchSize, 1u);
+    if (pPool != nullptr && updatingCount >= 2u * batchSize)
+    {
+        struct Range
+        {
+            SyncGraphExecutor   &rExec;
+            SyncGraph const     &graph;
+            std::size_t         batchSize;
+            std::size_t         count;
+        };
+        Range range{*this, graph, batchSize, updatingCount};
+
+        auto const jobCount = std::uint32_t((updatingCount + batchSize - 1u) / batchSize);
+
+        pPool->parallel_for(jobCount, [] (void *pRange, std::uint32_t const index) noexcept
+        {
+            Range const &rRange = *static_cast<Range*>(pRange);
+            std::size_t const first = index * rRange.batchSize;
+            std::size_t const last  = std::min(first + rRange.batchSize, rRange.count);
+            rRange.rExec.advance_subgraphs(first, last, rRange.graph);
+        }, &range);
+    }
+    else
+    {
+        advance_subgraphs(0u, updatingCount, graph);
+    }
+
+    // Serially update syncs that were waiting for the moved subgraphs
+    for (std::size_t i = 0; i < updatingCount; ++i)
+    {
+        SubgraphId const subgraphId = scratchUpdating[i];
+
+        if ( ! scratchMoved[i] )
+        {
+            continue; // stays where it is. not moving anymore
+        }
+
+        subgraphsMoving.insert(subgraphId);
+        subgraphsMovingList.push_back(subgraphId);
+
+        // subgraph moved to the next point. clear self from 'needToAdvance' from all connected points
+        for (SynchronizerId const syncId : graph.subgraphs[subgraphId].points[scratchFromPoint[i]].connectedSyncs)
+        {
+            PerSync &rExecSync = perSync[syncId];
+
+            if (rExecSync.state == ESyncState::WaitForAdvance)
+            {
+                std::size_t const connection = first_connection(graph.syncs[syncId], subgraphId);
+                if (rExecSync.needToAdvance[connection])
+                {
+                    rExecSync.needToAdvance[connection] = false;
+                    --rExecSync.needToAdvanceCount;
+                }
+
+                if (rExecSync.needToAdvanceCount == 0)
+                {
+                    // done advancing all connected subgraphs
+                    rExecSync.state = ESyncState::WaitForAlign;
+                }
+            }
+        }
+
+        add_just_moved(subgraphId);
+    }
+
+    somethingHappened |= ! subgraphsMovingList.empty();
+
+    if (somethingHappened)
+    {
+        SyncGraphExecutorDebugger::instance().write_update(*this, graph);
+    }
+
+    return somethingHappened;
+}
+
+void SyncGraphExecutor::advance_subgraphs(std::size_t const first, std::size_t const last, SyncGraph const& graph) noexcept
+{
+    for (std::size_t i = first; i < last; ++i)
+    {
+        SubgraphId    const subgraphId     = scratchUpdating[i];
         Subgraph      const &rSubgraph     = graph.subgraphs[subgraphId];
-        PerSubgraph   const &rExecSubgraph = perSubgraph[subgraphId];
+        PerSubgraph         &rExecSubgraph = perSubgraph[subgraphId];
 
         LGRN_ASSERTMV(rExecSubgraph.activeSyncs != 0, "all syncs disabled, sync should have already been removed from subgraphsMoving in batch(SetDisable, ...)", subgraphId.value);
 
         SubgraphType  const &sgtype        = graph.sgtypes[rSubgraph.instanceOf];
         LocalPointId  const point          = sgtype.cycles[rExecSubgraph.activeCycle].path[rExecSubgraph.position];
 
+        bool stay = false;
         for (SynchronizerId const syncId : rSubgraph.points[point].connectedSyncs)
         {
-            Synchronizer const &rSync     = graph.syncs[syncId];
-            PerSync      const &rExecSync = perSync[syncId];
+            PerSync const &rExecSync = perSync[syncId];
 
             if (rExecSync.state == ESyncState::WaitForAlign)
             {
                 // Sync is aligned with the current point, and wants this subgraph to stay at
                 // its current position and wait for other subgraphs to align
-                subgraphsMoving.erase(subgraphId);
+                stay = true;
             }
             else if (rExecSync.state == ESyncState::WaitForUnlock)
             {
                 // Sync is locked (task in progress). don't move!
-                subgraphsMoving.erase(subgraphId);
+                stay = true;
             }
             else if (     rExecSync.state == ESyncState::WaitForAdvance
-                     && ! rExecSync.needToAdvance.contains(subgraphId))
+                     && ! rExecSync.needToAdvance[first_connection(graph.syncs[syncId], subgraphId)])
             {
                 // only happens when a cycle has only 1 state to loop through
-                subgraphsMoving.erase(subgraphId);
+                stay = true;
             }
         }
-    }
 
-    // Advance subgraphs to next point
-    for (SubgraphId const subgraphId : subgraphsMoving)
-    {
-        Subgraph      const &rSubgraph     = graph.subgraphs[subgraphId];
-        SubgraphType  const &sgtype        = graph.sgtypes[rSubgraph.instanceOf];
-        PerSubgraph         &rExecSubgraph = perSubgraph[subgraphId];
-        LocalPointId  const point          = sgtype.cycles[rExecSubgraph.activeCycle].path[rExecSubgraph.position];
+        scratchFromPoint[i] = point;
+        scratchMoved[i]     = stay ? 0u : 1u;
 
-        // subgraph is moving to the next point. clear self from 'needToAdvance' from all connected points
-        for (SynchronizerId const syncId : graph.subgraphs[subgraphId].points[point].connectedSyncs)
+        if (stay)
         {
-            PerSync &rExecSync = perSync[syncId];
-
-            if (rExecSync.state == ESyncState::WaitForAdvance)
-            {
-                rExecSync.needToAdvance.erase(subgraphId);
-
-                if (rExecSync.needToAdvance.empty())
-                {
-                    // done advancing all connected subgraphs
-                    rExecSync.state = ESyncState::WaitForAlign;
-                }
-            }
+            continue;
         }
 
-        justMoved.insert(subgraphId);
-
         if (rExecSubgraph.jumpNextCycle.has_value())
         {
             // Advance to next point based on rExecSubgraph.jumpNext*
@@ -261,15 +403,6 @@ bool SyncGraphExecutor::update(std::vector<SynchronizerId> &rJustAlignedOut, Syn
             rExecSubgraph.point = cycle.path[rExecSubgraph.position];
         }
     }
-
-    somethingHappened |= !subgraphsMoving.empty();
-
-    if (somethingHappened)
-    {
-        SyncGraphExecutorDebugger::instance().write_update(*this, graph);
-    }
-
-    return somethingHappened;
 }
 
 void SyncGraphExecutor::batch(ESyncAction const action, osp::ArrayView<SynchronizerId const> const syncs, SyncGraph const& graph)
@@ -291,7 +424,7 @@ void SyncGraphExecutor::batch(ESyncAction const action, osp::ArrayView<Synchroni
                     PerSubgraph &rExecSubgraph = perSubgraph[addr.subgraph];
                     if (rExecSubgraph.activeSyncs == 0)
                     {
-                        subgraphsMoving.insert(addr.subgraph);
+                        add_moving(addr.subgraph);
                     }
                     ++rExecSubgraph.activeSyncs;
 
@@ -311,7 +444,8 @@ void SyncGraphExecutor::batch(ESyncAction const action, osp::ArrayView<Synchroni
             rExecSync.pointsNotAligned = 0;
             if (rExecSync.state == ESyncState::WaitForAdvance)
             {
-                rExecSync.needToAdvance.clear();
+                std::fill(rExecSync.needToAdvance.begin(), rExecSync.needToAdvance.end(), false);
+                rExecSync.needToAdvanceCount = 0;
             }
             if (rExecSync.state != ESyncState::Inactive)
             {
@@ -327,7 +461,7 @@ void SyncGraphExecutor::batch(ESyncAction const action, osp::ArrayView<Synchroni
                     }
                     else
                     {
-                        subgraphsMoving.insert(addr.subgraph);
+                        add_moving(addr.subgraph);
                     }
                 }
             }
@@ -339,8 +473,13 @@ void SyncGraphExecutor::batch(ESyncAction const action, osp::ArrayView<Synchroni
 
             for (SubgraphPointAddr const addr : graph.syncs[syncId].connectedPoints)
             {
-                rExecSync.needToAdvance.insert(addr.subgraph);
-                subgraphsMoving.insert(addr.subgraph);
+                std::size_t const connection = first_connection(rSync, addr.subgraph);
+                if ( ! rExecSync.needToAdvance[connection] )
+                {
+                    rExecSync.needToAdvance[connection] = true;
+                    ++rExecSync.needToAdvanceCount;
+                }
+                add_moving(addr.subgraph);
             }
             break;
         }
@@ -29,10 +29,13 @@
 #include <longeron/id_management/id_set_stl.hpp>
 
 #include <chrono>
+#include <vector>
 
 namespace osp::exec
 {
 
+class WorkerPool;
+
 
 class SyncGraphExecutor
 {
@@ -53,13 +56,41 @@ public:
     };
     struct PerSync
     {
-        lgrn::IdSetStl<SubgraphId>  needToAdvance;
+        /// Parallel to Synchronizer::connectedPoints. Set for the first point of each connected
+        /// subgraph that still needs to advance after an Unlock.
+        std::vector<bool>           needToAdvance;
+        int                         needToAdvanceCount{0};
         ESyncState                  state           {ESyncState::Inactive};
         int                         pointsNotAligned{0};
     };
 
     void load(SyncGraph const& graph) noexcept;
 
+    /**
+     * @brief Fit to subgraphs and syncs that were added or changed since load(), keeping the state
+     *        of everything else
+     *
+     * @param touchedSubgraphs  [in] Subgraphs that were added or had syncs connected to them.
+     *                               New ones start at their initial point, the rest stay put.
+     * @param touchedSyncs      [in] Syncs that were added or had their connections changed.
+     *                               These must be inactive.
+     */
+    void load_changes(osp::ArrayView<SubgraphId const>       touchedSubgraphs,
+                      osp::ArrayView<SynchronizerId const>   touchedSyncs,
+                      SyncGraph const&                       graph) noexcept;
+
+    /**
+     * @brief Clear the state of a subgraph about to be removed from the graph
+     *
+     * All syncs connected to it must be inactive. Its ID may be reused by a new subgraph.
+     */
+    void forget_subgraph(SubgraphId const subgraphId) noexcept
+    {
+        perSubgraph[subgraphId] = {};
+        subgraphsMoving.erase(subgraphId);
+        justMoved      .erase(subgraphId);
+    }
+
     bool update(std::vector<SynchronizerId> &rJustAlignedOut, SyncGraph const& graph) noexcept;
 
     void batch(ESyncAction const action, osp::ArrayView<SynchronizerId const> const syncs, SyncGraph const& graph);
@@ -85,14 +116,65 @@ public:
         return perSync[syncId].state == ESyncState::WaitForUnlock;
     }
 
+    /**
+     * @brief Mark a subgraph as wanting to move on the next update
+     */
+    void add_moving(SubgraphId const subgraphId)
+    {
+        if ( ! subgraphsMoving.contains(subgraphId) )
+        {
+            subgraphsMoving.insert(subgraphId);
+            subgraphsMovingList.push_back(subgraphId);
+        }
+    }
+
+    /**
+     * @brief Mark a subgraph as just moved to a new point, checked for alignment on the next update
+     */
+    void add_just_moved(SubgraphId const subgraphId)
+    {
+        if ( ! justMoved.contains(subgraphId) )
+        {
+            justMoved.insert(subgraphId);
+            justMovedList.push_back(subgraphId);
+        }
+    }
+
+    // Sets are for fast lookups, lists are worklists so update() only visits subgraphs that
+    // actually changed. Lists may contain stale entries that were since erased from the sets.
     lgrn::IdSetStl<SubgraphId>              subgraphsMoving;
     lgrn::IdSetStl<SubgraphId>              justMoved;
+    std::vector<SubgraphId>                 subgraphsMovingList;
+    std::vector<SubgraphId>                 justMovedList;
 
     osp::KeyedVec<SubgraphId, PerSubgraph>  perSubgraph;
     osp::KeyedVec<SynchronizerId, PerSync>  perSync;
 
     std::vector<SynchronizerId>             alignedDuringEnable;
 
+    /// Optional. If set, large numbers of moving subgraphs are advanced in parallel
+    WorkerPool                              *pPool{nullptr};
+
+    /// Minimum number of moving subgraphs per parallel job
+    std::size_t                             parallelBatchSize{512};
+
+    /**
+     * @brief Advance scratchUpdating[first, last) to their next points, or mark them as staying
+     *
+     * Only reads perSync, so separate ranges can run on different threads.
+     */
+    void advance_subgraphs(std::size_t first, std::size_t last, SyncGraph const& graph) noexcept;
+
+    /**
+     * @brief Put a subgraph at the initial point of its type, and check it for alignment
+     */
+    void start_subgraph(SubgraphId subgraphId, SyncGraph const& graph) noexcept;
+
+    // Scratch space for update()
+    std::vector<SubgraphId>                 scratchUpdating;
+    std::vector<LocalPointId>               scratchFromPoint;
+    std::vector<std::uint8_t>               scratchMoved;
+
     std::chrono::time_point<std::chrono::high_resolution_clock> startTime;
 };
 
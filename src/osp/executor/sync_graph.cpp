@@ -24,17 +24,56 @@
  */
 #include "sync_graph.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
 namespace osp::exec
 {
+
+void SyncGraph::remove_sync(SynchronizerId const syncId)
+{
+    Synchronizer &rSync = syncs[syncId];
+    for (SubgraphPointAddr const addr : rSync.connectedPoints)
+    {
+        std::vector<SynchronizerId> &rConnected = subgraphs[addr.subgraph].points[addr.point].connectedSyncs;
+        rConnected.erase(std::remove(rConnected.begin(), rConnected.end(), syncId), rConnected.end());
+    }
+    rSync = {};
+    syncIds.remove(syncId);
+}
+
+void SyncGraph::remove_subgraph(SubgraphId const subgraphId)
+{
+    Subgraph &rSubgraph = subgraphs[subgraphId];
+    for (std::size_t i = 0; i < rSubgraph.points.size(); ++i)
+    {
+        LocalPointId const pointId = LocalPointId::from_index(i);
+        for (SynchronizerId const syncId : rSubgraph.points[pointId].connectedSyncs)
+        {
+            std::vector<SubgraphPointAddr> &rConnected = syncs[syncId].connectedPoints;
+            rConnected.erase(std::remove(rConnected.begin(), rConnected.end(), SubgraphPointAddr{subgraphId, pointId}),
+                             rConnected.end());
+        }
+    }
+    rSubgraph = {};
+    subgraphIds.remove(subgraphId);
+}
+
 void SyncGraph::debug_verify() const
 {
     bool nothingWentWrong = true;
     for (SynchronizerId const syncId : syncIds)
     {
-        for (SubgraphPointAddr const& addr : syncs.at(syncId).connectedPoints)
+        std::vector<SubgraphPointAddr> const &connectedPoints = syncs.at(syncId).connectedPoints;
+        if ( ! std::is_sorted(connectedPoints.begin(), connectedPoints.end()) )
+        {
+            nothingWentWrong = false;
+            std::cerr << "Graph::debug_verify: Connected points not sorted: "
+                      << "(" << syncId.value << "): " << syncs.at(syncId).debugName << "\n";
+        }
+
+        for (SubgraphPointAddr const& addr : connectedPoints)
         {
             auto const& connectedSyncs = subgraphs.at(addr.subgraph).points.at(addr.point).connectedSyncs;
             if (std::find(connectedSyncs.begin(), connectedSyncs.end(), syncId) == connectedSyncs.end())
@@ -30,6 +30,7 @@
 
 #include <longeron/id_management/registry_stl.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <vector>
 
@@ -94,6 +95,7 @@ struct Synchronizer
     bool debugGraphLoose = false;
     bool debugGraphLongAndUgly = false;
 
+    /// Sorted by subgraph then point, see SyncGraph::connect
     std::vector<SubgraphPointAddr> connectedPoints;
 };
 
@@ -103,6 +105,7 @@ struct Synchronizer
  * * Two-way connection between a synchronizer and connected points:
  *   * syncs[SYNC].connectedPoints                       must contain Addr(SUBGRAPH, POINT)
  *   * subgraphs[SUBGRAPH].points[POINT].connectedSyncs  must contain SYNC
+ * * syncs[SYNC].connectedPoints is sorted, so executors can binary search for a subgraph's points
  *
  */
 struct SyncGraph
@@ -116,9 +119,23 @@ struct SyncGraph
     void connect(ConnectArgs connect)
     {
         subgraphs[connect.subgraphPoint.subgraph].points[connect.subgraphPoint.point].connectedSyncs.push_back(connect.sync);
-        syncs[connect.sync].connectedPoints.push_back({connect.subgraphPoint.subgraph, connect.subgraphPoint.point});
+
+        // Insert sorted. Removing points keeps the order, so connectedPoints stays sorted.
+        std::vector<SubgraphPointAddr> &rPoints = syncs[connect.sync].connectedPoints;
+        SubgraphPointAddr const addr{connect.subgraphPoint.subgraph, connect.subgraphPoint.point};
+        rPoints.insert(std::upper_bound(rPoints.begin(), rPoints.end(), addr), addr);
     }
 
+    /**
+     * @brief Disconnect a synchronizer from all of its points then remove it
+     */
+    void remove_sync(SynchronizerId syncId);
+
+    /**
+     * @brief Disconnect all synchronizers from a subgraph's points then remove it
+     */
+    void remove_subgraph(SubgraphId subgraphId);
+
     lgrn::IdRegistryStl<SubgraphId>             subgraphIds;
     osp::KeyedVec<SubgraphId, Subgraph>         subgraphs;
 
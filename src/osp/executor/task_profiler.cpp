@@ -0,0 +1,268 @@
+/**
+ * Open Space Program
+ * Copyright © 2019-2025 Open Space Program Project
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "task_profiler.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace osp::exec
+{
+
+static std::atomic<std::uint64_t> g_nextProfilerInstance{1};
+
+// Per-thread cache of the buffer last used, to avoid locking on every record(). Only a cache;
+// profilers still know which buffer belongs to each thread, see TaskProfiler::m_bufferOf
+static thread_local std::uint64_t   t_cachedProfiler    = 0;
+static thread_local void            *t_pCachedBuffer    = nullptr;
+
+TaskProfiler::TaskProfiler(std::size_t const eventsPerThread)
+ : m_eventsPerThread{std::max<std::size_t>(eventsPerThread, 1u)}
+ , m_instanceId{g_nextProfilerInstance.fetch_add(1, std::memory_order_relaxed)}
+{ }
+
+TaskProfiler::~TaskProfiler() = default;
+
+TaskProfiler::ThreadBuffer& TaskProfiler::this_thread_buffer() noexcept
+{
+    if (t_cachedProfiler == m_instanceId)
+    {
+        return *static_cast<ThreadBuffer*>(t_pCachedBuffer);
+    }
+
+    std::lock_guard<std::mutex> lock(m_buffersMtx);
+
+    ThreadBuffer *&rpBuffer = m_bufferOf[std::this_thread::get_id()];
+    if (rpBuffer == nullptr)
+    {
+        // First event recorded by this thread
+        ThreadBuffer &rNew = *m_buffers.emplace_back(std::make_unique<ThreadBuffer>());
+        rNew.events.resize(m_eventsPerThread);
+        rNew.threadIndex = std::uint32_t(m_buffers.size() - 1u);
+        rpBuffer = &rNew;
+    }
+
+    t_cachedProfiler = m_instanceId;
+    t_pCachedBuffer  = rpBuffer;
+
+    return *rpBuffer;
+}
+
+void TaskProfiler::record(Event const& event) noexcept
+{
+    ThreadBuffer &rBuffer = this_thread_buffer();
+
+    // Only this thread writes to this buffer
+    std::uint64_t const index = rBuffer.written.load(std::memory_order_relaxed);
+    rBuffer.events[index % rBuffer.events.size()] = event;
+    rBuffer.written.store(index + 1u, std::memory_order_release);
+}
+
+template<typename FUNC_T>
+void TaskProfiler::for_each_event(std::uint32_t const frameCount, FUNC_T &&func) const
+{
+    std::uint32_t const current    = frame();
+    std::uint32_t const firstFrame = (current >= frameCount) ? (current - frameCount + 1u) : 0u;
+
+    std::lock_guard<std::mutex> lock(m_buffersMtx);
+
+    for (std::unique_ptr<ThreadBuffer> const &pBuffer : m_buffers)
+    {
+        std::uint64_t const written  = pBuffer->written.load(std::memory_order_acquire);
+        std::uint64_t const size     = pBuffer->events.size();
+        std::uint64_t const first    = (written > size) ? (written - size) : 0u;
+
+        for (std::uint64_t i = first; i < written; ++i)
+        {
+            Event const &event = pBuffer->events[i % size];
+            if (event.frame >= firstFrame)
+            {
+                func(event, pBuffer->threadIndex);
+            }
+        }
+    }
+}
+
+std::vector<TaskProfiler::TaskTotal> TaskProfiler::totals(std::uint32_t const frameCount) const
+{
+    std::unordered_map<std::uint32_t, TaskTotal> totalOf;
+
+    for_each_event(frameCount, [&totalOf] (Event const& event, std::uint32_t)
+    {
+        if (event.type != EEventType::Task)
+        {
+            return;
+        }
+        TaskTotal &rTotal   = totalOf[event.taskId.value];
+        Time_t const length = event.end - event.start;
+        rTotal.taskId   = event.taskId;
+        rTotal.total   += length;
+        rTotal.longest  = std::max(rTotal.longest, length);
+        ++rTotal.count;
+    });
+
+    std::vector<TaskTotal> out;
+    out.reserve(totalOf.size());
+    for (auto const &[_, total] : totalOf)
+    {
+        out.push_back(total);
+    }
+    std::sort(out.begin(), out.end(), [] (TaskTotal const& lhs, TaskTotal const& rhs)
+    {
+        return lhs.total > rhs.total;
+    });
+    return out;
+}
+
+std::vector<TaskProfiler::FeatureTotal> TaskProfiler::feature_totals(osp::fw::Framework const& fw, std::uint32_t const frameCount) const
+{
+    // TaskId -> index of the FeatureSession that added it, for tasks of contexts still open
+    KeyedVec<TaskId, osp::fw::FSessionId> sessionOf;
+    sessionOf.resize(fw.m_tasks.taskIds.capacity());
+    for (osp::fw::ContextId const ctx : fw.m_contextIds)
+    {
+        for (osp::fw::FSessionId const sessionId : fw.m_contextData[ctx].sessions)
+        {
+            for (TaskId const taskId : fw.m_fsessionData[sessionId].tasks)
+            {
+                sessionOf[taskId] = sessionId;
+            }
+        }
+    }
+
+    std::unordered_map<std::string_view, FeatureTotal> totalOf;
+    for (TaskTotal const& task : totals(frameCount))
+    {
+        osp::fw::FSessionId const sessionId = (task.taskId.value < sessionOf.size())
+                                   ? sessionOf[task.taskId] : osp::fw::FSessionId{};
+        std::string_view const name = sessionId.has_value()
+                                    ? fw.m_fsessionData[sessionId].name : std::string_view{"<closed>"};
+
+        FeatureTotal &rTotal = totalOf[name];
+        rTotal.name      = name;
+        rTotal.total    += task.total;
+        rTotal.taskRuns += task.count;
+    }
+
+    std::vector<FeatureTotal> out;
+    out.reserve(totalOf.size());
+    for (auto const &[_, total] : totalOf)
+    {
+        out.push_back(total);
+    }
+    std::sort(out.begin(), out.end(), [] (FeatureTotal const& lhs, FeatureTotal const& rhs)
+    {
+        return lhs.total > rhs.total;
+    });
+    return out;
+}
+
+static void write_json_string(std::ostream &rStream, std::string_view const str)
+{
+    rStream << '"';
+    for (char const c : str)
+    {
+        switch (c)
+        {
+        case '"':  rStream << "\\\""; break;
+        case '\\': rStream << "\\\\"; break;
+        case '\n': rStream << "\\n";  break;
+        case '\t': rStream << "\\t";  break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                rStream << ' ';
+            }
+            else
+            {
+                rStream << c;
+            }
+        }
+    }
+    rStream << '"';
+}
+
+void TaskProfiler::write_chrome_trace(std::ostream &rStream, osp::fw::Framework const& fw, std::uint32_t const frameCount) const
+{
+    Tasks const &tasks     = fw.m_tasks;
+    auto  const &pltypeReg = PipelineTypeIdReg::instance();
+
+    // "pipeline(stage), pipeline(stage), ..." for each task
+    KeyedVec<TaskId, std::string> syncsOf;
+    syncsOf.resize(tasks.taskIds.capacity());
+    for (TaskSyncToPipeline const& sync : tasks.syncs)
+    {
+        Pipeline         const &pipeline = tasks.pipelineInst[sync.pipeline];
+        PipelineTypeInfo const &pltype   = pltypeReg.get(pipeline.type);
+        std::string            &rStr     = syncsOf[sync.task];
+
+        if ( ! rStr.empty() )
+        {
+            rStr += ", ";
+        }
+        rStr += pipeline.name;
+        rStr += '(';
+        rStr += (sync.stage.value < pltype.stages.size()) ? pltype.stages[sync.stage].name : std::string{"?"};
+        rStr += ')';
+    }
+
+    // Chrome traces use microseconds
+    auto const us = [] (Time_t const ns) { return double(ns) / 1000.0; };
+
+    bool first = true;
+    rStream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    for_each_event(frameCount, [&] (Event const& event, std::uint32_t const threadIndex)
+    {
+        if ( ! first )
+        {
+            rStream << ",\n";
+        }
+        first = false;
+
+        rStream << "{\"ph\":\"X\",\"pid\":0,\"tid\":" << threadIndex
+                << ",\"ts\":"  << us(event.start)
+                << ",\"dur\":" << us(event.end - event.start)
+                << ",\"name\":";
+
+        if (event.type == EEventType::GraphUpdate)
+        {
+            rStream << "\"Sync graph update\",\"cat\":\"executor\",\"args\":{\"frame\":" << event.frame << "}}";
+            return;
+        }
+
+        bool const validTask = tasks.taskIds.exists(event.taskId);
+        write_json_string(rStream, validTask ? std::string_view{tasks.taskInst[event.taskId].debugName} : std::string_view{"(removed task)"});
+        rStream << ",\"cat\":\"task\",\"args\":{\"taskId\":" << event.taskId.value
+                << ",\"frame\":"  << event.frame
+                << ",\"waitUs\":" << us(event.start - event.aligned)
+                << ",\"syncs\":";
+        write_json_string(rStream, validTask ? std::string_view{syncsOf[event.taskId]} : std::string_view{});
+        rStream << "}}";
+    });
+
+    rStream << "\n]}\n";
+}
+
+} // namespace osp::exec
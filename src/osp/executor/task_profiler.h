@@ -0,0 +1,164 @@
+/**
+ * Open Space Program
+ * Copyright © 2019-2025 Open Space Program Project
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <osp/framework/framework.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace osp::exec
+{
+
+/**
+ * @brief Records how long each task takes to run, per frame
+ *
+ * Each thread that records events gets its own fixed-size ring buffer, so recording is lock-free
+ * and old events are overwritten. Only looking up the calling thread's buffer takes a lock, which
+ * happens on a thread's first event, or after it recorded into a different profiler. Reading
+ * (totals, write_chrome_trace) must not happen while tasks are running; call them between
+ * IExecutor::wait calls.
+ *
+ * Pass to an executor through SinglethreadFWExecutor::m_pProfiler. The executor starts a new
+ * frame on every call to IExecutor::wait, which is once per main loop iteration in testapp.
+ */
+class TaskProfiler
+{
+public:
+
+    using Clock_t = std::chrono::steady_clock;
+
+    /// Nanoseconds since the profiler was created
+    using Time_t  = std::int64_t;
+
+    enum class EEventType : std::uint8_t { Task, GraphUpdate };
+
+    struct Event
+    {
+        TaskId          taskId      {};
+        std::uint32_t   frame       {0};
+        Time_t          aligned     {0};    ///< When the task became ready to run
+        Time_t          start       {0};
+        Time_t          end         {0};
+        EEventType      type        {EEventType::Task};
+    };
+
+    struct TaskTotal
+    {
+        TaskId          taskId;
+        Time_t          total       {0};
+        Time_t          longest     {0};
+        std::uint32_t   count       {0};
+    };
+
+    struct FeatureTotal
+    {
+        std::string_view    name;           ///< FeatureSession::name
+        Time_t              total       {0};
+        std::uint32_t       taskRuns    {0};
+    };
+
+    explicit TaskProfiler(std::size_t eventsPerThread = 1u << 16u);
+
+    TaskProfiler(TaskProfiler const& copy) = delete;
+    TaskProfiler(TaskProfiler&& move) = delete;
+    TaskProfiler& operator=(TaskProfiler const& copy) = delete;
+    TaskProfiler& operator=(TaskProfiler&& move) = delete;
+
+    ~TaskProfiler();
+
+    [[nodiscard]] Time_t now() const noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock_t::now() - m_epoch).count();
+    }
+
+    void begin_frame() noexcept { m_frame.fetch_add(1, std::memory_order_relaxed); }
+
+    [[nodiscard]] std::uint32_t frame() const noexcept { return m_frame.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Record an event into the calling thread's ring buffer. Lock-free after the first call
+     *        from each thread.
+     */
+    void record(Event const& event) noexcept;
+
+    /**
+     * @brief Sum up task events from the last frameCount frames, sorted by total time descending
+     */
+    [[nodiscard]] std::vector<TaskTotal> totals(std::uint32_t frameCount) const;
+
+    /**
+     * @brief Same as totals, but summed up per feature that added the tasks
+     *
+     * Tasks that are no longer part of any context are grouped under "<closed>".
+     */
+    [[nodiscard]] std::vector<FeatureTotal> feature_totals(osp::fw::Framework const& fw, std::uint32_t frameCount) const;
+
+    /**
+     * @brief Write events from the last frameCount frames as Chrome trace_event JSON
+     *
+     * Open with chrome://tracing or https://ui.perfetto.dev. Tasks are named with their debugName,
+     * and list the pipelines and stages they sync with.
+     */
+    void write_chrome_trace(std::ostream &rStream, osp::fw::Framework const& fw, std::uint32_t frameCount) const;
+
+private:
+
+    struct ThreadBuffer
+    {
+        std::vector<Event>          events;
+        std::atomic<std::uint64_t>  written{0};
+        std::uint32_t               threadIndex{0};
+    };
+
+    ThreadBuffer& this_thread_buffer() noexcept;
+
+    template<typename FUNC_T>
+    void for_each_event(std::uint32_t frameCount, FUNC_T &&func) const;
+
+    Clock_t::time_point                         m_epoch{Clock_t::now()};
+    std::atomic<std::uint32_t>                  m_frame{0};
+    std::size_t                                 m_eventsPerThread;
+
+    mutable std::mutex                          m_buffersMtx;
+    std::vector<std::unique_ptr<ThreadBuffer>>  m_buffers;
+
+    /// Buffer of each thread that recorded events, so a thread keeps using the same buffer even
+    /// after recording into other profilers in between
+    std::unordered_map<std::thread::id, ThreadBuffer*> m_bufferOf;
+
+    /// Distinguishes this profiler from other (possibly destroyed) ones in thread_local caches
+    std::uint64_t                               m_instanceId;
+};
+
+} // namespace osp::exec
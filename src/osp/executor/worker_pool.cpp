@@ -0,0 +1,241 @@
+/**
+ * Open Space Program
+ * Copyright © 2019-2025 Open Space Program Project
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "worker_pool.h"
+
+#include "../util/logging.h"
+
+namespace osp::exec
+{
+
+// Identifies which pool (if any) the current thread is a worker of
+static thread_local WorkerPool const    *t_pCurrentPool     = nullptr;
+static thread_local std::size_t         t_currentWorker     = 0;
+
+WorkerPool::WorkerPool(std::size_t const threadCount)
+{
+    m_workers.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i)
+    {
+        m_workers.push_back(std::make_unique<Worker>());
+    }
+
+    Logger_t const logger = t_logger;
+
+    m_threads.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i)
+    {
+        m_threads.emplace_back([this, i, logger] ()
+        {
+            set_thread_logger(logger);
+            worker_main(i);
+        });
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMtx);
+        m_stop = true;
+    }
+    m_sleepCv.notify_all();
+
+    for (std::thread &rThread : m_threads)
+    {
+        rThread.join();
+    }
+}
+
+void WorkerPool::submit(Job const job)
+{
+    if (m_workers.empty())
+    {
+        job.func(job.pUserData, job.index);
+        return;
+    }
+
+    std::size_t const target = (t_pCurrentPool == this)
+                             ? t_currentWorker
+                             : m_nextRoundRobin.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+
+    {
+        Worker &rWorker = *m_workers[target];
+        std::lock_guard<std::mutex> lock(rWorker.mtx);
+        rWorker.jobs.push_back(job);
+    }
+
+    m_pending.fetch_add(1, std::memory_order_release);
+
+    {
+        // Lock so a worker can't check m_pending and go to sleep in between the increment above
+        // and the notify below
+        std::lock_guard<std::mutex> lock(m_sleepMtx);
+    }
+    m_sleepCv.notify_one();
+}
+
+void WorkerPool::parallel_for(std::uint32_t const count, JobFunc_t const func, void *const pUserData)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    if (m_workers.empty() || count == 1)
+    {
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            func(pUserData, i);
+        }
+        return;
+    }
+
+    struct Shared
+    {
+        JobFunc_t                   func;
+        void                        *pUserData;
+        std::atomic<std::uint32_t>  remaining;
+    };
+
+    Shared shared{ .func = func, .pUserData = pUserData, .remaining = count };
+
+    static constexpr JobFunc_t wrapper = [] (void *pShared, std::uint32_t const index) noexcept
+    {
+        auto &rShared = *static_cast<Shared*>(pShared);
+        rShared.func(rShared.pUserData, index);
+        rShared.remaining.fetch_sub(1, std::memory_order_acq_rel);
+    };
+
+    // Keep index 0 for the calling thread; it would otherwise sit idle until the first steal
+    for (std::uint32_t i = 1; i < count; ++i)
+    {
+        submit({.func = wrapper, .pUserData = &shared, .index = i});
+    }
+
+    wrapper(&shared, 0);
+
+    while (shared.remaining.load(std::memory_order_acquire) != 0)
+    {
+        if ( ! try_run_one() )
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool WorkerPool::try_run_one()
+{
+    Job job;
+    bool const isWorker = (t_pCurrentPool == this);
+    bool const found    = isWorker ? (try_pop(t_currentWorker, job) || try_steal(t_currentWorker, job))
+                                   : try_steal(m_workers.size(), job);
+    if (found)
+    {
+        m_pending.fetch_sub(1, std::memory_order_acq_rel);
+        job.func(job.pUserData, job.index);
+    }
+    return found;
+}
+
+int WorkerPool::current_worker() const noexcept
+{
+    return (t_pCurrentPool == this) ? int(t_currentWorker) : -1;
+}
+
+std::size_t WorkerPool::default_thread_count() noexcept
+{
+    unsigned int const hwThreads = std::thread::hardware_concurrency();
+    return (hwThreads > 1) ? (hwThreads - 1) : 0;
+}
+
+void WorkerPool::worker_main(std::size_t const workerIndex)
+{
+    t_pCurrentPool  = this;
+    t_currentWorker = workerIndex;
+
+    while (true)
+    {
+        Job job;
+        if (try_pop(workerIndex, job) || try_steal(workerIndex, job))
+        {
+            m_pending.fetch_sub(1, std::memory_order_acq_rel);
+            job.func(job.pUserData, job.index);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleepMtx);
+        m_sleepCv.wait(lock, [this] ()
+        {
+            return m_stop || m_pending.load(std::memory_order_acquire) != 0;
+        });
+
+        if (m_stop)
+        {
+            break;
+        }
+    }
+
+    t_pCurrentPool = nullptr;
+}
+
+bool WorkerPool::try_pop(std::size_t const workerIndex, Job &rJobOut)
+{
+    Worker &rWorker = *m_workers[workerIndex];
+    std::lock_guard<std::mutex> lock(rWorker.mtx);
+    if (rWorker.jobs.empty())
+    {
+        return false;
+    }
+    rJobOut = rWorker.jobs.back();
+    rWorker.jobs.pop_back();
+    return true;
+}
+
+bool WorkerPool::try_steal(std::size_t const thiefIndex, Job &rJobOut)
+{
+    std::size_t const workerCount = m_workers.size();
+
+    // Start from the thief's neighbour so thieves don't all hammer worker 0
+    for (std::size_t i = 1; i <= workerCount; ++i)
+    {
+        std::size_t const victimIndex = (thiefIndex + i) % workerCount;
+        if (victimIndex == thiefIndex)
+        {
+            continue;
+        }
+
+        Worker &rVictim = *m_workers[victimIndex];
+        std::lock_guard<std::mutex> lock(rVictim.mtx);
+        if ( ! rVictim.jobs.empty() )
+        {
+            rJobOut = rVictim.jobs.front();
+            rVictim.jobs.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace osp::exec
@@ -0,0 +1,165 @@
+/**
+ * Open Space Program
+ * Copyright © 2019-2025 Open Space Program Project
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace osp::exec
+{
+
+/**
+ * @brief Fixed-size pool of worker threads with per-worker work-stealing queues
+ *
+ * Each worker owns a queue. Jobs submitted from a worker thread are pushed to that worker's own
+ * queue and popped LIFO (good for cache locality of recently spawned work). Idle workers steal
+ * FIFO from the front of other workers' queues. Jobs submitted from outside the pool are spread
+ * round-robin across the workers.
+ *
+ * Jobs are plain function pointers + user data, so submitting does not allocate beyond the queue
+ * itself. Whatever pUserData points to must outlive the job.
+ *
+ * Worker threads inherit the osp::t_logger of the thread that created the pool.
+ */
+class WorkerPool
+{
+public:
+
+    using JobFunc_t = void(*)(void *pUserData, std::uint32_t index) noexcept;
+
+    struct Job
+    {
+        JobFunc_t       func        { nullptr };
+        void            *pUserData  { nullptr };
+        std::uint32_t   index       { 0 };
+    };
+
+    /**
+     * @param threadCount [in] Number of worker threads to create, may be 0.
+     */
+    explicit WorkerPool(std::size_t threadCount);
+
+    WorkerPool(WorkerPool const& copy) = delete;
+    WorkerPool(WorkerPool&& move) = delete;
+    WorkerPool& operator=(WorkerPool const& copy) = delete;
+    WorkerPool& operator=(WorkerPool&& move) = delete;
+
+    /**
+     * @brief Stop and join all worker threads. Jobs still queued are not run.
+     */
+    ~WorkerPool();
+
+    /**
+     * @brief Queue a job to run on any worker. Safe to call from any thread.
+     *
+     * If the pool has no worker threads, the job runs immediately on the calling thread.
+     */
+    void submit(Job job);
+
+    /**
+     * @brief Run func(pUserData, i) for every i in [0, count), then return
+     *
+     * The calling thread helps run queued jobs while waiting, so this is safe to call from inside
+     * a job running on a worker.
+     */
+    void parallel_for(std::uint32_t count, JobFunc_t func, void *pUserData);
+
+    /**
+     * @brief Run a single queued job on the calling thread if one is available
+     *
+     * @return true if a job was run
+     */
+    bool try_run_one();
+
+    [[nodiscard]] std::size_t thread_count() const noexcept { return m_threads.size(); }
+
+    /**
+     * @return Index of the calling worker thread within this pool, or -1 if not a worker of this pool
+     */
+    [[nodiscard]] int current_worker() const noexcept;
+
+    /**
+     * @brief Sensible default thread count: one less than hardware concurrency, leaving room for
+     *        the main thread.
+     */
+    [[nodiscard]] static std::size_t default_thread_count() noexcept;
+
+private:
+
+    struct Worker
+    {
+        std::mutex              mtx;
+        std::deque<Job>         jobs;
+    };
+
+    void worker_main(std::size_t workerIndex);
+
+    bool try_pop(std::size_t workerIndex, Job &rJobOut);
+    bool try_steal(std::size_t thiefIndex, Job &rJobOut);
+
+    std::vector<std::unique_ptr<Worker>>    m_workers;
+    std::vector<std::thread>                m_threads;
+
+    std::mutex                              m_sleepMtx;
+    std::condition_variable                 m_sleepCv;
+    std::atomic<std::uint32_t>              m_pending{0};
+    std::atomic<std::uint32_t>              m_nextRoundRobin{0};
+    bool                                    m_stop{false};
+};
+
+/**
+ * @brief Call func(i) for every i in [0, count) using a WorkerPool, or on the calling thread if
+ *        pPool is nullptr
+ *
+ * Meant for tasks to split up their own work, see osp::fw::WorkerContext::pPool. func must be
+ * safe to call concurrently for different indices.
+ */
+template <typename FUNC_T>
+void parallel_for(WorkerPool *const pPool, std::uint32_t const count, FUNC_T &&func)
+{
+    if (pPool == nullptr || pPool->thread_count() == 0 || count < 2)
+    {
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            func(i);
+        }
+        return;
+    }
+
+    using Func_t = std::remove_reference_t<FUNC_T>;
+    pPool->parallel_for(count, [] (void *pUserData, std::uint32_t const index) noexcept
+    {
+        (*static_cast<Func_t*>(pUserData))(index);
+    }, const_cast<void*>(static_cast<void const*>(&func)));
+}
+
+} // namespace osp::exec
@@ -48,6 +48,7 @@ void ContextBuilder::add_feature(FeatureDef const &def, entt::any setupData) noe
 
     m_rFW.m_fsessionData.resize(m_rFW.m_fsessionIds.capacity());
     FeatureSession &rFSession = m_rFW.m_fsessionData[fsessionId];
+    rFSession.name = def.name;
 
 
     for (FeatureDef::FIRelationship const& relation : def.relationships)
@@ -102,6 +103,7 @@ void ContextBuilder::add_feature(FeatureDef const &def, entt::any setupData) noe
                 rFI.data.resize(subjectInfo.dataCount);
                 m_rFW.m_dataIds.create(rFI.data.begin(), rFI.data.end());
                 m_rFW.m_data.resize(m_rFW.m_dataIds.capacity());
+                ++m_rFW.m_dataGeneration;
 
                 // Make PipelineIds
                 rFI.pipelines.resize(subjectInfo.pipelines.size());
@@ -31,6 +31,7 @@
 
 #include <entt/core/any.hpp>
 
+#include <array>
 #include <type_traits>
 #include <utility>
 
@@ -106,6 +107,19 @@ private:
         }
     }
 
+    template<typename T>
+    static constexpr decltype(auto) fast_argument([[maybe_unused]] void* const* pArgs,  [[maybe_unused]] WorkerContext ctx,  [[maybe_unused]] std::size_t index) noexcept
+    {
+        if constexpr (std::is_same_v<T, WorkerContext>)
+        {
+            return ctx;
+        }
+        else
+        {
+            return *static_cast<std::remove_reference_t<T>*>(pArgs[index]);
+        }
+    }
+
     template<typename RETURN_T, typename ... ARGS_T>
     struct with_args
     {
@@ -129,6 +143,50 @@ private:
                 return {};
             }
         }
+
+        template<std::size_t ... INDEX>
+        static constexpr RETURN_T call_fast(void* const* pArgs, WorkerContext ctx, [[maybe_unused]] std::index_sequence<INDEX...> indices) noexcept
+        {
+            return FUNCTOR_T{}(fast_argument<ARGS_T>(pArgs, ctx, INDEX) ...);
+        }
+
+        static TaskActions task_impl_fast_out([[maybe_unused]] WorkerContext ctx, [[maybe_unused]] void* const* pArgs) noexcept
+        {
+            if constexpr (std::is_same_v<RETURN_T, TaskActions>)
+            {
+                return call_fast(pArgs, ctx, std::make_index_sequence<sizeof...(ARGS_T)>{});
+            }
+            else
+            {
+                call_fast(pArgs, ctx, std::make_index_sequence<sizeof...(ARGS_T)>{});
+                return {};
+            }
+        }
+
+        template<std::size_t ... INDEX>
+        static constexpr void check(ArrayView<entt::any> args, [[maybe_unused]] std::index_sequence<INDEX...> indices) noexcept
+        {
+            ( static_cast<void>(cast_argument<ARGS_T>(args, WorkerContext{}, INDEX)), ... );
+        }
+
+        static void check_args_out([[maybe_unused]] ArrayView<entt::any> args) noexcept
+        {
+            LGRN_ASSERTMV(args.size() >= sizeof...(ARGS_T), "Incorrect number of arguments", args.size(), sizeof...(ARGS_T));
+            check(args, std::make_index_sequence<sizeof...(ARGS_T)>{});
+        }
+
+        // Only arguments taken by non-const reference can be modified
+        static constexpr std::array<bool, sizeof...(ARGS_T)> smc_writes
+        {
+            (   std::is_lvalue_reference_v<ARGS_T>
+             && ! std::is_const_v<std::remove_reference_t<ARGS_T>>
+             && ! std::is_same_v<std::remove_cvref_t<ARGS_T>, WorkerContext>) ...
+        };
+
+        static bool writes_arg_out(std::size_t const index) noexcept
+        {
+            return index < smc_writes.size() && smc_writes[index];
+        }
     };
 
     template<typename RETURN_T, typename ... ARGS_T>
@@ -138,6 +196,15 @@ private:
 
 public:
     static inline constexpr TaskImpl::Func_t value = &with_args_spec::task_impl_out;
+
+    /// Reads arguments from a table of pointers resolved ahead of time, see TaskImpl::FastFunc_t
+    static inline constexpr TaskImpl::FastFunc_t fast_value = &with_args_spec::task_impl_fast_out;
+
+    /// Runs the same type checks as value would, without calling the functor
+    static inline constexpr TaskImpl::CheckArgs_t check_value = &with_args_spec::check_args_out;
+
+    /// Which arguments are taken by non-const reference, see TaskImpl::WritesArg_t
+    static inline constexpr TaskImpl::WritesArg_t writes_arg_value = &with_args_spec::writes_arg_out;
 };
 
 template<CStatelessLambda FUNCTOR_T>
@@ -172,6 +239,12 @@ struct TaskRef
         return *this;
     }
 
+    TaskRef& main_thread(bool value)
+    {
+        m_rFW.m_taskImpl[taskId].mainThread = value;
+        return *this;
+    }
+
     TaskRef& args(std::initializer_list<DataId> args)
     {
         m_rFW.m_taskImpl.resize(m_rFW.m_tasks.taskIds.capacity());
@@ -214,16 +287,37 @@ struct TaskRef
         return *this;
     }
 
+    /**
+     * @brief Set the function called by this task
+     *
+     * Tasks that align together (eg. several tasks syncing to the same Modify stage) may run in
+     * parallel, unless they access the same data and at least one of them modifies it. Data the
+     * task modifies must be taken by non-const reference; data taken by value or by const
+     * reference must not be modified through it (eg. through pointers it holds), as it may be
+     * read by other tasks at the same time.
+     */
     template<typename FUNC_T>
     TaskRef& func(FUNC_T&& funcArg)
     {
-        m_rFW.m_taskImpl[taskId].func = as_task_impl_v<FUNC_T>;
+        TaskImpl &rTaskImpl = m_rFW.m_taskImpl[taskId];
+        rTaskImpl.func      = as_task_impl<FUNC_T>::value;
+        rTaskImpl.fastFunc  = as_task_impl<FUNC_T>::fast_value;
+        rTaskImpl.checkArgs = as_task_impl<FUNC_T>::check_value;
+        rTaskImpl.writesArg = as_task_impl<FUNC_T>::writes_arg_value;
         return *this;
     }
 
+    /**
+     * @brief Set a function called with entt::any arguments. The task is assumed to modify all of
+     *        its arguments.
+     */
     TaskRef& func_raw(TaskImpl::Func_t func)
     {
-        m_rFW.m_taskImpl[taskId].func = func;
+        TaskImpl &rTaskImpl = m_rFW.m_taskImpl[taskId];
+        rTaskImpl.func      = func;
+        rTaskImpl.fastFunc  = nullptr;
+        rTaskImpl.checkArgs = nullptr;
+        rTaskImpl.writesArg = nullptr;
         return *this;
     }
 
@@ -304,6 +398,8 @@ struct FeatureBuilder
 
     [[nodiscard]] entt::any& data(DataId const dataId) noexcept
     {
+        // Caller may assign a new value
+        ++m_rFW.m_dataGeneration;
         return m_rFW.m_data[dataId];
     }
 
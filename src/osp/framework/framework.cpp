@@ -46,6 +46,7 @@ void Framework::close_context(ContextId ctx)
         for (DataId const dataId : rFIInst.data)
         {
             m_data[dataId].reset();
+            ++m_dataGeneration;
             m_dataIds.remove(dataId);
         }
         rFIInst.data.clear();
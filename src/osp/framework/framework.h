@@ -37,6 +37,7 @@
 
 #include <Corrade/Containers/ArrayViewStl.h>
 
+#include <string_view>
 #include <utility>
 
 namespace osp::fw
@@ -316,6 +317,7 @@ using Implement = FInterfaceShorthand<FI_T, TagImplement>;
  */
 struct FeatureSession
 {
+    std::string_view                name;   ///< FeatureDef::name of the feature that was added
     std::vector<FIInstanceId>       finterDependsOn;
     std::vector<FIInstanceId>       finterImplements;
     std::vector<TaskId>             tasks;
@@ -434,6 +436,7 @@ struct Framework
     template<typename T, typename ... ARGS_T>
     T& data_emplace(DataId const dataId, ARGS_T &&...args) noexcept
     {
+        ++m_dataGeneration;
         entt::any &rData = m_data[dataId];
         rData.emplace<T>(std::forward<ARGS_T>(args) ...);
         return entt::any_cast<T&>(rData);
@@ -447,6 +450,10 @@ struct Framework
     lgrn::IdRegistryStl<DataId>                 m_dataIds;
     KeyedVec<DataId, entt::any>                 m_data;
 
+    /// Incremented whenever values in m_data are added, replaced, or removed. Executors compare
+    /// this to know when argument pointers they resolved ahead of time are no longer valid.
+    std::uint64_t                               m_dataGeneration{0};
+
     lgrn::IdRegistryStl<ContextId>              m_contextIds;
     KeyedVec< ContextId, FeatureContext >       m_contextData;
 
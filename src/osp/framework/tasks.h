@@ -38,6 +38,11 @@
 #include <string>
 #include <vector>
 
+namespace osp::exec
+{
+    class WorkerPool;
+}
+
 namespace osp::fw
 {
 
@@ -46,7 +51,9 @@ using DataId = osp::StrongId<std::uint32_t, struct DummyForDataId>;
 
 struct WorkerContext
 {
-    // TODO: maybe put something here? Thread info?
+    /// Pool a task can split its own work onto using osp::exec::parallel_for, or nullptr if the
+    /// executor doesn't have one. In that case, run everything on the calling thread.
+    osp::exec::WorkerPool *pPool{nullptr};
 };
 
 /**
@@ -56,9 +63,31 @@ struct TaskImpl
 {
     using Func_t = TaskActions(*)(WorkerContext, ArrayView<entt::any>) noexcept;
 
+    /// Same as Func_t, but arguments are raw pointers to each data, already resolved by the
+    /// executor. Types are not checked here; use CheckArgs_t once when resolving.
+    using FastFunc_t = TaskActions(*)(WorkerContext, void* const* pArgs) noexcept;
+
+    /// Asserts that the given arguments match the types expected by FastFunc_t
+    using CheckArgs_t = void(*)(ArrayView<entt::any>) noexcept;
+
+    /// Tells if the task may modify the argument at an index. Executors that run tasks in
+    /// parallel use this to keep tasks that write to the same data apart.
+    using WritesArg_t = bool(*)(std::size_t index) noexcept;
+
     std::vector<DataId>     args;
     Func_t                  func    { nullptr };
+
+    /// Optional. Used instead of func by executors that pre-resolve args into pointers
+    FastFunc_t              fastFunc  { nullptr };
+    CheckArgs_t             checkArgs { nullptr };
+
+    /// Optional. Null means every argument may be modified.
+    WritesArg_t             writesArg { nullptr };
+
     bool                    externalFinish{false};
+
+    /// Task must run on the thread that calls IExecutor::wait, eg. tasks that use the GL context
+    bool                    mainThread{false};
 };
 
 } // namespace osp
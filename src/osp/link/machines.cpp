@@ -97,4 +97,38 @@ void copy_nodes(
     }
 }
 
+void resize_machine_dirty(MachineDirty &rDirty, MachineUpdater const &rUpdMach)
+{
+    rDirty.machTypesDirty.resize(rUpdMach.machTypesDirty.capacity());
+    rDirty.localDirty.resize(rUpdMach.localDirty.size());
+
+    for (std::size_t type = 0; type < rUpdMach.localDirty.size(); ++type)
+    {
+        std::size_t const capacity = rUpdMach.localDirty[MachTypeId(type)].capacity();
+        if (rDirty.localDirty[MachTypeId(type)].capacity() != capacity)
+        {
+            rDirty.localDirty[MachTypeId(type)].resize(capacity);
+        }
+    }
+}
+
+void merge_machine_dirty(MachineUpdater &rUpdMach, MachineDirty &rDirty)
+{
+    // Machines are only ever marked dirty along with their type, so only dirty types need to
+    // be looked at
+    for (MachTypeId const type : rDirty.machTypesDirty)
+    {
+        rUpdMach.machTypesDirty.insert(type);
+
+        lgrn::IdSetStl<MachLocalId> &rSrc = rDirty.localDirty[type];
+        lgrn::IdSetStl<MachLocalId> &rDst = rUpdMach.localDirty[type];
+        for (MachLocalId const local : rSrc)
+        {
+            rDst.insert(local);
+        }
+        rSrc.clear();
+    }
+    rDirty.machTypesDirty.clear();
+}
+
 } // namespace osp::link
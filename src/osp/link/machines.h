@@ -89,6 +89,20 @@ struct MachineUpdater
     osp::KeyedVec<MachTypeId, lgrn::IdSetStl<MachLocalId>> localDirty;
 };
 
+/**
+ * @brief Machines marked dirty by one thread, merged into a MachineUpdater afterwards
+ *
+ * Bit sets can't be written to by multiple threads at once, so each thread notifying machines
+ * gets its own. Merging is order-independent.
+ */
+struct MachineDirty
+{
+    lgrn::IdSetStl<MachTypeId> machTypesDirty;
+
+    // [MachTypeId][MachLocalId]
+    osp::KeyedVec<MachTypeId, lgrn::IdSetStl<MachLocalId>> localDirty;
+};
+
 struct MachinePair
 {
     MachLocalId     local   {lgrn::id_null<MachLocalId>()};
@@ -148,5 +162,15 @@ void copy_nodes(
         Machines &rDstMach,
         ArrayView<NodeId> remapNodeOut);
 
+/**
+ * @brief Resize a MachineDirty to fit the same machines as a MachineUpdater
+ */
+void resize_machine_dirty(MachineDirty &rDirty, MachineUpdater const &rUpdMach);
+
+/**
+ * @brief Mark machines from a MachineDirty as dirty in a MachineUpdater, then clear it
+ */
+void merge_machine_dirty(MachineUpdater &rUpdMach, MachineDirty &rDirty);
+
 
 } // namespace osp::wire
@@ -26,6 +26,12 @@
 
 #include "machines.h"
 
+#include "../executor/worker_pool.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
 namespace osp::link
 {
 
@@ -51,14 +57,74 @@ struct UpdateNodes
     }
 };
 
-template <typename VALUE_T, typename RANGE_T>
+/**
+ * @brief Scratch space to split the work of one signal node type across threads
+ *
+ * Each thread only writes to its own UpdateNodes or MachineDirty, which are merged afterwards.
+ * Used by one task at a time, same as the UpdateNodes it's for.
+ */
+template <typename VALUE_T>
+struct SignalThreads
+{
+    std::vector<UpdateNodes<VALUE_T>>   updNodes;   ///< New values assigned by each thread
+    std::vector<MachineDirty>           machDirty;  ///< Machines notified by each thread
+    std::vector<std::uint8_t>           notified;   ///< If each thread notified any machines
+
+    std::vector<NodeId>                 nodes;      ///< Dirty nodes, as a list to split up
+    std::vector<MachLocalId>            locals;     ///< Dirty machines, as a list to split up
+};
+
+/// Fewer dirty nodes than this per thread aren't worth splitting up
+constexpr std::size_t gc_minNodesPerThread      = 1024;
+
+/// Fewer dirty machines than this per thread aren't worth splitting up
+constexpr std::size_t gc_minMachinesPerThread   = 64;
+
+/**
+ * @return Number of contiguous ranges to split count items into, at least 1
+ */
+inline std::uint32_t signal_thread_count(std::size_t const count, std::size_t const minPerThread, exec::WorkerPool const* pPool) noexcept
+{
+    std::size_t const maxThreads = (pPool != nullptr) ? (pPool->thread_count() + 1) : 1;
+    return std::uint32_t(std::max<std::size_t>(1, std::min(maxThreads, count / minPerThread)));
+}
+
+/**
+ * @brief Move new values from rSrc into rDst, then clear rSrc
+ *
+ * Values in rSrc overwrite values already assigned to the same nodes in rDst.
+ */
+template <typename VALUE_T>
+void merge_update_nodes(UpdateNodes<VALUE_T> &rDst, UpdateNodes<VALUE_T> &rSrc)
+{
+    if ( ! rSrc.dirty )
+    {
+        return;
+    }
+
+    for (NodeId const node : rSrc.nodeDirty)
+    {
+        rDst.nodeDirty.insert(node);
+        rDst.nodeNewValues[node] = std::move(rSrc.nodeNewValues[node]);
+    }
+    rDst.dirty = true;
+
+    rSrc.nodeDirty.clear();
+    rSrc.dirty = false;
+}
+
+/**
+ * @param rUpdMach  [out] MachineUpdater, or a MachineDirty when multiple threads are notifying
+ *                        machines at once
+ */
+template <typename VALUE_T, typename RANGE_T, typename UPDMACH_T>
 bool update_signal_nodes(
         RANGE_T const&                  toUpdate,
         Nodes::NodeToMach_t const&      nodeToMach,
         Machines const&                 machines,
         ArrayView<VALUE_T const>        newValues,
         ArrayView<VALUE_T>              currentValues,
-        MachineUpdater&                 rUpdMach)
+        UPDMACH_T&                      rUpdMach)
 {
     bool somethingNotified = false;
 
@@ -86,4 +152,131 @@ bool update_signal_nodes(
     return somethingNotified;
 }
 
+/**
+ * @brief Apply all new values in rUpdNodes and notify connected machines, split across threads
+ *
+ * Dirty nodes are split into contiguous ranges, each notifying machines into its own
+ * MachineDirty. These are all merged into rUpdMach after, so the result is the same no matter
+ * how many threads are used. Clears rUpdNodes.
+ *
+ * @param pPool     [in] Pool to split work onto, or nullptr to run on the calling thread
+ *
+ * @return true if any machines were notified
+ */
+template <typename VALUE_T>
+bool update_signal_nodes(
+        UpdateNodes<VALUE_T>&           rUpdNodes,
+        SignalThreads<VALUE_T>&         rThreads,
+        Nodes::NodeToMach_t const&      nodeToMach,
+        Machines const&                 machines,
+        ArrayView<VALUE_T>              currentValues,
+        MachineUpdater&                 rUpdMach,
+        exec::WorkerPool*               pPool)
+{
+    rThreads.nodes.clear();
+    for (NodeId const node : rUpdNodes.nodeDirty)
+    {
+        rThreads.nodes.push_back(node);
+    }
+
+    ArrayView<NodeId const>  const nodes      = arrayView(std::as_const(rThreads.nodes));
+    ArrayView<VALUE_T const> const newValues  = arrayView(std::as_const(rUpdNodes.nodeNewValues));
+    std::uint32_t            const threads    = signal_thread_count(nodes.size(), gc_minNodesPerThread, pPool);
+
+    bool somethingNotified = false;
+
+    if (threads == 1)
+    {
+        somethingNotified = update_signal_nodes<VALUE_T>(nodes, nodeToMach, machines, newValues, currentValues, rUpdMach);
+    }
+    else
+    {
+        rThreads.machDirty.resize(std::max<std::size_t>(rThreads.machDirty.size(), threads));
+        rThreads.notified.assign(threads, 0);
+        for (std::uint32_t i = 0; i < threads; ++i)
+        {
+            resize_machine_dirty(rThreads.machDirty[i], rUpdMach);
+        }
+
+        // Each thread writes to different currentValues, and only to its own MachineDirty
+        exec::parallel_for(pPool, threads, [&] (std::uint32_t const i)
+        {
+            ArrayView<NodeId const> const range = nodes.slice(nodes.size() * i       / threads,
+                                                              nodes.size() * (i + 1) / threads);
+
+            rThreads.notified[i] = update_signal_nodes<VALUE_T>(range, nodeToMach, machines, newValues, currentValues, rThreads.machDirty[i]);
+        });
+
+        for (std::uint32_t i = 0; i < threads; ++i)
+        {
+            merge_machine_dirty(rUpdMach, rThreads.machDirty[i]);
+            somethingNotified = somethingNotified || (rThreads.notified[i] != 0);
+        }
+    }
+
+    rUpdNodes.nodeDirty.clear();
+    rUpdNodes.dirty = false;
+
+    return somethingNotified;
+}
+
+/**
+ * @brief Call func(locals, rUpdNodes) with ranges of dirty machines of a type, split across threads
+ *
+ * Each thread assigns new values into its own UpdateNodes, sized the same as rUpdNodes. Machines
+ * are split into contiguous ranges in order, and merged into rUpdNodes in the same order. If
+ * multiple machines assign the same node, the last one wins, same as calling func for all
+ * machines in order on one thread.
+ *
+ * func must only read shared data, and only write to the UpdateNodes it is given.
+ *
+ * @param localDirty    [in] Dirty machines of a type, see MachineUpdater::localDirty
+ * @param pPool         [in] Pool to split work onto, or nullptr to run on the calling thread
+ */
+template <typename VALUE_T, typename FUNC_T>
+void update_machines(
+        lgrn::IdSetStl<MachLocalId> const&  localDirty,
+        UpdateNodes<VALUE_T>&               rUpdNodes,
+        SignalThreads<VALUE_T>&             rThreads,
+        exec::WorkerPool*                   pPool,
+        FUNC_T&&                            func)
+{
+    rThreads.locals.clear();
+    for (MachLocalId const local : localDirty)
+    {
+        rThreads.locals.push_back(local);
+    }
+
+    ArrayView<MachLocalId const> const locals   = arrayView(std::as_const(rThreads.locals));
+    std::uint32_t                const threads  = signal_thread_count(locals.size(), gc_minMachinesPerThread, pPool);
+
+    if (threads == 1)
+    {
+        func(locals, rUpdNodes);
+        return;
+    }
+
+    rThreads.updNodes.resize(std::max<std::size_t>(rThreads.updNodes.size(), threads));
+    for (std::uint32_t i = 0; i < threads; ++i)
+    {
+        UpdateNodes<VALUE_T> &rThreadUpd = rThreads.updNodes[i];
+        if (rThreadUpd.nodeNewValues.size() != rUpdNodes.nodeNewValues.size())
+        {
+            rThreadUpd.nodeNewValues.resize(rUpdNodes.nodeNewValues.size());
+            rThreadUpd.nodeDirty.resize(rUpdNodes.nodeDirty.capacity());
+        }
+    }
+
+    exec::parallel_for(pPool, threads, [&] (std::uint32_t const i)
+    {
+        func(locals.slice(locals.size() * i       / threads,
+                          locals.size() * (i + 1) / threads), rThreads.updNodes[i]);
+    });
+
+    for (std::uint32_t i = 0; i < threads; ++i)
+    {
+        merge_update_nodes(rUpdNodes, rThreads.updNodes[i]);
+    }
+}
+
 } // namespace osp::wire
@@ -0,0 +1,160 @@
+/**
+ * Open Space Program
+ * Copyright © 2019-2025 Open Space Program Project
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "coordinates.h"
+
+#include <Magnum/Math/Matrix.h>
+#include <Magnum/Math/Quaternion.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace osp::universe
+{
+
+namespace
+{
+
+// Positions are processed in fixed-size blocks of separate X, Y, and Z arrays. Loops below
+// only do branch-free arithmetic on these, so the compiler can vectorize them.
+constexpr std::size_t gc_blockSize = 256;
+
+struct Block
+{
+    alignas(64) std::array<spaceint_t, gc_blockSize> x;
+    alignas(64) std::array<spaceint_t, gc_blockSize> y;
+    alignas(64) std::array<spaceint_t, gc_blockSize> z;
+};
+
+/**
+ * @brief Rotate positions in a block by a column-major 3x3 rotation matrix
+ *
+ * Same as Vector3g(rotation * Vector3d(in)), truncating towards zero.
+ */
+void rotate_block(Block &rBlock, std::size_t const count, Magnum::Math::Matrix3x3<double> const& mat) noexcept
+{
+    double const m00 = mat[0][0], m01 = mat[1][0], m02 = mat[2][0];
+    double const m10 = mat[0][1], m11 = mat[1][1], m12 = mat[2][1];
+    double const m20 = mat[0][2], m21 = mat[1][2], m22 = mat[2][2];
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        double const x = double(rBlock.x[i]);
+        double const y = double(rBlock.y[i]);
+        double const z = double(rBlock.z[i]);
+        rBlock.x[i] = spaceint_t(m00 * x + m01 * y + m02 * z);
+        rBlock.y[i] = spaceint_t(m10 * x + m11 * y + m12 * z);
+        rBlock.z[i] = spaceint_t(m20 * x + m21 * y + m22 * z);
+    }
+}
+
+/**
+ * @brief value * 2^exponent + add for each component of a block
+ *
+ * Matches mul_2pow<spaceint_t>, which multiplies for positive exponents and divides (rounding
+ * towards zero) for negative exponents, using only shifts and adds.
+ */
+void shift_add_block(Block &rBlock, std::size_t const count, int const exponent, Vector3g const add) noexcept
+{
+    auto const shift_add = [count] (std::array<spaceint_t, gc_blockSize> &rValues, int const exponent, spaceint_t const add) noexcept
+    {
+        if (exponent >= 0)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                rValues[i] = spaceint_t(std::uint64_t(rValues[i]) << exponent) + add;
+            }
+        }
+        else
+        {
+            // Arithmetic right shift rounds towards negative infinity. Add (2^k - 1) to
+            // negative values beforehand to round towards zero like integer division does.
+            int          const k    = -exponent;
+            spaceint_t   const bias = math::int_2pow<spaceint_t>(k) - 1;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                spaceint_t const value = rValues[i];
+                rValues[i] = ((value + ((value >> 63) & bias)) >> k) + add;
+            }
+        }
+    };
+
+    shift_add(rBlock.x, exponent, add.x());
+    shift_add(rBlock.y, exponent, add.y());
+    shift_add(rBlock.z, exponent, add.z());
+}
+
+} // namespace
+
+void CoordTransformer::transform_positions(StridedVector3g const& in, std::span<Vector3g> out) const noexcept
+{
+    using osp::math::mul_2pow;
+
+    bool const hasRotIn  = quat_non_zero(rotIn);
+    bool const hasRotOut = quat_non_zero(rotOut);
+
+    Magnum::Math::Matrix3x3<double> const matIn  = hasRotIn  ? rotIn .toMatrix() : Magnum::Math::Matrix3x3<double>{};
+    Magnum::Math::Matrix3x3<double> const matOut = hasRotOut ? rotOut.toMatrix() : Magnum::Math::Matrix3x3<double>{};
+
+    // c * 2^m is the same for every position
+    Vector3g const cTerm = mul_2pow<Vector3g, spaceint_t>(Vector3g(c), m);
+
+    std::array<std::byte const*, 3> pos = in.pos;
+
+    Block block;
+
+    for (std::size_t first = 0; first < out.size(); first += gc_blockSize)
+    {
+        std::size_t const count = std::min(gc_blockSize, out.size() - first);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::memcpy(&block.x[i], pos[0], sizeof(spaceint_t));
+            std::memcpy(&block.y[i], pos[1], sizeof(spaceint_t));
+            std::memcpy(&block.z[i], pos[2], sizeof(spaceint_t));
+            pos[0] += in.stride[0];
+            pos[1] += in.stride[1];
+            pos[2] += in.stride[2];
+        }
+
+        if (hasRotIn)
+        {
+            rotate_block(block, count, matIn);
+        }
+
+        shift_add_block(block, count, n, cTerm);
+
+        if (hasRotOut)
+        {
+            rotate_block(block, count, matOut);
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            out[first + i] = {block.x[i], block.y[i], block.z[i]};
+        }
+    }
+}
+
+} // namespace osp::universe
@@ -28,6 +28,10 @@
 
 #include "../core/math_2pow.h"
 
+#include <array>
+#include <cstddef>
+#include <span>
+
 namespace osp::universe
 {
 
@@ -43,6 +47,18 @@ constexpr bool quat_non_zero(Quaterniond const in) noexcept
     return in.scalar() != 1.0;
 }
 
+/**
+ * @brief Three strided arrays of spaceint_t holding the X, Y, and Z components of positions
+ *
+ * Matches how DataAccessor exposes posX, posY, and posZ as separate components. Interleaved
+ * Vector3g arrays work too, with each component pointing into the first element.
+ */
+struct StridedVector3g
+{
+    std::array<std::byte const*, 3>  pos{};
+    std::array<std::ptrdiff_t, 3>    stride{};
+};
+
 /**
  * @brief Relevant variables to for a parent-child relationship between two coordinate spaces
  */
@@ -138,6 +154,18 @@ struct CoordTransformer
         return out;
     }
 
+    /**
+     * @brief Transform many positions at once
+     *
+     * Produces the same results as calling transform_position on each element. Without
+     * rotations, output is bit-exact. With rotations, a precomputed rotation matrix is used
+     * instead of the quaternion, which can round differently by 1 unit per rotation.
+     *
+     * @param in    [in] Input positions, in.pos[i] must be non-null
+     * @param out   [out] Transformed positions, out.size() positions are read from in
+     */
+    void transform_positions(StridedVector3g const& in, std::span<Vector3g> out) const noexcept;
+
     Quaterniond rotation() const noexcept
     {
         return rotOut * rotIn;
@@ -0,0 +1,365 @@
+/**
+ * Open Space Program
+ * Copyright © 2019-2025 Open Space Program Project
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "universe.h"
+
+#include <longeron/utility/asserts.hpp>
+
+#include <string_view>
+#include <utility>
+
+namespace osp::universe
+{
+
+void UCtxCoordSpaces::insert(std::span<Insert const> batch)
+{
+    if (batch.empty())
+    {
+        return;
+    }
+
+    constexpr std::uint32_t c_none = lgrn::id_null<std::uint32_t>();
+
+    // Singly linked list of new children for each parent, as indices into batch. Built backwards
+    // so children are visited in the order given.
+    osp::KeyedVec<CoSpaceId, std::uint32_t> firstNewChild;
+    firstNewChild.resize(ids.capacity(), c_none);
+    std::vector<std::uint32_t> nextNewChild(batch.size(), c_none);
+
+    CoSpaceId root = treeToId[0];
+
+    for (std::uint32_t i = std::uint32_t(batch.size()); i-- != 0; )
+    {
+        Insert const &rInsert = batch[i];
+        parentOf[rInsert.addme] = rInsert.parent;
+
+        if (rInsert.parent.has_value())
+        {
+            nextNewChild[i]                = firstNewChild[rInsert.parent];
+            firstNewChild[rInsert.parent]  = i;
+        }
+        else
+        {
+            LGRN_ASSERTM( ! root.has_value(), "Coordinate space tree can only have one root");
+            root = rInsert.addme;
+        }
+    }
+
+    // Rebuild the tree with a single depth-first pass. Existing children are copied over from
+    // the old tree, followed by new children.
+
+    osp::KeyedVec<TreePos_t, CoSpaceId>     oldTreeToId;
+    osp::KeyedVec<TreePos_t, std::uint32_t> oldTreeDescendants;
+    std::swap(oldTreeToId,        treeToId);
+    std::swap(oldTreeDescendants, treeDescendants);
+    bool const hadRoot = oldTreeToId[0].has_value();
+
+    treeToId       .reserve(oldTreeToId.size() + batch.size());
+    treeDescendants.reserve(oldTreeToId.size() + batch.size());
+
+    auto const add_subtree = [&] (auto const &self, CoSpaceId const cospace, TreePos_t const oldPos, bool const isOld) -> void
+    {
+        auto const pos = TreePos_t(treeToId.size());
+        treeToId       .push_back(cospace);
+        treeDescendants.push_back(0);
+        treeposOf[cospace] = pos;
+
+        if (isOld)
+        {
+            TreePos_t const childLast = oldPos + 1 + oldTreeDescendants[oldPos];
+            for (TreePos_t child = oldPos + 1; child != childLast; child += 1 + oldTreeDescendants[child])
+            {
+                self(self, oldTreeToId[child], child, true);
+            }
+        }
+
+        for (std::uint32_t i = firstNewChild[cospace]; i != c_none; i = nextNewChild[i])
+        {
+            self(self, batch[i].addme, 0, false);
+        }
+
+        treeDescendants[pos] = std::uint32_t(treeToId.size()) - pos - 1;
+    };
+
+    add_subtree(add_subtree, root, 0, hadRoot);
+
+    LGRN_ASSERTM(treeToId.size() == (hadRoot ? oldTreeToId.size() : 0) + batch.size(),
+                 "Cospaces inserted with parents that are not in the tree");
+}
+
+void UCtxCoordSpaces::remove(std::span<CoSpaceId const> roots)
+{
+    if (roots.empty())
+    {
+        return;
+    }
+
+    std::vector<TreePos_t> toDelete;
+    toDelete.reserve(roots.size());
+    for (CoSpaceId const cospace : roots)
+    {
+        LGRN_ASSERTM(treeposOf[cospace] != lgrn::id_null<TreePos_t>(), "Cospace is not in the tree");
+        toDelete.push_back(treeposOf[cospace]);
+    }
+    std::sort(toDelete.begin(), toDelete.end());
+
+    TreePos_t const treeLast = TreePos_t(treeToId.size());
+
+    auto const clear_range = [this] (TreePos_t const first, TreePos_t const last)
+    {
+        for (TreePos_t pos = first; pos != last; ++pos)
+        {
+            treeposOf[treeToId[pos]] = lgrn::id_null<TreePos_t>();
+            parentOf [treeToId[pos]] = {};
+        }
+    };
+
+    if (toDelete.front() == 0)
+    {
+        // Removing the root, which removes everything
+        clear_range(0, treeLast);
+        treeToId       .assign(1, CoSpaceId{});
+        treeDescendants.assign(1, 0);
+        return;
+    }
+
+    // Delete subtrees by shifting elements left in a single left-to-right pass, same as
+    // SysSceneGraph::do_delete
+    //
+    // State of array each iteration:
+    //
+    // [Done] [Prev. shifted] [Delete] [Keep] [Delete Next] ....
+    //        <--------SHIFT-----------|----|
+
+    TreePos_t done = toDelete.front();
+
+    for (std::size_t i = 0; i != toDelete.size(); )
+    {
+        TreePos_t     const delFirst    = toDelete[i];
+        std::uint32_t const removeTotal = 1 + treeDescendants[delFirst];
+        TreePos_t     const delLast     = delFirst + removeTotal;
+
+        // Skip positions already being removed as part of this subtree
+        std::size_t next = i + 1;
+        while (next != toDelete.size() && toDelete[next] < delLast)
+        {
+            ++next;
+        }
+
+        TreePos_t const keepFirst = delLast;
+        TreePos_t const keepLast  = (next != toDelete.size()) ? toDelete[next] : treeLast;
+        TreePos_t const shift     = keepFirst - done;
+
+        // Ancestors are all left of delFirst, and were already moved to their final positions
+        for (CoSpaceId parent = parentOf[treeToId[delFirst]]; parent.has_value(); parent = parentOf[parent])
+        {
+            treeDescendants[treeposOf[parent]] -= removeTotal;
+        }
+
+        clear_range(delFirst, delLast);
+
+        for (TreePos_t pos = keepFirst; pos != keepLast; ++pos)
+        {
+            treeposOf[treeToId[pos]] -= shift;
+        }
+
+        std::shift_left(treeDescendants.begin() + done, treeDescendants.begin() + keepLast, shift);
+        std::shift_left(treeToId       .begin() + done, treeToId       .begin() + keepLast, shift);
+
+        done += keepLast - keepFirst;
+        i = next;
+    }
+
+    treeToId       .resize(done);
+    treeDescendants.resize(done);
+}
+
+std::size_t UCtxDataSources::hash_entries(DataSource const& dataSrc) noexcept
+{
+    // Entries have no uninitialized padding bytes (see DataSource::Entry::_padding), so hashing
+    // raw bytes is consistent with the memcmp comparisons below.
+    return std::hash<std::string_view>{}(std::string_view{
+            reinterpret_cast<char const*>(dataSrc.entries.data()),
+            dataSrc.entries.size() * sizeof(DataSource::Entry)});
+}
+
+DataSourceId UCtxDataSources::find_datasource(DataSource const& query) const
+{
+    std::size_t const size = query.entries.size();
+    auto const [first, last] = index.equal_range(hash_entries(query));
+    for (auto it = first; it != last; ++it)
+    {
+        DataSource const& candidate = instances[it->second];
+        if (   candidate.entries.size() == size
+            && std::memcmp(candidate.entries.data(), query.entries.data(), size * sizeof(DataSource::Entry)) == 0)
+        {
+            return it->second;
+        }
+    }
+    return {};
+}
+
+DataSourceId UCtxDataSources::make_datasource(DataSource &&dataSrc)
+{
+    DataSourceId const dataSrcId = ids.create();
+    instances.resize(ids.capacity());
+    index.emplace(hash_entries(dataSrc), dataSrcId);
+    instances[dataSrcId] = std::move(dataSrc);
+    return dataSrcId;
+}
+
+void UCtxDataSources::remove_datasource(DataSourceId const dataSrcId)
+{
+    auto const [first, last] = index.equal_range(hash_entries(instances[dataSrcId]));
+    for (auto it = first; it != last; ++it)
+    {
+        if (it->second == dataSrcId)
+        {
+            index.erase(it);
+            break;
+        }
+    }
+    instances[dataSrcId] = {};
+    ids.remove(dataSrcId);
+}
+
+void UCtxDataSources::apply_changes()
+{
+    // DataSources that reached zero references. These are only deleted at the end, as they may
+    // be reused by a later change.
+    std::vector<DataSourceId> released;
+
+    // Satellites sharing a DataSource all transition to the same new DataSource for a given
+    // change. Remember old -> new so the scratchpad only has to be built once per old DataSource.
+    // A null key is for satellites without a DataSource.
+    std::unordered_map<DataSourceId, DataSourceId> transitions;
+
+    DataSource scratchpad;
+
+    for (DataSourceChange const& dsc : changes)
+    {
+        transitions.clear();
+
+        for (SatelliteId const satId : dsc.satsAffected)
+        {
+            DataSourceOwner_t &rSatDsOwner = datasrcOf[satId];
+            DataSourceId const oldDsId     = rSatDsOwner.has_value() ? rSatDsOwner.value() : DataSourceId{};
+
+            if (oldDsId.has_value())
+            {
+                refCounts.ref_release(std::exchange(rSatDsOwner, {}));
+                if (refCounts[oldDsId.value] == 0)
+                {
+                    released.push_back(oldDsId);
+                }
+            }
+
+            auto const [transIt, isNew] = transitions.try_emplace(oldDsId);
+            if ( ! isNew )
+            {
+                rSatDsOwner = refCounts.ref_add(transIt->second);
+                continue;
+            }
+
+            scratchpad.entries.clear();
+
+            if (oldDsId.has_value())
+            {
+                // Satellite already has a DataSource, copy it into scratchpad then modify it.
+                DataSource const &rSatDs = instances[oldDsId];
+
+                scratchpad.entries.assign(rSatDs.entries.begin(), rSatDs.entries.end());
+
+                bool added = false;
+
+                // remove occurances of ComponentTypeIds used in dsc.components from scratchpad
+                auto const newLast = std::remove_if(
+                        scratchpad.entries.begin(),
+                        scratchpad.entries.end(),
+                        [&dsc, &added] (DataSource::Entry &rSpEntry) -> bool
+                {
+                    if (rSpEntry.accessor == dsc.accessor)
+                    {
+                        for (ComponentTypeId const ctId : dsc.components)
+                        {
+                            rSpEntry.components.insert(ctId);
+                        }
+                        LGRN_ASSERT(added == false);
+                        added = true;
+
+                        return false;
+                    }
+                    else
+                    {
+                        for (ComponentTypeId const ctId : dsc.components)
+                        {
+                            rSpEntry.components.erase(ctId);
+                        }
+
+                        return rSpEntry.components.empty(); // remove if true
+                    }
+                });
+                scratchpad.entries.resize(std::distance(scratchpad.entries.begin(), newLast));
+
+                if ( ! added )
+                {
+                    scratchpad.entries.push_back(DataSource::Entry{
+                        .components = dsc.components,
+                        .accessor   = dsc.accessor
+                    });
+                }
+                scratchpad.sort();
+            }
+            else
+            {
+                // No existing data source, likely that the satellite is newly added.
+                scratchpad.entries.push_back(DataSource::Entry{
+                    .components = dsc.components,
+                    .accessor   = dsc.accessor
+                });
+            }
+
+            DataSourceId newDsId = find_datasource(scratchpad);
+
+            if ( ! newDsId.has_value() )
+            {
+                newDsId = make_datasource(std::exchange(scratchpad, {}));
+            }
+
+            transIt->second = newDsId;
+            rSatDsOwner     = refCounts.ref_add(newDsId);
+        }
+    }
+
+    for (DataSourceId const dataSrcId : released)
+    {
+        // Skip duplicates and DataSources that were referenced again
+        if (ids.exists(dataSrcId) && refCounts[dataSrcId.value] == 0)
+        {
+            remove_datasource(dataSrcId);
+        }
+    }
+}
+
+} // namespace osp::universe
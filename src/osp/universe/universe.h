@@ -32,6 +32,7 @@
 #include "universetypes.h"
 
 #include "../core/math_types.h"
+#include "../core/bitvector.h"
 #include "../core/buffer_format.h"
 #include "../core/keyed_vector.h"
 #include "../core/copymove_macros.h"
@@ -49,7 +50,7 @@
 #include <algorithm>
 #include <array>
 #include <memory>
-#include <set>
+#include <span>
 #include <unordered_map>
 
 namespace osp::universe
@@ -84,73 +85,49 @@ struct UCtxCoordSpaces
 {
     using TreePos_t = std::uint32_t;
 
+    struct Insert
+    {
+        /// Cospace already in the tree, one inserted earlier in the same batch, or null for root
+        CoSpaceId parent;
+        CoSpaceId addme;
+    };
+
     void resize()
     {
         auto cospaceCapacity = ids.capacity();
         treeposOf  .resize(cospaceCapacity);
+        parentOf   .resize(cospaceCapacity);
         transformOf.resize(cospaceCapacity);
     }
 
     void insert(CoSpaceId parent, CoSpaceId addme)
     {
-        if (parent.has_value())
-        {
-            TreePos_t const parentPos = treeposOf[parent];
-            TreePos_t const addmePos  = parentPos + 1;
-
-            treeToId       .insert(treeToId.begin()        + addmePos, addme);
-            treeDescendants.insert(treeDescendants.begin() + addmePos, 0);
-
-            // Calls to insert(..) above pushed all positions right of addmePos right by 1.
-            // Tree positions of cospace IDs need to be updated.
-            for (TreePos_t pos = addmePos; pos < treeDescendants.size(); ++pos)
-            {
-                treeposOf[treeToId[pos]] = pos;
-            }
-
-            // Starting from the root, walk down parent-child chain and increment descendant count
-            // of all ascendants of addmePos
-            TreePos_t ascendant = 0; // root
-            while (ascendant != addmePos)
-            {
-                ++ treeDescendants[ascendant];
-
-                // addmePos belongs to which child?
-                auto        const childLast = ascendant + 1 + treeDescendants[ascendant];
-                TreePos_t         child     = ascendant + 1;
-
-                while (child != childLast)
-                {
-                    TreePos_t const nextChild = child + 1 + treeDescendants[child];
-
-                    if (addmePos <= nextChild) // is 'addmePos' a descendent-of or is 'child'?
-                    {
-                        ascendant = child;
-                        break;
-                    }
-                    else
-                    {
-                       child = nextChild;
-                    }
-                }
-            }
-        }
-        else
-        {
-            LGRN_ASSERT( ! treeToId[0].has_value() );
-            treeToId       .resize(1);
-            treeDescendants.resize(1);
-            treeToId[0]         = addme;
-            treeDescendants[0]  = 0;
-            treeposOf[addme]    = 0;
-        }
+        Insert const single{parent, addme};
+        insert(std::span<Insert const>{&single, 1});
     }
 
+    /**
+     * @brief Add many cospaces to the tree at once
+     *
+     * New cospaces are placed after the existing children of their parent, in the order given.
+     * Costs O(batch size + tree size).
+     */
+    void insert(std::span<Insert const> batch);
+
+    /**
+     * @brief Remove cospaces and all of their descendants from the tree
+     *
+     * Cospaces that are descendants of others in the same call are ignored. Does not release
+     * CoSpaceIds. Costs O(roots log roots + tree size).
+     */
+    void remove(std::span<CoSpaceId const> roots);
+
     lgrn::IdRegistryStl<CoSpaceId>              ids;
     lgrn::IdRefCount<CoSpaceId>                 refCounts;
 
     osp::KeyedVec<CoSpaceId, CospaceTransform>  transformOf;
     osp::KeyedVec<CoSpaceId, TreePos_t>         treeposOf;
+    osp::KeyedVec<CoSpaceId, CoSpaceId>         parentOf;
 
     osp::KeyedVec<TreePos_t, CoSpaceId>         treeToId{{lgrn::id_null<CoSpaceId>()}};
     osp::KeyedVec<TreePos_t, std::uint32_t>     treeDescendants{std::initializer_list<std::uint32_t>{0}};
@@ -239,6 +216,29 @@ struct SatIdIndexPair
     std::uint32_t   accessorIdx;
 };
 
+/**
+ * @brief Typed read-only view of a single component of a DataAccessor
+ *
+ * Resolved once from DataAccessor::components, then indexed directly. Elements are read with
+ * memcpy as components may be tightly packed without alignment (see transfer buffers), which
+ * compiles to plain loads and still allows loops over views to be vectorized.
+ */
+template <typename T>
+struct ComponentView
+{
+    [[nodiscard]] T operator[](std::size_t const index) const noexcept
+    {
+        T out;
+        std::memcpy(&out, pos + stride * std::ptrdiff_t(index), sizeof(T));
+        return out;
+    }
+
+    [[nodiscard]] constexpr bool has_value() const noexcept { return pos != nullptr; }
+
+    std::byte const     *pos    {nullptr};
+    std::ptrdiff_t      stride  {0};
+};
+
 struct DataAccessor
 {
     enum class IterationMethod : std::uint8_t { Dense, SkipNullSatellites, IndexOnly };
@@ -322,6 +322,20 @@ struct DataAccessor
         return out;
     }
 
+    /**
+     * @brief Get a typed view of a component, or an empty view if the component isn't present
+     */
+    template<typename T>
+    [[nodiscard]] ComponentView<T> view(ComponentTypeId const compType) const
+    {
+        auto const it = components.find(compType);
+        if (it != components.cend())
+        {
+            return { .pos = it->second.pos, .stride = it->second.stride };
+        }
+        return {};
+    }
+
     //std::vector<SatIdIndexPair> todo;
     std::string         debugName;
     CompMap_t           components;
@@ -338,6 +352,104 @@ inline DataAccessor::Component make_comp(T const* ptr, std::ptrdiff_t stride)
     return {reinterpret_cast<std::byte const*>(ptr), stride};
 }
 
+/**
+ * @brief Typed views of all DefaultComponents of a DataAccessor
+ *
+ * Alternative to DataAccessor::iterate that does all component lookups once, then allows indexing
+ * each component directly by element. Views of components not present are empty.
+ */
+struct DefaultComponentViews
+{
+    [[nodiscard]] bool has_pos()  const noexcept { return posX .has_value() && posY .has_value() && posZ .has_value(); }
+    [[nodiscard]] bool has_vel()  const noexcept { return velX .has_value() && velY .has_value() && velZ .has_value(); }
+    [[nodiscard]] bool has_veld() const noexcept { return velXd.has_value() && velYd.has_value() && velZd.has_value(); }
+    [[nodiscard]] bool has_rot()  const noexcept { return rotX .has_value() && rotY .has_value() && rotZ .has_value() && rotW.has_value(); }
+
+    ComponentView<SatelliteId>  satId;
+    ComponentView<spaceint_t>   posX;
+    ComponentView<spaceint_t>   posY;
+    ComponentView<spaceint_t>   posZ;
+    ComponentView<float>        velX;
+    ComponentView<float>        velY;
+    ComponentView<float>        velZ;
+    ComponentView<double>       velXd;
+    ComponentView<double>       velYd;
+    ComponentView<double>       velZd;
+    ComponentView<float>        accelX;
+    ComponentView<float>        accelY;
+    ComponentView<float>        accelZ;
+    ComponentView<float>        rotX;
+    ComponentView<float>        rotY;
+    ComponentView<float>        rotZ;
+    ComponentView<float>        rotW;
+    ComponentView<float>        radius;
+    ComponentView<float>        surface;
+};
+
+[[nodiscard]] inline DefaultComponentViews view_defaults(DataAccessor const &rAccessor, DefaultComponents const &dc)
+{
+    return {
+        .satId   = rAccessor.view<SatelliteId>(dc.satId),
+        .posX    = rAccessor.view<spaceint_t>(dc.posX),
+        .posY    = rAccessor.view<spaceint_t>(dc.posY),
+        .posZ    = rAccessor.view<spaceint_t>(dc.posZ),
+        .velX    = rAccessor.view<float>(dc.velX),
+        .velY    = rAccessor.view<float>(dc.velY),
+        .velZ    = rAccessor.view<float>(dc.velZ),
+        .velXd   = rAccessor.view<double>(dc.velXd),
+        .velYd   = rAccessor.view<double>(dc.velYd),
+        .velZd   = rAccessor.view<double>(dc.velZd),
+        .accelX  = rAccessor.view<float>(dc.accelX),
+        .accelY  = rAccessor.view<float>(dc.accelY),
+        .accelZ  = rAccessor.view<float>(dc.accelZ),
+        .rotX    = rAccessor.view<float>(dc.rotX),
+        .rotY    = rAccessor.view<float>(dc.rotY),
+        .rotZ    = rAccessor.view<float>(dc.rotZ),
+        .rotW    = rAccessor.view<float>(dc.rotW),
+        .radius  = rAccessor.view<float>(dc.radius),
+        .surface = rAccessor.view<float>(dc.surface)
+    };
+}
+
+/**
+ * @brief Write a bitmask of which elements have a non-null SatelliteId
+ *
+ * Used for DataAccessor::IterationMethod::SkipNullSatellites. Iterate the result with
+ * rOut.ones() to visit only valid satellites, skipping 64 null elements at a time.
+ *
+ * @param satIds    [in] SatelliteId component view
+ * @param count     [in] Number of elements in the accessor
+ * @param rOut      [out] Bitmask, resized to fit count
+ */
+inline void non_null_satellite_mask(ComponentView<SatelliteId> const satIds, std::size_t const count, BitVector_t &rOut)
+{
+    bitvector_resize(rOut, count);
+
+    std::vector<bitint_t> &rInts = rOut.ints();
+    std::size_t const fullInts = count / 64;
+
+    for (std::size_t intIdx = 0; intIdx < fullInts; ++intIdx)
+    {
+        bitint_t bits = 0;
+        for (std::size_t bit = 0; bit < 64; ++bit)
+        {
+            bits |= bitint_t(satIds[intIdx * 64 + bit].has_value()) << bit;
+        }
+        rInts[intIdx] = bits;
+    }
+
+    if (std::size_t const remainder = count % 64;
+        remainder != 0)
+    {
+        bitint_t bits = 0;
+        for (std::size_t bit = 0; bit < remainder; ++bit)
+        {
+            bits |= bitint_t(satIds[fullInts * 64 + bit].has_value()) << bit;
+        }
+        rInts[fullInts] = bits;
+    }
+}
+
 struct UCtxDataAccessors
 {
     using AccessorVec_t = std::vector<DataAccessorId>;
@@ -360,13 +472,72 @@ struct UCtxStolenSatellites
 {
     struct OfAccessor
     {
-        std::set<SatelliteId>   sats;
+        /// Bit i is set if the satellite at index i of the accessor is stolen. Only used if dirty.
+        BitVector_t             stolen;
         bool                    allStolen = false;
         bool                    dirty = false;
 
-        bool has(SatelliteId satId) const noexcept
+        /**
+         * @param index [in] Satellite's index within the accessor, not its SatelliteId
+         */
+        bool has(std::size_t const index) const noexcept
+        {
+            return allStolen || (dirty && index / 64 < stolen.ints().size() && (stolen.ints()[index / 64] >> (index % 64)) & 1u);
+        }
+
+        /**
+         * @brief Mark accessor indices [first, first+count) as stolen
+         */
+        void steal(std::size_t const first, std::size_t const count = 1)
+        {
+            std::size_t const last = first + count;
+            if (stolen.ints().size() * 64 < last)
+            {
+                bitvector_resize(stolen, last);
+            }
+
+            std::vector<bitint_t> &rInts = stolen.ints();
+            for (std::size_t i = first; i < last; )
+            {
+                // Set up to 64 bits at a time
+                std::size_t const bit  = i % 64;
+                std::size_t const bits = std::min<std::size_t>(64 - bit, last - i);
+                bitint_t    const mask = (bits == 64) ? ~bitint_t(0) : (((bitint_t(1) << bits) - 1) << bit);
+                rInts[i / 64] |= mask;
+                i += bits;
+            }
+            dirty = true;
+        }
+
+        /**
+         * @brief Un-steal all satellites, such as when the accessor is deleted
+         */
+        void clear() noexcept
         {
-            return allStolen || (dirty && sats.contains(satId));
+            std::fill(stolen.ints().begin(), stolen.ints().end(), 0);
+            allStolen   = false;
+            dirty       = false;
+        }
+
+        /**
+         * @brief Clear bits of stolen satellites from a mask of accessor indices, such as from
+         *        non_null_satellite_mask. Done 64 satellites at a time.
+         */
+        void remove_stolen(BitVector_t &rMask) const noexcept
+        {
+            std::vector<bitint_t> &rInts = rMask.ints();
+            if (allStolen)
+            {
+                std::fill(rInts.begin(), rInts.end(), 0);
+            }
+            else if (dirty)
+            {
+                std::size_t const size = std::min(rInts.size(), stolen.ints().size());
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    rInts[i] &= ~stolen.ints()[i];
+                }
+            }
         }
     };
 
@@ -437,21 +608,37 @@ struct UCtxDataSources
     osp::KeyedVec<SatelliteId, DataSourceOwner_t>   datasrcOf;
     std::vector<DataSourceChange>                   changes;
 
-    DataSourceId find_datasource(DataSource const& query)
-    {
-        std::size_t const size = query.entries.size();
-        for (DataSourceId const dataSrcId : ids)
-        {
-            DataSource const& candidate = instances[dataSrcId];
-            if (   candidate.entries.size() == size
-                && std::memcmp(candidate.entries.data(), query.entries.data(), size * sizeof(DataSource::Entry)) == 0)
-            {
-                return dataSrcId;
-            }
-        }
-        return {};
-    }
-
+    /// Hash of DataSource::entries bytes -> DataSources with that hash
+    std::unordered_multimap<std::size_t, DataSourceId> index;
+
+    /**
+     * @return Hash of all bytes of a DataSource's entries. Entries must be sorted.
+     */
+    static std::size_t hash_entries(DataSource const& dataSrc) noexcept;
+
+    /**
+     * @brief Find an existing DataSource with the exact same entries as query
+     *
+     * @return DataSourceId found, or null if none match
+     */
+    DataSourceId find_datasource(DataSource const& query) const;
+
+    /**
+     * @brief Create a new DataSource, must not be a duplicate of an existing one
+     */
+    DataSourceId make_datasource(DataSource &&dataSrc);
+
+    /**
+     * @brief Delete a DataSource no longer referenced by any satellites
+     */
+    void remove_datasource(DataSourceId dataSrcId);
+
+    /**
+     * @brief Apply all changes, moving affected satellites to new or existing DataSources
+     *
+     * DataSources that are no longer used afterwards are deleted. Does not clear changes.
+     */
+    void apply_changes();
 };
 
 //-----------------------------------------------------------------------------
@@ -29,6 +29,7 @@
 #include <osp/activescene/basic.h>
 #include <osp/activescene/physics.h>
 #include <osp/core/id_map.h>
+#include <osp/executor/worker_pool.h>
 
 
 #include <Jolt/Jolt.h>
@@ -51,7 +52,9 @@ JPH_SUPPRESS_WARNINGS
 #include <Jolt/Physics/PhysicsSystem.h>
 
 #include <Jolt/Core/Factory.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
 #include <Jolt/Core/JobSystemThreadPool.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
 #include <Jolt/Core/TempAllocator.h>
 
 JPH_SUPPRESS_WARNING_POP
@@ -63,8 +66,12 @@ JPH_SUPPRESS_WARNING_POP
 
 #include <spdlog/spdlog.h>
 
+#include <array>
+#include <atomic>
 #include <iostream>
 #include <cstdarg>
+#include <memory>
+#include <vector>
 #include <osp/util/logging.h>
 
 #include "osp/core/strong_id.h"
@@ -257,6 +264,43 @@ public:
     }
 };
 
+/**
+ * @brief Jolt job system that runs jobs on an osp::exec::WorkerPool
+ *
+ * Lets Jolt share worker threads with the framework executor instead of starting its own, so
+ * the two don't oversubscribe cores. Job bookkeeping is the same as JPH::JobSystemThreadPool.
+ */
+class WorkerPoolJobSystem final : public JPH::JobSystemWithBarrier
+{
+public:
+
+    WorkerPoolJobSystem(osp::exec::WorkerPool &rPool, JPH::uint maxJobs, JPH::uint maxBarriers);
+
+    /**
+     * @brief Wait for the pool to drop its references to jobs that were already run by a thread
+     *        waiting on a barrier, but are still queued
+     */
+    ~WorkerPoolJobSystem() override;
+
+    int GetMaxConcurrency() const override;
+
+    JobHandle CreateJob(const char *inName, JPH::ColorArg inColor, const JobFunction &inJobFunction, JPH::uint32 inNumDependencies = 0) override;
+
+protected:
+
+    void QueueJob(Job *inJob) override;
+    void QueueJobs(Job **inJobs, JPH::uint inNumJobs) override;
+    void FreeJob(Job *inJob) override;
+
+private:
+
+    static void run_job(void *pUserData, std::uint32_t index) noexcept;
+
+    JPH::FixedSizeFreeList<Job>     m_jobs;
+    osp::exec::WorkerPool           &m_rPool;
+    std::atomic<std::uint32_t>      m_queued{0}; ///< Jobs queued in m_rPool and not yet released
+};
+
 struct ACtxJoltWorld;
 
 //The physics callback to sync bodies between osp and jolt
@@ -271,6 +315,18 @@ public:
     ACtxBasic     *m_pCtxBasic      {nullptr};
     ACtxPhysics   *m_pCtxPhysics    {nullptr};
     ACtxJoltWorld *m_pCtxJoltWorld  {nullptr};
+
+private:
+
+    /**
+     * @brief Apply force factors and sync transforms for bodies [first, last) of m_bodies
+     *
+     * Each body is only touched by one call, so calls for disjoint ranges can run in parallel.
+     */
+    void update_bodies(std::size_t first, std::size_t last) noexcept;
+
+    std::vector<BodyId>         m_bodies;
+    std::vector<JPH::BodyID>    m_activate;
 };
 
 using ShapeStorage_t = osp::Storage_t<osp::active::ActiveEnt, JPH::Ref<JPH::Shape>>;
@@ -281,12 +337,82 @@ using ShapeStorage_t = osp::Storage_t<osp::active::ActiveEnt, JPH::Ref<JPH::Shap
 struct ACtxJoltWorld
 {
 public:
+    /**
+     * @brief Adds to the force and torque of a body each physics step
+     *
+     * Called in parallel for different bodies from Jolt's job system. Functions must only read
+     * from the world and from user data.
+     */
     struct ForceFactorFunc
     {
-        using Func_t = void (*)(BodyId bodyId, ACtxJoltWorld const&, entt::any, osp::Vector3&, osp::Vector3&) noexcept;
+        using UserData_t = std::array<void*, 6u>;
+        using Func_t = void (*)(JPH::Body const& rBody, BodyId bodyId, ACtxJoltWorld const&, UserData_t const&, osp::Vector3&, osp::Vector3&) noexcept;
 
         Func_t      m_func{nullptr};
-        entt::any   m_userData;
+        UserData_t  m_userData{};
+    };
+
+    /**
+     * @brief Mass of entities summed about the origin of their body
+     *
+     * Kept as sums so entities can be added and subtracted as they change. Converted to mass
+     * properties about the center of mass by SysJolt::compound_mass_properties.
+     */
+    struct MassSum
+    {
+        MassSum& operator+=(MassSum const& rhs) noexcept
+        {
+            inertia     += rhs.inertia;
+            inertiaPos  += rhs.inertiaPos;
+            mass        += rhs.mass;
+            return *this;
+        }
+
+        MassSum& operator-=(MassSum const& rhs) noexcept
+        {
+            inertia     -= rhs.inertia;
+            inertiaPos  -= rhs.inertiaPos;
+            mass        -= rhs.mass;
+            return *this;
+        }
+
+        osp::Matrix3    inertia     {0.0f}; ///< Inertia tensors about the origin
+        osp::Vector3    inertiaPos  {0.0f}; ///< mass * position of the inertia tensors
+        float           mass        {0.0f};
+    };
+
+    /**
+     * @brief Body with a MutableCompoundShape that is changed in place as its colliders change
+     */
+    struct CompoundBody
+    {
+        JPH::Ref<JPH::MutableCompoundShape>     shape;
+
+        /// Entities with a collider or mass that are part of this body
+        std::vector<osp::active::ActiveEnt>     members;
+
+        /// Entity of each sub-shape of the compound, by sub-shape index
+        std::vector<osp::active::ActiveEnt>     subShapeEnts;
+
+        MassSum                                 mass;
+    };
+
+    /**
+     * @brief An entity's part in a CompoundBody
+     */
+    struct CompoundMember
+    {
+        static constexpr std::uint32_t sc_noSubShape = ~std::uint32_t(0);
+
+        BodyId          body;
+        std::uint32_t   memberIndex;
+        std::uint32_t   subShape        {sc_noSubShape};
+
+        /// Sub-shape transform relative to the body, needed to move it to a different index
+        JPH::Vec3       position        {JPH::Vec3::sZero()};
+        JPH::Quat       rotation        {JPH::Quat::sIdentity()};
+
+        MassSum         mass;
     };
 
     JPH::PhysicsSystem                                  m_physicsSystem;
@@ -295,7 +421,7 @@ public:
     ObjectLayerPairFilterImpl                           m_objectLayerFilter;
     BPLayerInterfaceImpl                                m_bplInterface;
     ObjectVsBroadPhaseLayerFilterImpl                   m_objectVsBPLFilter;
-    JPH::JobSystemThreadPool                            m_jobSystem;
+    std::unique_ptr<JPH::JobSystem>                     m_pJobSystem;
 
     PhysicsStepListenerImpl                             m_listener;
 
@@ -309,6 +435,10 @@ public:
     std::vector<ForceFactorFunc>                        m_factors;
     ShapeStorage_t                                      m_shapes;
 
+    osp::IdMap_t<BodyId, CompoundBody>                  m_compoundBodies;
+    osp::IdMap_t<osp::active::ActiveEnt, CompoundMember> m_compoundMembers;
+    std::vector<BodyId>                                 m_compoundDirty;
+
     //osp::active::ACompTransformStorage_t                *m_pTransform{nullptr};
 
     bool m_allDirty{}; ///< if true, update all positions
@@ -319,15 +449,21 @@ private:
 
 // The default values are the one suggested in the Jolt hello world exemple for a "real" project.
 // It might be overkill here.
+//
+// threadCount is passed to JPH::JobSystemThreadPool, where -1 uses all cores but one. If
+// pSharedPool is given and has worker threads, Jolt jobs run on it instead and threadCount is
+// ignored.
 inline void setup_jolt_world(
-    ACtxJoltWorld   &rCtxJoltWorld,
-    int             threadCount             = 2,
-    JPH::uint       maxBodies               = 65536,
-    JPH::uint       numBodyMutexes          = 0,
-    JPH::uint       maxBodyPairs            = 65536,
-    JPH::uint       maxContactConstraints   = 10240)
+    ACtxJoltWorld           &rCtxJoltWorld,
+    int                     threadCount             = 2,
+    std::size_t             tempAllocatorSize       = 10 * 1024 * 1024,
+    osp::exec::WorkerPool   *pSharedPool            = nullptr,
+    JPH::uint               maxBodies               = 65536,
+    JPH::uint               numBodyMutexes          = 0,
+    JPH::uint               maxBodyPairs            = 65536,
+    JPH::uint               maxContactConstraints   = 10240)
 {
-    rCtxJoltWorld.m_oAllocator.emplace(10 * 1024 * 1024);
+    rCtxJoltWorld.m_oAllocator.emplace(JPH::uint(tempAllocatorSize));
 
     rCtxJoltWorld.m_physicsSystem.Init(
         maxBodies,
@@ -338,7 +474,14 @@ inline void setup_jolt_world(
         rCtxJoltWorld.m_objectVsBPLFilter,
         rCtxJoltWorld.m_objectLayerFilter);
 
-    rCtxJoltWorld.m_jobSystem.Init(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, threadCount);
+    if (pSharedPool != nullptr && pSharedPool->thread_count() != 0)
+    {
+        rCtxJoltWorld.m_pJobSystem = std::make_unique<WorkerPoolJobSystem>(*pSharedPool, JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
+    }
+    else
+    {
+        rCtxJoltWorld.m_pJobSystem = std::make_unique<JPH::JobSystemThreadPool>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, threadCount);
+    }
 
     // gravity is handled on the OSP side
     rCtxJoltWorld.m_physicsSystem.SetGravity(JPH::Vec3Arg::sZero());
@@ -26,6 +26,9 @@
 #include "joltinteg_fn.h"          // IWYU pragma: associated
 #include <osp/activescene/basic_fn.h>
 
+#include <algorithm>                 // for std::min, std::max, std::remove, std::sort, std::unique
+#include <thread>                    // for std::this_thread::yield
+#include <optional>                  // for std::make_optional
 #include <utility>                   // for std::exchange
 #include <cassert>                   // for assert
 
@@ -40,13 +43,19 @@ using namespace Magnum::Math::Literals;
 using osp::EShape;
 
 using osp::active::ActiveEnt;
+using osp::active::ACompMass;
 using osp::active::ACtxPhysics;
 using osp::active::SysSceneGraph;
 
 using osp::Matrix3;
 using osp::Matrix4;
+using osp::Quaternion;
 using osp::Vector3;
 
+using CompoundBody      = ACtxJoltWorld::CompoundBody;
+using CompoundMember    = ACtxJoltWorld::CompoundMember;
+using MassSum           = ACtxJoltWorld::MassSum;
+
 using Corrade::Containers::ArrayView;
 
 void SysJolt::update_world(
@@ -61,18 +70,152 @@ void SysJolt::update_world(
     rJoltWorld.m_listener.m_pCtxPhysics      = &rPhys;
     rJoltWorld.m_listener.m_pCtxJoltWorld    = &rJoltWorld;
 
+    update_translate(rBasic, rJoltWorld);
+
     // calls PhysicsStepListenerImpl::OnStep
-    rJoltWorld.m_physicsSystem.Update(timestep, collisionSteps, &rJoltWorld.m_oAllocator.value(), &rJoltWorld.m_jobSystem);
+    rJoltWorld.m_physicsSystem.Update(timestep, collisionSteps, &rJoltWorld.m_oAllocator.value(), rJoltWorld.m_pJobSystem.get());
+}
+
+WorkerPoolJobSystem::WorkerPoolJobSystem(osp::exec::WorkerPool &rPool, JPH::uint const maxJobs, JPH::uint const maxBarriers)
+ : JPH::JobSystemWithBarrier(maxBarriers)
+ , m_rPool{rPool}
+{
+    m_jobs.Init(maxJobs, maxJobs);
+}
+
+WorkerPoolJobSystem::~WorkerPoolJobSystem()
+{
+    while (m_queued.load(std::memory_order_acquire) != 0)
+    {
+        if ( ! m_rPool.try_run_one() )
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+int WorkerPoolJobSystem::GetMaxConcurrency() const
+{
+    // Workers + the thread waiting on a barrier, which helps run jobs
+    return int(m_rPool.thread_count()) + 1;
+}
+
+JPH::JobHandle WorkerPoolJobSystem::CreateJob(const char *inName, JPH::ColorArg inColor, const JobFunction &inJobFunction, JPH::uint32 inNumDependencies)
+{
+    JPH::uint32 index;
+    while (true)
+    {
+        index = m_jobs.ConstructObject(inName, inColor, this, inJobFunction, inNumDependencies);
+        if (index != JPH::FixedSizeFreeList<Job>::cInvalidObjectIndex)
+        {
+            break;
+        }
+        // Out of jobs. Wait for running ones to finish, helping out if possible
+        if ( ! m_rPool.try_run_one() )
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    Job *pJob = &m_jobs.Get(index);
+
+    // Construct the handle before queueing, as the job may be freed as soon as it finishes
+    JobHandle handle(pJob);
+
+    if (inNumDependencies == 0)
+    {
+        QueueJob(pJob);
+    }
+
+    return handle;
+}
+
+void WorkerPoolJobSystem::QueueJob(Job *inJob)
+{
+    // Reference held by the queue, released in run_job
+    inJob->AddRef();
+    m_queued.fetch_add(1, std::memory_order_relaxed);
+    m_rPool.submit({ .func = &run_job, .pUserData = inJob });
+}
+
+void WorkerPoolJobSystem::QueueJobs(Job **inJobs, JPH::uint inNumJobs)
+{
+    for (JPH::uint i = 0; i < inNumJobs; ++i)
+    {
+        QueueJob(inJobs[i]);
+    }
+}
+
+void WorkerPoolJobSystem::FreeJob(Job *inJob)
+{
+    m_jobs.DestructObject(inJob);
+}
+
+void WorkerPoolJobSystem::run_job(void *pUserData, std::uint32_t) noexcept
+{
+    Job *pJob = static_cast<Job*>(pUserData);
+
+    // The job may be freed by Release
+    auto &rJobSystem = *static_cast<WorkerPoolJobSystem*>(pJob->GetJobSystem());
+
+    pJob->Execute();
+    pJob->Release();
+
+    rJobSystem.m_queued.fetch_sub(1, std::memory_order_release);
+}
+
+void SysJolt::update_translate(ACtxBasic const& rCtxBasic, ACtxJoltWorld& rCtxWorld) noexcept
+{
+    if (rCtxBasic.m_translateOrigin.isZero())
+    {
+        return;
+    }
+
+    JPH::Vec3 const translate = Vec3MagnumToJolt(rCtxBasic.m_translateOrigin);
+
+    // Not stepping yet and nothing else touches the world during this task, no locks needed.
+    // SetPosition only re-adds the shape's center-of-mass offset to the new position and updates
+    // the body's bounds in the broadphase. Mass properties and shapes are left untouched.
+    //
+    // The broadphase is notified once per body. BodyInterface has no way to move many bodies and
+    // update their bounds at once; RemoveBodies followed by AddBodiesPrepare/Finalize would, but
+    // removing bodies deactivates them, losing their velocities and sleep state.
+    JPH::BodyInterface &rBodyInterface = rCtxWorld.m_physicsSystem.GetBodyInterfaceNoLock();
+
+    for (BodyId const bodyId : rCtxWorld.m_bodyIds)
+    {
+        JPH::BodyID const joltBodyId = BToJolt(bodyId);
+
+        // As we are translating the whole world, we don't need to wake up asleep bodies.
+        rBodyInterface.SetPosition(joltBodyId, rBodyInterface.GetPosition(joltBodyId) - translate, JPH::EActivation::DontActivate);
+    }
 }
 
 void SysJolt::remove_components(ACtxJoltWorld& rCtxWorld, ActiveEnt ent) noexcept
 {
+    if (rCtxWorld.m_compoundMembers.contains(ent))
+    {
+        remove_member(rCtxWorld, ent);
+    }
+    rCtxWorld.m_shapes.remove(ent);
+
     auto itBodyId = rCtxWorld.m_entToBody.find(ent);
     JPH::BodyInterface &bodyInterface = rCtxWorld.m_physicsSystem.GetBodyInterface();
 
     if (itBodyId != rCtxWorld.m_entToBody.end())
     {
         BodyId const bodyId = itBodyId->second;
+
+        auto const itCompound = rCtxWorld.m_compoundBodies.find(bodyId);
+        if (itCompound != rCtxWorld.m_compoundBodies.end())
+        {
+            for (ActiveEnt const member : itCompound->second.members)
+            {
+                rCtxWorld.m_compoundMembers.erase(member);
+            }
+            rCtxWorld.m_compoundBodies.erase(itCompound);
+        }
+
         JPH::BodyID joltBodyId = BToJolt(bodyId);
         bodyInterface.RemoveBody(joltBodyId);
         bodyInterface.DestroyBody(joltBodyId);
@@ -176,112 +319,485 @@ void SysJolt::find_shapes_recurse(
 
 }
 
-//TODO this is locking on all bodies. Is it bad ?
-//The easy fix is to provide multiple step listeners for disjoint sets of bodies, which can then run in parallel.
-//It might not be worth it considering this function should be quite fast.
-void PhysicsStepListenerImpl::OnStep(float inDeltaTime, JPH::PhysicsSystem &rPhysicsSystem)
+JPH::Ref<JPH::MutableCompoundShape> SysJolt::create_compound(
+        ACtxPhysics const&          rCtxPhys,
+        ACtxJoltWorld&              rCtxWorld,
+        ACtxBasic const&            rBasic,
+        ActiveEnt const             root,
+        BodyId const                bodyId)
 {
-    JPH::BodyInterface &bodyInterface = rPhysicsSystem.GetBodyInterfaceNoLock();
-    JPH::BodyLockInterfaceNoLock const &bodyLockInterface = rPhysicsSystem.GetBodyLockInterfaceNoLock();
+    CompoundBody &rBody = rCtxWorld.m_compoundBodies[bodyId];
 
-    bool const doOriginTranslation = !m_pCtxBasic->m_translateOrigin.isZero();
-    JPH::Vec3 const translateOrigin = Vec3MagnumToJolt(m_pCtxBasic->m_translateOrigin);
+    JPH::MutableCompoundShapeSettings compound;
 
+    compound_collect_recurse(rCtxPhys, rCtxWorld, rBasic, root, Matrix4{}, bodyId, rBody, compound);
 
-//    if (!translateOrigin.isZero())
-//    {
-//        JPH::BodyIDVector allBodiesIds;
-//        pJoltWorld->GetBodies(allBodiesIds);
+    // Sub-shapes are created in the same order they're added to the settings, so sub-shape
+    // indices recorded by compound_collect_recurse are valid.
+    JPH::Ref<JPH::Shape> const pShape = compound.Create().Get();
+    rBody.shape = static_cast<JPH::MutableCompoundShape*>(pShape.GetPtr());
 
-//        JPH::BodyInterface &bodyInterface = pJoltWorld->GetBodyInterface();
+    return rBody.shape;
+}
 
-//        // Translate every jolt body
-//        for (JPH::BodyID bodyId : allBodiesIds)
-//        {
-//            JPH::RVec3 position = bodyInterface.GetPosition(bodyId);S
-//            Matrix4 matrix;
-//            position -= Vec3MagnumToJolt(translateOrigin);
-//            //As we are translating the whole world, we don't need to wake up asleep bodies.
-//            bodyInterface.SetPosition(bodyId, position, JPH::EActivation::DontActivate);
-//        }
-//    }
+void SysJolt::compound_collect_recurse(
+        ACtxPhysics const&          rCtxPhys,
+        ACtxJoltWorld&              rCtxWorld,
+        ACtxBasic const&            rBasic,
+        ActiveEnt const             ent,
+        Matrix4 const&              transform,
+        BodyId const                bodyId,
+        CompoundBody&               rBody,
+        JPH::MutableCompoundShapeSettings& rCompound)
+{
+    EShape const shape      = rCtxPhys.m_shape[ent];
+    bool   const hasMass    = rCtxPhys.m_mass.contains(ent);
 
-    // Apply changed velocities
-    for (auto const& [ent, vel] : m_pCtxPhysics->m_setVelocity)
+    if (shape != EShape::None || hasMass)
     {
-        JPH::BodyID const joltBodyId     = BToJolt(m_pCtxJoltWorld->m_entToBody.at(ent));
+        CompoundMember member{ .body = bodyId, .memberIndex = std::uint32_t(rBody.members.size()) };
+        rBody.members.push_back(ent);
 
-        bodyInterface.SetLinearVelocity(joltBodyId, Vec3MagnumToJolt(vel));
+        if (shape != EShape::None)
+        {
+            member.subShape = std::uint32_t(rBody.subShapeEnts.size());
+            member.position = Vec3MagnumToJolt(transform.translation());
+            member.rotation = QuatMagnumToJolt(Quaternion::fromMatrix(transform.rotation()));
+            rBody.subShapeEnts.push_back(ent);
+
+            rCompound.AddShape(member.position, member.rotation,
+                               collider_shape(rCtxWorld, ent, shape, transform.scaling()));
+        }
+
+        if (hasMass)
+        {
+            member.mass = member_mass(rCtxPhys.m_mass.get(ent), transform);
+            rBody.mass += member.mass;
+        }
+
+        rCtxWorld.m_compoundMembers.insert_or_assign(ent, member);
     }
-    m_pCtxPhysics->m_setVelocity.clear();
 
+    if ( ! rCtxPhys.m_hasColliders.contains(ent) )
+    {
+        return;
+    }
 
-    for (BodyId bodyId : m_pCtxJoltWorld->m_bodyIds)
+    // Recurse into children if there are more colliders
+    for (ActiveEnt const child : SysSceneGraph::children(rBasic.m_scnGraph, ent))
     {
-        JPH::BodyID joltBodyId = BToJolt(bodyId);
+        if (rBasic.m_transform.contains(child))
+        {
+            Matrix4 const childMatrix = transform * rBasic.m_transform.get(child).m_transform;
+
+            compound_collect_recurse(rCtxPhys, rCtxWorld, rBasic, child, childMatrix, bodyId, rBody, rCompound);
+        }
+    }
+}
 
-        bool        updateOspTf     = false;
-        bool        forcesDirty     = false;
+JPH::MassProperties SysJolt::compound_mass_properties(MassSum const& mass, Vector3 const about) noexcept
+{
+    // Parallel axis theorem from the body origin to 'about', expanded so it only needs the sums
+    // kept in MassSum:  I = S - 2(A.c)E + Ac' + cA' + M(|c|^2 E - cc')
+    auto const outer = [] (Vector3 const a, Vector3 const b) noexcept
+    {
+        return Matrix3{a * b.x(), a * b.y(), a * b.z()};
+    };
 
-        JPH::Vec3 newPos;
-        JPH::Quat newRot;
+    Vector3 const& A = mass.inertiaPos;
+    Vector3 const& c = about;
 
-        ActiveEnt const ent = m_pCtxJoltWorld->m_bodyToEnt[bodyId];
+    Matrix3 const inertia = mass.inertia
+                          + Matrix3{} * (mass.mass * c.dot() - 2.0f * Magnum::Math::dot(A, c))
+                          + outer(A, c) + outer(c, A)
+                          - outer(c, c) * mass.mass;
 
-        JPH::BodyLockWrite lock(bodyLockInterface, joltBodyId);
+    Matrix4 const inertiaMat4{inertia};
 
-        JPH::Body &rBody = lock.GetBody();
+    JPH::MassProperties massProp;
+    massProp.mMass = mass.mass;
+    massProp.mInertia = JPH::Mat44::sLoadFloat4x4((JPH::Float4*) inertiaMat4.data());
+    return massProp;
+}
 
-        if (rBody.IsDynamic())
-        {
-            updateOspTf = true;
+void SysJolt::update_compounds(
+        ACtxBasic const&            rBasic,
+        ACtxPhysics&                rCtxPhys,
+        ACtxJoltWorld&              rCtxWorld) noexcept
+{
+    if (rCtxWorld.m_compoundBodies.empty())
+    {
+        rCtxPhys.m_colliderDirty.clear();
+        return;
+    }
 
-            //Force and torque osp -> jolt
-            Vector3 force{0.0f};
-            Vector3 torque{0.0f};
+    ACtxSceneGraph const &rScnGraph = rBasic.m_scnGraph;
 
-            LGRN_ASSERT(ForceFactors_t{}.size() == 64u);
-            auto const factorsInts = std::initializer_list<std::uint64_t>{m_pCtxJoltWorld->m_bodyFactors[bodyId].to_ullong()};
-            auto const factorsBits = lgrn::bit_view(factorsInts);
+    for (ActiveEnt const ent : rCtxPhys.m_colliderDirty)
+    {
+        update_member(rBasic, rCtxPhys, rCtxWorld, ent);
 
-            for (std::size_t const factorIdx : factorsBits.ones())
+        // Transforms of descendants relative to the body change along with this entity's
+        if (   rCtxPhys.m_hasColliders.contains(ent)
+            && rScnGraph.m_entToTreePos[ent] != lgrn::id_null<osp::active::TreePos_t>())
+        {
+            for (ActiveEnt const descendant : SysSceneGraph::descendants(rScnGraph, ent))
             {
-                ACtxJoltWorld::ForceFactorFunc const& factor = m_pCtxJoltWorld->m_factors[factorIdx];
-                factor.m_func(bodyId, *m_pCtxJoltWorld, factor.m_userData, force, torque);
+                update_member(rBasic, rCtxPhys, rCtxWorld, descendant);
             }
+        }
+    }
+
+    rCtxPhys.m_colliderDirty.clear();
+
+    finalize_compounds(rCtxWorld);
+}
+
+void SysJolt::update_member(
+        ACtxBasic const&            rBasic,
+        ACtxPhysics const&          rCtxPhys,
+        ACtxJoltWorld&              rCtxWorld,
+        ActiveEnt const             ent) noexcept
+{
+    // Find the compound body this entity is part of, and its transform relative to the body.
+    // Follows the same rules as compound_collect_recurse: colliders are only searched for under
+    // entities with m_hasColliders, and each entity along the way needs a transform.
+    BodyId      bodyId;
+    Matrix4     transform;
+    ActiveEnt   cur = ent;
+    while (true)
+    {
+        auto const itBody = rCtxWorld.m_entToBody.find(cur);
+        if (itBody != rCtxWorld.m_entToBody.end() && rCtxWorld.m_compoundBodies.contains(itBody->second))
+        {
+            bodyId = itBody->second;
+            break;
+        }
+
+        if ( ! rBasic.m_transform.contains(cur) )
+        {
+            break;
+        }
+
+        transform = rBasic.m_transform.get(cur).m_transform * transform;
+        cur = rBasic.m_scnGraph.m_entParent[cur];
+
+        if ( cur == lgrn::id_null<ActiveEnt>() || ! rCtxPhys.m_hasColliders.contains(cur) )
+        {
+            break;
+        }
+    }
+
+    bool   const attached   = bodyId.has_value();
+    EShape const shape      = attached ? rCtxPhys.m_shape[ent] : EShape::None;
+    bool   const hasMass    = attached && rCtxPhys.m_mass.contains(ent);
 
-            forcesDirty = true;
+    auto itMember = rCtxWorld.m_compoundMembers.find(ent);
 
-            rBody.AddForce(Vec3MagnumToJolt(force));
-            rBody.AddTorque(Vec3MagnumToJolt(torque));
+    if (itMember != rCtxWorld.m_compoundMembers.end() && (itMember->second.body != bodyId || (shape == EShape::None && ! hasMass)))
+    {
+        // Moved to a different body, detached, or no longer has anything to contribute
+        remove_member(rCtxWorld, ent);
+        itMember = rCtxWorld.m_compoundMembers.end();
+    }
+
+    if (shape == EShape::None && ! hasMass)
+    {
+        return;
+    }
+
+    CompoundBody &rBody = rCtxWorld.m_compoundBodies.at(bodyId);
+
+    if (itMember == rCtxWorld.m_compoundMembers.end())
+    {
+        itMember = rCtxWorld.m_compoundMembers.emplace(ent, CompoundMember{
+                .body           = bodyId,
+                .memberIndex    = std::uint32_t(rBody.members.size()) }).first;
+        rBody.members.push_back(ent);
+    }
+
+    CompoundMember &rMember = itMember->second;
+
+    rBody.mass -= rMember.mass;
+    rMember.mass = hasMass ? member_mass(rCtxPhys.m_mass.get(ent), transform) : MassSum{};
+    rBody.mass += rMember.mass;
+
+    if (shape != EShape::None)
+    {
+        rMember.position = Vec3MagnumToJolt(transform.translation());
+        rMember.rotation = QuatMagnumToJolt(Quaternion::fromMatrix(transform.rotation()));
+
+        JPH::Ref<JPH::Shape> const pShape = collider_shape(rCtxWorld, ent, shape, transform.scaling());
+
+        if (rMember.subShape == CompoundMember::sc_noSubShape)
+        {
+            rMember.subShape = rBody.shape->AddShape(rMember.position, rMember.rotation, pShape);
+            rBody.subShapeEnts.push_back(ent);
+        }
+        else
+        {
+            rBody.shape->ModifyShape(rMember.subShape, rMember.position, rMember.rotation, pShape);
         }
+    }
+    else if (rMember.subShape != CompoundMember::sc_noSubShape)
+    {
+        remove_sub_shape(rCtxWorld, rBody, std::exchange(rMember.subShape, CompoundMember::sc_noSubShape));
+        rCtxWorld.m_shapes.remove(ent);
+    }
+
+    rCtxWorld.m_compoundDirty.push_back(bodyId);
+}
 
-//        if (doOriginTranslation && JPH::BodyManager::sIsValidBodyPointer(&rBody))
-//        {
-//            // TODO: SetPositionAndRotationInternal is the only way to set position?
-//            //       Some unneeded center-of-mass calculations are involved, can this be fixed?
-//            newPos = rBody.GetPosition() - translateOrigin;
-//            newRot = rBody.GetRotation();
-//            bodyInterface.SetPositionAndRotation(joltBodyId, newPos, newRot, JPH::EActivation::DontActivate);
-//            //rBody.SetPositionAndRotationInternal(newPos, newRot, false);
-//            updateOspTf = true;
-//        }
-
-        if (forcesDirty)
+void SysJolt::remove_member(ACtxJoltWorld& rCtxWorld, ActiveEnt const ent) noexcept
+{
+    auto const itMember = rCtxWorld.m_compoundMembers.find(ent);
+    CompoundMember const member = itMember->second;
+    rCtxWorld.m_compoundMembers.erase(itMember);
+
+    CompoundBody &rBody = rCtxWorld.m_compoundBodies.at(member.body);
+
+    rBody.mass -= member.mass;
+
+    if (member.subShape != CompoundMember::sc_noSubShape)
+    {
+        remove_sub_shape(rCtxWorld, rBody, member.subShape);
+    }
+
+    // Swap-and-pop from the member list
+    ActiveEnt const lastMember = rBody.members.back();
+    if (lastMember != ent)
+    {
+        rBody.members[member.memberIndex] = lastMember;
+        rCtxWorld.m_compoundMembers.at(lastMember).memberIndex = member.memberIndex;
+    }
+    rBody.members.pop_back();
+
+    rCtxWorld.m_compoundDirty.push_back(member.body);
+}
+
+void SysJolt::remove_sub_shape(
+        ACtxJoltWorld&              rCtxWorld,
+        CompoundBody&               rBody,
+        std::uint32_t const         subShape) noexcept
+{
+    // MutableCompoundShape::RemoveShape shifts all following sub-shapes and recalculates their
+    // bounds. Moving the last sub-shape into the removed one's place only touches one.
+    auto const lastSubShape = std::uint32_t(rBody.subShapeEnts.size() - 1);
+    if (subShape != lastSubShape)
+    {
+        ActiveEnt const lastEnt     = rBody.subShapeEnts[lastSubShape];
+        CompoundMember  &rLast      = rCtxWorld.m_compoundMembers.at(lastEnt);
+
+        rBody.shape->ModifyShape(subShape, rLast.position, rLast.rotation, rCtxWorld.m_shapes.get(lastEnt));
+        rBody.subShapeEnts[subShape] = lastEnt;
+        rLast.subShape = subShape;
+    }
+    rBody.shape->RemoveShape(lastSubShape);
+    rBody.subShapeEnts.pop_back();
+}
+
+JPH::Ref<JPH::Shape> SysJolt::collider_shape(
+        ACtxJoltWorld&              rCtxWorld,
+        ActiveEnt const             ent,
+        EShape const                shape,
+        Vector3 const               scale)
+{
+    JPH::Ref<JPH::Shape> pShape = create_primitive(rCtxWorld, shape, Vec3MagnumToJolt(scale));
+    osp::storage_assign(rCtxWorld.m_shapes, ent, std::make_optional(pShape));
+    return pShape;
+}
+
+MassSum SysJolt::member_mass(ACompMass const& mass, Matrix4 const& transform) noexcept
+{
+    Matrix3 inertiaTensor{};
+    inertiaTensor[0][0] = mass.m_inertia.x();
+    inertiaTensor[1][1] = mass.m_inertia.y();
+    inertiaTensor[2][2] = mass.m_inertia.z();
+
+    Vector3 const offset = transform.translation() + mass.m_offset * transform.scaling();
+
+    return {
+        .inertia    = osp::transform_inertia_tensor(inertiaTensor, mass.m_mass, offset, transform.rotation()),
+        .inertiaPos = offset * mass.m_mass,
+        .mass       = mass.m_mass
+    };
+}
+
+void SysJolt::finalize_compounds(ACtxJoltWorld& rCtxWorld) noexcept
+{
+    std::vector<BodyId> &rDirty = rCtxWorld.m_compoundDirty;
+
+    if (rDirty.empty())
+    {
+        return;
+    }
+
+    std::sort(rDirty.begin(), rDirty.end());
+    rDirty.erase(std::unique(rDirty.begin(), rDirty.end()), rDirty.end());
+
+    JPH::BodyInterface              &rBodyInterface = rCtxWorld.m_physicsSystem.GetBodyInterface();
+    JPH::BodyLockInterface const    &rLockInterface = rCtxWorld.m_physicsSystem.GetBodyLockInterface();
+
+    for (BodyId const bodyId : rDirty)
+    {
+        auto const itBody = rCtxWorld.m_compoundBodies.find(bodyId);
+        if (itBody == rCtxWorld.m_compoundBodies.end() || itBody->second.subShapeEnts.empty())
         {
-            bodyInterface.ActivateBody(joltBodyId);
+            continue; // Body was deleted, or has no shapes left to recenter
         }
 
-        if (updateOspTf)
+        CompoundBody        &rBody      = itBody->second;
+        JPH::BodyID const   joltBodyId  = BToJolt(bodyId);
+
+        // The shape was modified in place. NotifyShapeChanged updates the body's bounds, and
+        // moves the body so its colliders stay in place if the center of mass changed.
+        JPH::Vec3 const prevCom = rBody.shape->GetCenterOfMass();
+        rBody.shape->AdjustCenterOfMass();
+        rBodyInterface.NotifyShapeChanged(joltBodyId, prevCom, false, JPH::EActivation::Activate);
+
+        if (rBody.mass.mass <= 0.0f)
         {
-            JPH::Quat a;
-            JPH::Vec3 b;
+            continue;
+        }
 
-            JPH::Vec3 comOffset = rBody.GetRotation() * rBody.GetShape()->GetCenterOfMass();
+        JPH::MassProperties const massProp
+                = compound_mass_properties(rBody.mass, Vec3JoltToMagnum(rBody.shape->GetCenterOfMass()));
 
-            m_pCtxBasic->m_transform.get(ent).m_transform = Matrix4::from(
-                    QuatJoltToMagnum(rBody.GetRotation()).toMatrix(),
-                    Vec3JoltToMagnum(rBody.GetCenterOfMassPosition()) - Vec3JoltToMagnum(comOffset));
+        JPH::Mat44 rotation;
+        JPH::Vec3  diagonal;
+        if ( ! massProp.DecomposePrincipalMomentsOfInertia(rotation, diagonal) || diagonal.IsNearZero() )
+        {
+            continue;
         }
+
+        JPH::BodyLockWrite lock(rLockInterface, joltBodyId);
+        if (lock.Succeeded() && lock.GetBody().IsDynamic())
+        {
+            JPH::MotionProperties &rMotion = *lock.GetBody().GetMotionProperties();
+            rMotion.SetInverseMass(1.0f / massProp.mMass);
+            rMotion.SetInverseInertia(diagonal.Reciprocal(), rotation.GetQuaternion());
+        }
+    }
+
+    rDirty.clear();
+}
+
+namespace
+{
+
+// Fewer bodies than this per job isn't worth the overhead of scheduling it
+constexpr std::size_t gc_minBodiesPerJob = 32;
+
+} // namespace
+
+// Called by Jolt from within a physics job while all bodies are locked, so NoLock interfaces are
+// used throughout. Bodies are split into contiguous ranges and handed to the world's job system.
+// Waiting on the barrier from a job thread is fine: both JobSystemThreadPool and
+// WorkerPoolJobSystem derive from JPH::JobSystemWithBarrier, whose Barrier Wait executes the
+// barrier's own queued jobs on the waiting thread until none are left, so no other thread needs
+// to be free. See test JoltJobSystem.UpdateWorldLowConcurrency.
+void PhysicsStepListenerImpl::OnStep(float inDeltaTime, JPH::PhysicsSystem &rPhysicsSystem)
+{
+    JPH::BodyInterface &bodyInterface = rPhysicsSystem.GetBodyInterfaceNoLock();
+
+    // Apply changed velocities
+    for (auto const& [ent, vel] : m_pCtxPhysics->m_setVelocity)
+    {
+        JPH::BodyID const joltBodyId     = BToJolt(m_pCtxJoltWorld->m_entToBody.at(ent));
+
+        bodyInterface.SetLinearVelocity(joltBodyId, Vec3MagnumToJolt(vel));
+    }
+    m_pCtxPhysics->m_setVelocity.clear();
+
+    m_bodies.clear();
+    m_bodies.reserve(m_pCtxJoltWorld->m_bodyIds.size());
+    for (BodyId const bodyId : m_pCtxJoltWorld->m_bodyIds)
+    {
+        m_bodies.push_back(bodyId);
+    }
+    m_activate.assign(m_bodies.size(), JPH::BodyID{});
+
+    std::size_t const bodyCount = m_bodies.size();
+
+    JPH::JobSystem &rJobSystem = *m_pCtxJoltWorld->m_pJobSystem;
+
+    std::size_t const maxJobs   = std::size_t(std::max(1, rJobSystem.GetMaxConcurrency()));
+    std::size_t const jobCount  = std::min(maxJobs, (bodyCount + gc_minBodiesPerJob - 1) / gc_minBodiesPerJob);
+
+    if (jobCount <= 1)
+    {
+        update_bodies(0, bodyCount);
+    }
+    else
+    {
+        JPH::JobSystem::Barrier *pBarrier = rJobSystem.CreateBarrier();
+
+        for (std::size_t job = 0; job < jobCount; ++job)
+        {
+            std::size_t const first = bodyCount * job / jobCount;
+            std::size_t const last  = bodyCount * (job + 1) / jobCount;
+
+            pBarrier->AddJob(rJobSystem.CreateJob("OSP Force Factors", JPH::Color::sGreen, [this, first, last] ()
+            {
+                update_bodies(first, last);
+            }));
+        }
+
+        rJobSystem.WaitForJobs(pBarrier);
+        rJobSystem.DestroyBarrier(pBarrier);
+    }
+
+    // Bodies with forces applied are woken up. Done here instead of in the jobs, as activating
+    // modifies the physics system's list of active bodies.
+    auto const itActivateLast = std::remove(m_activate.begin(), m_activate.end(), JPH::BodyID{});
+    if (itActivateLast != m_activate.begin())
+    {
+        bodyInterface.ActivateBodies(m_activate.data(), int(std::distance(m_activate.begin(), itActivateLast)));
+    }
+}
+
+void PhysicsStepListenerImpl::update_bodies(std::size_t const first, std::size_t const last) noexcept
+{
+    JPH::BodyLockInterfaceNoLock const &bodyLockInterface = m_pCtxJoltWorld->m_physicsSystem.GetBodyLockInterfaceNoLock();
+
+    for (std::size_t i = first; i < last; ++i)
+    {
+        BodyId const        bodyId      = m_bodies[i];
+        JPH::BodyID const   joltBodyId  = BToJolt(bodyId);
+        ActiveEnt const     ent         = m_pCtxJoltWorld->m_bodyToEnt[bodyId];
+
+        JPH::BodyLockWrite lock(bodyLockInterface, joltBodyId);
+
+        JPH::Body &rBody = lock.GetBody();
+
+        if ( ! rBody.IsDynamic() )
+        {
+            continue;
+        }
+
+        //Force and torque osp -> jolt
+        Vector3 force{0.0f};
+        Vector3 torque{0.0f};
+
+        LGRN_ASSERT(ForceFactors_t{}.size() == 64u);
+        auto const factorsInts = std::initializer_list<std::uint64_t>{m_pCtxJoltWorld->m_bodyFactors[bodyId].to_ullong()};
+        auto const factorsBits = lgrn::bit_view(factorsInts);
+
+        for (std::size_t const factorIdx : factorsBits.ones())
+        {
+            ACtxJoltWorld::ForceFactorFunc const& factor = m_pCtxJoltWorld->m_factors[factorIdx];
+            factor.m_func(rBody, bodyId, *m_pCtxJoltWorld, factor.m_userData, force, torque);
+        }
+
+        rBody.AddForce(Vec3MagnumToJolt(force));
+        rBody.AddTorque(Vec3MagnumToJolt(torque));
+
+        m_activate[i] = joltBodyId;
+
+        JPH::Vec3 comOffset = rBody.GetRotation() * rBody.GetShape()->GetCenterOfMass();
+
+        m_pCtxBasic->m_transform.get(ent).m_transform = Matrix4::from(
+                QuatJoltToMagnum(rBody.GetRotation()).toMatrix(),
+                Vec3JoltToMagnum(rBody.GetCenterOfMassPosition()) - Vec3JoltToMagnum(comOffset));
     }
 }
@@ -63,9 +63,69 @@ public:
             ACtxJoltWorld               &rCtxWorld,
             float                       timestep) noexcept;
 
+    /**
+     * @brief Respond to scene origin shifts by translating all bodies
+     *
+     * Bodies are moved without waking them up. Called by update_world before stepping, so the
+     * shift is applied once per frame regardless of the number of collision steps.
+     *
+     * @param rCtxBasic     [in] Basic context with m_translateOrigin
+     * @param rCtxWorld     [ref] Jolt world
+     */
+    static void update_translate(
+            ACtxBasic const             &rCtxBasic,
+            ACtxJoltWorld               &rCtxWorld) noexcept;
+
     static void remove_components(
             ACtxJoltWorld& rCtxWorld, ActiveEnt ent) noexcept;
 
+    /**
+     * @brief Create a MutableCompoundShape from colliders in an entity's hierarchy
+     *
+     * Each entity with a shape or mass is registered as a member of the body, so it can later be
+     * changed individually by update_compounds.
+     *
+     * @param rCtxPhys      [in] Generic Physics context
+     * @param rCtxWorld     [ref] Jolt world
+     * @param rBasic        [in] Scene graph and transforms
+     * @param root          [in] Root entity of the body
+     * @param bodyId        [in] Body the shape is for, not yet created in Jolt
+     */
+    static JPH::Ref<JPH::MutableCompoundShape> create_compound(
+            ACtxPhysics const&          rCtxPhys,
+            ACtxJoltWorld&              rCtxWorld,
+            ACtxBasic const&            rBasic,
+            ActiveEnt                   root,
+            BodyId                      bodyId);
+
+    /**
+     * @brief Mass properties of a compound body about a point, usually the shape's center of mass
+     */
+    static JPH::MassProperties compound_mass_properties(
+            ACtxJoltWorld::MassSum const&   mass,
+            osp::Vector3                    about) noexcept;
+
+    /**
+     * @brief Apply ACtxPhysics::m_colliderDirty to compound shapes of existing bodies
+     *
+     * Only sub-shapes of dirty entities and their descendants are added, moved, or removed.
+     * Mass properties are updated by subtracting and adding contributions of changed entities.
+     * Entities that aren't part of a compound body are ignored. Clears m_colliderDirty.
+     *
+     * @param rBasic        [in] Scene graph and transforms
+     * @param rCtxPhys      [ref] Generic Physics context
+     * @param rCtxWorld     [ref] Jolt world
+     */
+    static void update_compounds(
+            ACtxBasic const&            rBasic,
+            ACtxPhysics&                rCtxPhys,
+            ACtxJoltWorld&              rCtxWorld) noexcept;
+
+    /**
+     * @brief Recenter changed compound shapes and notify Jolt of new shapes and mass
+     */
+    static void finalize_compounds(ACtxJoltWorld& rCtxWorld) noexcept;
+
     static JPH::Ref<JPH::Shape> create_primitive(ACtxJoltWorld &rCtxWorld, osp::EShape shape, JPH::Vec3Arg scale);
 
     template<typename IT_T>
@@ -77,6 +137,8 @@ public:
             remove_components(rCtxWorld, *first);
             std::advance(first, 1);
         }
+
+        finalize_compounds(rCtxWorld);
     }
     //Apply a scale to a shape.
     static void scale_shape(JPH::Ref<JPH::Shape> rShape, JPH::Vec3Arg scale);
@@ -86,6 +148,53 @@ public:
     
 private:
 
+    /**
+     * @brief Add, move, or remove an entity's sub-shape and mass in the compound body it's part of
+     */
+    static void update_member(
+            ACtxBasic const&            rBasic,
+            ACtxPhysics const&          rCtxPhys,
+            ACtxJoltWorld&              rCtxWorld,
+            ActiveEnt                   ent) noexcept;
+
+    static void remove_member(ACtxJoltWorld& rCtxWorld, ActiveEnt ent) noexcept;
+
+    /**
+     * @brief Remove a sub-shape by moving the last sub-shape into its place
+     */
+    static void remove_sub_shape(
+            ACtxJoltWorld&              rCtxWorld,
+            ACtxJoltWorld::CompoundBody& rBody,
+            std::uint32_t               subShape) noexcept;
+
+    /**
+     * @brief Create a primitive for an entity's collider, and keep it in ACtxJoltWorld::m_shapes
+     */
+    static JPH::Ref<JPH::Shape> collider_shape(
+            ACtxJoltWorld&              rCtxWorld,
+            ActiveEnt                   ent,
+            osp::EShape                 shape,
+            osp::Vector3                scale);
+
+    /**
+     * @brief Contribution of an entity's mass to its compound body
+     *
+     * @param transform     [in] Transform of the entity relative to the body
+     */
+    static ACtxJoltWorld::MassSum member_mass(
+            osp::active::ACompMass const&   mass,
+            osp::Matrix4 const&             transform) noexcept;
+
+    static void compound_collect_recurse(
+            ACtxPhysics const&          rCtxPhys,
+            ACtxJoltWorld&              rCtxWorld,
+            ACtxBasic const&            rBasic,
+            ActiveEnt                   ent,
+            osp::Matrix4 const&         transform,
+            BodyId                      bodyId,
+            ACtxJoltWorld::CompoundBody& rBody,
+            JPH::MutableCompoundShapeSettings& rCompound);
+
     /**
      * @brief Find shapes in an entity and its hierarchy, and add them to
      *        a Jolt Compound Shape
@@ -24,14 +24,18 @@
  */
 #pragma once
 
+#include "../chunk_cache.h"
 #include "../chunk_generate.h"
 #include "../geometry.h"
 #include "../skeleton_subdiv.h"
 #include "../skeleton.h"
+#include "../terrain_generator.h"
 
 #include <osp/drawing/drawing.h>
 #include <osp/core/math_types.h>
 
+#include <memory>
+
 namespace planeta
 {
 
@@ -59,6 +63,7 @@ struct ACtxTerrain
 
     planeta::ChunkMeshBufferInfo        chunkInfo{};
     planeta::BasicChunkMeshGeometry     chunkGeom;
+    planeta::ChunkMeshCache             chunkCache;
 
     planeta::ChunkScratchpad            chunkSP;
     planeta::SkeletonSubdivScratchpad   scratchpad;
@@ -74,6 +79,9 @@ struct ACtxTerrainIco
     /// Planet max ground height in meters. Highest mountain.
     double  height{};
 
+    /// Calculates heights of terrain vertices, all within [0, height]
+    std::unique_ptr<planeta::ITerrainGenerator> generator;
+
     std::array<planeta::SkVrtxId,     12>   icoVrtx;
     std::array<planeta::SkTriGroupId, 5>    icoGroups;
     std::array<planeta::SkTriId,      20>   icoTri;
@@ -0,0 +1,193 @@
+/**
+ * Open Space Program
+ * Copyright © 2019-2025 Open Space Program Project
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "chunk_cache.h"
+
+#include <Corrade/Containers/ArrayViewStl.h>
+
+#include <algorithm>
+#include <functional>
+
+using osp::Vector3;
+using osp::Vector3l;
+using osp::arrayView;
+using osp::as_2d;
+
+namespace planeta
+{
+
+std::size_t ChunkMeshCache::KeyHash::operator()(Key const& key) const noexcept
+{
+    // boost::hash_combine
+    std::size_t seed = 0;
+    for (Vector3l const& corner : key.corners)
+    {
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            seed ^= std::hash<std::int64_t>{}(corner[i]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+    }
+    return seed;
+}
+
+ChunkMeshCache::Key ChunkMeshCache::make_key(
+        SkTriId                 const sktriId,
+        SubdivTriangleSkeleton  const &rSkel,
+        SkeletonVertexData      const &rSkData)
+{
+    auto const &corners = rSkel.tri_at(sktriId).vertices;
+    return { .corners = { rSkData.positions[corners[0].value()],
+                          rSkData.positions[corners[1].value()],
+                          rSkData.positions[corners[2].value()] } };
+}
+
+void ChunkMeshCache::set_max_bytes(std::size_t const maxBytes)
+{
+    m_maxBytes = maxBytes;
+    evict_to_fit();
+}
+
+void ChunkMeshCache::set_chunk_key(ChunkId const chunkId, Key const& key)
+{
+    if (m_keyOf.size() <= chunkId.value)
+    {
+        m_keyOf.resize(std::size_t(chunkId.value) + 1);
+    }
+    m_keyOf[chunkId] = key;
+}
+
+void ChunkMeshCache::store(
+        ChunkId                 const chunkId,
+        BasicChunkMeshGeometry  const &rGeom,
+        ChunkMeshBufferInfo     const &rChInfo,
+        ChunkSkeleton           const &rSkCh)
+{
+    if (m_maxBytes == 0)
+    {
+        return;
+    }
+
+    LGRN_ASSERTM(chunkId.value < m_keyOf.size(), "Missing set_chunk_key(...) for chunk");
+    Key const &key = m_keyOf[chunkId];
+
+    // Replace existing entry, if any
+    if (auto const found = m_entryOf.find(key);
+        found != m_entryOf.end())
+    {
+        m_sizeBytes -= entry_bytes(*found->second);
+        m_lru.erase(found->second);
+        m_entryOf.erase(found);
+    }
+
+    std::size_t const fillOffset = rChInfo.vbufFillOffset + chunkId.value*rChInfo.fillVrtxCount;
+    auto const positions = rGeom.vbufPositions.view_const(rGeom.vrtxBuffer, rChInfo.vrtxTotal).sliceSize(fillOffset, rChInfo.fillVrtxCount);
+    auto const normals   = rGeom.vbufNormals  .view_const(rGeom.vrtxBuffer, rChInfo.vrtxTotal).sliceSize(fillOffset, rChInfo.fillVrtxCount);
+    auto const fillSharedNormals = as_2d(arrayView(rGeom.chunkFillSharedNormals), rSkCh.m_chunkSharedCount).row(chunkId.value);
+
+    Entry &rEntry = m_lru.emplace_front(Entry{ .key = key, .origin = rGeom.originSkelPos });
+    rEntry.positions        .reserve(rChInfo.fillVrtxCount);
+    rEntry.normals          .reserve(rChInfo.fillVrtxCount);
+    rEntry.fillSharedNormals.assign(fillSharedNormals.begin(), fillSharedNormals.end());
+    for (std::size_t i = 0; i < rChInfo.fillVrtxCount; ++i)
+    {
+        rEntry.positions.push_back(positions[i]);
+        rEntry.normals  .push_back(normals[i]);
+    }
+    m_entryOf.emplace(key, m_lru.begin());
+    m_sizeBytes += entry_bytes(rEntry);
+
+    evict_to_fit();
+}
+
+bool ChunkMeshCache::restore(
+        ChunkId                 const chunkId,
+        BasicChunkMeshGeometry        &rGeom,
+        ChunkMeshBufferInfo     const &rChInfo,
+        ChunkSkeleton           const &rSkCh,
+        float                   const scale)
+{
+    if (m_maxBytes == 0)
+    {
+        return false;
+    }
+
+    auto const found = m_entryOf.find(m_keyOf[chunkId]);
+    if (found == m_entryOf.end())
+    {
+        ++m_misses;
+        return false;
+    }
+    ++m_hits;
+
+    Entry const &entry = *found->second;
+
+    std::size_t const fillOffset = rChInfo.vbufFillOffset + chunkId.value*rChInfo.fillVrtxCount;
+    auto const positions = rGeom.vbufPositions.view(rGeom.vrtxBuffer, rChInfo.vrtxTotal).sliceSize(fillOffset, rChInfo.fillVrtxCount);
+    auto const normals   = rGeom.vbufNormals  .view(rGeom.vrtxBuffer, rChInfo.vrtxTotal).sliceSize(fillOffset, rChInfo.fillVrtxCount);
+    auto const fillSharedNormals = as_2d(arrayView(rGeom.chunkFillSharedNormals), rSkCh.m_chunkSharedCount).row(chunkId.value);
+
+    // Same as translating the mesh, see BasicChunkMeshGeometry::originSkelPos
+    Vector3 const deltaOffset = Vector3(entry.origin - rGeom.originSkelPos) * scale;
+
+    for (std::size_t i = 0; i < rChInfo.fillVrtxCount; ++i)
+    {
+        positions[i] = entry.positions[i] + deltaOffset;
+        normals[i]   = entry.normals[i];
+    }
+    std::copy(entry.fillSharedNormals.begin(), entry.fillSharedNormals.end(), fillSharedNormals.begin());
+
+    // The chunk now owns this data again, and will store it back when removed
+    m_sizeBytes -= entry_bytes(entry);
+    m_lru.erase(found->second);
+    m_entryOf.erase(found);
+
+    return true;
+}
+
+void ChunkMeshCache::clear()
+{
+    m_lru       .clear();
+    m_entryOf   .clear();
+    m_sizeBytes = 0;
+}
+
+std::size_t ChunkMeshCache::entry_bytes(Entry const& entry) noexcept
+{
+    return sizeof(Entry) + sizeof(Vector3) * (  entry.positions.size()
+                                              + entry.normals.size()
+                                              + entry.fillSharedNormals.size());
+}
+
+void ChunkMeshCache::evict_to_fit()
+{
+    while (m_sizeBytes > m_maxBytes && ! m_lru.empty())
+    {
+        Entry const &oldest = m_lru.back();
+        m_sizeBytes -= entry_bytes(oldest);
+        m_entryOf.erase(oldest.key);
+        m_lru.pop_back();
+    }
+}
+
+} // namespace planeta
@@ -0,0 +1,156 @@
+/**
+ * Open Space Program
+ * Copyright © 2019-2025 Open Space Program Project
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+/**
+ * @file
+ * @brief Cache of chunk mesh data for chunks that were recently removed
+ */
+
+#include "geometry.h"
+#include "skeleton.h"
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace planeta
+{
+
+/**
+ * @brief LRU cache of fill vertices of recently removed chunks
+ *
+ * Chunks are removed and created again with new IDs as the viewer moves back and forth. Fill
+ * vertex positions and normals only depend on the chunk's skeleton triangle, so they can be
+ * copied back instead of being generated again.
+ *
+ * Entries are keyed by the positions of the skeleton triangle's corners, as skeleton vertex and
+ * triangle IDs don't survive the triangle being unsubdivided.
+ */
+class ChunkMeshCache
+{
+public:
+
+    struct Key
+    {
+        std::array<osp::Vector3l, 3> corners;
+
+        bool operator==(Key const& rhs) const noexcept
+        {
+            return corners[0] == rhs.corners[0] && corners[1] == rhs.corners[1] && corners[2] == rhs.corners[2];
+        }
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(Key const& key) const noexcept;
+    };
+
+    static Key make_key(SkTriId sktriId, SubdivTriangleSkeleton const& rSkel, SkeletonVertexData const& rSkData);
+
+    /**
+     * @brief Set max memory used by cached entries, evicting least recently used ones if needed.
+     *        0 disables the cache.
+     */
+    void set_max_bytes(std::size_t maxBytes);
+
+    /**
+     * @brief Remember which skeleton triangle a newly created chunk is for
+     */
+    void set_chunk_key(ChunkId chunkId, Key const& key);
+
+    /**
+     * @brief Copy fill vertices of a chunk about to be removed into the cache
+     *
+     * Must be called before subtract_normal_contrib(...), which clears the chunk's row of
+     * BasicChunkMeshGeometry::chunkFillSharedNormals.
+     */
+    void store(
+            ChunkId                         chunkId,
+            BasicChunkMeshGeometry    const &rGeom,
+            ChunkMeshBufferInfo       const &rChInfo,
+            ChunkSkeleton             const &rSkCh);
+
+    /**
+     * @brief Copy cached fill vertices into a newly created chunk, if its skeleton triangle is
+     *        cached. The entry is removed from the cache.
+     *
+     * On success, call update_fill_faces(...) with normalsCached = true, then the chunk is
+     * ready for add_fill_shared_normals(...).
+     *
+     * @param scale [in] Vertex buffer units per skeleton unit, 2^-SkeletonVertexData::precision
+     *
+     * @return true if found
+     */
+    bool restore(
+            ChunkId                         chunkId,
+            BasicChunkMeshGeometry          &rGeom,
+            ChunkMeshBufferInfo       const &rChInfo,
+            ChunkSkeleton             const &rSkCh,
+            float                           scale);
+
+    void clear();
+
+    [[nodiscard]] std::size_t   max_bytes()     const noexcept { return m_maxBytes; }
+    [[nodiscard]] std::size_t   size_bytes()    const noexcept { return m_sizeBytes; }
+    [[nodiscard]] std::size_t   entry_count()   const noexcept { return m_lru.size(); }
+    [[nodiscard]] std::uint64_t hits()          const noexcept { return m_hits; }
+    [[nodiscard]] std::uint64_t misses()        const noexcept { return m_misses; }
+
+private:
+
+    struct Entry
+    {
+        Key                         key;
+
+        /// BasicChunkMeshGeometry::originSkelPos the positions are relative to
+        osp::Vector3l               origin;
+
+        std::vector<osp::Vector3>   positions;
+        std::vector<osp::Vector3>   normals;
+        std::vector<osp::Vector3>   fillSharedNormals;
+    };
+
+    using EntryIt_t = std::list<Entry>::iterator;
+
+    static std::size_t entry_bytes(Entry const& entry) noexcept;
+
+    void evict_to_fit();
+
+    /// Most recently stored entry in front
+    std::list<Entry>                            m_lru;
+    std::unordered_map<Key, EntryIt_t, KeyHash> m_entryOf;
+
+    osp::KeyedVec<ChunkId, Key>                 m_keyOf;
+
+    std::size_t                                 m_maxBytes{0};
+    std::size_t                                 m_sizeBytes{0};
+    std::uint64_t                               m_hits{0};
+    std::uint64_t                               m_misses{0};
+
+}; // class ChunkMeshCache
+
+} // namespace planeta
@@ -48,6 +48,7 @@ void ChunkScratchpad::resize(ChunkSkeleton const& rChSk)
     stitchCmds          .resize(maxChunks, {});
     chunksAdded         .resize(maxChunks);
     chunksRemoved       .resize(maxChunks);
+    chunksRestored      .resize(maxChunks);
     sharedAdded         .resize(maxSharedVrtx);
     sharedRemoved       .resize(maxSharedVrtx);
     sharedNormalsDirty  .resize(maxSharedVrtx);
@@ -191,130 +192,208 @@ void update_faces(
         ChunkScratchpad              &rChSP,
         ChunkSkeleton                &rSkCh)
 {
-    ChunkStitch const cmd = rChSP.stitchCmds[chunkId];
-
-    if ( ! newlyAdded && ! cmd.enabled )
+    if (newlyAdded)
     {
-        return; // Nothing to do
+        update_fill_faces(chunkId, rGeom, rChInfo, rSkCh);
+        fill_dirty(chunkId, rGeom, rChInfo);
+        add_fill_shared_normals(chunkId, rGeom, rChSP, rSkCh);
     }
 
+    update_fan_faces(chunkId, sktriId, rSkel, rGeom, rChInfo, rChSP, rSkCh);
+}
+
+void update_fill_faces(
+        ChunkId                const chunkId,
+        BasicChunkMeshGeometry       &rGeom,
+        ChunkMeshBufferInfo    const &rChInfo,
+        ChunkSkeleton          const &rSkCh,
+        bool                   const normalsCached)
+{
     auto const vbufNormalsView   = rGeom.vbufNormals.view(rGeom.vrtxBuffer, rChInfo.vrtxTotal);
     auto const ibufSlice         = as_2d(rGeom.indxBuffer,             rChInfo.chunkMaxFaceCount).row(chunkId.value);
     auto const fanNormalContrib  = as_2d(rGeom.chunkFanNormalContrib,  rChInfo.fanMaxSharedCount).row(chunkId.value);
     auto const fillNormalContrib = as_2d(rGeom.chunkFillSharedNormals, rSkCh.m_chunkSharedCount) .row(chunkId.value);
-    auto const sharedUsed        = rSkCh.shared_vertices_used(chunkId);
 
     TerrainFaceWriter writer{
         .vbufPos             = rGeom.vbufPositions.view_const(rGeom.vrtxBuffer, rChInfo.vrtxTotal),
         .vbufNrm             = vbufNormalsView,
-        .sharedNormalSum     = rGeom.sharedNormalSum.base(),
         .fillNormalContrib   = fillNormalContrib,
-        .fanNormalContrib    = fanNormalContrib,
-        .sharedUsed          = sharedUsed,
-        .currentFace         = ibufSlice.begin(),
-        .contribLast         = fanNormalContrib.begin(),
-        .rSharedNormalsDirty = rChSP.sharedNormalsDirty
+        .currentFace         = ibufSlice.begin()
     };
 
-    // Create triangle fill for newly added triangles
-    if (newlyAdded)
-    {
-        // Reset fill normals to zero, as values are left over from a previously deleted chunk
-        auto const chunkVbufFillNormals2D = as_2d(vbufNormalsView.exceptPrefix(rChInfo.vbufFillOffset), rChInfo.fillVrtxCount);
-        auto const vbufFillNormals        = chunkVbufFillNormals2D.row(chunkId.value);
+    // Reset fill normals to zero, as values are left over from a previously deleted chunk
+    auto const chunkVbufFillNormals2D = as_2d(vbufNormalsView.exceptPrefix(rChInfo.vbufFillOffset), rChInfo.fillVrtxCount);
+    auto const vbufFillNormals        = chunkVbufFillNormals2D.row(chunkId.value);
 
-        // These aren't cleaned up by the previous chunk that used them
+    // These aren't cleaned up by the previous chunk that used them
+    if ( ! normalsCached )
+    {
         std::fill(vbufFillNormals  .begin(), vbufFillNormals  .end(), Vector3{ZeroInit});
         std::fill(fillNormalContrib.begin(), fillNormalContrib.end(), Vector3{ZeroInit});
-        std::fill(fanNormalContrib .begin(), fanNormalContrib .end(), FanNormalContrib{});
+    }
+    std::fill(fanNormalContrib .begin(), fanNormalContrib .end(), FanNormalContrib{});
 
-        auto const add_fill_tri = [&rSkCh, &rChInfo, &writer, chunkId]
-                (std::uint16_t const aX, std::uint16_t const aY,
-                 std::uint16_t const bX, std::uint16_t const bY,
-                 std::uint16_t const cX, std::uint16_t const cY)
+    auto const add_fill_tri = [&rSkCh, &rChInfo, &writer, chunkId, normalsCached]
+            (std::uint16_t const aX, std::uint16_t const aY,
+             std::uint16_t const bX, std::uint16_t const bY,
+             std::uint16_t const cX, std::uint16_t const cY)
+    {
+        auto const [shLocalA, vrtxA] = chunk_coord_to_vrtx(rSkCh, rChInfo, chunkId, aX, aY);
+        auto const [shLocalB, vrtxB] = chunk_coord_to_vrtx(rSkCh, rChInfo, chunkId, bX, bY);
+        auto const [shLocalC, vrtxC] = chunk_coord_to_vrtx(rSkCh, rChInfo, chunkId, cX, cY);
+
+        if (normalsCached)
         {
-            auto const [shLocalA, vrtxA] = chunk_coord_to_vrtx(rSkCh, rChInfo, chunkId, aX, aY);
-            auto const [shLocalB, vrtxB] = chunk_coord_to_vrtx(rSkCh, rChInfo, chunkId, bX, bY);
-            auto const [shLocalC, vrtxC] = chunk_coord_to_vrtx(rSkCh, rChInfo, chunkId, cX, cY);
-
-            writer.fill_add_face(vrtxA, vrtxB, vrtxC);
-
-            shLocalA.has_value() ? writer.fill_add_normal_shared(vrtxA, shLocalA)
-                                 : writer.fill_add_normal_filled(vrtxA);
-            shLocalB.has_value() ? writer.fill_add_normal_shared(vrtxB, shLocalB)
-                                 : writer.fill_add_normal_filled(vrtxB);
-            shLocalC.has_value() ? writer.fill_add_normal_shared(vrtxC, shLocalC)
-                                 : writer.fill_add_normal_filled(vrtxC);
-        };
+            *writer.currentFace = {vrtxA, vrtxB, vrtxC};
+            std::advance(writer.currentFace, 1);
+            return;
+        }
+
+        writer.fill_add_face(vrtxA, vrtxB, vrtxC);
 
-        for (unsigned int y = 0; y < rSkCh.m_chunkEdgeVrtxCount; ++y)
+        shLocalA.has_value() ? writer.fill_add_normal_shared(vrtxA, shLocalA)
+                             : writer.fill_add_normal_filled(vrtxA);
+        shLocalB.has_value() ? writer.fill_add_normal_shared(vrtxB, shLocalB)
+                             : writer.fill_add_normal_filled(vrtxB);
+        shLocalC.has_value() ? writer.fill_add_normal_shared(vrtxC, shLocalC)
+                             : writer.fill_add_normal_filled(vrtxC);
+    };
+
+    for (unsigned int y = 0; y < rSkCh.m_chunkEdgeVrtxCount; ++y)
+    {
+        for (unsigned int x = 0; x < y; ++x)
         {
-            for (unsigned int x = 0; x < y; ++x)
+            // down-pointing
+            //                ( aX   aY )    ( aX   aY )    ( aX   aY )
+            add_fill_tri(      x+1, y+1,      x+1,  y,         x,  y      );
+
+            // up pointing
+            bool const onEdge = (x == y-1) || y == rSkCh.m_chunkEdgeVrtxCount - 1;
+            if ( ! onEdge )
             {
-                // down-pointing
                 //                ( aX   aY )    ( aX   aY )    ( aX   aY )
-                add_fill_tri(      x+1, y+1,      x+1,  y,         x,  y      );
-
-                // up pointing
-                bool const onEdge = (x == y-1) || y == rSkCh.m_chunkEdgeVrtxCount - 1;
-                if ( ! onEdge )
-                {
-                    //                ( aX   aY )    ( aX   aY )    ( aX   aY )
-                    add_fill_tri(      x+1,  y,       x+1,  y+1,     x+2,  y+1   );
-                }
+                add_fill_tri(      x+1,  y,       x+1,  y+1,     x+2,  y+1   );
             }
         }
+    }
 
-        LGRN_ASSERTM(writer.currentFace == std::next(ibufSlice.begin(), rChInfo.fillFaceCount),
-                     "Code above must always add a known number of faces");
+    LGRN_ASSERTM(writer.currentFace == std::next(ibufSlice.begin(), rChInfo.fillFaceCount),
+                 "Code above must always add a known number of faces");
 
+    if ( ! normalsCached )
+    {
         for (Vector3 &rNormal : vbufFillNormals)
         {
             rNormal = rNormal.normalized();
         }
     }
 
-    writer.currentFace = std::next(ibufSlice.begin(), rChInfo.fillFaceCount);
+    // No fans yet. Fill with zeros to indicate an early end
+    std::fill(writer.currentFace, ibufSlice.end(), Vector3u{ZeroInit});
+}
+
+void fill_dirty(
+        ChunkId                const chunkId,
+        BasicChunkMeshGeometry       &rGeom,
+        ChunkMeshBufferInfo    const &rChInfo)
+{
+    std::size_t const fillOffset = rChInfo.vbufFillOffset + chunkId.value*rChInfo.fillVrtxCount;
+    rGeom.positions_dirty(fillOffset, rChInfo.fillVrtxCount);
+    rGeom.normals_dirty  (fillOffset, rChInfo.fillVrtxCount);
+
+    // update_fill_faces also zeros out the fan faces
+    rGeom.faces_dirty(chunkId.value*rChInfo.chunkMaxFaceCount, rChInfo.chunkMaxFaceCount);
+}
+
+void add_fill_shared_normals(
+        ChunkId                const chunkId,
+        BasicChunkMeshGeometry       &rGeom,
+        ChunkScratchpad              &rChSP,
+        ChunkSkeleton          const &rSkCh)
+{
+    auto const fillNormalContrib = as_2d(rGeom.chunkFillSharedNormals, rSkCh.m_chunkSharedCount).row(chunkId.value);
+    auto const sharedUsed        = rSkCh.shared_vertices_used(chunkId);
 
-    // Add or replace Fan triangles
-    if (cmd.enabled)
+    for (std::size_t i = 0; i < sharedUsed.size(); ++i)
     {
-        ChunkStitch &rCurrentStitch = rSkCh.m_chunkStitch[chunkId];
-        if (rCurrentStitch.enabled)
+        SharedVrtxId const shared = sharedUsed[i].value();
+        if ( ! shared.has_value() )
         {
-            // Delete previous fan stitch, Subtract normal contributions
-            subtract_normal_contrib(chunkId, true, rGeom, rChInfo, rChSP, rSkCh);
+            break;
         }
-        rSkCh.m_chunkStitch[chunkId] = cmd;
-        ArrayView<SharedVrtxOwner_t const> detailX2Edge0;
-        ArrayView<SharedVrtxOwner_t const> detailX2Edge1;
 
-        // For detailX2 stitches, get the 2 neighboring higher detail triangles,
-        // and get the rows of shared vertices along the edge in contact.
-        if (cmd.detailX2)
-        {
-            SkTriId          const  neighborId = rSkel.tri_at(sktriId).neighbors[cmd.x2ownEdge];
-            SkeletonTriangle const& neighbor   = rSkel.tri_at(neighborId);
+        rGeom.sharedNormalSum[shared] += fillNormalContrib[i];
+        rChSP.sharedNormalsDirty.insert(shared);
+    }
+}
 
-            auto const child_chunk_edge = [&rSkCh, children = neighbor.children, edgeIdx = std::uint32_t(cmd.x2neighborEdge)]
-                                          (std::uint8_t siblingIdx) -> ArrayView<SharedVrtxOwner_t const>
-            {
-                ChunkId const chunk = rSkCh.m_triToChunk[tri_id(children, siblingIdx)];
-                return as_2d(rSkCh.shared_vertices_used(chunk), rSkCh.m_chunkEdgeVrtxCount).row(edgeIdx);
-            };
+void update_fan_faces(
+        ChunkId                const chunkId,
+        SkTriId                const sktriId,
+        SubdivTriangleSkeleton const &rSkel,
+        BasicChunkMeshGeometry       &rGeom,
+        ChunkMeshBufferInfo    const &rChInfo,
+        ChunkScratchpad              &rChSP,
+        ChunkSkeleton                &rSkCh)
+{
+    ChunkStitch const cmd = rChSP.stitchCmds[chunkId];
 
-            detailX2Edge0 = child_chunk_edge(cmd.x2neighborEdge);
-            detailX2Edge1 = child_chunk_edge((cmd.x2neighborEdge + 1) % 3);
-        }
+    if ( ! cmd.enabled )
+    {
+        return; // Nothing to do
+    }
+
+    auto const ibufSlice         = as_2d(rGeom.indxBuffer,             rChInfo.chunkMaxFaceCount).row(chunkId.value);
+    auto const fanNormalContrib  = as_2d(rGeom.chunkFanNormalContrib,  rChInfo.fanMaxSharedCount).row(chunkId.value);
+
+    TerrainFaceWriter writer{
+        .vbufPos             = rGeom.vbufPositions.view_const(rGeom.vrtxBuffer, rChInfo.vrtxTotal),
+        .vbufNrm             = rGeom.vbufNormals.view(rGeom.vrtxBuffer, rChInfo.vrtxTotal),
+        .sharedNormalSum     = rGeom.sharedNormalSum.base(),
+        .fanNormalContrib    = fanNormalContrib,
+        .sharedUsed          = rSkCh.shared_vertices_used(chunkId),
+        .currentFace         = std::next(ibufSlice.begin(), rChInfo.fillFaceCount),
+        .contribLast         = fanNormalContrib.begin(),
+        .pSharedNormalsDirty = &rChSP.sharedNormalsDirty
+    };
+
+    ChunkStitch &rCurrentStitch = rSkCh.m_chunkStitch[chunkId];
+    if (rCurrentStitch.enabled)
+    {
+        // Delete previous fan stitch, Subtract normal contributions
+        subtract_normal_contrib(chunkId, true, rGeom, rChInfo, rChSP, rSkCh);
+    }
+    rSkCh.m_chunkStitch[chunkId] = cmd;
+    ArrayView<SharedVrtxOwner_t const> detailX2Edge0;
+    ArrayView<SharedVrtxOwner_t const> detailX2Edge1;
+
+    // For detailX2 stitches, get the 2 neighboring higher detail triangles,
+    // and get the rows of shared vertices along the edge in contact.
+    if (cmd.detailX2)
+    {
+        SkTriId          const  neighborId = rSkel.tri_at(sktriId).neighbors[cmd.x2ownEdge];
+        SkeletonTriangle const& neighbor   = rSkel.tri_at(neighborId);
 
-        auto const stitcher = make_chunk_fan_stitcher<TerrainFaceWriter&>(writer, chunkId, detailX2Edge0, detailX2Edge1, rSkCh, rChInfo);
+        auto const child_chunk_edge = [&rSkCh, children = neighbor.children, edgeIdx = std::uint32_t(cmd.x2neighborEdge)]
+                                      (std::uint8_t siblingIdx) -> ArrayView<SharedVrtxOwner_t const>
+        {
+            ChunkId const chunk = rSkCh.m_triToChunk[tri_id(children, siblingIdx)];
+            return as_2d(rSkCh.shared_vertices_used(chunk), rSkCh.m_chunkEdgeVrtxCount).row(edgeIdx);
+        };
 
-        stitcher.stitch(cmd);
+        detailX2Edge0 = child_chunk_edge(cmd.x2neighborEdge);
+        detailX2Edge1 = child_chunk_edge((cmd.x2neighborEdge + 1) % 3);
     }
 
+    auto const stitcher = make_chunk_fan_stitcher<TerrainFaceWriter&>(writer, chunkId, detailX2Edge0, detailX2Edge1, rSkCh, rChInfo);
+
+    stitcher.stitch(cmd);
+
     // Fill remaining with zeros to indicate an early end if the full range isn't used
     std::fill(writer.currentFace, ibufSlice.end(), Vector3u{ZeroInit});
 
+    rGeom.faces_dirty(chunkId.value*rChInfo.chunkMaxFaceCount + rChInfo.fillFaceCount,
+                      rChInfo.chunkMaxFaceCount - rChInfo.fillFaceCount);
 }
 
 void subtract_normal_contrib(
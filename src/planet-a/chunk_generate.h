@@ -44,12 +44,32 @@ struct ChunkScratchpad
     /// Temporary vector for storing sections of shared vertices
     std::vector< osp::MaybeNewId<SkVrtxId> > edgeVertices;
 
+    /// Temporary vectors for batches of shared vertex positions passed to a terrain generator
+    std::vector<osp::Vector3l>  sharedHeightPos;
+    std::vector<float>          sharedHeights;
+
+    struct FillHeightBuffers
+    {
+        std::vector<osp::Vector3l>  skelPos;
+        std::vector<float>          heights;
+    };
+
+    /// Temporary vectors for a chunk's fill vertex positions passed to a terrain generator. Fill
+    /// vertices are generated in parallel over ranges of chunks, with one of these per range.
+    std::vector<FillHeightBuffers> fillHeightBuffers;
+
     /// New stitches to apply to currently existing chunks
     osp::KeyedVec<ChunkId, ChunkStitch> stitchCmds;
 
     lgrn::IdSetStl<ChunkId> chunksAdded;   ///< Recently added chunks
     lgrn::IdSetStl<ChunkId> chunksRemoved; ///< Recently removed chunks
 
+    /// chunksAdded as a vector, for splitting work across threads
+    std::vector<ChunkId>    chunksAddedList;
+
+    /// Recently added chunks with fill vertices copied from a ChunkMeshCache
+    lgrn::IdSetStl<ChunkId> chunksRestored;
+
     lgrn::IdSetStl<SharedVrtxId> sharedAdded;   ///< Recently added shared vertices
     lgrn::IdSetStl<SharedVrtxId> sharedRemoved; ///< Recently removed shared vertices
 
@@ -75,6 +95,9 @@ void restitch_check(
  *
  * Fan triangles will be generated for newly added chunks. Fan triangles will be added or replaced
  * if a chunk command is enabled.
+ *
+ * Same as calling update_fill_faces and add_fill_shared_normals (if newlyAdded), then
+ * update_fan_faces.
  */
 void update_faces(
         ChunkId                         chunkId,
@@ -87,6 +110,57 @@ void update_faces(
         ChunkScratchpad                 &rChSP,
         ChunkSkeleton                   &rSkCh);
 
+/**
+ * @brief Write fill triangles and fill vertex normals of a newly added chunk
+ *
+ * Only writes to parts of rGeom owned by chunkId, so this is safe to call in parallel for
+ * different chunks. Shared vertex normals are only recorded in the chunk's row of
+ * BasicChunkMeshGeometry::chunkFillSharedNormals; apply them with add_fill_shared_normals(...).
+ *
+ * @param normalsCached [in] Only write triangles, as normals were already copied from a
+ *                           ChunkMeshCache
+ */
+void update_fill_faces(
+        ChunkId                         chunkId,
+        BasicChunkMeshGeometry          &rGeom,
+        ChunkMeshBufferInfo       const &rChInfo,
+        ChunkSkeleton             const &rSkCh,
+        bool                            normalsCached = false);
+
+/**
+ * @brief Record fill vertices and faces of a chunk as modified in BasicChunkMeshGeometry::vrtxDirty
+ *        and indxDirty
+ *
+ * Covers everything written by update_fill_faces(...) and the chunk's fill vertex positions. This
+ * isn't done by update_fill_faces itself, since that may run in parallel.
+ */
+void fill_dirty(
+        ChunkId                         chunkId,
+        BasicChunkMeshGeometry          &rGeom,
+        ChunkMeshBufferInfo       const &rChInfo);
+
+/**
+ * @brief Add fill normal contributions of a chunk written by update_fill_faces(...) to
+ *        BasicChunkMeshGeometry::sharedNormalSum
+ */
+void add_fill_shared_normals(
+        ChunkId                         chunkId,
+        BasicChunkMeshGeometry          &rGeom,
+        ChunkScratchpad                 &rChSP,
+        ChunkSkeleton             const &rSkCh);
+
+/**
+ * @brief Add or replace a chunk's fan triangles if its stitch command is enabled
+ */
+void update_fan_faces(
+        ChunkId                         chunkId,
+        SkTriId                         sktriId,
+        SubdivTriangleSkeleton    const &rSkel,
+        BasicChunkMeshGeometry          &rGeom,
+        ChunkMeshBufferInfo       const &rChInfo,
+        ChunkScratchpad                 &rChSP,
+        ChunkSkeleton                   &rSkCh);
+
 /**
  * @brief Subtract normals from connected shared vertices when removing a chunk, or fan triangles
  *        only if fans are being redone.
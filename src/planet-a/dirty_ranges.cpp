@@ -0,0 +1,66 @@
+/**
+ * Open Space Program
+ * Copyright © 2019-2025 Open Space Program Project
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "dirty_ranges.h"
+
+#include <algorithm>
+
+namespace planeta
+{
+
+std::vector<ByteRange> const& DirtyRanges::coalesce(std::size_t const maxGap)
+{
+    if (m_ranges.empty() || (m_coalesced && maxGap <= m_coalescedGap))
+    {
+        return m_ranges;
+    }
+
+    std::sort(m_ranges.begin(), m_ranges.end(), [] (ByteRange const& lhs, ByteRange const& rhs)
+    {
+        return lhs.offset < rhs.offset;
+    });
+
+    // Merge in-place; itOut is the last range written
+    auto itOut = m_ranges.begin();
+    for (auto it = std::next(m_ranges.begin()); it < m_ranges.end(); ++it)
+    {
+        if (it->offset <= itOut->end() + maxGap)
+        {
+            itOut->size = std::max(itOut->end(), it->end()) - itOut->offset;
+        }
+        else
+        {
+            ++itOut;
+            *itOut = *it;
+        }
+    }
+
+    m_ranges.erase(std::next(itOut), m_ranges.end());
+
+    m_coalesced     = true;
+    m_coalescedGap  = maxGap;
+    return m_ranges;
+}
+
+} // namespace planeta
@@ -0,0 +1,117 @@
+/**
+ * Open Space Program
+ * Copyright © 2019-2025 Open Space Program Project
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+/**
+ * @file
+ * @brief Records which byte ranges of a buffer were modified, for partial GPU uploads
+ */
+
+#include <cstddef>
+#include <vector>
+
+namespace planeta
+{
+
+struct ByteRange
+{
+    std::size_t offset;
+    std::size_t size;
+
+    constexpr std::size_t end() const noexcept { return offset + size; }
+
+    constexpr bool operator==(ByteRange const&) const noexcept = default;
+};
+
+/**
+ * @brief List of modified byte ranges of a single buffer
+ *
+ * Ranges are added in any order while the buffer is written to, then sorted and merged with
+ * coalesce(...) when they're read. Owners of the buffer call clear() before writing a new batch
+ * of changes.
+ */
+class DirtyRanges
+{
+public:
+
+    /**
+     * @brief Mark [offset, offset+size) as modified
+     */
+    void add(std::size_t const offset, std::size_t const size)
+    {
+        if (size != 0 && ! m_all)
+        {
+            m_ranges.push_back({offset, size});
+            m_coalesced = false;
+        }
+    }
+
+    /**
+     * @brief Mark an entire buffer of a given size as modified, such as when all of its contents
+     *        moved or it was reallocated
+     */
+    void add_all(std::size_t const bufferSize)
+    {
+        m_ranges.assign(1, {0, bufferSize});
+        m_all       = true;
+        m_coalesced = true;
+    }
+
+    void clear() noexcept
+    {
+        m_ranges.clear();
+        m_all       = false;
+        m_coalesced = true;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return m_ranges.empty(); }
+
+    /**
+     * @return true if add_all(...) was called since the last clear()
+     */
+    [[nodiscard]] bool is_all() const noexcept { return m_all; }
+
+    /**
+     * @brief Sort ranges, and merge ones that overlap or are separated by maxGap bytes or less
+     *
+     * Merging across small gaps re-uploads a few unmodified bytes in exchange for fewer uploads.
+     *
+     * @return Sorted non-overlapping ranges
+     */
+    std::vector<ByteRange> const& coalesce(std::size_t maxGap = 0);
+
+    /**
+     * @brief Ranges as added, only sorted and non-overlapping after coalesce(...)
+     */
+    [[nodiscard]] std::vector<ByteRange> const& ranges() const noexcept { return m_ranges; }
+
+private:
+    std::vector<ByteRange>  m_ranges;
+    std::size_t             m_coalescedGap{0};
+    bool                    m_coalesced{true};
+    bool                    m_all{false};
+
+}; // class DirtyRanges
+
+} // namespace planeta
@@ -43,6 +43,9 @@ void BasicChunkMeshGeometry::resize(ChunkSkeleton const& skCh, ChunkMeshBufferIn
     vrtxBuffer = Array<std::byte>    (Corrade::ValueInit, formatBuilder.total_size());
     indxBuffer = Array<osp::Vector3u>(Corrade::ValueInit, info.faceTotal);
 
+    vrtxDirty.add_all(vrtxBuffer.size());
+    indxDirty.add_all(indxBuffer.size() * sizeof(osp::Vector3u));
+
     chunkFanNormalContrib  .resize(maxChunks * info.fanMaxSharedCount);
     chunkFillSharedNormals .resize(maxChunks * skCh.m_chunkSharedCount, osp::Vector3{osp::ZeroInit});
     sharedNormalSum        .resize(maxSharedVrtx, osp::Vector3{osp::ZeroInit});
@@ -31,6 +31,7 @@
 
 #include "skeleton.h"
 #include "chunk_utils.h"
+#include "dirty_ranges.h"
 
 #include <osp/core/math_int64.h>
 #include <osp/core/buffer_format.h>
@@ -84,12 +85,37 @@ struct BasicChunkMeshGeometry
 {
     void resize(ChunkSkeleton const& skCh, ChunkMeshBufferInfo const& info);
 
+    /// Record vertex positions [first, first+count) as modified in vrtxDirty
+    void positions_dirty(std::size_t const first, std::size_t const count)
+    {
+        attrib_dirty(vbufPositions, first, count);
+    }
+
+    /// Record vertex normals [first, first+count) as modified in vrtxDirty
+    void normals_dirty(std::size_t const first, std::size_t const count)
+    {
+        attrib_dirty(vbufNormals, first, count);
+    }
+
+    /// Record faces [first, first+count) as modified in indxDirty
+    void faces_dirty(std::size_t const first, std::size_t const count)
+    {
+        indxDirty.add(first * sizeof(osp::Vector3u), count * sizeof(osp::Vector3u));
+    }
+
     Corrade::Containers::Array<std::byte>     vrtxBuffer; ///< Output vertex buffer
     Corrade::Containers::Array<osp::Vector3u> indxBuffer; ///< Output index buffer
 
     osp::BufAttribFormat<osp::Vector3> vbufPositions;   ///< Describes Position data in vrtxBuffer
     osp::BufAttribFormat<osp::Vector3> vbufNormals;     ///< Describes Normal data in vrtxBuffer
 
+    /// Byte ranges of vrtxBuffer modified by the latest terrain update. Cleared at the start of
+    /// each update, so renderers only need to upload these.
+    DirtyRanges vrtxDirty;
+
+    /// Byte ranges of indxBuffer modified by the latest terrain update, see \c vrtxDirty
+    DirtyRanges indxDirty;
+
     /// Shared vertex positions copied from the skeleton and offsetted with no heightmap applied
     osp::KeyedVec<planeta::SharedVrtxId, osp::Vector3>  sharedPosNoHeightmap;
 
@@ -106,6 +132,17 @@ struct BasicChunkMeshGeometry
     /// "Chunk Mesh Vertex positions = to_float(skeleton positions + skelOffset)". This is intended
     /// to move the mesh's origin closer to the viewer, preventing floating point imprecision.
     osp::Vector3l originSkelPos{osp::ZeroInit};
+
+private:
+
+    void attrib_dirty(osp::BufAttribFormat<osp::Vector3> const& format, std::size_t const first, std::size_t const count)
+    {
+        if (count != 0)
+        {
+            std::size_t const stride = std::size_t(format.stride);
+            vrtxDirty.add(format.offset + first*stride, (count-1)*stride + sizeof(osp::Vector3));
+        }
+    }
 };
 
 /**
@@ -129,14 +166,13 @@ struct TerrainFaceWriter
         fan_add_face(a, b, c);
     }
 
+    /**
+     * Only records into the chunk's own fillNormalContrib, so fill faces of different chunks can
+     * be written in parallel. See add_fill_shared_normals(...) for adding them to sharedNormalSum.
+     */
     void fill_add_normal_shared(VertexIdx const vertex, ChunkLocalSharedId const local)
     {
-        SharedVrtxId const shared = sharedUsed[local.value];
-
-        fillNormalContrib[local.value]  += selectedFaceNormal;
-        sharedNormalSum  [shared.value] += selectedFaceNormal;
-
-        rSharedNormalsDirty.insert(shared);
+        fillNormalContrib[local.value] += selectedFaceNormal;
     }
 
     void fill_add_normal_filled(VertexIdx const vertex)
@@ -198,7 +234,7 @@ struct TerrainFaceWriter
         {
             rContrib.shared = shared;
             rContrib.sum = osp::Vector3{osp::ZeroInit};
-            rSharedNormalsDirty.insert(shared);
+            pSharedNormalsDirty->insert(shared);
             std::advance(contribLast, 1);
             LGRN_ASSERT(contribLast != fanNormalContrib.end());
         }
@@ -224,7 +260,7 @@ struct TerrainFaceWriter
     osp::Vector3u                       selectedFaceIndx;
     IndxIt_t                            currentFace;
     ContribIt_t                         contribLast;
-    lgrn::IdSetStl<SharedVrtxId>        &rSharedNormalsDirty;
+    lgrn::IdSetStl<SharedVrtxId>        *pSharedNormalsDirty{nullptr}; ///< Only used by fans
 };
 static_assert(CFaceWriter<TerrainFaceWriter>, "TerrainFaceWriter must satisfy concept CFaceWriter");
 
@@ -24,7 +24,10 @@
  */
 #include "skeleton_subdiv.h"
 
+#include <algorithm>
+
 using osp::Vector3;
+using osp::Vector3d;
 using osp::Vector3l;
 
 namespace planeta
@@ -41,6 +44,36 @@ void SkeletonSubdivScratchpad::resize(SubdivTriangleSkeleton &rSkel)
     surfaceRemoved  .resize(triCapacity);
 }
 
+void subdiv_budget_begin(SkeletonSubdivScratchpad &rSP) noexcept
+{
+    rSP.budgetStart         = std::chrono::steady_clock::now();
+    rSP.budgetSubdivCount   = 0;
+    rSP.budgetUnsubdivCount = 0;
+    rSP.budgetExceeded      = false;
+}
+
+static bool budget_out_of_time(SkeletonSubdivScratchpad const &rSP) noexcept
+{
+    return    rSP.budget.maxMicroseconds != 0
+           && (std::chrono::steady_clock::now() - rSP.budgetStart) > std::chrono::microseconds(rSP.budget.maxMicroseconds);
+}
+
+static bool budget_allows_subdiv(SkeletonSubdivScratchpad &rSP) noexcept
+{
+    bool const allowed =    (rSP.budget.maxSubdiv == 0 || rSP.budgetSubdivCount < rSP.budget.maxSubdiv)
+                         && ! budget_out_of_time(rSP);
+    rSP.budgetExceeded |= ! allowed;
+    return allowed;
+}
+
+static bool budget_allows_unsubdiv(SkeletonSubdivScratchpad &rSP, std::uint32_t const selected) noexcept
+{
+    bool const allowed =    (rSP.budget.maxUnsubdiv == 0 || rSP.budgetUnsubdivCount + selected < rSP.budget.maxUnsubdiv)
+                         && ! budget_out_of_time(rSP);
+    rSP.budgetExceeded |= ! allowed;
+    return allowed;
+}
+
 void unsubdivide_select_by_distance(
         std::uint8_t             const lvl,
         osp::Vector3l            const pos,
@@ -85,6 +118,10 @@ void unsubdivide_select_by_distance(
         maybe_distance_check(sktriId);
     }
 
+    // Selecting only part of the triangles is fine, unsubdivide_deselect_invariant_violations
+    // treats the ones not selected as staying subdivided
+    std::uint32_t selected = 0;
+
     while (rLvlSP.distanceTestNext.size() != 0)
     {
         std::swap(rLvlSP.distanceTestProcessing, rLvlSP.distanceTestNext);
@@ -100,6 +137,13 @@ void unsubdivide_select_by_distance(
 
             if (tooFar)
             {
+                if ( ! budget_allows_unsubdiv(rSP, selected) )
+                {
+                    rLvlSP.distanceTestNext.clear();
+                    break; // Leave the rest for later frames
+                }
+                ++selected;
+
                 // All checks passed
                 rSP.tryUnsubdiv.insert(sktriId);
 
@@ -303,6 +347,8 @@ void unsubdivide_level(
         rSP.onUnsubdiv(sktriId, rTri, rSkel, rSkData, rSP.onUnsubdivUserData);
 
         rSkel.tri_unsubdiv(sktriId, rTri);
+
+        ++rSP.budgetUnsubdivCount;
     }
 
     rSP.tryUnsubdiv.clear();
@@ -333,6 +379,7 @@ SkTriGroupId subdivide(
     // Actually do the subdivision ( create a new group (4 triangles) as children )
     // manual borrow checker hint: rSkTri becomes invalid here >:)
     auto const [groupId, rGroup] = rSkel.tri_subdiv(sktriId, rSkTri, middles);
+    ++rSP.budgetSubdivCount;
 
     rSkData.resize(rSkel);
     rSP.resize(rSkel);
@@ -535,12 +582,28 @@ void subdivide_level_by_distance(
     SubdivScratchpadLevel         &rLvlSP = rSP  .levels[lvl];
 
     bool const hasNextLevel = lvl+1 < rSkel.levelMax;
+    bool const limited      =    rSP.budget.maxSubdiv != 0
+                              || rSP.budget.maxMicroseconds != 0;
 
     while ( ! rSP.levels[lvl].distanceTestNext.empty() )
     {
         std::swap(rLvlSP.distanceTestProcessing, rLvlSP.distanceTestNext);
         rLvlSP.distanceTestNext.clear();
 
+        if (limited)
+        {
+            // Nearest first, so the budget is spent where detail matters most
+            auto const distanceSqr = [&rSkData, pos] (SkTriId const sktriId) noexcept
+            {
+                return (Vector3d(rSkData.centers[sktriId] - pos)).dot();
+            };
+            std::sort(rLvlSP.distanceTestProcessing.begin(), rLvlSP.distanceTestProcessing.end(),
+                      [&distanceSqr] (SkTriId const lhs, SkTriId const rhs) noexcept
+            {
+                return distanceSqr(lhs) < distanceSqr(rhs);
+            });
+        }
+
         for (SkTriId const sktriId : rLvlSP.distanceTestProcessing)
         {
             Vector3l const center = rSkData.centers[sktriId];
@@ -569,10 +632,12 @@ void subdivide_level_by_distance(
                         rSP.distanceTestDone.insert(tri_id(children, 3));
                     }
                 }
-                else
+                else if (budget_allows_subdiv(rSP))
                 {
                     subdivide(sktriId, rTri, lvl, hasNextLevel, rSkel, rSkData, rSP);
                 }
+                // else, over budget. This triangle will be found again by the next frame's
+                // distance test
             }
 
             // Fix up Invariant B violations
@@ -32,6 +32,8 @@
 #include "skeleton.h"
 #include "geometry.h"
 
+#include <chrono>
+
 namespace planeta
 {
 
@@ -42,6 +44,25 @@ struct SubdivScratchpadLevel
 };
 
 
+/**
+ * @brief Limits how much work subdividing and unsubdividing can do per frame
+ *
+ * Zero means no limit. Work not done is carried over to the next frame, since distance testing
+ * starts over from the root triangles each frame.
+ */
+struct SubdivBudget
+{
+    /// Max triangles subdivided because they're close to the viewer. Subdivisions needed to fix
+    /// invariant violations are counted, but are always done even if over budget.
+    std::uint32_t maxSubdiv         {0};
+
+    /// Max triangles unsubdivided
+    std::uint32_t maxUnsubdiv       {0};
+
+    /// Time limit shared by unsubdivide and subdivide, counting from subdiv_budget_begin(...)
+    std::uint32_t maxMicroseconds   {0};
+};
+
 /**
  * @brief Temporary data needed to subdivide/unsubdivide a SkeletonVertexData
  *
@@ -85,13 +106,27 @@ struct SkeletonSubdivScratchpad
     osp::Vector3l viewerPosition;
 
     std::uint32_t distanceCheckCount{};
+
+    SubdivBudget budget;
+    std::chrono::steady_clock::time_point budgetStart;
+    std::uint32_t budgetSubdivCount     {};
+    std::uint32_t budgetUnsubdivCount   {};
+
+    /// Set if work was skipped due to the budget, meaning LOD is not fully up to date
+    bool budgetExceeded                 {false};
 };
 
+/**
+ * @brief Start a new frame's SkeletonSubdivScratchpad::budget. Call before unsubdividing and
+ *        subdividing.
+ */
+void subdiv_budget_begin(SkeletonSubdivScratchpad &rSP) noexcept;
+
 
 /**
  * @brief Selects triangles (within a subdiv level) that are too far away from pos
  *
- * Populates SubdivScratchpad::tryUnsubdiv
+ * Populates SubdivScratchpad::tryUnsubdiv, up to the remaining SubdivBudget::maxUnsubdiv
  */
 void unsubdivide_select_by_distance(
         std::uint8_t                    lvl,
@@ -136,6 +171,9 @@ SkTriGroupId subdivide(
 
 /**
  * @brief Subdivide all triangles (within a subdiv level) too close to pos
+ *
+ * If SkeletonSubdivScratchpad::budget is limited, triangles nearest to pos are subdivided first,
+ * and the rest are left for later frames once the budget runs out.
  */
 void subdivide_level_by_distance(
         osp::Vector3l                   pos,
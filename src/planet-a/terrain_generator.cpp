@@ -0,0 +1,239 @@
+/**
+ * Open Space Program
+ * Copyright © 2019-2025 Open Space Program Project
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "terrain_generator.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+using osp::Vector3;
+using osp::Vector3d;
+using osp::Vector3l;
+
+namespace planeta
+{
+
+namespace
+{
+
+// Positions are processed in fixed-size blocks of separate X, Y, and Z arrays. Loops over these
+// only do branch-free arithmetic, so the compiler can vectorize them.
+constexpr std::size_t gc_blockSize = 64;
+
+struct Block
+{
+    // Positions in meters relative to planet center
+    alignas(64) std::array<double, gc_blockSize> x;
+    alignas(64) std::array<double, gc_blockSize> y;
+    alignas(64) std::array<double, gc_blockSize> z;
+
+    // Height in meters, and its gradient (change in height per meter)
+    alignas(64) std::array<double, gc_blockSize> height;
+    alignas(64) std::array<double, gc_blockSize> dx;
+    alignas(64) std::array<double, gc_blockSize> dy;
+    alignas(64) std::array<double, gc_blockSize> dz;
+};
+
+/**
+ * @brief Split positions into blocks, call calcBlock on each, then write heights and normals
+ *
+ * @param calcBlock [in] void(Block&, std::size_t count), reads positions and writes height and
+ *                       gradient for the first count elements
+ */
+template <typename FUNC_T>
+void process_blocks(
+        osp::ArrayView<Vector3l const>  positions,
+        int                       const precision,
+        osp::ArrayView<float>           heightsOut,
+        osp::ArrayView<Vector3>         normalsOut,
+        FUNC_T                          &&calcBlock) noexcept
+{
+    double const scale       = std::exp2(double(-precision));
+    bool   const wantNormals = normalsOut.size() != 0;
+
+    Block block;
+
+    for (std::size_t first = 0; first < positions.size(); first += gc_blockSize)
+    {
+        std::size_t const count = std::min(gc_blockSize, positions.size() - first);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Vector3l const pos = positions[first + i];
+            block.x[i] = double(pos.x()) * scale;
+            block.y[i] = double(pos.y()) * scale;
+            block.z[i] = double(pos.z()) * scale;
+        }
+
+        calcBlock(block, count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            heightsOut[first + i] = float(block.height[i]);
+        }
+
+        if ( ! wantNormals )
+        {
+            continue;
+        }
+
+        // Tilt the radial direction against the tangential part of the height gradient
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Vector3d const radialDir = Vector3d{block.x[i], block.y[i], block.z[i]}.normalized();
+            Vector3d const gradient  {block.dx[i], block.dy[i], block.dz[i]};
+            Vector3d const tangent   = gradient - radialDir * Magnum::Math::dot(gradient, radialDir);
+            normalsOut[first + i] = Vector3{(radialDir - tangent).normalized()};
+        }
+    }
+}
+
+/**
+ * @return Pseudo-random value in [-1, 1] for an integer lattice point
+ */
+constexpr double lattice_value(std::uint32_t x, std::uint32_t y, std::uint32_t z, std::uint32_t seed) noexcept
+{
+    std::uint32_t h = seed ^ (x * 0x8da6b343u) ^ (y * 0xd8163841u) ^ (z * 0xcb1ab31fu);
+    h ^= h >> 16;
+    h *= 0x7feb352du;
+    h ^= h >> 15;
+    h *= 0x846ca68bu;
+    h ^= h >> 16;
+    return double(h) * (2.0 / 4294967295.0) - 1.0;
+}
+
+} // namespace
+
+void CosineTerrainGenerator::heights(
+        osp::ArrayView<Vector3l const>  positions,
+        int                       const precision,
+        osp::ArrayView<float>           heightsOut,
+        osp::ArrayView<Vector3>         normalsOut) const noexcept
+{
+    double const h  = m_maxHeight;
+    double const kx = 0.000050*2.0*3.14159;
+    double const ky = 0.000005*2.0*3.14159;
+
+    process_blocks(positions, precision, heightsOut, normalsOut, [h, kx, ky] (Block &rBlock, std::size_t const count) noexcept
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            double const ax = kx * rBlock.x[i];
+            double const ay = ky * rBlock.y[i];
+
+            rBlock.height[i] = h * std::clamp(0.1*(0.5 - 0.5*std::cos(ax)) + 0.9*(0.5 - 0.5*std::cos(ay)), 0.0, 1.0);
+            rBlock.dx[i]     = h * 0.1*0.5*kx*std::sin(ax);
+            rBlock.dy[i]     = h * 0.9*0.5*ky*std::sin(ay);
+            rBlock.dz[i]     = 0.0;
+        }
+    });
+}
+
+void NoiseTerrainGenerator::heights(
+        osp::ArrayView<Vector3l const>  positions,
+        int                       const precision,
+        osp::ArrayView<float>           heightsOut,
+        osp::ArrayView<Vector3>         normalsOut) const noexcept
+{
+    NoiseTerrainParams const& params = m_params;
+
+    process_blocks(positions, precision, heightsOut, normalsOut, [&params] (Block &rBlock, std::size_t const count) noexcept
+    {
+        std::fill_n(rBlock.height.begin(), count, 0.0);
+        std::fill_n(rBlock.dx.begin(),     count, 0.0);
+        std::fill_n(rBlock.dy.begin(),     count, 0.0);
+        std::fill_n(rBlock.dz.begin(),     count, 0.0);
+
+        int    const octaves = std::max(params.octaves, 1);
+        double freq     = 1.0 / params.wavelength;
+        double amp      = 1.0;
+        double ampSum   = 0.0;
+
+        for (int octave = 0; octave < octaves; ++octave)
+        {
+            std::uint32_t const seed = params.seed + std::uint32_t(octave) * 0x9e3779b9u;
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                double const px = rBlock.x[i] * freq;
+                double const py = rBlock.y[i] * freq;
+                double const pz = rBlock.z[i] * freq;
+                double const fx = std::floor(px);
+                double const fy = std::floor(py);
+                double const fz = std::floor(pz);
+
+                auto const ix = std::uint32_t(std::int64_t(fx));
+                auto const iy = std::uint32_t(std::int64_t(fy));
+                auto const iz = std::uint32_t(std::int64_t(fz));
+
+                // Smoothstep interpolation weights and their derivatives
+                double const tx = px - fx, ux = tx*tx*(3.0 - 2.0*tx), dux = 6.0*tx*(1.0 - tx);
+                double const ty = py - fy, uy = ty*ty*(3.0 - 2.0*ty), duy = 6.0*ty*(1.0 - ty);
+                double const tz = pz - fz, uz = tz*tz*(3.0 - 2.0*tz), duz = 6.0*tz*(1.0 - tz);
+
+                double const a = lattice_value(ix,     iy,     iz,     seed);
+                double const b = lattice_value(ix + 1, iy,     iz,     seed);
+                double const c = lattice_value(ix,     iy + 1, iz,     seed);
+                double const d = lattice_value(ix + 1, iy + 1, iz,     seed);
+                double const e = lattice_value(ix,     iy,     iz + 1, seed);
+                double const f = lattice_value(ix + 1, iy,     iz + 1, seed);
+                double const g = lattice_value(ix,     iy + 1, iz + 1, seed);
+                double const h = lattice_value(ix + 1, iy + 1, iz + 1, seed);
+
+                // Trilinear interpolation expanded as a polynomial, so the derivative is cheap
+                double const k1 = b - a;
+                double const k2 = c - a;
+                double const k3 = e - a;
+                double const k4 = a - b - c + d;
+                double const k5 = a - c - e + g;
+                double const k6 = a - b - e + f;
+                double const k7 = - a + b + c - d + e - f - g + h;
+
+                double const value = a + k1*ux + k2*uy + k3*uz + k4*ux*uy + k5*uy*uz + k6*uz*ux + k7*ux*uy*uz;
+
+                rBlock.height[i] += amp * value;
+                rBlock.dx[i]     += amp * freq * dux * (k1 + k4*uy + k6*uz + k7*uy*uz);
+                rBlock.dy[i]     += amp * freq * duy * (k2 + k5*uz + k4*ux + k7*uz*ux);
+                rBlock.dz[i]     += amp * freq * duz * (k3 + k6*ux + k5*uy + k7*ux*uy);
+            }
+
+            ampSum += amp;
+            amp    *= params.persistence;
+            freq   *= params.lacunarity;
+        }
+
+        // Noise sum is within [-ampSum, ampSum]. Remap to [0, height]
+        double const slope = 0.5 * params.height / ampSum;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            rBlock.height[i] = std::clamp(0.5*params.height + slope*rBlock.height[i], 0.0, params.height);
+            rBlock.dx[i]     *= slope;
+            rBlock.dy[i]     *= slope;
+            rBlock.dz[i]     *= slope;
+        }
+    });
+}
+
+} // namespace planeta
@@ -0,0 +1,134 @@
+/**
+ * Open Space Program
+ * Copyright © 2019-2025 Open Space Program Project
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#pragma once
+/**
+ * @file
+ * @brief Interface for calculating terrain heights, and a few implementations of it
+ */
+
+#include <osp/core/array_view.h>
+#include <osp/core/math_types.h>
+
+#include <cstdint>
+
+namespace planeta
+{
+
+/**
+ * @brief Calculates terrain heights for batches of skeleton positions
+ *
+ * Positions are passed in batches (such as all of a chunk's fill vertices) so implementations
+ * can process them in tight loops, instead of paying for a virtual call per vertex.
+ *
+ * Implementations must be safe to call from multiple threads at once.
+ */
+class ITerrainGenerator
+{
+public:
+
+    virtual ~ITerrainGenerator() = default;
+
+    /**
+     * @brief Calculate heights and optionally surface normals for a batch of positions
+     *
+     * @param positions     [in] Skeleton positions relative to the planet center
+     * @param precision     [in] Skeleton precision, 2^precision units = 1 meter
+     * @param heightsOut    [out] Heights above ACtxTerrainIco::radius in meters. Must be the same
+     *                            size as positions. Values are within [0, ACtxTerrainIco::height].
+     * @param normalsOut    [out] Unit surface normals. Either the same size as positions, or
+     *                            empty to skip calculating normals.
+     */
+    virtual void heights(
+            osp::ArrayView<osp::Vector3l const> positions,
+            int                                 precision,
+            osp::ArrayView<float>               heightsOut,
+            osp::ArrayView<osp::Vector3>        normalsOut) const noexcept = 0;
+};
+
+/**
+ * @brief Two cosine waves along the X and Y axes
+ *
+ * Placeholder terrain used for testing.
+ */
+class CosineTerrainGenerator final : public ITerrainGenerator
+{
+public:
+
+    CosineTerrainGenerator(double maxHeight) noexcept : m_maxHeight{maxHeight} { }
+
+    void heights(
+            osp::ArrayView<osp::Vector3l const> positions,
+            int                                 precision,
+            osp::ArrayView<float>               heightsOut,
+            osp::ArrayView<osp::Vector3>        normalsOut) const noexcept override;
+
+private:
+    double m_maxHeight;
+};
+
+struct NoiseTerrainParams
+{
+    /// Max height in meters, should match ACtxTerrainIco::height
+    double          height      {};
+
+    /// Wavelength of the first (largest) octave in meters
+    double          wavelength  {100000.0};
+
+    /// Amplitude multiplier for each successive octave
+    double          persistence {0.5};
+
+    /// Frequency multiplier for each successive octave
+    double          lacunarity  {2.0};
+
+    int             octaves     {8};
+
+    std::uint32_t   seed        {};
+};
+
+/**
+ * @brief Multi-octave 3D value noise (fractal Brownian motion) sampled on the planet surface
+ *
+ * Normals are calculated from the analytic derivative of the noise, so they don't require
+ * sampling neighboring positions.
+ */
+class NoiseTerrainGenerator final : public ITerrainGenerator
+{
+public:
+
+    NoiseTerrainGenerator(NoiseTerrainParams const& params) noexcept : m_params{params} { }
+
+    void heights(
+            osp::ArrayView<osp::Vector3l const> positions,
+            int                                 precision,
+            osp::ArrayView<float>               heightsOut,
+            osp::ArrayView<osp::Vector3>        normalsOut) const noexcept override;
+
+    [[nodiscard]] NoiseTerrainParams const& params() const noexcept { return m_params; }
+
+private:
+    NoiseTerrainParams m_params;
+};
+
+} // namespace planeta
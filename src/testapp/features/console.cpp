@@ -90,6 +90,7 @@ FeatureDef const ftrREPL = feature_def("REPL", [] (FeatureBuilder &rFB, Implemen
 
     rFB.task()
         .name       ("Read stdin buffer")
+        .main_thread(true)
         .sync_with  ({cinREPL.pl.cinLines(Modify_)})
         .args       ({            cinREPL.di.cinLines})
         .func([] (std::vector<std::string> &rCinLines) noexcept
@@ -91,6 +91,7 @@ FeatureDef const ftrMagnum = feature_def("Magnum", [] (
 
     rFB.task()
         .name       ("Clean up Magnum renderer")
+        .main_thread(true)
         .sync_with  ({cleanup.pl.cleanup(Run_)})
         .args       ({    mainApp.di.resources,  magnum.di.renderGl})
         .func       ([] (Resources &rResources, RenderGL &rRenderGl) noexcept
@@ -128,6 +129,7 @@ FeatureDef const ftrMagnumScene = feature_def("MagnumScene", [] (
 
     rFB.task()
         .name       ("Resize ACtxSceneRenderGL (OpenGL) to fit all DrawEnts")
+        .main_thread(true)
         .sync_with  ({scnRender.pl.drawEnt(Ready), magnumScn.pl.entMeshGL(Resize_), magnumScn.pl.entDiffuseGL(Resize_)})
         .args       ({              scnRender.di.scnRender,        magnumScn.di.scnRenderGl })
         .func       ([] (ACtxSceneRender const &rScnRender, ACtxSceneRenderGL &rScnRenderGl) noexcept
@@ -139,6 +141,7 @@ FeatureDef const ftrMagnumScene = feature_def("MagnumScene", [] (
 
     rFB.task()
         .name       ("Compile Resource Meshes to GL")
+        .main_thread(true)
         .sync_with  ({comScn.pl.meshToRes(Ready), magnum.pl.meshGL(New)})
         .args       ({                comScn.di.drawingRes,       mainApp.di.resources,  magnum.di.renderGl })
         .func       ([] (ACtxDrawingRes const &rDrawingRes, osp::Resources &rResources, RenderGL &rRenderGl) noexcept
@@ -149,6 +152,7 @@ FeatureDef const ftrMagnumScene = feature_def("MagnumScene", [] (
 
     rFB.task()
         .name       ("Compile Resource Textures to GL")
+        .main_thread(true)
         .sync_with  ({comScn.pl.texToRes(Ready), magnum.pl.textureGL(New)})
         .args       ({                comScn.di.drawingRes,       mainApp.di.resources,  magnum.di.renderGl })
         .func       ([] (ACtxDrawingRes const &rDrawingRes, osp::Resources &rResources, RenderGL &rRenderGl) noexcept
@@ -159,6 +163,7 @@ FeatureDef const ftrMagnumScene = feature_def("MagnumScene", [] (
 
     rFB.task()
         .name       ("Assign GL textures to DrawEnts with diffuse textures")
+        .main_thread(true)
         .sync_with  ({scnRender.pl.diffuseTexDirty(UseOrRun), scnRender.pl.diffuseTex(Ready), magnum.pl.textureGL(Ready), magnumScn.pl.entDiffuseGL(New)})
         .args       ({       comScn.di.drawing,        comScn.di.drawingRes,      scnRender.di.scnRender,        magnumScn.di.scnRenderGl,  magnum.di.renderGl })
         .func       ([] (ACtxDrawing &rDrawing, ACtxDrawingRes &rDrawingRes, ACtxSceneRender &rScnRender, ACtxSceneRenderGL &rScnRenderGl, RenderGL &rRenderGl) noexcept
@@ -175,6 +180,7 @@ FeatureDef const ftrMagnumScene = feature_def("MagnumScene", [] (
 
     rFB.task()
         .name       ("Resync GL textures")
+        .main_thread(true)
         .sync_with  ({windowApp.pl.resync(Run), scnRender.pl.diffuseTex(Ready), magnum.pl.textureGL(Ready), magnumScn.pl.entDiffuseGL(New)})
         .args       ({          comScn.di.drawingRes,      scnRender.di.scnRender,        magnumScn.di.scnRenderGl,  magnum.di.renderGl })
         .func       ([] (ACtxDrawingRes &rDrawingRes, ACtxSceneRender &rScnRender, ACtxSceneRenderGL &rScnRenderGl, RenderGL &rRenderGl) noexcept
@@ -192,6 +198,7 @@ FeatureDef const ftrMagnumScene = feature_def("MagnumScene", [] (
 
     rFB.task()
         .name       ("Sync GL meshes to entities with scene meshes")
+        .main_thread(true)
         .sync_with  ({scnRender.pl.meshDirty(UseOrRun), scnRender.pl.mesh(Ready), magnum.pl.meshGL(Ready), magnumScn.pl.entMeshGL(New)})
         .args       ({          comScn.di.drawingRes,      scnRender.di.scnRender,        magnumScn.di.scnRenderGl,  magnum.di.renderGl })
         .func       ([] (ACtxDrawingRes &rDrawingRes, ACtxSceneRender &rScnRender, ACtxSceneRenderGL &rScnRenderGl, RenderGL &rRenderGl) noexcept
@@ -207,6 +214,7 @@ FeatureDef const ftrMagnumScene = feature_def("MagnumScene", [] (
 
     rFB.task()
         .name       ("Resync GL meshes")
+        .main_thread(true)
         .sync_with  ({windowApp.pl.resync(Run), scnRender.pl.mesh(Ready), magnum.pl.meshGL(Ready), magnumScn.pl.entMeshGL(New)})
         .args       ({          comScn.di.drawingRes,      scnRender.di.scnRender,        magnumScn.di.scnRenderGl,  magnum.di.renderGl })
         .func       ([] (ACtxDrawingRes &rDrawingRes, ACtxSceneRender &rScnRender, ACtxSceneRenderGL &rScnRenderGl, RenderGL &rRenderGl) noexcept
@@ -224,6 +232,7 @@ FeatureDef const ftrMagnumScene = feature_def("MagnumScene", [] (
 
     rFB.task()
         .name       ("Bind and display off-screen FBO")
+        .main_thread(true)
         .sync_with  ({scnRender.pl.render(Run), magnumScn.pl.fbo(EStgFBO::Bind)})
         .args       ({             comScn.di.drawing,  magnum.di.renderGl,        magnumScn.di.groupFwd,   magnumScn.di.camera })
         .func       ([] (ACtxDrawing const &rDrawing, RenderGL &rRenderGl, RenderGroup const &rGroupFwd, Camera const &rCamera) noexcept
@@ -242,6 +251,7 @@ FeatureDef const ftrMagnumScene = feature_def("MagnumScene", [] (
 
     rFB.task()
         .name       ("Render Entities")
+        .main_thread(true)
         .sync_with  ({scnRender.pl.render(Run), magnumScn.pl.groupFwd(Ready), magnumScn.pl.groupFwdEnts(Ready), magnumScn.pl.camera(Ready), scnRender.pl.drawTransforms(Ready), scnRender.pl.mesh(Ready), scnRender.pl.diffuseTex(Ready),
                       magnumScn.pl.entMeshGL(Ready), magnumScn.pl.entDiffuseGL(Ready),
                       scnRender.pl.drawEnt(Ready)})
@@ -256,6 +266,7 @@ FeatureDef const ftrMagnumScene = feature_def("MagnumScene", [] (
 
     rFB.task()
         .name       ("Delete DrawEnts from render groups")
+        .main_thread(true)
         .sync_with  ({scnRender.pl.drawEntDelete(UseOrRun), magnumScn.pl.groupFwdEnts(Delete)})
         .args       ({             comScn.di.drawing,  magnumScn.di.groupFwd,         scnRender.di.drawEntDel })
         .func       ([] (ACtxDrawing const &rDrawing, RenderGroup &rGroupFwd, DrawEntVec_t const &rDrawEntDel) noexcept
@@ -285,6 +296,7 @@ FeatureDef const ftrCameraControl = feature_def("CameraControl", [] (
 
     rFB.task()
         .name       ("Position Rendering Camera according to Camera Controller")
+        .main_thread(true)
         .sync_with  ({scnRender.pl.render(Run), camCtrl.pl.camCtrl(Ready), magnumScn.pl.camera(Modify)})
         .args       ({                     camCtrl.di.camCtrl, magnumScn.di.camera })
         .func       ([] (ACtxCameraController const& rCamCtrl,     Camera &rCamera) noexcept
@@ -294,6 +306,7 @@ FeatureDef const ftrCameraControl = feature_def("CameraControl", [] (
 
     rFB.task()
         .name       ("Clean up ACtxCameraController's subscription to UserInputHandler")
+        .main_thread(true)
         .sync_with  ({cleanup.pl.cleanup(Run_)})
         .args       ({               camCtrl.di.camCtrl })
         .func       ([] (ACtxCameraController &rCamCtrl) noexcept
@@ -337,6 +350,7 @@ FeatureDef const ftrShaderVisualizer = feature_def("ShaderVisualizer", [] (
 
     rFB.task()
         .name       ("Sync MeshVisualizer shader DrawEnts")
+        .main_thread(true)
         .sync_with  ({windowApp.pl.sync(Run), scnRender.pl.materialDirty(UseOrRun), magnum.pl.textureGL(Ready), magnumScn.pl.groupFwdEnts(New)})
         .args       ({        scnRender.di.scnRender,  magnumScn.di.groupFwd,              shVisual.di.shader})
         .func       ([] (ACtxSceneRender &rScnRender, RenderGroup &rGroupFwd, ACtxDrawMeshVisualizer &rShader) noexcept
@@ -347,6 +361,7 @@ FeatureDef const ftrShaderVisualizer = feature_def("ShaderVisualizer", [] (
 
     rFB.task()
         .name       ("Resync MeshVisualizer shader DrawEnts")
+        .main_thread(true)
         .sync_with  ({windowApp.pl.resync(Run), magnumScn.pl.groupFwdEnts(New), magnumScn.pl.groupFwd(Modify)})
         .args       ({        scnRender.di.scnRender,  magnumScn.di.groupFwd,              shVisual.di.shader})
         .func       ([] (ACtxSceneRender &rScnRender, RenderGroup &rGroupFwd, ACtxDrawMeshVisualizer &rShader) noexcept
@@ -390,6 +405,7 @@ FeatureDef const ftrShaderFlat = feature_def("ShaderFlat", [] (
 
     rFB.task()
         .name       ("Sync Flat shader DrawEnts")
+        .main_thread(true)
         .sync_with  ({windowApp.pl.sync(Run), magnumScn.pl.groupFwdEnts(New), magnumScn.pl.groupFwd(New), scnRender.pl.materialDirty(UseOrRun)})
         .args       ({        scnRender.di.scnRender,  magnumScn.di.groupFwd,              magnumScn.di.scnRenderGl,      shFlat.di.shader})
         .func       ([] (ACtxSceneRender &rScnRender, RenderGroup &rGroupFwd, ACtxSceneRenderGL const &rScnRenderGl, ACtxDrawFlat &rShader) noexcept
@@ -409,6 +425,7 @@ FeatureDef const ftrShaderFlat = feature_def("ShaderFlat", [] (
 
     rFB.task()
         .name       ("Resync Flat shader DrawEnts")
+        .main_thread(true)
         .sync_with  ({windowApp.pl.resync(Run), magnum.pl.textureGL(Ready), magnumScn.pl.groupFwdEnts(New), magnumScn.pl.groupFwd(Modify)})
         .args       ({        scnRender.di.scnRender,  magnumScn.di.groupFwd,              magnumScn.di.scnRenderGl,      shFlat.di.shader})
         .func       ([] (ACtxSceneRender &rScnRender, RenderGroup &rGroupFwd, ACtxSceneRenderGL const &rScnRenderGl, ACtxDrawFlat &rShader) noexcept
@@ -461,6 +478,7 @@ FeatureDef const ftrShaderPhong = feature_def("ShaderPhong", [] (
 
     rFB.task()
         .name       ("Sync Phong shader DrawEnts")
+        .main_thread(true)
         .sync_with  ({windowApp.pl.sync(Run), scnRender.pl.materialDirty(UseOrRun), magnumScn.pl.entDiffuseGL(Ready), magnumScn.pl.groupFwdEnts(New), magnumScn.pl.groupFwd(Modify)})
         .args       ({        scnRender.di.scnRender,  magnumScn.di.groupFwd,              magnumScn.di.scnRenderGl,      shPhong.di.shader})
         .func       ([] (ACtxSceneRender &rScnRender, RenderGroup &rGroupFwd, ACtxSceneRenderGL const &rScnRenderGl, ACtxDrawPhong &rShader) noexcept
@@ -480,6 +498,7 @@ FeatureDef const ftrShaderPhong = feature_def("ShaderPhong", [] (
 
     rFB.task()
         .name       ("Resync Phong shader DrawEnts")
+        .main_thread(true)
         .sync_with  ({windowApp.pl.resync(Run), magnumScn.pl.entDiffuseGL(Ready), magnumScn.pl.groupFwdEnts(New), magnumScn.pl.groupFwd(Modify)})
         .args       ({        scnRender.di.scnRender,  magnumScn.di.groupFwd,              magnumScn.di.scnRenderGl,      shPhong.di.shader})
         .func       ([] (ACtxSceneRender &rScnRender, RenderGroup &rGroupFwd, ACtxSceneRenderGL const &rScnRenderGl, ACtxDrawPhong &rShader) noexcept
@@ -532,6 +551,7 @@ FeatureDef const ftrTerrainDrawMagnum = feature_def("ShaderPhong", [] (
 
     rFB.task()
         .name       ("Sync terrainMeshGl to entities with terrainMesh")
+        .main_thread(true)
         .sync_with  ({windowApp.pl.sync(Run), scnRender.pl.meshDirty(UseOrRun), scnRender.pl.mesh(Ready), magnum.pl.meshGL(Modify)})
         .args       ({         terrainMgn.di.drawTerrainGL,    terrain.di.terrain,      scnRender.di.scnRender,        magnumScn.di.scnRenderGl,  magnum.di.renderGl })
         .func       ([] (ACtxDrawTerrainGL &rDrawTerrainGl, ACtxTerrain &rTerrain, ACtxSceneRender &rScnRender, ACtxSceneRenderGL &rScnRenderGl, RenderGL &rRenderGl) noexcept
@@ -552,6 +572,7 @@ FeatureDef const ftrTerrainDrawMagnum = feature_def("ShaderPhong", [] (
 
     rFB.task()
         .name       ("Resync terrainMeshGl to entities with terrainMesh")
+        .main_thread(true)
         .sync_with  ({windowApp.pl.resync(Run), scnRender.pl.mesh(Ready), magnum.pl.meshGL(Modify)})
         .args       ({         terrainMgn.di.drawTerrainGL,    terrain.di.terrain,      scnRender.di.scnRender,        magnumScn.di.scnRenderGl,  magnum.di.renderGl })
         .func       ([] (ACtxDrawTerrainGL &rDrawTerrainGl, ACtxTerrain &rTerrain, ACtxSceneRender &rScnRender, ACtxSceneRenderGL &rScnRenderGl, RenderGL &rRenderGl) noexcept
@@ -571,13 +592,18 @@ FeatureDef const ftrTerrainDrawMagnum = feature_def("ShaderPhong", [] (
 
     rFB.task()
         .name       ("Update terrain mesh GPU buffer data")
+        .main_thread(true)
         .sync_with  ({windowApp.pl.sync(Run), terrain.pl.chunkMesh(Ready)})
         .args       ({        scnRender.di.scnRender,  magnumScn.di.groupFwd,              magnumScn.di.scnRenderGl,  magnum.di.renderGl,       terrainMgn.di.drawTerrainGL,    terrain.di.terrain})
         .func       ([] (ACtxSceneRender &rScnRender, RenderGroup &rGroupFwd, ACtxSceneRenderGL const &rScnRenderGl, RenderGL &rRenderGl, ACtxDrawTerrainGL &rDrawTerrainGl, ACtxTerrain &rTerrain) noexcept
     {
+        // Only upload ranges modified by the latest terrain update, unless the GL buffers are new
+        bool uploadAll = false;
+
         if ( ! rDrawTerrainGl.enabled )
         {
             rDrawTerrainGl.enabled = true;
+            uploadAll = true;
 
             rDrawTerrainGl.indxBufGL = Magnum::GL::Buffer{};
             rDrawTerrainGl.vrtxBufGL = Magnum::GL::Buffer{};
@@ -596,19 +622,26 @@ FeatureDef const ftrTerrainDrawMagnum = feature_def("ShaderPhong", [] (
                  .setCount(Magnum::Int(3*rTerrain.chunkInfo.faceTotal)); // 3 vertices in each triangle
         }
 
-        auto const indxBuffer = arrayCast<unsigned char const>(rTerrain.chunkGeom.indxBuffer);
-        auto const vrtxBuffer = arrayView<std::byte const>(rTerrain.chunkGeom.vrtxBuffer);
-
-        // There's faster ways to sync the buffer, but keeping it simple for now
-
-        // see "Buffer re-specification" in
-        // https://www.khronos.org/opengl/wiki/Buffer_Object_Streaming
+        auto const upload = [uploadAll] (Magnum::GL::Buffer &rBufGl, ArrayView<std::byte const> const data, planeta::DirtyRanges &rDirty)
+        {
+            if (uploadAll || rDirty.is_all())
+            {
+                // see "Buffer re-specification" in
+                // https://www.khronos.org/opengl/wiki/Buffer_Object_Streaming
+                rBufGl.setData({nullptr, data.size()});
+                rBufGl.setData(data);
+                return;
+            }
 
-        rDrawTerrainGl.indxBufGL.setData({nullptr, indxBuffer.size()});
-        rDrawTerrainGl.indxBufGL.setData(indxBuffer);
+            // Merging ranges a few vertices apart means less calls for only a little extra data
+            for (planeta::ByteRange const& range : rDirty.coalesce(256))
+            {
+                rBufGl.setSubData(GLintptr(range.offset), data.sliceSize(range.offset, range.size));
+            }
+        };
 
-        rDrawTerrainGl.vrtxBufGL.setData({nullptr, vrtxBuffer.size()});
-        rDrawTerrainGl.vrtxBufGL.setData(vrtxBuffer);
+        upload(rDrawTerrainGl.indxBufGL, arrayCast<std::byte const>(rTerrain.chunkGeom.indxBuffer), rTerrain.chunkGeom.indxDirty);
+        upload(rDrawTerrainGl.vrtxBufGL, arrayView<std::byte const>(rTerrain.chunkGeom.vrtxBuffer), rTerrain.chunkGeom.vrtxDirty);
     });
 }); // ftrShaderPhong
 
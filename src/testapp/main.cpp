@@ -41,10 +41,13 @@
 #include <adera_app/application.h>
 #include <adera_app/feature_interfaces.h>
 #include <adera_app/features/common.h>
+#include <adera_app/features/jolt.h>
 
 #include <osp/core/Resources.h>
 #include <osp/drawing/own_restypes.h>
+#include <osp/executor/multithread_framework.h>
 #include <osp/executor/singlethread_framework.h>
+#include <osp/executor/task_profiler.h>
 #include <osp/framework/builder.h>
 #include <osp/framework/builder.h>
 #include <osp/util/logging.h>
@@ -54,6 +57,12 @@
 #include <spdlog/fmt/ostr.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
+#include <toml.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <fstream>
 #include <iostream>
 
 using namespace testapp;
@@ -68,12 +77,57 @@ void print_help();
 // prefer not to use names like this outside of main/testapp
 void load_a_bunch_of_stuff();
 
+/**
+ * @brief Read settings from a --config TOML file
+ *
+ * @return false if the file failed to parse
+ */
+bool load_config(std::string const& path, bool &rShareWorkerPool);
+
+/**
+ * @brief Parse a command line option that must be a number
+ *
+ * @return false if the whole value isn't a valid number of type T; an error is logged
+ */
+template <typename T>
+bool parse_number_arg(Corrade::Utility::Arguments const& args, std::string const& key, T &rOut);
+
 class DefaultMainLoop : public IMainLoopFunc
 {
 public:
     IMainLoopFunc::Status run(osp::fw::Framework &rFW, osp::fw::IExecutor &rExecutor) override;
 };
 
+/**
+ * @brief Runs a fixed number of main loop iterations as fast as possible, then prints frame rate
+ *        and per-feature task timings. Used by --headless, no window or renderer is required.
+ */
+class HeadlessMainLoop : public IMainLoopFunc
+{
+public:
+    HeadlessMainLoop(std::uint32_t frames, float deltaTime, osp::exec::TaskProfiler &rProfiler)
+     : m_frames{frames}, m_deltaTime{deltaTime}, m_rProfiler{rProfiler} { }
+
+    IMainLoopFunc::Status run(osp::fw::Framework &rFW, osp::fw::IExecutor &rExecutor) override;
+
+private:
+    using Clock_t = std::chrono::steady_clock;
+
+    /// Profiler ring buffers only hold so many events; sum up timings every this many frames
+    static constexpr std::uint32_t sc_accumulateEvery = 16;
+
+    void accumulate(osp::fw::Framework &rFW, std::uint32_t frameCount);
+    void print_report(Clock_t::duration elapsed) const;
+
+    std::vector<osp::exec::TaskProfiler::FeatureTotal> m_featureTotals;
+    Clock_t::time_point         m_start;
+    Clock_t::duration           m_notCounted    {};
+    std::uint32_t               m_frames;
+    std::uint32_t               m_framesDone    {0};
+    float                       m_deltaTime;
+    osp::exec::TaskProfiler     &m_rProfiler;
+};
+
 class FWMCLoadScenario : public IFrameworkModifyCommand
 {
 public:
@@ -100,6 +154,8 @@ osp::Logger_t   g_logMagnumApp;
 
 bool            g_autoLaunchMagnum = true;
 
+adera::JoltSettings g_joltSettings;
+
 
 //-----------------------------------------------------------------------------
 
@@ -109,8 +165,13 @@ int main(int argc, char** argv)
     Corrade::Utility::Arguments args;
     args.addSkippedPrefix   ("magnum", "Magnum options")
         .addOption          ("scene", "none")   .setHelp("scene",       "Set the scene to launch")
-        .addOption          ("config")          .setHelp("config",      "path to configuration file to use")
+        .addOption          ("config")          .setHelp("config",      "path to TOML configuration file to use. [jolt] accepts threads, temp_allocator_mb, and share_worker_pool")
         .addBooleanOption   ("norepl")          .setHelp("norepl",      "don't enter read, evaluate, print, loop.")
+        .addOption          ("trace")           .setHelp("trace",       "write a Chrome trace_event JSON of the last 300 frames' task timings to this path on exit")
+        .addOption          ("threads", "0")    .setHelp("threads",     "number of worker threads to run tasks on, or 'auto'. 0 runs all tasks on the main thread")
+        .addBooleanOption   ("headless")        .setHelp("headless",    "run --scene without a window as fast as possible, print frame rate and per-feature task timings, then exit")
+        .addOption          ("frames", "600")   .setHelp("frames",      "number of frames to run with --headless")
+        .addOption          ("dt", "0.0166667") .setHelp("dt",          "fixed scene time step in seconds to use with --headless")
         // TODO .addBooleanOption('v', "verbose")   .setHelp("verbose",     "log verbosely")
         .setGlobalHelp("Helptext goes here.")
         .parse(argc, argv);
@@ -130,17 +191,73 @@ int main(int argc, char** argv)
     // needed by Tasks & Framework
     register_stage_enums();
 
+    bool shareWorkerPool = false;
+    if ( ! args.value("config").empty() && ! load_config(args.value("config"), shareWorkerPool) )
+    {
+        return 1;
+    }
+
+    std::string const threadsArg = args.value("threads");
+    std::size_t threadCount = 0;
+    if (threadsArg == "auto")
+    {
+        threadCount = osp::exec::WorkerPool::default_thread_count();
+    }
+    else if ( ! parse_number_arg(args, "threads", threadCount) )
+    {
+        return 1;
+    }
+
+    std::uint32_t frames = 0;
+    float deltaTime = 0.0f;
+    if ( ! parse_number_arg(args, "frames", frames) || ! parse_number_arg(args, "dt", deltaTime) )
+    {
+        return 1;
+    }
+    if (frames == 0)
+    {
+        OSP_LOG_ERROR("--frames must be at least 1");
+        return 1;
+    }
+
+
+    // Select SinglethreadFWExecutor or MultithreadFWExecutor
+    std::unique_ptr<osp::exec::SinglethreadFWExecutor> pExecutor;
+    if (threadCount == 0)
+    {
+        pExecutor = std::make_unique<osp::exec::SinglethreadFWExecutor>();
+        if (shareWorkerPool)
+        {
+            OSP_LOG_WARN("share_worker_pool has no effect without --threads");
+        }
+    }
+    else
+    {
+        OSP_LOG_INFO("Using MultithreadFWExecutor with {} worker threads", threadCount);
+        auto pMultithread = std::make_unique<osp::exec::MultithreadFWExecutor>(threadCount);
+        if (shareWorkerPool)
+        {
+            g_joltSettings.pSharedPool = &pMultithread->pool();
+        }
+        pExecutor = std::move(pMultithread);
+    }
+    pExecutor->m_log = g_logExecutor;
+    g_pExecutor = pExecutor.get();
 
-    // Select SinglethreadFWExecutor
-    auto pSingleThreadExecutor = std::make_unique<osp::exec::SinglethreadFWExecutor>();
-    pSingleThreadExecutor->m_log = g_logExecutor;
-    g_pExecutor = pSingleThreadExecutor.get();
+    bool const headless = args.isSet("headless");
+
+    std::unique_ptr<osp::exec::TaskProfiler> pProfiler;
+    if ( ! args.value("trace").empty() || headless )
+    {
+        pProfiler = std::make_unique<osp::exec::TaskProfiler>();
+        pExecutor->m_pProfiler = pProfiler.get();
+    }
 
 
     g_mainContext = g_framework.m_contextIds.create();
     ContextBuilder mainCB { g_mainContext, {}, g_framework };
     mainCB.add_feature(ftrMainApp);
-    if( ! args.isSet("norepl"))
+    if( ! args.isSet("norepl") && ! headless )
     {
         mainCB.add_feature(ftrREPL);
         mainCB.add_feature(ftrMainCommands);
@@ -154,6 +271,23 @@ int main(int argc, char** argv)
 
     load_a_bunch_of_stuff();
 
+    if (headless)
+    {
+        // Load directly instead of through FrameworkModify, as there is no need to start and stop
+        // the main loop beforehand
+        auto const it = scenarios().find(args.value("scene"));
+        if (it == std::end(scenarios()))
+        {
+            OSP_LOG_ERROR("--headless requires a valid --scene");
+            return 1;
+        }
+        FWMCLoadScenario{it->second}.run(g_framework);
+
+        auto const &rAppCtxs = g_framework.data_get<AppContexts&>(mainApp.di.appContexts);
+        auto const scn       = g_framework.get_interface<FIScene>(rAppCtxs.scene);
+        g_framework.data_get<float&>(scn.di.deltaTimeIn) = deltaTime;
+    }
+
     g_pExecutor->load(g_framework);
     g_pExecutor->wait(g_framework);
 
@@ -165,7 +299,7 @@ int main(int argc, char** argv)
         rMainLoopCtrl.mainScheduleWaiting = false;
     }
 
-    if(args.value("scene") != "none")
+    if( ! headless && args.value("scene") != "none")
     {
         auto const mainApp    = g_framework.get_interface<FIMainApp>(g_mainContext);
         auto       &rFWModify = g_framework.data_get<FrameworkModify>(mainApp.di.frameworkModify);
@@ -182,9 +316,15 @@ int main(int argc, char** argv)
 
     std::vector<std::unique_ptr<IMainLoopFunc>> mainLoopStack;
 
-    mainLoopStack.push_back(std::make_unique<DefaultMainLoop>());
-
-    print_help();
+    if (headless)
+    {
+        mainLoopStack.push_back(std::make_unique<HeadlessMainLoop>(frames, deltaTime, *pProfiler));
+    }
+    else
+    {
+        mainLoopStack.push_back(std::make_unique<DefaultMainLoop>());
+        print_help();
+    }
 
     // Main (thread) loop
     while (!mainLoopStack.empty())
@@ -202,6 +342,13 @@ int main(int argc, char** argv)
         }
     }
 
+    if ( ! args.value("trace").empty() )
+    {
+        std::ofstream file{args.value("trace")};
+        pProfiler->write_chrome_trace(file, g_framework, 300);
+        OSP_LOG_INFO("Wrote task trace to {}", args.value("trace"));
+    }
+
     spdlog::shutdown();
     return 0;
 }
@@ -280,6 +427,121 @@ IMainLoopFunc::Status DefaultMainLoop::run(osp::fw::Framework &rFW, osp::fw::IEx
 }
 
 
+IMainLoopFunc::Status HeadlessMainLoop::run(osp::fw::Framework &rFW, osp::fw::IExecutor &rExecutor)
+{
+    auto const mainApp       = rFW.get_interface<FIMainApp>(g_mainContext);
+    auto       &rMainLoopCtrl = rFW.data_get<MainLoopControl&>(mainApp.di.mainLoopCtrl);
+
+    if (m_framesDone == 0)
+    {
+        m_start = Clock_t::now();
+    }
+
+    // Same as DefaultMainLoop, but without the sleep
+    rExecutor.wait(rFW);
+    if (rMainLoopCtrl.keepOpenWaiting)
+    {
+        rMainLoopCtrl.keepOpenWaiting = false;
+        rExecutor.task_finish(rFW, mainApp.tasks.keepOpen, true, {.cancel = false});
+    }
+    ++m_framesDone;
+
+    if (m_framesDone % sc_accumulateEvery == 0)
+    {
+        accumulate(rFW, sc_accumulateEvery);
+    }
+
+    if (m_framesDone < m_frames)
+    {
+        return {};
+    }
+
+    Clock_t::duration const elapsed = Clock_t::now() - m_start - m_notCounted;
+
+    accumulate(rFW, m_framesDone % sc_accumulateEvery);
+
+    // Let the main loop exit cleanly, same as DefaultMainLoop does before modifying the framework
+    while ( ! rMainLoopCtrl.mainScheduleWaiting )
+    {
+        rExecutor.wait(rFW);
+        if (rMainLoopCtrl.keepOpenWaiting)
+        {
+            rMainLoopCtrl.keepOpenWaiting = false;
+            rExecutor.task_finish(rFW, mainApp.tasks.keepOpen, true, {.cancel = true});
+            rExecutor.wait(rFW);
+        }
+    }
+
+    print_report(elapsed);
+
+    return {.exit = true};
+}
+
+void HeadlessMainLoop::accumulate(osp::fw::Framework &rFW, std::uint32_t const frameCount)
+{
+    if (frameCount == 0)
+    {
+        return;
+    }
+
+    Clock_t::time_point const start = Clock_t::now();
+
+    for (osp::exec::TaskProfiler::FeatureTotal const& feature : m_rProfiler.feature_totals(rFW, frameCount))
+    {
+        auto const found = std::find_if(m_featureTotals.begin(), m_featureTotals.end(),
+                                        [&feature] (auto const& rTotal) { return rTotal.name == feature.name; });
+        if (found == m_featureTotals.end())
+        {
+            m_featureTotals.push_back(feature);
+        }
+        else
+        {
+            found->total    += feature.total;
+            found->taskRuns += feature.taskRuns;
+        }
+    }
+
+    m_notCounted += Clock_t::now() - start;
+}
+
+void HeadlessMainLoop::print_report(Clock_t::duration const elapsed) const
+{
+    using osp::exec::TaskProfiler;
+
+    double const seconds   = std::chrono::duration<double>(elapsed).count();
+    double const fps       = double(m_framesDone) / seconds;
+    double const simTime   = double(m_framesDone) * double(m_deltaTime);
+
+    auto sorted = m_featureTotals;
+    std::sort(sorted.begin(), sorted.end(), [] (auto const& lhs, auto const& rhs)
+    {
+        return lhs.total > rhs.total;
+    });
+
+    std::size_t longestName = 7;
+    for (TaskProfiler::FeatureTotal const& feature : sorted)
+    {
+        longestName = std::max(feature.name.size(), longestName);
+    }
+
+    std::cout << "--- HEADLESS RESULTS ---\n"
+              << "Frames:         " << m_framesDone << " (dt = " << m_deltaTime << "s)\n"
+              << "Wall time:      " << seconds << "s\n"
+              << "Frames/second:  " << fps << "\n"
+              << "Realtime ratio: " << (simTime / seconds) << "x\n"
+              << "Task time per frame, by feature:\n";
+
+    for (TaskProfiler::FeatureTotal const& feature : sorted)
+    {
+        double const msPerFrame = double(feature.total) / 1e6 / double(m_framesDone);
+        std::string const spaces(longestName - feature.name.size(), ' ');
+        std::cout << "* " << feature.name << spaces << "  " << msPerFrame << " ms  ("
+                  << (double(feature.taskRuns) / double(m_framesDone)) << " task runs)\n";
+    }
+    std::cout << "------------------------\n";
+}
+
+
 void FWMCLoadScenario::run(osp::fw::Framework &rFW)
 {
     auto const mainApp   = rFW.get_interface<FIMainApp>(g_mainContext);
@@ -296,7 +558,8 @@ void FWMCLoadScenario::run(osp::fw::Framework &rFW)
     m_option.loadFunc(ScenarioArgs{
         .rFW            = g_framework,
         .mainContext    = g_mainContext,
-        .defaultPkg     = g_defaultPkg
+        .defaultPkg     = g_defaultPkg,
+        .jolt           = g_joltSettings
     });
 
     std::cout << "Loaded scenario: " << m_option.name << "\n"
@@ -306,11 +569,60 @@ void FWMCLoadScenario::run(osp::fw::Framework &rFW)
 }
 
 
+bool load_config(std::string const& path, bool &rShareWorkerPool)
+{
+    toml::value config;
+    try
+    {
+        config = toml::parse(path);
+    }
+    catch (std::exception const& e)
+    {
+        OSP_LOG_ERROR("Failed to load config '{}': {}", path, e.what());
+        return false;
+    }
+
+    if (config.is_table() && config.as_table().count("jolt") != 0)
+    {
+        toml::value const &jolt = toml::find(config, "jolt");
+
+        constexpr std::size_t mb = 1024 * 1024;
+
+        g_joltSettings.threadCount          = toml::find_or<int>        (jolt, "threads",           g_joltSettings.threadCount);
+        g_joltSettings.tempAllocatorSize    = toml::find_or<std::size_t>(jolt, "temp_allocator_mb", g_joltSettings.tempAllocatorSize / mb) * mb;
+        rShareWorkerPool                    = toml::find_or<bool>       (jolt, "share_worker_pool", false);
+
+        if (g_joltSettings.threadCount < 0)
+        {
+            OSP_LOG_ERROR("Config '{}': [jolt] threads must not be negative, got {}", path, g_joltSettings.threadCount);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename T>
+bool parse_number_arg(Corrade::Utility::Arguments const& args, std::string const& key, T &rOut)
+{
+    std::string const value = args.value(key);
+    char const *const pLast = value.data() + value.size();
+
+    auto const [pEnd, error] = std::from_chars(value.data(), pLast, rOut);
+    if (error != std::errc{} || pEnd != pLast)
+    {
+        OSP_LOG_ERROR("--{} expects a number, got '{}'", key, value);
+        return false;
+    }
+    return true;
+}
+
 
 osp::fw::FeatureDef const ftrMainCommands = feature_def("MainCommands", [] (FeatureBuilder& rFB, DependOn<FIMainApp> mainApp, DependOn<FICinREPL> cinREPL)
 {
     rFB.task()
         .name       ("Poll and evaluate commands")
+        .main_thread(true)
         .sync_with  ({cinREPL.pl.cinLines(UseOrRun)})
         .args       ({                         cinREPL.di.cinLines,        mainApp.di.frameworkModify,         mainApp.di.appContexts})
         .func       ([] (std::vector<std::string> const &rCinLines, FrameworkModify &rFrameworkModify, AppContexts const& appContexts) noexcept
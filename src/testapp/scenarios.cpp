@@ -70,6 +70,42 @@ FeatureDef const ftrEngineTest = feature_def("EngineTest", [] (FeatureBuilder& r
     rFB.data(engineTest.di.bigStruct) = enginetest::make_scene(rResources, entt::any_cast<PkgId>(data));
 });
 
+/**
+ * @brief Initialize an Earth-sized terrain in a scene with ftrTerrain, and place the scene just on
+ *        its surface
+ *
+ * Shared by the terrain and terrain_flyover scenarios, so the benchmark measures the same planet
+ * and LOD budget as the interactive scene.
+ */
+static void initialize_earth_terrain(Framework &rFW, ContextId const sceneCtx)
+{
+    auto terrain        = rFW.get_interface<FITerrain>(sceneCtx);
+    auto &rTerrain      = rFW.data_get<ACtxTerrain>(terrain.di.terrain);
+    auto &rTerrainFrame = rFW.data_get<ACtxTerrainFrame>(terrain.di.terrainFrame);
+
+    constexpr std::uint64_t c_earthRadius = 6371000;
+
+    initialize_ico_terrain(rFW, sceneCtx, {
+        .radius                 = double(c_earthRadius),
+        .height                 = 20000.0,   // Height between Mariana Trench and Mount Everest
+        .skelPrecision          = 10,        // 2^10 units = 1024 units = 1 meter
+        .skelMaxSubdivLevels    = 19,
+        .chunkSubdivLevels      = 4,
+        .chunkCacheMaxBytes     = 32u << 20, // 32MiB, around 10k chunks
+        .generator              = std::make_unique<NoiseTerrainGenerator>(NoiseTerrainParams{
+            .height     = 20000.0,
+            .wavelength = 500000.0,
+            .octaves    = 12 })
+    });
+
+    // Moving the camera quickly can trigger thousands of subdivisions at once. Spread them
+    // over a few frames instead of hitching.
+    rTerrain.scratchpad.budget = { .maxSubdiv = 512, .maxUnsubdiv = 1024, .maxMicroseconds = 8000 };
+
+    // Set scene position relative to planet to be just on the surface
+    rTerrainFrame.position = Vector3l{0,0,c_earthRadius} * 1024;
+}
+
 static ScenarioMap_t make_scenarios()
 {   
     ScenarioMap_t scenarioMap;
@@ -129,7 +165,7 @@ static ScenarioMap_t make_scenarios()
         sceneCB.add_feature(ftrDroppers);
         sceneCB.add_feature(ftrBounds);
 
-        sceneCB.add_feature(ftrJolt);
+        sceneCB.add_feature(ftrJolt, args.jolt);
         sceneCB.add_feature(ftrJoltConstAccel);
         sceneCB.add_feature(ftrPhysicsShapesJolt);
         ContextBuilder::finalize(std::move(sceneCB));
@@ -185,7 +221,7 @@ static ScenarioMap_t make_scenarios()
         sceneCB.add_feature(ftrMachMagicRockets);
         sceneCB.add_feature(ftrMachRCSDriver);
 
-        sceneCB.add_feature(ftrJolt);
+        sceneCB.add_feature(ftrJolt, args.jolt);
         sceneCB.add_feature(ftrJoltConstAccel);
         sceneCB.add_feature(ftrPhysicsShapesJolt);
         sceneCB.add_feature(ftrVehicleSpawnJolt);
@@ -245,22 +281,37 @@ static ScenarioMap_t make_scenarios()
         sceneCB.add_feature(ftrTerrainSubdivDist);
         ContextBuilder::finalize(std::move(sceneCB));
 
-        auto terrain        = args.rFW.get_interface<FITerrain>(sceneCtx);
-        auto &rTerrain      = args.rFW.data_get<ACtxTerrain>(terrain.di.terrain);
-        auto &rTerrainFrame = args.rFW.data_get<ACtxTerrainFrame>(terrain.di.terrainFrame);
+        initialize_earth_terrain(args.rFW, sceneCtx);
+    }});
 
-        constexpr std::uint64_t c_earthRadius = 6371000;
 
-        initialize_ico_terrain(args.rFW, sceneCtx, {
-            .radius                 = double(c_earthRadius),
-            .height                 = 20000.0,   // Height between Mariana Trench and Mount Everest
-            .skelPrecision          = 10,        // 2^10 units = 1024 units = 1 meter
-            .skelMaxSubdivLevels    = 19,
-            .chunkSubdivLevels      = 4
-        });
 
-        // Set scene position relative to planet to be just on the surface
-        rTerrainFrame.position = Vector3l{0,0,c_earthRadius} * 1024;
+    add_scenario({
+        .name        = "terrain_flyover",
+        .brief       = "Planet terrain LOD benchmark, flies around an Earth-sized planet",
+        .description = "Moves the terrain viewer low over the surface at 2km/s, adding and removing "
+                       "lots of chunks every frame. Intended to be run with --headless to measure "
+                       "terrain subdivision and chunk mesh generation, eg:\n"
+                       "  --headless --scene=terrain_flyover --frames=600 --threads=auto\n",
+        .loadFunc = [] (ScenarioArgs args)
+    {
+        auto const mainApp = args.rFW.get_interface<FIMainApp>  (args.mainContext);
+
+        ContextId const sceneCtx = args.rFW.m_contextIds.create();
+        args.rFW.data_get<adera::AppContexts&>(mainApp.di.appContexts).scene = sceneCtx;
+
+        ContextBuilder  sceneCB { sceneCtx, {args.mainContext}, args.rFW };
+        sceneCB.add_feature(ftrScene);
+        sceneCB.add_feature(ftrCleanupCtx);
+        sceneCB.add_feature(ftrCommonScene, args.defaultPkg);
+
+        sceneCB.add_feature(ftrTerrain);
+        sceneCB.add_feature(ftrTerrainIcosahedron);
+        sceneCB.add_feature(ftrTerrainSubdivDist);
+        sceneCB.add_feature(ftrTerrainFlyover, TerrainFlyover{.speed = 2000.0, .altitude = 100.0});
+        ContextBuilder::finalize(std::move(sceneCB));
+
+        initialize_earth_terrain(args.rFW, sceneCtx);
     }});
 
 
@@ -27,6 +27,8 @@
 #include <osp/drawing/drawing.h>
 #include <osp/framework/framework.h>
 
+#include <adera_app/features/jolt.h>
+
 #include <unordered_map>
 
 namespace testapp
@@ -37,6 +39,9 @@ struct ScenarioArgs
     osp::fw::Framework  &rFW;
     osp::fw::ContextId  mainContext;
     osp::PkgId          defaultPkg;
+
+    /// Jolt settings from --config, scenarios may adjust these before adding ftrJolt
+    adera::JoltSettings jolt;
 };
 
 struct ScenarioOption
@@ -78,6 +78,7 @@ FeatureDef const ftrEngineTestRenderer = feature_def("EngineTestRenderer", [] (
 
     rFB.task()
         .name       ("Update & Render Engine Test Scene")
+        .main_thread(true)
         .sync_with  ({scn.pl.update(Run)})
         .args       ({                   engineTest.di.bigStruct,                engineTestRndr.di.renderer,  magnum.di.renderGl,         magnum.di.magnumApp,      scn.di.deltaTimeIn  })
         .func       ([] (enginetest::EngineTestScene &rBigStruct, enginetest::EngineTestRenderer &rRenderer, RenderGL &rRenderGl, MagnumWindowApp &rMagnumApp, float const deltaTimeIn) noexcept
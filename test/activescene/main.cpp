@@ -0,0 +1,358 @@
+/**
+ * Open Space Program
+ * Copyright © 2019-2022 Open Space Program Project
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <osp/activescene/basic_fn.h>
+#include <osp/drawing/drawing_fn.h>
+#include <osp/executor/worker_pool.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace osp;
+using namespace osp::active;
+using namespace osp::draw;
+
+/**
+ * @brief Fill a SubtreeBuilder with new entities, using descendant counts from another scene
+ *        graph that already contains them
+ */
+static void fill_like(SubtreeBuilder &rBld, ACtxSceneGraph const& like, ActiveEnt &rNext)
+{
+    while (rBld.remaining() != 0)
+    {
+        ActiveEnt const ent = rNext;
+        rNext = ActiveEnt{rNext.value + 1};
+
+        SubtreeBuilder bldChild = rBld.add_child(ent, like.m_treeDescendants[like.m_entToTreePos[ent]]);
+        fill_like(bldChild, like, rNext);
+    }
+}
+
+/**
+ * @brief Fill a SubtreeBuilder with new entities, randomly nesting some of them
+ */
+static void fill_random(SubtreeBuilder &rBld, std::mt19937 &rRand, ActiveEnt &rNext)
+{
+    while (rBld.remaining() != 0)
+    {
+        ActiveEnt const ent = rNext;
+        rNext = ActiveEnt{rNext.value + 1};
+
+        uint32_t const descendants = (rRand() % 3 == 0) ? uint32_t(rRand() % rBld.remaining()) : 0;
+
+        SubtreeBuilder bldChild = rBld.add_child(ent, descendants);
+        fill_random(bldChild, rRand, rNext);
+    }
+}
+
+static void expect_same_tree(ACtxSceneGraph const& lhs, ACtxSceneGraph const& rhs)
+{
+    ASSERT_EQ(lhs.m_treeToEnt.size(), rhs.m_treeToEnt.size());
+    for (TreePos_t pos = 0; pos < lhs.m_treeToEnt.size(); ++pos)
+    {
+        ASSERT_EQ(lhs.m_treeToEnt[pos],         rhs.m_treeToEnt[pos]);
+        ASSERT_EQ(lhs.m_treeDescendants[pos],   rhs.m_treeDescendants[pos]);
+    }
+    for (std::size_t i = 0; i < lhs.m_entParent.size(); ++i)
+    {
+        ASSERT_EQ(lhs.m_entParent[ActiveEnt(i)],    rhs.m_entParent[ActiveEnt(i)]);
+        ASSERT_EQ(lhs.m_entToTreePos[ActiveEnt(i)], rhs.m_entToTreePos[ActiveEnt(i)]);
+    }
+}
+
+// Test that adding subtrees in a batch gives the same tree as adding them one at a time
+TEST(SceneGraph, BatchedInsert)
+{
+    constexpr std::size_t   maxEnts = 4000;
+    constexpr int           rounds  = 8;
+
+    std::mt19937 randGen(69);
+
+    for (int test = 0; test < 200; ++test)
+    {
+        ACtxSceneGraph sequential;
+        ACtxSceneGraph batched;
+        sequential  .resize(maxEnts);
+        batched     .resize(maxEnts);
+
+        std::vector<ActiveEnt> ents;
+        ActiveEnt next{0};
+
+        for (int round = 0; round < rounds; ++round)
+        {
+            // Requests may share roots, and roots may be ancestors of each other
+            std::vector<SubtreeRequest> requests(1 + randGen() % 8);
+            for (SubtreeRequest &rRequest : requests)
+            {
+                bool const atSceneRoot  = ents.empty() || (randGen() % 4 == 0);
+                rRequest.root           = atSceneRoot ? lgrn::id_null<ActiveEnt>() : ents[randGen() % ents.size()];
+                rRequest.descendantCount = uint32_t(randGen() % 6);
+            }
+
+            ActiveEnt const roundFirst = next;
+
+            for (SubtreeRequest const& request : requests)
+            {
+                SubtreeBuilder bld = SysSceneGraph::add_descendants(sequential, request.descendantCount, request.root);
+                fill_random(bld, randGen, next);
+            }
+
+            ActiveEnt nextBatched = roundFirst;
+            for (SubtreeBuilder &rBld : SysSceneGraph::add_descendants(batched, requests))
+            {
+                fill_like(rBld, sequential, nextBatched);
+            }
+            ASSERT_EQ(nextBatched, next);
+
+            for (uint32_t i = roundFirst.value; i < next.value; ++i)
+            {
+                ents.push_back(ActiveEnt{i});
+            }
+
+            expect_same_tree(sequential, batched);
+        }
+    }
+}
+
+// Many parents: 10k entities spawned under 1k parents
+constexpr uint32_t gc_parentCount   = 1000;
+constexpr uint32_t gc_childrenEach  = 10;
+constexpr uint32_t gc_totalEnts     = gc_parentCount * (1 + gc_childrenEach);
+
+/**
+ * @brief Add gc_parentCount parents to the scene root, ActiveEnts [0, gc_parentCount)
+ */
+static void add_many_parents(ACtxSceneGraph &rScnGraph)
+{
+    rScnGraph.resize(gc_totalEnts);
+    SubtreeBuilder bld = SysSceneGraph::add_descendants(rScnGraph, gc_parentCount);
+    for (uint32_t i = 0; i < gc_parentCount; ++i)
+    {
+        bld.add_child(ActiveEnt{i});
+    }
+}
+
+/**
+ * @brief Add children of a parent from add_many_parents, ActiveEnts
+ *        [gc_parentCount + parent * gc_childrenEach, ...)
+ */
+static void add_many_children(SubtreeBuilder &rBld, uint32_t const parent)
+{
+    for (uint32_t i = 0; i < gc_childrenEach; ++i)
+    {
+        rBld.add_child(ActiveEnt{gc_parentCount + parent * gc_childrenEach + i});
+    }
+}
+
+/**
+ * @brief Add children to all parents with one add_descendants call per parent
+ */
+static void add_many_children_sequential(ACtxSceneGraph &rScnGraph)
+{
+    for (uint32_t parent = 0; parent < gc_parentCount; ++parent)
+    {
+        SubtreeBuilder bld = SysSceneGraph::add_descendants(rScnGraph, gc_childrenEach, ActiveEnt{parent});
+        add_many_children(bld, parent);
+    }
+}
+
+/**
+ * @brief Add children to all parents with a single batched add_descendants call
+ */
+static void add_many_children_batched(ACtxSceneGraph &rScnGraph)
+{
+    std::vector<SubtreeRequest> requests(gc_parentCount);
+    for (uint32_t parent = 0; parent < gc_parentCount; ++parent)
+    {
+        requests[parent] = {ActiveEnt{parent}, gc_childrenEach};
+    }
+    std::vector<SubtreeBuilder> builders = SysSceneGraph::add_descendants(rScnGraph, requests);
+    for (uint32_t parent = 0; parent < gc_parentCount; ++parent)
+    {
+        add_many_children(builders[parent], parent);
+    }
+}
+
+// Spawn 10k entities under 1k parents, one add_descendants call per parent vs. one batch
+TEST(SceneGraph, BatchedInsertManyParents)
+{
+    ACtxSceneGraph sequential;
+    add_many_parents(sequential);
+    add_many_children_sequential(sequential);
+
+    ACtxSceneGraph batched;
+    add_many_parents(batched);
+    add_many_children_batched(batched);
+
+    ASSERT_EQ(batched.m_treeToEnt.size(), gc_totalEnts + 1);
+    expect_same_tree(sequential, batched);
+}
+
+// Time for BatchedInsertManyParents. Run with --gtest_also_run_disabled_tests
+TEST(SceneGraph, DISABLED_BatchedInsertBenchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    static constexpr int repeats = 20;
+
+    auto const time_inserts = [] (auto const& add_children) -> Clock::duration
+    {
+        Clock::duration total{};
+        for (int i = 0; i < repeats; ++i)
+        {
+            ACtxSceneGraph scnGraph;
+            add_many_parents(scnGraph);
+
+            Clock::time_point const start = Clock::now();
+            add_children(scnGraph);
+            total += Clock::now() - start;
+        }
+        return total / repeats;
+    };
+
+    Clock::duration const sequential = time_inserts(add_many_children_sequential);
+    Clock::duration const batched    = time_inserts(add_many_children_batched);
+
+    std::cout << "[ BENCHMARK ] " << gc_parentCount * gc_childrenEach << " entities under "
+              << gc_parentCount << " parents\n"
+              << "              one call per parent: " << duration_cast<microseconds>(sequential).count() << "us\n"
+              << "              batched:             " << duration_cast<microseconds>(batched).count() << "us\n";
+}
+
+/**
+ * @brief Reference for SysRender::update_draw_transforms_all, recursing through children the
+ *        same way it was done before the tree arrays were streamed through
+ */
+static void draw_transforms_recurse(
+        SysRender::ArgsForUpdDrawTransform  args,
+        ActiveEnt                           ent,
+        Matrix4 const&                      parentTf,
+        int                                 depth,
+        std::vector<int>                    &rDepths)
+{
+    Matrix4 const& entTf     = args.transforms.get(ent).m_transform;
+    Matrix4 const  entDrawTf = parentTf * entTf;
+
+    rDepths[ent.value] = depth;
+    args.rDrawTf[args.activeToDraw[ent]] = entDrawTf;
+
+    for (ActiveEnt entChild : SysSceneGraph::children(args.scnGraph, ent))
+    {
+        if (args.needDrawTf.contains(entChild))
+        {
+            draw_transforms_recurse(args, entChild, entDrawTf, depth + 1, rDepths);
+        }
+    }
+}
+
+// Test that streamed draw transforms and observer depths match a recursive walk, with and
+// without a worker pool
+TEST(DrawTransforms, MatchesRecursive)
+{
+    // Big enough for update_draw_transforms_all to split work across threads
+    constexpr uint32_t entCount = 6000;
+
+    std::mt19937 randGen(69);
+
+    ACtxSceneGraph scnGraph;
+    scnGraph.resize(entCount);
+
+    ActiveEnt next{0};
+    SubtreeBuilder bld = SysSceneGraph::add_descendants(scnGraph, entCount);
+    fill_random(bld, randGen, next);
+    ASSERT_EQ(next.value, entCount);
+
+    ACompTransformStorage_t transforms;
+    KeyedVec<ActiveEnt, DrawEnt> activeToDraw;
+    ActiveEntSet_t needDrawTf;
+    activeToDraw.resize(entCount);
+    needDrawTf.resize(entCount);
+
+    for (uint32_t i = 0; i < entCount; ++i)
+    {
+        // Small rotations and offsets, so deep chains don't blow up precision
+        Magnum::Rad const angle{float(randGen() % 100) * 0.001f};
+        Vector3 const offset{float(randGen() % 5), float(randGen() % 5), 1.0f};
+        transforms.emplace(ActiveEnt{i}, ACompTransform{Matrix4::translation(offset) * Matrix4::rotationZ(angle)});
+
+        activeToDraw[ActiveEnt{i}] = DrawEnt{i};
+
+        // Leaves some subtrees out, which update_draw_transforms_all must skip over
+        if (randGen() % 2 == 0)
+        {
+            SysRender::needs_draw_transforms(scnGraph, needDrawTf, ActiveEnt{i});
+        }
+    }
+
+    DrawTransforms_t expectTf;
+    expectTf.resize(entCount);
+    std::vector<int> expectDepths(entCount, 0);
+
+    SysRender::ArgsForUpdDrawTransform const expectArgs{scnGraph, transforms, activeToDraw, needDrawTf, expectTf};
+    for (ActiveEnt const root : SysSceneGraph::children(scnGraph))
+    {
+        if (needDrawTf.contains(root))
+        {
+            draw_transforms_recurse(expectArgs, root, Matrix4{}, 1, expectDepths);
+        }
+    }
+
+    auto const check = [&] (osp::exec::WorkerPool *pPool)
+    {
+        DrawTransforms_t drawTf;
+        drawTf.resize(entCount);
+
+        // Each entity is only written to by its own call, so this is safe with a pool
+        std::vector<int> depths(entCount, 0);
+
+        SysRender::update_draw_transforms_all(
+                {scnGraph, transforms, activeToDraw, needDrawTf, drawTf},
+                pPool,
+                [&depths] (Matrix4 const&, ActiveEnt ent, int depth)
+        {
+            depths[ent.value] = depth;
+        });
+
+        for (uint32_t i = 0; i < entCount; ++i)
+        {
+            ASSERT_EQ(depths[i], expectDepths[i]);
+            if (needDrawTf.contains(ActiveEnt{i}))
+            {
+                ASSERT_EQ(drawTf[DrawEnt{i}], expectTf[DrawEnt{i}]);
+            }
+        }
+    };
+
+    check(nullptr);
+
+    osp::exec::WorkerPool pool{3};
+    check(&pool);
+}
@@ -51,6 +51,7 @@
  *
  * This does it quite well so better be the correct API, or is at least close to the ideal solution.
  */
+#include <osp/executor/multithread_framework.h>
 #include <osp/executor/singlethread_framework.h>
 #include <osp/framework/builder.h>
 #include <osp/util/logging.h>
@@ -59,6 +60,13 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
 using namespace osp;
 using namespace osp::fw;
 
@@ -610,6 +618,574 @@ TEST(Framework, NestedLoop)
 
 //-----------------------------------------------------------------------------
 
+// Test 4: Same as above, but with tasks running on worker threads. Results must be identical.
+
+TEST(Framework, Multithread)
+{
+    register_pltype_info();
+
+    auto pSink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+
+    osp::Logger_t logger = std::make_shared<spdlog::logger>("executor", pSink);
+    osp::set_thread_logger(logger);
+
+    Framework fw;
+
+    ContextId const ctxAquarium   = fw.m_contextIds.create();
+    ContextId const ctxNestedLoop = fw.m_contextIds.create();
+
+    ContextBuilder cbAquarium{ctxAquarium, {}, fw};
+    cbAquarium.add_feature(ftrWorld);
+    cbAquarium.add_feature(ftrFish);
+    cbAquarium.add_feature(ftrSharks, std::string{"user data!"});
+    ContextBuilder::finalize(std::move(cbAquarium));
+
+    ContextBuilder cbNestedLoop{ctxNestedLoop, {}, fw};
+    cbNestedLoop.add_feature(ftrNestedLoop);
+    ContextBuilder::finalize(std::move(cbNestedLoop));
+
+    auto const mainLoop         = fw.get_interface<FIMainLoop>(ctxAquarium);
+    auto const aquarium         = fw.get_interface<FIAquarium>(ctxAquarium);
+    auto const fish             = fw.get_interface<FIFish>(ctxAquarium);
+    auto const nestedLoop       = fw.get_interface<FINestedLoop>(ctxNestedLoop);
+
+    auto       &rAquariumFish   = fw.data_get<AquariumFish>(fish.di.fishDI);
+    auto       &rData           = fw.data_get<NestedLoopData>(nestedLoop.di.data);
+
+    osp::exec::MultithreadFWExecutor exec{4};
+    exec.m_log = logger;
+    exec.load(fw);
+
+    exec.wait(fw);
+    ASSERT_FALSE(exec.is_running(fw, mainLoop.loopblks.mainLoop));
+    ASSERT_FALSE(exec.is_running(fw, nestedLoop.loopblks.outer));
+    EXPECT_EQ(rAquariumFish.fishCount, 10);
+
+    exec.task_finish(fw, mainLoop.tasks.schedule, true, {.cancel = false});
+    exec.wait(fw);
+    ASSERT_TRUE(exec.is_running(fw, mainLoop.loopblks.mainLoop));
+
+    for (int i = 0; i < 3; ++i)
+    {
+        exec.task_finish(fw, aquarium.tasks.schedule, true, {.cancel = false});
+        exec.wait(fw);
+        ASSERT_TRUE(exec.is_running(fw, mainLoop.loopblks.mainLoop));
+        ASSERT_EQ(rAquariumFish.fishCount, 8 - 2*i);
+    }
+
+    exec.task_finish(fw, aquarium.tasks.schedule, true, {.cancel = true});
+    exec.wait(fw);
+    ASSERT_EQ(rAquariumFish.fishCount, 4);
+    ASSERT_FALSE(exec.is_running(fw, mainLoop.loopblks.mainLoop));
+
+    rData.setpoint = 10;
+    exec.task_finish(fw, nestedLoop.tasks.outerSchedule);
+    exec.wait(fw);
+    ASSERT_EQ(rData.value, 10);
+
+    rData.setpoint = -5;
+    exec.task_finish(fw, nestedLoop.tasks.outerSchedule);
+    exec.wait(fw);
+    ASSERT_EQ(rData.value, -5);
+    ASSERT_FALSE(exec.is_running(fw, nestedLoop.loopblks.outer));
+    ASSERT_FALSE(exec.is_running(fw, nestedLoop.loopblks.inner));
+}
+
+TEST(Framework, Profiler)
+{
+    register_pltype_info();
+
+    Framework fw;
+    ContextId const ctx = fw.m_contextIds.create();
+
+    ContextBuilder cb{ctx, {}, fw};
+    cb.add_feature(ftrWorld);
+    cb.add_feature(ftrFish);
+    cb.add_feature(ftrSharks, std::string{"user data!"});
+    ContextBuilder::finalize(std::move(cb));
+
+    auto const mainLoop = fw.get_interface<FIMainLoop>(ctx);
+    auto const aquarium = fw.get_interface<FIAquarium>(ctx);
+
+    osp::exec::TaskProfiler profiler;
+    osp::exec::MultithreadFWExecutor exec{2};
+    exec.m_pProfiler = &profiler;
+    exec.load(fw);
+    exec.wait(fw);
+
+    exec.task_finish(fw, mainLoop.tasks.schedule, true, {.cancel = false});
+    exec.wait(fw);
+    for (int i = 0; i < 3; ++i)
+    {
+        exec.task_finish(fw, aquarium.tasks.schedule, true, {.cancel = false});
+        exec.wait(fw);
+    }
+
+    // Sharks ate fish on each of the last 3 frames
+    std::vector<osp::exec::TaskProfiler::TaskTotal> const totals = profiler.totals(3);
+    auto const found = std::find_if(totals.begin(), totals.end(), [&fw] (osp::exec::TaskProfiler::TaskTotal const& total)
+    {
+        return fw.m_tasks.taskInst[total.taskId].debugName == "Each shark eats a fish";
+    });
+    ASSERT_NE(found, totals.end());
+    EXPECT_EQ(found->count, 3);
+
+    // Same task, counted under the feature that added it
+    std::vector<osp::exec::TaskProfiler::FeatureTotal> const features = profiler.feature_totals(fw, 3);
+    auto const foundSharks = std::find_if(features.begin(), features.end(), [] (osp::exec::TaskProfiler::FeatureTotal const& total)
+    {
+        return total.name == "Sharks";
+    });
+    ASSERT_NE(foundSharks, features.end());
+    EXPECT_GE(foundSharks->taskRuns, 3);
+    EXPECT_GE(foundSharks->total, found->total);
+
+    std::ostringstream os;
+    profiler.write_chrome_trace(os, fw, 3);
+    std::string const trace = os.str();
+    EXPECT_EQ(trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0);
+    EXPECT_NE(trace.find("\"name\":\"Each shark eats a fish\""), std::string::npos);
+    EXPECT_NE(trace.find("aquariumUpdatePL(Run)"), std::string::npos);
+}
+
+// A thread recording into two profilers in turn must keep using the same buffer in each
+TEST(Framework, ProfilerSharedThread)
+{
+    using osp::exec::TaskProfiler;
+
+    // Small enough that older events get overwritten
+    constexpr std::size_t eventsPerThread = 4;
+
+    TaskProfiler profilerA{eventsPerThread};
+    TaskProfiler profilerB{eventsPerThread};
+
+    for (int i = 0; i < 10; ++i)
+    {
+        profilerA.record({.taskId = TaskId{0}, .frame = profilerA.frame()});
+        profilerB.record({.taskId = TaskId{1}, .frame = profilerB.frame()});
+    }
+
+    // Events only ever went to one ring buffer per profiler, so only the last few are kept
+    for (auto const& [pProfiler, taskId] : {std::pair{&profilerA, TaskId{0}}, std::pair{&profilerB, TaskId{1}}})
+    {
+        std::vector<TaskProfiler::TaskTotal> const totals = pProfiler->totals(1);
+        ASSERT_EQ(totals.size(), 1);
+        EXPECT_EQ(totals[0].taskId, taskId);
+        EXPECT_EQ(totals[0].count,  eventsPerThread);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+// Test 5: Task dispatch. 10k trivial tasks run each frame, either through the argument table the
+//         executor resolves in load() (TaskRef::func), or by building entt::any references for
+//         every call (TaskRef::func_raw). Both must see the same data.
+
+struct DispatchCounter
+{
+    std::uint64_t count{0};
+
+    // Larger than entt::any's small buffer, so replacing this moves it to a new address
+    std::array<std::uint64_t, 7> padding{};
+};
+
+struct FIDispatchBench {
+    struct DataIds {
+        DataId counterDI;
+    };
+    struct Pipelines { };
+};
+
+constexpr int gc_dispatchTaskCount = 10000;
+
+constexpr auto gc_incrementCounter = [] (DispatchCounter &rCounter) noexcept
+{
+    ++rCounter.count;
+};
+using IncrementCounter_t = std::remove_const_t<decltype(gc_incrementCounter)>;
+
+FeatureDef const ftrDispatchBench = feature_def("DispatchBench", [] (
+        FeatureBuilder              &rFB,
+        Implement<FIDispatchBench>  bench,
+        DependOn<FIAquarium>        aquarium,
+        entt::any                   userData)
+{
+    bool const useArgTable = entt::any_cast<bool>(userData);
+
+    rFB.data_emplace<DispatchCounter>(bench.di.counterDI);
+
+    for (int i = 0; i < gc_dispatchTaskCount; ++i)
+    {
+        TaskRef task = rFB.task()
+            .name       ("Increment counter")
+            .sync_with  ({aquarium.pl.aquariumUpdatePL(EStgOptionalPath::Run)})
+            .args       ({bench.di.counterDI});
+
+        if (useArgTable)
+        {
+            task.func(IncrementCounter_t{});
+        }
+        else
+        {
+            task.func_raw(as_task_impl_v<IncrementCounter_t>);
+        }
+    }
+});
+
+/**
+ * @brief Run the aquarium with 10k dispatch tasks for a number of frames
+ *
+ * @return Time taken to run the frames, not including load or setup
+ */
+static std::chrono::steady_clock::duration run_dispatch_frames(bool const useArgTable, int const frames)
+{
+    using Clock = std::chrono::steady_clock;
+
+    Framework fw;
+    ContextId const ctx = fw.m_contextIds.create();
+
+    ContextBuilder cb{ctx, {}, fw};
+    cb.add_feature(ftrWorld);
+    cb.add_feature(ftrDispatchBench, useArgTable);
+    ContextBuilder::finalize(std::move(cb));
+
+    auto const mainLoop = fw.get_interface<FIMainLoop>(ctx);
+    auto const aquarium = fw.get_interface<FIAquarium>(ctx);
+    auto const bench    = fw.get_interface<FIDispatchBench>(ctx);
+
+    osp::exec::SinglethreadFWExecutor exec;
+    exec.load(fw);
+
+    exec.task_finish(fw, mainLoop.tasks.schedule, true, {.cancel = false});
+    exec.wait(fw);
+
+    auto const start = Clock::now();
+    for (int i = 0; i < frames; ++i)
+    {
+        exec.task_finish(fw, aquarium.tasks.schedule, true, {.cancel = false});
+        exec.wait(fw);
+    }
+    auto const time = Clock::now() - start;
+
+    EXPECT_EQ(fw.data_get<DispatchCounter>(bench.di.counterDI).count, std::uint64_t(frames) * gc_dispatchTaskCount);
+
+    // Replacing data invalidates the argument table; tasks must see the new counter
+    fw.data_emplace<DispatchCounter>(bench.di.counterDI);
+    exec.task_finish(fw, aquarium.tasks.schedule, true, {.cancel = false});
+    exec.wait(fw);
+    EXPECT_EQ(fw.data_get<DispatchCounter>(bench.di.counterDI).count, std::uint64_t(gc_dispatchTaskCount));
+
+    exec.task_finish(fw, aquarium.tasks.schedule, true, {.cancel = true});
+    exec.wait(fw);
+    exec.task_finish(fw, mainLoop.tasks.schedule, true, {.cancel = true});
+    exec.wait(fw);
+
+    return time;
+}
+
+TEST(Framework, Dispatch)
+{
+    register_pltype_info();
+
+    run_dispatch_frames(true,  3);
+    run_dispatch_frames(false, 3);
+}
+
+// Compare per-task dispatch overhead of the argument table and entt::any references.
+// Run with --gtest_also_run_disabled_tests
+TEST(Framework, DISABLED_DispatchBenchmark)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::nanoseconds;
+
+    register_pltype_info();
+
+    constexpr int frames = 100;
+
+    auto const tableTime = run_dispatch_frames(true,  frames);
+    auto const anyTime   = run_dispatch_frames(false, frames);
+
+    double const tasksRun = double(frames) * gc_dispatchTaskCount;
+    std::cout << "[ BENCHMARK ] " << gc_dispatchTaskCount << " tasks per frame\n"
+              << "              Argument table:   " << double(duration_cast<nanoseconds>(tableTime).count()) / tasksRun << "ns per task\n"
+              << "              entt::any refs:   " << double(duration_cast<nanoseconds>(anyTime)  .count()) / tasksRun << "ns per task\n";
+}
+
+//-----------------------------------------------------------------------------
+
+// Test 6: Adding and closing a context only adds or removes its own tasks from the executor. The
+//         executor is reloaded the same way as before, but doesn't rebuild everything else.
+
+/**
+ * @brief Add a context with an aquarium and 10k dispatch tasks
+ */
+static ContextId add_big_aquarium(Framework &rFW)
+{
+    ContextId const ctx = rFW.m_contextIds.create();
+    ContextBuilder cb{ctx, {}, rFW};
+    cb.add_feature(ftrWorld);
+    cb.add_feature(ftrFish);
+    cb.add_feature(ftrDispatchBench, true);
+    ContextBuilder::finalize(std::move(cb));
+    return ctx;
+}
+
+static ContextId add_sharks(Framework &rFW, ContextId const ctxAquarium)
+{
+    ContextId const ctx = rFW.m_contextIds.create();
+    ContextBuilder cb{ctx, {ctxAquarium}, rFW};
+    cb.add_feature(ftrSharks, std::string{"user data!"});
+    ContextBuilder::finalize(std::move(cb));
+    return ctx;
+}
+
+TEST(Framework, IncrementalLoad)
+{
+    using LoadStats = osp::exec::SinglethreadFWExecutor::LoadStats;
+
+    register_pltype_info();
+
+    Framework fw;
+
+    // Big context with lots of tasks
+    ContextId const ctxAquarium = add_big_aquarium(fw);
+
+    auto const mainLoop         = fw.get_interface<FIMainLoop>(ctxAquarium);
+    auto const aquarium         = fw.get_interface<FIAquarium>(ctxAquarium);
+    auto const fish             = fw.get_interface<FIFish>(ctxAquarium);
+    auto const bench            = fw.get_interface<FIDispatchBench>(ctxAquarium);
+
+    auto       &rAquariumFish   = fw.data_get<AquariumFish>(fish.di.fishDI);
+    auto       &rCounter        = fw.data_get<DispatchCounter>(bench.di.counterDI);
+
+    osp::exec::SinglethreadFWExecutor exec;
+
+    auto const run_aquarium_once = [&] (auto const& loop, auto const& aqua)
+    {
+        exec.task_finish(fw, loop.tasks.schedule, true, {.cancel = false});
+        exec.wait(fw);
+        exec.task_finish(fw, aqua.tasks.schedule, true, {.cancel = false});
+        exec.wait(fw);
+        exec.task_finish(fw, aqua.tasks.schedule, true, {.cancel = true});
+        exec.wait(fw);
+        exec.task_finish(fw, loop.tasks.schedule, true, {.cancel = true});
+        exec.wait(fw);
+        ASSERT_FALSE(exec.is_running(fw, loop.loopblks.mainLoop));
+    };
+
+    auto const expect_load_stats = [&exec] (LoadStats const expect)
+    {
+        EXPECT_EQ(exec.m_loadStats.everything,  expect.everything);
+        EXPECT_EQ(exec.m_loadStats.incremental, expect.incremental);
+        EXPECT_EQ(exec.m_loadStats.keptState,   expect.keptState);
+    };
+
+    exec.load(fw);
+    expect_load_stats({.everything = 1, .incremental = 0, .keptState = 0});
+
+    run_aquarium_once(mainLoop, aquarium);
+    ASSERT_EQ(rAquariumFish.fishCount, 10); // no sharks yet
+    ASSERT_EQ(rCounter.count, std::uint64_t(gc_dispatchTaskCount));
+
+    // Add sharks in a separate context, depending on the aquarium's context. This adds a pipeline
+    // to the existing main loop.
+    ContextId const ctxSharks = add_sharks(fw, ctxAquarium);
+
+    exec.load(fw);
+    expect_load_stats({.everything = 1, .incremental = 1, .keptState = 1});
+
+    run_aquarium_once(mainLoop, aquarium);
+    ASSERT_EQ(rAquariumFish.fishCount, 8); // sharks ate 2 fish
+    ASSERT_EQ(rCounter.count, 2u * gc_dispatchTaskCount);
+
+    fw.close_context(ctxSharks);
+
+    exec.load(fw);
+    expect_load_stats({.everything = 1, .incremental = 2, .keptState = 2});
+
+    run_aquarium_once(mainLoop, aquarium);
+    ASSERT_EQ(rAquariumFish.fishCount, 8); // sharks are gone
+    ASSERT_EQ(rCounter.count, 3u * gc_dispatchTaskCount);
+
+    // Add sharks again, reusing the IDs that were just freed
+    add_sharks(fw, ctxAquarium);
+    exec.load(fw);
+    expect_load_stats({.everything = 1, .incremental = 3, .keptState = 3});
+
+    run_aquarium_once(mainLoop, aquarium);
+    ASSERT_EQ(rAquariumFish.fishCount, 6);
+    ASSERT_EQ(rCounter.count, 4u * gc_dispatchTaskCount);
+
+    // A second aquarium adds a new top-level loop block, which must start without restarting the
+    // first one
+    ContextId const ctxAquarium2 = add_big_aquarium(fw);
+    exec.load(fw);
+    expect_load_stats({.everything = 1, .incremental = 4, .keptState = 4});
+
+    auto const mainLoop2 = fw.get_interface<FIMainLoop>(ctxAquarium2);
+    auto const aquarium2 = fw.get_interface<FIAquarium>(ctxAquarium2);
+    auto const fish2     = fw.get_interface<FIFish>(ctxAquarium2);
+
+    run_aquarium_once(mainLoop2, aquarium2);
+    ASSERT_EQ(fw.data_get<AquariumFish>(fish2.di.fishDI).fishCount, 10);
+    ASSERT_EQ(rAquariumFish.fishCount, 6);
+
+    run_aquarium_once(mainLoop, aquarium);
+    ASSERT_EQ(rAquariumFish.fishCount, 4);
+    ASSERT_EQ(rCounter.count, 5u * gc_dispatchTaskCount);
+}
+
+// Time a full load against adding and closing a small context.
+// Run with --gtest_also_run_disabled_tests
+TEST(Framework, DISABLED_IncrementalLoadBenchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    register_pltype_info();
+
+    Framework fw;
+    ContextId const ctxAquarium = add_big_aquarium(fw);
+
+    osp::exec::SinglethreadFWExecutor exec;
+
+    auto const load = [&exec, &fw] () -> Clock::duration
+    {
+        auto const start = Clock::now();
+        exec.load(fw);
+        return Clock::now() - start;
+    };
+
+    Clock::duration const fullTime = load();
+
+    ContextId const ctxSharks = add_sharks(fw, ctxAquarium);
+    Clock::duration const addTime = load();
+
+    fw.close_context(ctxSharks);
+    Clock::duration const closeTime = load();
+
+    EXPECT_EQ(exec.m_loadStats.keptState, 2u);
+
+    std::cout << "[ BENCHMARK ] " << gc_dispatchTaskCount << " tasks\n"
+              << "              Full load:        " << duration_cast<microseconds>(fullTime) .count() << "us\n"
+              << "              Add context:      " << duration_cast<microseconds>(addTime)  .count() << "us\n"
+              << "              Close context:    " << duration_cast<microseconds>(closeTime).count() << "us\n";
+}
+
+TEST(Framework, WorkerPoolParallelFor)
+{
+    osp::exec::WorkerPool pool{3};
+
+    std::vector<std::atomic<int>> counts(1000);
+
+    pool.parallel_for(std::uint32_t(counts.size()), [] (void *pData, std::uint32_t const index) noexcept
+    {
+        auto &rCounts = *static_cast<std::vector<std::atomic<int>>*>(pData);
+        rCounts[index].fetch_add(1, std::memory_order_relaxed);
+    }, &counts);
+
+    for (std::atomic<int> const &count : counts)
+    {
+        ASSERT_EQ(count.load(), 1);
+    }
+
+    // Lambda version used by tasks through WorkerContext::pPool; nullptr runs on this thread
+    for (osp::exec::WorkerPool *pPool : {&pool, static_cast<osp::exec::WorkerPool*>(nullptr)})
+    {
+        osp::exec::parallel_for(pPool, std::uint32_t(counts.size()), [&counts] (std::uint32_t const index)
+        {
+            counts[index].fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+
+    for (std::atomic<int> const &count : counts)
+    {
+        ASSERT_EQ(count.load(), 3);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+// Test 7: Tasks aligned together may still modify the same data, eg. several tasks syncing to
+//         the same Run or Modify stage. MultithreadFWExecutor must never run them at the same
+//         time, or some of the increments below are lost.
+
+struct SharedWriteCount
+{
+    int count{0};
+};
+
+struct FISharedWrites {
+    struct DataIds {
+        DataId countDI;
+    };
+    struct Pipelines { };
+};
+
+constexpr int gc_sharedWriteTaskCount = 16;
+
+FeatureDef const ftrSharedWrites = feature_def("SharedWrites", [] (
+        FeatureBuilder              &rFB,
+        Implement<FISharedWrites>   sharedWrites,
+        DependOn<FIAquarium>        aquarium)
+{
+    rFB.data_emplace<SharedWriteCount>(sharedWrites.di.countDI);
+
+    for (int i = 0; i < gc_sharedWriteTaskCount; ++i)
+    {
+        rFB.task()
+            .name       ("Slowly increment shared count")
+            .sync_with  ({aquarium.pl.aquariumUpdatePL(EStgOptionalPath::Run)})
+            .args       ({sharedWrites.di.countDI})
+            .func       ([] (SharedWriteCount &rShared) noexcept
+        {
+            int const before = rShared.count;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            rShared.count = before + 1;
+        });
+    }
+});
+
+TEST(Framework, MultithreadSharedWrites)
+{
+    register_pltype_info();
+
+    Framework fw;
+    ContextId const ctx = fw.m_contextIds.create();
+
+    ContextBuilder cb{ctx, {}, fw};
+    cb.add_feature(ftrWorld);
+    cb.add_feature(ftrSharedWrites);
+    ContextBuilder::finalize(std::move(cb));
+
+    auto const mainLoop     = fw.get_interface<FIMainLoop>(ctx);
+    auto const aquarium     = fw.get_interface<FIAquarium>(ctx);
+    auto const sharedWrites = fw.get_interface<FISharedWrites>(ctx);
+
+    osp::exec::MultithreadFWExecutor exec{4};
+    exec.load(fw);
+
+    exec.task_finish(fw, mainLoop.tasks.schedule, true, {.cancel = false});
+    exec.wait(fw);
+
+    constexpr int frames = 4;
+    for (int i = 0; i < frames; ++i)
+    {
+        exec.task_finish(fw, aquarium.tasks.schedule, true, {.cancel = false});
+        exec.wait(fw);
+    }
+
+    EXPECT_EQ(fw.data_get<SharedWriteCount>(sharedWrites.di.countDI).count, frames * gc_sharedWriteTaskCount);
+
+    exec.task_finish(fw, aquarium.tasks.schedule, true, {.cancel = true});
+    exec.wait(fw);
+    exec.task_finish(fw, mainLoop.tasks.schedule, true, {.cancel = true});
+    exec.wait(fw);
+}
+
+//-----------------------------------------------------------------------------
+
 
 void register_pltype_info()
 {
@@ -0,0 +1,531 @@
+/**
+ * Open Space Program
+ * Copyright © 2019-2025 Open Space Program Project
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <ospjolt/activescene/joltinteg_fn.h>
+
+#include <osp/activescene/basic_fn.h>
+#include <osp/executor/worker_pool.h>
+#include <osp/scientific/shapes.h>
+
+#include <Jolt/Geometry/AABox.h>
+#include <Jolt/Physics/Collision/CollisionCollectorImpl.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace ospjolt;
+
+using osp::active::ActiveEnt;
+using osp::active::ACompMass;
+using osp::active::ACompTransform;
+using osp::active::ACtxBasic;
+using osp::active::ACtxPhysics;
+using osp::active::SubtreeBuilder;
+using osp::active::SysSceneGraph;
+
+using osp::EShape;
+using osp::Matrix4;
+using osp::Vector3;
+
+using CompoundBody      = ACtxJoltWorld::CompoundBody;
+using CompoundMember    = ACtxJoltWorld::CompoundMember;
+
+// for the angle literals
+using namespace Magnum::Math::Literals;
+
+/**
+ * @brief Run func on a worker thread of rPool and wait for it to return
+ *
+ * Jobs submitted from outside the pool always go to a worker's queue. The calling thread doesn't
+ * help, so func never runs on it.
+ */
+template <typename FUNC_T>
+static void run_on_worker(osp::exec::WorkerPool &rPool, FUNC_T &&func)
+{
+    struct Data
+    {
+        FUNC_T              &rFunc;
+        std::atomic<bool>   done{false};
+    };
+    Data data{ .rFunc = func };
+
+    rPool.submit({ .func = [] (void *pUserData, std::uint32_t) noexcept
+    {
+        Data &rData = *static_cast<Data*>(pUserData);
+        rData.rFunc();
+        rData.done.store(true, std::memory_order_release);
+    }, .pUserData = &data });
+
+    while ( ! data.done.load(std::memory_order_acquire) )
+    {
+        std::this_thread::yield();
+    }
+}
+
+// Test that Jolt jobs created and waited on from a worker thread complete. Each job waits on a
+// nested barrier of its own, like PhysicsStepListenerImpl::OnStep does from within a physics job.
+TEST(JoltJobSystem, NestedBarriersOnWorker)
+{
+    constexpr int outerJobs = 64;
+    constexpr int innerJobs = 16;
+
+    JoltGlobalInit::init_if_required();
+
+    osp::exec::WorkerPool   pool{3};
+    WorkerPoolJobSystem     jobSystem{pool, JPH::cMaxPhysicsJobs, outerJobs + 1};
+
+    std::atomic<int> outerDone{0};
+    std::atomic<int> innerDone{0};
+    bool onWorker = false;
+
+    run_on_worker(pool, [&] ()
+    {
+        onWorker = (pool.current_worker() != -1);
+
+        JPH::JobSystem::Barrier *pBarrier = jobSystem.CreateBarrier();
+
+        for (int i = 0; i < outerJobs; ++i)
+        {
+            pBarrier->AddJob(jobSystem.CreateJob("Outer", JPH::Color::sGreen, [&] ()
+            {
+                JPH::JobSystem::Barrier *pInner = jobSystem.CreateBarrier();
+
+                for (int j = 0; j < innerJobs; ++j)
+                {
+                    pInner->AddJob(jobSystem.CreateJob("Inner", JPH::Color::sGreen, [&] ()
+                    {
+                        innerDone.fetch_add(1, std::memory_order_relaxed);
+                    }));
+                }
+
+                jobSystem.WaitForJobs(pInner);
+                jobSystem.DestroyBarrier(pInner);
+
+                outerDone.fetch_add(1, std::memory_order_relaxed);
+            }));
+        }
+
+        jobSystem.WaitForJobs(pBarrier);
+        jobSystem.DestroyBarrier(pBarrier);
+    });
+
+    EXPECT_TRUE(onWorker);
+    EXPECT_EQ(outerDone.load(), outerJobs);
+    EXPECT_EQ(innerDone.load(), outerJobs * innerJobs);
+}
+
+/**
+ * @brief Add dynamic spheres along the X axis, far enough apart to not collide, each with its
+ *        own ActiveEnt
+ */
+static std::vector<ActiveEnt> add_spheres(ACtxBasic &rBasic, ACtxJoltWorld &rWorld, int const count)
+{
+    JPH::BodyInterface &rBodyInterface = rWorld.m_physicsSystem.GetBodyInterface();
+
+    JPH::Ref<JPH::Shape> const pSphere = SysJolt::create_primitive(rWorld, osp::EShape::Sphere, JPH::Vec3::sReplicate(1.0f));
+
+    std::vector<ActiveEnt>      ents(std::size_t(count));
+    std::vector<JPH::BodyID>    joltBodyIds;
+    rBasic.m_activeIds.create(ents.begin(), ents.end());
+
+    for (int i = 0; i < count; ++i)
+    {
+        ActiveEnt const ent     = ents[std::size_t(i)];
+        BodyId const    bodyId  = rWorld.m_bodyIds.create();
+
+        rBasic.m_transform.emplace(ent);
+
+        rWorld.m_bodyToEnt[bodyId]   = ent;
+        rWorld.m_bodyFactors[bodyId] = ForceFactors_t{};
+        rWorld.m_entToBody.emplace(ent, bodyId);
+
+        JPH::BodyCreationSettings const bodyCreation(pSphere, JPH::Vec3(float(i) * 4.0f, 0.0f, 0.0f),
+                                                     JPH::Quat::sIdentity(), JPH::EMotionType::Dynamic, Layers::MOVING);
+        rBodyInterface.CreateBodyWithID(BToJolt(bodyId), bodyCreation);
+        joltBodyIds.push_back(BToJolt(bodyId));
+    }
+
+    JPH::BodyInterface::AddState const addState = rBodyInterface.AddBodiesPrepare(joltBodyIds.data(), count);
+    rBodyInterface.AddBodiesFinalize(joltBodyIds.data(), count, addState, JPH::EActivation::Activate);
+
+    return ents;
+}
+
+/**
+ * @brief Expect OnStep to have written the transform of every sphere from add_spheres, whichever
+ *        job it ended up in
+ */
+static void expect_sphere_transforms(ACtxBasic const &rBasic, std::vector<ActiveEnt> const& ents)
+{
+    for (std::size_t i = 0; i < ents.size(); ++i)
+    {
+        Vector3 const pos = rBasic.m_transform.get(ents[i]).m_transform.translation();
+        EXPECT_FLOAT_EQ(pos.x(), float(i) * 4.0f);
+    }
+}
+
+// Test stepping a world whose job system shares the pool, from a worker thread like a framework
+// task would. There are enough bodies for OnStep to split them across a nested barrier.
+TEST(JoltJobSystem, UpdateWorldOnWorker)
+{
+    constexpr int bodyCount = 256;
+
+    JoltGlobalInit::init_if_required();
+
+    osp::exec::WorkerPool pool{3};
+
+    ACtxBasic       basic;
+    ACtxPhysics     phys;
+    ACtxJoltWorld   world;
+    setup_jolt_world(world, 0, 10 * 1024 * 1024, &pool, bodyCount, 0, bodyCount, bodyCount);
+
+    // WorkerPoolJobSystem runs jobs on the pool's workers and the waiting thread
+    ASSERT_EQ(world.m_pJobSystem->GetMaxConcurrency(), int(pool.thread_count()) + 1);
+
+    std::vector<ActiveEnt> const ents = add_spheres(basic, world, bodyCount);
+
+    run_on_worker(pool, [&] ()
+    {
+        SysJolt::update_world(basic, phys, world, 1.0f / 60.0f);
+    });
+
+    expect_sphere_transforms(basic, ents);
+}
+
+// Test stepping with as few threads as each job system allows. OnStep waits on its own barrier
+// from within one of Jolt's step jobs; this must not deadlock when no other thread is free to
+// run the jobs it queued.
+TEST(JoltJobSystem, UpdateWorldLowConcurrency)
+{
+    constexpr int bodyCount = 256;
+
+    JoltGlobalInit::init_if_required();
+
+    auto const step = [] (ACtxJoltWorld &rWorld, int const concurrency, auto const& run)
+    {
+        ACtxBasic   basic;
+        ACtxPhysics phys;
+
+        ASSERT_EQ(rWorld.m_pJobSystem->GetMaxConcurrency(), concurrency);
+
+        std::vector<ActiveEnt> const ents = add_spheres(basic, rWorld, bodyCount);
+
+        run([&] ()
+        {
+            SysJolt::update_world(basic, phys, rWorld, 1.0f / 60.0f);
+        });
+
+        expect_sphere_transforms(basic, ents);
+    };
+
+    auto const run_here = [] (auto const& func) { func(); };
+
+    // JobSystemThreadPool with no threads of its own: everything runs on the calling thread
+    {
+        ACtxJoltWorld world;
+        setup_jolt_world(world, 0, 10 * 1024 * 1024, nullptr, bodyCount, 0, bodyCount, bodyCount);
+        step(world, 1, run_here);
+    }
+
+    // JobSystemThreadPool with one thread, enough for OnStep to use a barrier
+    {
+        ACtxJoltWorld world;
+        setup_jolt_world(world, 1, 10 * 1024 * 1024, nullptr, bodyCount, 0, bodyCount, bodyCount);
+        step(world, 2, run_here);
+    }
+
+    // WorkerPoolJobSystem on a pool without workers, which runs jobs as soon as they're queued.
+    // setup_jolt_world doesn't use it for an empty pool, so it's set directly.
+    {
+        osp::exec::WorkerPool pool{0};
+        ACtxJoltWorld world;
+        setup_jolt_world(world, 0, 10 * 1024 * 1024, nullptr, bodyCount, 0, bodyCount, bodyCount);
+        world.m_pJobSystem = std::make_unique<WorkerPoolJobSystem>(pool, JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
+        step(world, 1, run_here);
+    }
+
+    // WorkerPoolJobSystem with a single worker, stepped from that worker. The only worker is busy
+    // waiting, so the barriers must run their own jobs.
+    {
+        osp::exec::WorkerPool pool{1};
+        ACtxJoltWorld world;
+        setup_jolt_world(world, 0, 10 * 1024 * 1024, &pool, bodyCount, 0, bodyCount, bodyCount);
+        step(world, 2, [&pool] (auto const& func) { run_on_worker(pool, func); });
+    }
+}
+
+// Test that shifting the origin moves every body and its broadphase bounds, without waking up
+// sleeping bodies or changing velocities
+TEST(JoltRebase, TranslateOrigin)
+{
+    JoltGlobalInit::init_if_required();
+
+    ACtxBasic       basic;
+    ACtxJoltWorld   world;
+    setup_jolt_world(world, 1, 1024 * 1024, nullptr, 16, 0, 16, 16);
+
+    JPH::BodyInterface &rBodyInterface = world.m_physicsSystem.GetBodyInterface();
+
+    JPH::Ref<JPH::Shape> const pSphere = SysJolt::create_primitive(world, osp::EShape::Sphere, JPH::Vec3::sReplicate(1.0f));
+
+    struct TestBody
+    {
+        JPH::Vec3           position;
+        JPH::EMotionType    motion;
+        JPH::ObjectLayer    layer;
+        JPH::EActivation    activation;
+    };
+
+    std::array<TestBody, 3> const testBodies
+    {{
+        { JPH::Vec3( 10.0f, 0.0f,  0.0f), JPH::EMotionType::Static,  Layers::NON_MOVING, JPH::EActivation::DontActivate },
+        { JPH::Vec3(  0.0f, 5.0f,  0.0f), JPH::EMotionType::Dynamic, Layers::MOVING,     JPH::EActivation::Activate },
+        { JPH::Vec3(-10.0f, 0.0f, 20.0f), JPH::EMotionType::Dynamic, Layers::MOVING,     JPH::EActivation::DontActivate }
+    }};
+
+    JPH::Vec3 const velocity{1.0f, 2.0f, 3.0f};
+
+    std::array<JPH::BodyID, 3> joltBodyIds;
+    for (std::size_t i = 0; i < testBodies.size(); ++i)
+    {
+        TestBody const &rTest  = testBodies[i];
+        BodyId const   bodyId  = world.m_bodyIds.create();
+
+        JPH::BodyCreationSettings const bodyCreation(pSphere, rTest.position, JPH::Quat::sIdentity(), rTest.motion, rTest.layer);
+        rBodyInterface.CreateBodyWithID(BToJolt(bodyId), bodyCreation);
+        rBodyInterface.AddBody(BToJolt(bodyId), rTest.activation);
+        joltBodyIds[i] = BToJolt(bodyId);
+    }
+    rBodyInterface.SetLinearVelocity(joltBodyIds[1], velocity);
+
+    Vector3 const translate{100.0f, -50.0f, 25.0f};
+    basic.m_translateOrigin = translate;
+
+    SysJolt::update_translate(basic, world);
+
+    JPH::BroadPhaseQuery const &rBroadPhase = world.m_physicsSystem.GetBroadPhaseQuery();
+
+    for (std::size_t i = 0; i < testBodies.size(); ++i)
+    {
+        TestBody const      &rTest      = testBodies[i];
+        JPH::BodyID const   joltBodyId  = joltBodyIds[i];
+        JPH::Vec3 const     expected    = rTest.position - Vec3MagnumToJolt(translate);
+
+        EXPECT_TRUE(rBodyInterface.GetPosition(joltBodyId).IsClose(expected, 1e-8f));
+        EXPECT_EQ(rBodyInterface.IsActive(joltBodyId), rTest.activation == JPH::EActivation::Activate);
+
+        // Broadphase finds the body at its new position only
+        auto const bodies_near = [&rBroadPhase] (JPH::Vec3 const center)
+        {
+            JPH::AllHitCollisionCollector<JPH::CollideShapeBodyCollector> collector;
+            rBroadPhase.CollideAABox(JPH::AABox(center - JPH::Vec3::sReplicate(0.5f), center + JPH::Vec3::sReplicate(0.5f)), collector);
+            std::vector<JPH::BodyID> found(collector.mHits.begin(), collector.mHits.end());
+            return found;
+        };
+
+        std::vector<JPH::BodyID> const foundNew = bodies_near(expected);
+        std::vector<JPH::BodyID> const foundOld = bodies_near(rTest.position);
+        EXPECT_NE(std::find(foundNew.begin(), foundNew.end(), joltBodyId), foundNew.end());
+        EXPECT_EQ(std::find(foundOld.begin(), foundOld.end(), joltBodyId), foundOld.end());
+    }
+
+    EXPECT_TRUE(rBodyInterface.GetLinearVelocity(joltBodyIds[1]).IsClose(velocity, 1e-8f));
+}
+
+static void add_collider(ACtxPhysics &rPhys, ActiveEnt const ent, EShape const shape, float const mass)
+{
+    rPhys.m_shape[ent] = shape;
+    rPhys.m_mass.emplace(ent, ACompMass{
+            .m_offset   = {0.1f, 0.0f, 0.0f},
+            .m_inertia  = osp::collider_inertia_tensor(shape, Vector3{1.0f}, mass),
+            .m_mass     = mass });
+}
+
+static std::vector<ActiveEnt> sorted(std::vector<ActiveEnt> ents)
+{
+    std::sort(ents.begin(), ents.end());
+    return ents;
+}
+
+/**
+ * @brief Expect two compound bodies to have the same members, sub-shapes, and mass properties
+ *
+ * Sub-shapes may be in a different order. Member and sub-shape indices of each world must be
+ * consistent with its own body.
+ */
+static void expect_same_compound(
+        ACtxJoltWorld const& lhsWorld, BodyId const lhsId,
+        ACtxJoltWorld const& rhsWorld, BodyId const rhsId)
+{
+    CompoundBody const &rLhs = lhsWorld.m_compoundBodies.at(lhsId);
+    CompoundBody const &rRhs = rhsWorld.m_compoundBodies.at(rhsId);
+
+    ASSERT_EQ(sorted(rLhs.members),         sorted(rRhs.members));
+    ASSERT_EQ(sorted(rLhs.subShapeEnts),    sorted(rRhs.subShapeEnts));
+    ASSERT_EQ(rLhs.shape->GetNumSubShapes(), rLhs.subShapeEnts.size());
+
+    for (std::uint32_t i = 0; i < rLhs.members.size(); ++i)
+    {
+        CompoundMember const &rMember = lhsWorld.m_compoundMembers.at(rLhs.members[i]);
+        EXPECT_EQ(rMember.body,         lhsId);
+        EXPECT_EQ(rMember.memberIndex,  i);
+    }
+
+    EXPECT_TRUE(rLhs.shape->GetCenterOfMass().IsClose(rRhs.shape->GetCenterOfMass(), 1e-8f));
+
+    for (std::uint32_t i = 0; i < rLhs.subShapeEnts.size(); ++i)
+    {
+        ActiveEnt const         ent         = rLhs.subShapeEnts[i];
+        CompoundMember const    &rLhsMember = lhsWorld.m_compoundMembers.at(ent);
+        CompoundMember const    &rRhsMember = rhsWorld.m_compoundMembers.at(ent);
+
+        ASSERT_EQ(rLhsMember.subShape, i);
+
+        JPH::CompoundShape::SubShape const &rLhsSub = rLhs.shape->GetSubShape(i);
+        JPH::CompoundShape::SubShape const &rRhsSub = rRhs.shape->GetSubShape(rRhsMember.subShape);
+
+        EXPECT_TRUE(rLhsSub.GetPositionCOM().IsClose(rRhsSub.GetPositionCOM(), 1e-8f));
+        EXPECT_TRUE(rLhsSub.GetRotation().IsClose(rRhsSub.GetRotation(), 1e-8f));
+        EXPECT_NEAR(rLhsSub.mShape->GetVolume(), rRhsSub.mShape->GetVolume(), 1e-4f);
+    }
+
+    JPH::MassProperties const lhsMass = SysJolt::compound_mass_properties(rLhs.mass, Vec3JoltToMagnum(rLhs.shape->GetCenterOfMass()));
+    JPH::MassProperties const rhsMass = SysJolt::compound_mass_properties(rRhs.mass, Vec3JoltToMagnum(rRhs.shape->GetCenterOfMass()));
+
+    EXPECT_NEAR(lhsMass.mMass, rhsMass.mMass, 1e-4f);
+    for (JPH::uint row = 0; row < 4; ++row)
+    {
+        for (JPH::uint col = 0; col < 4; ++col)
+        {
+            EXPECT_NEAR(lhsMass.mInertia(row, col), rhsMass.mInertia(row, col), 1e-3f);
+        }
+    }
+}
+
+// Test that adding, moving, and removing colliders of an existing compound body with
+// update_compounds gives the same shape and mass as rebuilding it with create_compound
+TEST(JoltCompound, UpdateMatchesRebuild)
+{
+    JoltGlobalInit::init_if_required();
+
+    ACtxBasic       basic;
+    ACtxPhysics     phys;
+    ACtxJoltWorld   world;
+    setup_jolt_world(world, 1, 1024 * 1024, nullptr, 16, 0, 16, 16);
+
+    std::array<ActiveEnt, 6> ents;
+    basic.m_activeIds.create(ents.begin(), ents.end());
+    auto const [root, a, b, c, d, e] = ents;
+
+    basic.m_scnGraph        .resize(basic.m_activeIds.capacity());
+    phys.m_shape            .resize(basic.m_activeIds.capacity());
+    phys.m_hasColliders     .resize(basic.m_activeIds.capacity());
+
+    // root
+    // ├── a
+    // ├── b
+    // │   └── d
+    // └── c
+    {
+        SubtreeBuilder bldScene = SysSceneGraph::add_descendants(basic.m_scnGraph, 5);
+        SubtreeBuilder bldRoot  = bldScene.add_child(root, 4);
+        bldRoot.add_child(a);
+        SubtreeBuilder bldB     = bldRoot.add_child(b, 1);
+        bldB.add_child(d);
+        bldRoot.add_child(c);
+    }
+
+    basic.m_transform.emplace(root);
+    basic.m_transform.emplace(a, ACompTransform{Matrix4::translation({1.0f, 0.0f, 0.0f})});
+    basic.m_transform.emplace(b, ACompTransform{Matrix4::translation({0.0f, 2.0f, 0.0f}) * Matrix4::rotationZ(30.0_degf)});
+    basic.m_transform.emplace(c, ACompTransform{Matrix4::translation({-1.0f, 0.0f, 0.5f}) * Matrix4::rotationX(45.0_degf)});
+    basic.m_transform.emplace(d, ACompTransform{Matrix4::translation({0.0f, 0.0f, 1.5f}) * Matrix4::scaling(Vector3{0.5f})});
+
+    add_collider(phys, root,    EShape::Box,    10.0f);
+    add_collider(phys, a,       EShape::Sphere, 2.0f);
+    add_collider(phys, b,       EShape::Box,    3.0f);
+    add_collider(phys, c,       EShape::Box,    4.0f);
+    add_collider(phys, d,       EShape::Sphere, 1.0f);
+
+    phys.m_hasColliders.insert(root);
+    phys.m_hasColliders.insert(a);
+    phys.m_hasColliders.insert(b);
+
+    BodyId const bodyId = world.m_bodyIds.create();
+    world.m_bodyToEnt[bodyId] = root;
+    world.m_entToBody.emplace(root, bodyId);
+
+    JPH::Ref<JPH::MutableCompoundShape> const pShape = SysJolt::create_compound(phys, world, basic, root, bodyId);
+
+    JPH::BodyCreationSettings bodyCreation(pShape, JPH::Vec3::sZero(), JPH::Quat::sIdentity(), JPH::EMotionType::Dynamic, Layers::MOVING);
+    bodyCreation.mMassPropertiesOverride = SysJolt::compound_mass_properties(
+            world.m_compoundBodies.at(bodyId).mass, Vec3JoltToMagnum(pShape->GetCenterOfMass()));
+    bodyCreation.mOverrideMassProperties = JPH::EOverrideMassProperties::MassAndInertiaProvided;
+
+    JPH::BodyInterface &rBodyInterface = world.m_physicsSystem.GetBodyInterface();
+    rBodyInterface.CreateBodyWithID(BToJolt(bodyId), bodyCreation);
+    rBodyInterface.AddBody(BToJolt(bodyId), JPH::EActivation::Activate);
+
+    // Add e under a
+    SysSceneGraph::add_descendants(basic.m_scnGraph, 1, a).add_child(e);
+    basic.m_transform.emplace(e, ACompTransform{Matrix4::translation({0.5f, -1.0f, 0.0f})});
+    add_collider(phys, e, EShape::Box, 5.0f);
+
+    // Move b, which moves d along with it
+    basic.m_transform.get(b).m_transform = Matrix4::translation({0.0f, 3.0f, -1.0f}) * Matrix4::rotationY(60.0_degf);
+
+    // Remove a's shape but keep its mass. Its sub-shape isn't the last one.
+    phys.m_shape[a] = EShape::None;
+
+    // Remove c entirely
+    phys.m_shape[c] = EShape::None;
+    phys.m_mass.remove(c);
+
+    phys.m_colliderDirty = {e, b, a, c};
+
+    SysJolt::update_compounds(basic, phys, world);
+
+    EXPECT_TRUE(phys.m_colliderDirty.empty());
+    EXPECT_TRUE(world.m_compoundDirty.empty());
+    EXPECT_FALSE(world.m_compoundMembers.contains(c));
+    EXPECT_EQ(world.m_compoundMembers.at(a).subShape, CompoundMember::sc_noSubShape);
+
+    ACtxJoltWorld rebuilt;
+    setup_jolt_world(rebuilt, 1, 1024 * 1024, nullptr, 16, 0, 16, 16);
+    BodyId const rebuiltId = rebuilt.m_bodyIds.create();
+    SysJolt::create_compound(phys, rebuilt, basic, root, rebuiltId);
+
+    expect_same_compound(world, bodyId, rebuilt, rebuiltId);
+
+    // finalize_compounds gave the body the new mass
+    float const mass = SysJolt::compound_mass_properties(rebuilt.m_compoundBodies.at(rebuiltId).mass, {}).mMass;
+    EXPECT_NEAR(SysJolt::get_inverse_mass_no_lock(world.m_physicsSystem, bodyId), 1.0f / mass, 1e-5f);
+}
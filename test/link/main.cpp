@@ -0,0 +1,333 @@
+/**
+ * Open Space Program
+ * Copyright © 2019-2025 Open Space Program Project
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <adera/machines/links.h>
+
+#include <osp/link/signal.h>
+#include <osp/executor/worker_pool.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace adera;
+using namespace osp::link;
+
+using osp::arrayView;
+using osp::Vector3;
+using osp::exec::WorkerPool;
+
+constexpr MachTypeId gc_machTypes = 3;
+
+/**
+ * @brief Connect each node to a few random machines, mostly as inputs
+ */
+static void random_connections(Nodes::NodeToMach_t &rNodeToMach, std::uint32_t const nodeCount, std::uint32_t const machPerType, std::mt19937 &rRand)
+{
+    rNodeToMach.ids_reserve(nodeCount);
+    rNodeToMach.data_reserve(nodeCount * 3);
+
+    for (NodeId node = 0; node < nodeCount; ++node)
+    {
+        rNodeToMach.emplace(node, 1 + rRand() % 3);
+        for (Junction &rJunc : rNodeToMach[node])
+        {
+            rJunc.local     = MachLocalId(rRand() % machPerType);
+            rJunc.type      = MachTypeId(rRand() % gc_machTypes);
+            rJunc.custom    = (rRand() % 4 == 0) ? gc_sigOut : gc_sigIn;
+        }
+    }
+}
+
+static void resize_updater(MachineUpdater &rUpdMach, std::uint32_t const machPerType)
+{
+    rUpdMach.machTypesDirty.resize(gc_machTypes);
+    rUpdMach.localDirty.resize(gc_machTypes);
+    for (lgrn::IdSetStl<MachLocalId> &rLocalDirty : rUpdMach.localDirty)
+    {
+        rLocalDirty.resize(machPerType);
+    }
+}
+
+template <typename ID_T>
+static std::vector<ID_T> to_vector(lgrn::IdSetStl<ID_T> const& set)
+{
+    std::vector<ID_T> out;
+    for (ID_T const id : set)
+    {
+        out.push_back(id);
+    }
+    return out;
+}
+
+static void expect_same_dirty(MachineUpdater const& lhs, MachineUpdater const& rhs)
+{
+    ASSERT_EQ(to_vector(lhs.machTypesDirty), to_vector(rhs.machTypesDirty));
+    for (MachTypeId type = 0; type < gc_machTypes; ++type)
+    {
+        ASSERT_EQ(to_vector(lhs.localDirty[type]), to_vector(rhs.localDirty[type]));
+    }
+}
+
+// Test that update_signal_nodes gives the same node values and dirty machines when split across
+// threads as when run on one thread
+TEST(Signal, UpdateNodesThreaded)
+{
+    constexpr std::uint32_t nodeCount   = std::uint32_t(gc_minNodesPerThread) * 5;
+    constexpr std::uint32_t machPerType = 1000;
+
+    std::mt19937 randGen(69);
+
+    Nodes::NodeToMach_t nodeToMach;
+    random_connections(nodeToMach, nodeCount, machPerType, randGen);
+
+    Machines const machines;
+
+    WorkerPool pool{3};
+
+    // Enough dirty nodes to split across every thread
+    ASSERT_EQ(signal_thread_count(nodeCount * 7 / 8, gc_minNodesPerThread, &pool), pool.thread_count() + 1);
+
+    for (int test = 0; test < 10; ++test)
+    {
+        UpdateNodes<float> updNodes;
+        updNodes.nodeDirty      .resize(nodeCount);
+        updNodes.nodeNewValues  .resize(nodeCount);
+        for (NodeId node = 0; node < nodeCount; ++node)
+        {
+            if (randGen() % 8 != 0)
+            {
+                updNodes.assign(node, float(randGen() % 1000));
+            }
+        }
+
+        UpdateNodes<float>      singleUpd   = updNodes;
+        SignalThreads<float>    singleThreads;
+        std::vector<float>      singleValues(nodeCount, -1.0f);
+        MachineUpdater          singleMach;
+        resize_updater(singleMach, machPerType);
+
+        UpdateNodes<float>      multiUpd    = updNodes;
+        SignalThreads<float>    multiThreads;
+        std::vector<float>      multiValues(nodeCount, -1.0f);
+        MachineUpdater          multiMach;
+        resize_updater(multiMach, machPerType);
+
+        bool const singleNotified = update_signal_nodes(singleUpd, singleThreads, nodeToMach, machines, arrayView(singleValues), singleMach, nullptr);
+        bool const multiNotified  = update_signal_nodes(multiUpd,  multiThreads,  nodeToMach, machines, arrayView(multiValues),  multiMach,  &pool);
+
+        EXPECT_TRUE(singleNotified);
+        EXPECT_EQ(singleNotified, multiNotified);
+        ASSERT_EQ(singleValues, multiValues);
+        expect_same_dirty(singleMach, multiMach);
+
+        EXPECT_FALSE(multiUpd.dirty);
+        EXPECT_TRUE(to_vector(multiUpd.nodeDirty).empty());
+    }
+}
+
+// Test that update_machines gives the same new node values when split across threads as when
+// run on one thread, including nodes assigned by multiple machines
+TEST(Signal, UpdateMachinesThreaded)
+{
+    constexpr std::uint32_t nodeCount   = 512;
+    constexpr std::uint32_t machCount   = std::uint32_t(gc_minMachinesPerThread) * 20;
+
+    std::mt19937 randGen(420);
+
+    // Each machine writes to two nodes. Nodes are shared by many machines, so the last machine
+    // to assign a node decides its value.
+    std::vector<NodeId> machToNode(machCount * 2);
+    for (NodeId &rNode : machToNode)
+    {
+        rNode = NodeId(randGen() % nodeCount);
+    }
+
+    auto const func = [&machToNode] (osp::ArrayView<MachLocalId const> const locals, UpdateNodes<float> &rUpdNodes)
+    {
+        for (MachLocalId const local : locals)
+        {
+            rUpdNodes.assign(machToNode[local * 2],     float(local));
+            rUpdNodes.assign(machToNode[local * 2 + 1], float(local) * 0.5f);
+        }
+    };
+
+    WorkerPool pool{3};
+
+    ASSERT_EQ(signal_thread_count(machCount / 2, gc_minMachinesPerThread, &pool), pool.thread_count() + 1);
+
+    for (int test = 0; test < 10; ++test)
+    {
+        lgrn::IdSetStl<MachLocalId> localDirty;
+        localDirty.resize(machCount);
+        for (MachLocalId local = 0; local < machCount; ++local)
+        {
+            if (randGen() % 2 == 0)
+            {
+                localDirty.insert(local);
+            }
+        }
+
+        UpdateNodes<float>      singleUpd;
+        SignalThreads<float>    singleThreads;
+        singleUpd.nodeDirty     .resize(nodeCount);
+        singleUpd.nodeNewValues .resize(nodeCount, -1.0f);
+
+        UpdateNodes<float>      multiUpd;
+        SignalThreads<float>    multiThreads;
+        multiUpd.nodeDirty      .resize(nodeCount);
+        multiUpd.nodeNewValues  .resize(nodeCount, -1.0f);
+
+        update_machines(localDirty, singleUpd, singleThreads, nullptr, func);
+        update_machines(localDirty, multiUpd,  multiThreads,  &pool,   func);
+
+        EXPECT_EQ(singleUpd.dirty, multiUpd.dirty);
+        ASSERT_EQ(to_vector(singleUpd.nodeDirty), to_vector(multiUpd.nodeDirty));
+        for (NodeId const node : singleUpd.nodeDirty)
+        {
+            ASSERT_EQ(singleUpd.nodeNewValues[node], multiUpd.nodeNewValues[node]);
+        }
+    }
+}
+
+// Test that the branchless thruster_influence_block gives the same results as
+// thruster_influence. Edge cases take different branches in thruster_influence, or make NaN
+// terms in the block version that must not be selected. The last block is partially filled.
+TEST(RcsDriver, BlockMatchesScalar)
+{
+    struct Driver
+    {
+        Vector3 pos;
+        Vector3 dir;
+        Vector3 cmdLin;
+        Vector3 cmdAng;
+    };
+
+    Vector3 const zero{0.0f};
+
+    std::vector<Driver> drivers
+    {
+        { {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, zero,                     zero                    }, // No commands
+        { {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f},       zero                    }, // Linear only
+        { {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, zero,                     {0.0f, -1.0f, 0.0f}     }, // Angular only
+        { {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f},       {0.0f, -1.0f, 0.0f}     }, // Both, clamped to 1
+        { {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, -1.0f},      zero                    }, // Opposing, negative
+        { {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f, 0.005f},     zero                    }, // Below cut-off
+        { {0.0f, 0.0f, 2.0f}, {0.0f, 0.0f, 1.0f}, zero,                     {1.0f, 0.0f, 0.0f}      }, // pos parallel to dir
+        { {0.0f, 0.0f, 2.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f},       zero                    }, // pos parallel to dir, linear only
+        { {0.0f, 0.0f, 2.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f},       {1.0f, 0.0f, 0.0f}      }, // pos parallel to dir, both
+        { zero,               {0.0f, 0.0f, 1.0f}, {0.0f, 0.0f, 1.0f},       zero                    }, // pos at origin, linear only
+    };
+
+    std::mt19937 randGen(1337);
+    std::uniform_real_distribution<float> randFloat(-1.0f, 1.0f);
+    auto const randVec = [&randGen, &randFloat] () { return Vector3{randFloat(randGen), randFloat(randGen), randFloat(randGen)}; };
+
+    while (drivers.size() < 1000)
+    {
+        drivers.push_back({
+                .pos    = randVec() * 4.0f,
+                .dir    = randVec().normalized(),
+                .cmdLin = (randGen() % 3 == 0) ? zero : randVec(),
+                .cmdAng = (randGen() % 3 == 0) ? zero : randVec() });
+    }
+
+    ASSERT_NE(drivers.size() % gc_rcsBlockSize, 0);
+
+    using namespace ports_rcsdriver;
+
+    for (std::size_t first = 0; first < drivers.size(); first += gc_rcsBlockSize)
+    {
+        std::size_t const count = std::min(gc_rcsBlockSize, drivers.size() - first);
+
+        // Lanes past count are garbage, and must be left alone
+        RcsDriverBlock block;
+        for (std::array<float, gc_rcsBlockSize> &rIn : block.in)
+        {
+            rIn.fill(std::numeric_limits<float>::quiet_NaN());
+        }
+        block.influence.fill(-1.0f);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Driver const &rDriver = drivers[first + i];
+            block.in[gc_posXIn.port][i]     = rDriver.pos.x();
+            block.in[gc_posYIn.port][i]     = rDriver.pos.y();
+            block.in[gc_posZIn.port][i]     = rDriver.pos.z();
+            block.in[gc_dirXIn.port][i]     = rDriver.dir.x();
+            block.in[gc_dirYIn.port][i]     = rDriver.dir.y();
+            block.in[gc_dirZIn.port][i]     = rDriver.dir.z();
+            block.in[gc_cmdLinXIn.port][i]  = rDriver.cmdLin.x();
+            block.in[gc_cmdLinYIn.port][i]  = rDriver.cmdLin.y();
+            block.in[gc_cmdLinZIn.port][i]  = rDriver.cmdLin.z();
+            block.in[gc_cmdAngXIn.port][i]  = rDriver.cmdAng.x();
+            block.in[gc_cmdAngYIn.port][i]  = rDriver.cmdAng.y();
+            block.in[gc_cmdAngZIn.port][i]  = rDriver.cmdAng.z();
+        }
+
+        thruster_influence_block(block, count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Driver const &rDriver   = drivers[first + i];
+            float const expected    = thruster_influence(rDriver.pos, rDriver.dir, rDriver.cmdLin, rDriver.cmdAng);
+            float const actual      = block.influence[i];
+
+            // Rounding may differ. Right at the cut-off for small contributions, one may be 0.
+            if (std::abs(std::max(expected, actual) - 0.01f) < 1e-4f)
+            {
+                continue;
+            }
+
+            EXPECT_NEAR(actual, expected, 1e-5f) << "driver " << (first + i);
+        }
+
+        for (std::size_t i = count; i < gc_rcsBlockSize; ++i)
+        {
+            EXPECT_EQ(block.influence[i], -1.0f);
+        }
+    }
+
+    // Spot check edge cases, in case both versions are wrong the same way
+    auto const scalar = [&drivers] (std::size_t const i)
+    {
+        return thruster_influence(drivers[i].pos, drivers[i].dir, drivers[i].cmdLin, drivers[i].cmdAng);
+    };
+    EXPECT_EQ(scalar(0), 0.0f);
+    EXPECT_EQ(scalar(1), 1.0f);
+    EXPECT_EQ(scalar(2), 1.0f);
+    EXPECT_EQ(scalar(3), 1.0f);
+    EXPECT_EQ(scalar(4), 0.0f);
+    EXPECT_EQ(scalar(5), 0.0f);
+    EXPECT_EQ(scalar(6), 0.0f);
+    EXPECT_EQ(scalar(7), 1.0f);
+    EXPECT_EQ(scalar(8), 0.0f);
+    EXPECT_EQ(scalar(9), 1.0f);
+}
@@ -0,0 +1,471 @@
+/**
+ * Open Space Program
+ * Copyright © 2019-2025 Open Space Program Project
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <planet-a/chunk_cache.h>
+#include <planet-a/chunk_utils.h>
+#include <planet-a/dirty_ranges.h>
+#include <planet-a/icosahedron.h>
+#include <planet-a/skeleton_subdiv.h>
+#include <planet-a/terrain_generator.h>
+
+#include <gtest/gtest.h>
+
+using planeta::BasicChunkMeshGeometry;
+using planeta::ByteRange;
+using planeta::ChunkId;
+using planeta::ChunkMeshBufferInfo;
+using planeta::ChunkMeshCache;
+using planeta::ChunkSkeleton;
+using planeta::DirtyRanges;
+using planeta::NoiseTerrainGenerator;
+using planeta::NoiseTerrainParams;
+using planeta::SkeletonSubdivScratchpad;
+using planeta::SkeletonVertexData;
+using planeta::SkTriGroupId;
+using planeta::SkTriId;
+using planeta::SkVrtxId;
+using planeta::SubdivBudget;
+using planeta::SubdivTriangleSkeleton;
+
+using osp::Vector3;
+using osp::Vector3l;
+
+using Ranges_t = std::vector<ByteRange>;
+
+// Test overlapping and adjacent ranges added out of order being merged
+TEST(DirtyRanges, Coalesce)
+{
+    DirtyRanges dirty;
+    EXPECT_TRUE(dirty.empty());
+    EXPECT_TRUE(dirty.coalesce().empty());
+
+    dirty.add(100, 12);
+    dirty.add(0,   12);
+    dirty.add(12,  12);   // adjacent to [0, 12)
+    dirty.add(104, 4);    // inside [100, 112)
+    dirty.add(50,  0);    // empty, ignored
+    dirty.add(108, 20);   // overlaps end of [100, 112)
+    dirty.add(200, 12);
+
+    EXPECT_EQ(dirty.coalesce(), (Ranges_t{{0, 24}, {100, 28}, {200, 12}}));
+
+    // Gaps of up to maxGap bytes are merged
+    EXPECT_EQ(dirty.coalesce(72), (Ranges_t{{0, 24}, {100, 112}}));
+    EXPECT_EQ(dirty.coalesce(76), (Ranges_t{{0, 212}}));
+
+    dirty.clear();
+    EXPECT_TRUE(dirty.empty());
+    EXPECT_TRUE(dirty.coalesce().empty());
+}
+
+// Test whole-buffer invalidation
+TEST(DirtyRanges, AddAll)
+{
+    DirtyRanges dirty;
+
+    dirty.add(12, 12);
+    dirty.add_all(1024);
+    dirty.add(500, 12); // already covered
+
+    EXPECT_TRUE(dirty.is_all());
+    EXPECT_EQ(dirty.coalesce(), (Ranges_t{{0, 1024}}));
+
+    dirty.clear();
+    EXPECT_FALSE(dirty.is_all());
+
+    dirty.add(500, 12);
+    EXPECT_EQ(dirty.coalesce(), (Ranges_t{{500, 12}}));
+}
+
+// Test many single-vertex ranges, like shared vertex normals written one at a time
+TEST(DirtyRanges, ManySmallRanges)
+{
+    constexpr std::size_t vertexSize = 12;
+
+    DirtyRanges dirty;
+
+    // Every vertex in [0, 1000) except multiples of 10, added in reverse
+    for (std::size_t i = 1000; i-- > 0; )
+    {
+        if (i % 10 != 0)
+        {
+            dirty.add(i * vertexSize, vertexSize);
+        }
+    }
+
+    Ranges_t const& ranges = dirty.coalesce();
+    ASSERT_EQ(ranges.size(), 100);
+    for (std::size_t i = 0; i < ranges.size(); ++i)
+    {
+        EXPECT_EQ(ranges[i], (ByteRange{(i*10 + 1) * vertexSize, 9 * vertexSize}));
+    }
+
+    // Skipped vertices are merged over if allowed
+    EXPECT_EQ(dirty.coalesce(vertexSize), (Ranges_t{{vertexSize, 999 * vertexSize}}));
+}
+
+// Test that heights don't depend on how positions are split into batches, and stay in range
+TEST(TerrainGenerator, NoiseBatches)
+{
+    constexpr int    c_precision = 10;
+    constexpr double c_radius    = 6371000.0;
+    constexpr double c_height    = 20000.0;
+
+    NoiseTerrainGenerator const generator{NoiseTerrainParams{
+        .height     = c_height,
+        .wavelength = 50000.0,
+        .octaves    = 10,
+        .seed       = 1234 }};
+
+    // Points along a great circle, more than a few of the generator's internal blocks
+    std::vector<Vector3l> positions;
+    for (int i = 0; i < 1000; ++i)
+    {
+        double const angle = i * 0.0001;
+        positions.emplace_back(Vector3l(osp::Vector3d{std::sin(angle), 0.0, std::cos(angle)} * c_radius * 1024.0));
+    }
+
+    std::vector<float>   heights(positions.size());
+    std::vector<Vector3> normals(positions.size());
+    generator.heights(positions, c_precision, heights, normals);
+
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        float   singleHeight;
+        Vector3 singleNormal;
+        generator.heights({&positions[i], 1}, c_precision, {&singleHeight, 1}, {&singleNormal, 1});
+
+        ASSERT_EQ(heights[i], singleHeight);
+        ASSERT_EQ(normals[i], singleNormal);
+        ASSERT_GE(heights[i], 0.0f);
+        ASSERT_LE(heights[i], float(c_height));
+        ASSERT_NEAR(normals[i].length(), 1.0f, 1e-5f);
+    }
+
+    // Neighboring points 0.0001 radians (~640m) apart, heights must be continuous but varied
+    float maxStep = 0.0f;
+    for (std::size_t i = 1; i < positions.size(); ++i)
+    {
+        maxStep = std::max(maxStep, std::abs(heights[i] - heights[i-1]));
+    }
+    EXPECT_LT(maxStep, float(c_height) * 0.25f);
+    EXPECT_GT(maxStep, 0.0f);
+
+    // Normals are optional
+    std::vector<float> heightsNoNormals(positions.size());
+    generator.heights(positions, c_precision, heightsNoNormals, {});
+    EXPECT_EQ(heights, heightsNoNormals);
+}
+
+/**
+ * @brief Chunk mesh buffers to store to and restore from a ChunkMeshCache, without a skeleton
+ */
+struct CacheTestChunks
+{
+    CacheTestChunks()
+     : skCh{planeta::make_skeleton_chunks(3)}
+    {
+        skCh.chunk_reserve(8);
+        skCh.shared_reserve(64);
+        info = planeta::make_chunk_mesh_buffer_info(skCh);
+        geom.resize(skCh, info);
+    }
+
+    Corrade::Containers::StridedArrayView1D<Vector3> fill_positions(ChunkId const chunkId)
+    {
+        return geom.vbufPositions.view(geom.vrtxBuffer, info.vrtxTotal).sliceSize(info.vbufFillOffset + chunkId.value*info.fillVrtxCount, info.fillVrtxCount);
+    }
+
+    Corrade::Containers::StridedArrayView1D<Vector3> fill_normals(ChunkId const chunkId)
+    {
+        return geom.vbufNormals.view(geom.vrtxBuffer, info.vrtxTotal).sliceSize(info.vbufFillOffset + chunkId.value*info.fillVrtxCount, info.fillVrtxCount);
+    }
+
+    osp::ArrayView<Vector3> fill_shared_normals(ChunkId const chunkId)
+    {
+        return osp::arrayView(geom.chunkFillSharedNormals).sliceSize(chunkId.value*skCh.m_chunkSharedCount, skCh.m_chunkSharedCount);
+    }
+
+    /// Write distinct values derived from seed into a chunk's fill vertices
+    void fill(ChunkId const chunkId, float const seed)
+    {
+        for (std::size_t i = 0; i < info.fillVrtxCount; ++i)
+        {
+            fill_positions(chunkId)[i] = Vector3{seed, float(i), 1.0f};
+            fill_normals(chunkId)[i]   = Vector3{0.0f, seed, float(i)};
+        }
+        for (std::size_t i = 0; i < skCh.m_chunkSharedCount; ++i)
+        {
+            fill_shared_normals(chunkId)[i] = Vector3{float(i), 0.0f, seed};
+        }
+    }
+
+    /// Set a chunk's key, fill it, and store it into the cache
+    void store(ChunkMeshCache &rCache, ChunkId const chunkId, ChunkMeshCache::Key const& key, float const seed)
+    {
+        rCache.set_chunk_key(chunkId, key);
+        fill(chunkId, seed);
+        rCache.store(chunkId, geom, info, skCh);
+    }
+
+    /// Restore into a new chunk with the given key
+    bool restore(ChunkMeshCache &rCache, ChunkId const chunkId, ChunkMeshCache::Key const& key, float const scale = 1.0f)
+    {
+        rCache.set_chunk_key(chunkId, key);
+        return rCache.restore(chunkId, geom, info, skCh, scale);
+    }
+
+    ChunkSkeleton           skCh;
+    ChunkMeshBufferInfo     info{};
+    BasicChunkMeshGeometry  geom;
+};
+
+static ChunkMeshCache::Key make_test_key(std::int64_t const i)
+{
+    return { .corners = { Vector3l{i, 0, 0}, Vector3l{0, i, 0}, Vector3l{0, 0, i} } };
+}
+
+// Test that restored fill vertices match what was stored, shifted to the new mesh origin
+TEST(ChunkMeshCache, RestoreShiftsOrigin)
+{
+    constexpr float c_scale = 0.25f;
+
+    CacheTestChunks chunks;
+    ChunkMeshCache  cache;
+    cache.set_max_bytes(1u << 20);
+
+    chunks.geom.originSkelPos = Vector3l{100, -40, 8};
+    chunks.store(cache, ChunkId{0}, make_test_key(1), 5.0f);
+    EXPECT_EQ(cache.entry_count(), 1);
+
+    // Restore into another chunk after the origin moved, like when the viewer moves away and back
+    chunks.geom.originSkelPos = Vector3l{20, 0, -8};
+    ASSERT_TRUE(chunks.restore(cache, ChunkId{3}, make_test_key(1), c_scale));
+
+    Vector3 const shift = Vector3{80.0f, -40.0f, 16.0f} * c_scale;
+    for (std::size_t i = 0; i < chunks.info.fillVrtxCount; ++i)
+    {
+        EXPECT_EQ(chunks.fill_positions(ChunkId{3})[i], (Vector3{5.0f, float(i), 1.0f} + shift));
+        EXPECT_EQ(chunks.fill_normals(ChunkId{3})[i],   (Vector3{0.0f, 5.0f, float(i)}));
+    }
+    for (std::size_t i = 0; i < chunks.skCh.m_chunkSharedCount; ++i)
+    {
+        EXPECT_EQ(chunks.fill_shared_normals(ChunkId{3})[i], (Vector3{float(i), 0.0f, 5.0f}));
+    }
+
+    // Restored entries are removed, as the chunk owns its data again
+    EXPECT_EQ(cache.entry_count(), 0);
+    EXPECT_EQ(cache.size_bytes(),  0);
+    EXPECT_FALSE(chunks.restore(cache, ChunkId{4}, make_test_key(1)));
+    EXPECT_EQ(cache.hits(),   1);
+    EXPECT_EQ(cache.misses(), 1);
+}
+
+// Test that the least recently stored entries are evicted to stay under the byte limit
+TEST(ChunkMeshCache, EvictLeastRecent)
+{
+    CacheTestChunks chunks;
+    ChunkMeshCache  cache;
+    cache.set_max_bytes(1u << 20);
+
+    // All entries are the same size
+    chunks.store(cache, ChunkId{0}, make_test_key(0), 0.0f);
+    std::size_t const entryBytes = cache.size_bytes();
+    ASSERT_GT(entryBytes, 0);
+
+    cache.set_max_bytes(3 * entryBytes);
+    chunks.store(cache, ChunkId{1}, make_test_key(1), 1.0f);
+    chunks.store(cache, ChunkId{2}, make_test_key(2), 2.0f);
+    EXPECT_EQ(cache.entry_count(), 3);
+    EXPECT_EQ(cache.size_bytes(),  3 * entryBytes);
+
+    // Storing the same key again replaces it and makes it most recent, so 1 is now the oldest
+    chunks.store(cache, ChunkId{0}, make_test_key(0), 10.0f);
+    EXPECT_EQ(cache.entry_count(), 3);
+
+    chunks.store(cache, ChunkId{3}, make_test_key(3), 3.0f);
+    EXPECT_EQ(cache.entry_count(), 3);
+    EXPECT_EQ(cache.size_bytes(),  3 * entryBytes);
+
+    // Lowering the limit evicts down to fit: 2 is oldest now
+    cache.set_max_bytes(2 * entryBytes + entryBytes / 2);
+    EXPECT_EQ(cache.entry_count(), 2);
+    EXPECT_LE(cache.size_bytes(),  cache.max_bytes());
+
+    EXPECT_FALSE(chunks.restore(cache, ChunkId{4}, make_test_key(1)));
+    EXPECT_FALSE(chunks.restore(cache, ChunkId{4}, make_test_key(2)));
+    EXPECT_TRUE (chunks.restore(cache, ChunkId{4}, make_test_key(3)));
+    EXPECT_TRUE (chunks.restore(cache, ChunkId{5}, make_test_key(0)));
+    EXPECT_EQ(chunks.fill_positions(ChunkId{5})[0], (Vector3{10.0f, 0.0f, 1.0f}));
+
+    EXPECT_EQ(cache.hits(),   2);
+    EXPECT_EQ(cache.misses(), 2);
+    EXPECT_EQ(cache.entry_count(), 0);
+    EXPECT_EQ(cache.size_bytes(),  0);
+}
+
+// Test that a max of 0 bytes disables the cache, without counting misses
+TEST(ChunkMeshCache, Disabled)
+{
+    CacheTestChunks chunks;
+    ChunkMeshCache  cache;
+    cache.set_max_bytes(1u << 20);
+
+    chunks.store(cache, ChunkId{0}, make_test_key(0), 0.0f);
+    chunks.store(cache, ChunkId{1}, make_test_key(1), 1.0f);
+
+    cache.set_max_bytes(0);
+    EXPECT_EQ(cache.entry_count(), 0);
+    EXPECT_EQ(cache.size_bytes(),  0);
+
+    chunks.store(cache, ChunkId{2}, make_test_key(2), 2.0f);
+    EXPECT_EQ(cache.entry_count(), 0);
+    EXPECT_FALSE(chunks.restore(cache, ChunkId{3}, make_test_key(2)));
+
+    EXPECT_EQ(cache.hits(),   0);
+    EXPECT_EQ(cache.misses(), 0);
+}
+
+/**
+ * @brief Icosahedron skeleton subdivided around a viewer, the same way adera_app's terrain
+ *        feature does each frame
+ */
+struct IcoTestPlanet
+{
+    static constexpr double c_radius = 50000.0;
+    static constexpr double c_height = 100.0;
+
+    IcoTestPlanet(std::uint8_t const levelMax, SubdivBudget const budget)
+    {
+        skData.precision = 10;
+        skel = planeta::create_skeleton_icosahedron(c_radius, icoVrtx, icoGroups, icoTri, skData);
+        skel.levelMax = levelMax;
+        skData.resize(skel);
+
+        for (SkTriGroupId const groupId : icoGroups)
+        {
+            planeta::ico_calc_sphere_tri_center(groupId, c_radius + c_height, c_height, skel, skData);
+        }
+
+        sp.resize(skel);
+        sp.budget = budget;
+        sp.onSubdiv = [] (
+                SkTriId,
+                SkTriGroupId                                groupId,
+                std::array<SkVrtxId, 3>                     corners,
+                std::array<osp::MaybeNewId<SkVrtxId>, 3>    middles,
+                SubdivTriangleSkeleton                      &rSkel,
+                SkeletonVertexData                          &rSkData,
+                SkeletonSubdivScratchpad::UserData_t) noexcept
+        {
+            planeta::ico_calc_middles(c_radius, corners, middles, rSkData);
+            planeta::ico_calc_sphere_tri_center(groupId, c_radius + c_height, c_height, rSkel, rSkData);
+        };
+        // Nothing to do on un-subdivide
+        sp.onUnsubdiv = [] (SkTriId, planeta::SkeletonTriangle&, SubdivTriangleSkeleton&, SkeletonVertexData&, SkeletonSubdivScratchpad::UserData_t) noexcept
+        { };
+
+        double const scale = std::exp2(double(skData.precision));
+        for (std::size_t level = 0; level < planeta::gc_maxSubdivLevels; ++level)
+        {
+            double const subdivRadius = 0.75 * planeta::gc_icoMaxEdgeVsLevel[level] * c_radius * scale;
+            sp.distanceThresholdSubdiv[level]   = subdivRadius;
+            sp.distanceThresholdUnsubdiv[level] = 2.0 * subdivRadius;
+        }
+    }
+
+    /// Unsubdivide then subdivide for a single frame
+    void update(Vector3l const viewerPos)
+    {
+        planeta::subdiv_budget_begin(sp);
+
+        for (int level = skel.levelMax-1; level >= 0; --level)
+        {
+            planeta::unsubdivide_select_by_distance(std::uint8_t(level), viewerPos, skel, skData, sp);
+            planeta::unsubdivide_deselect_invariant_violations(std::uint8_t(level), skel, skData, sp);
+            planeta::unsubdivide_level(std::uint8_t(level), skel, skData, sp);
+        }
+        sp.distanceTestDone.clear();
+
+        for (SkTriId const sktriId : icoTri)
+        {
+            sp.levels[0].distanceTestNext.push_back(sktriId);
+            sp.distanceTestDone.insert(sktriId);
+        }
+        sp.levelNeedProcess = 0;
+
+        for (std::uint8_t level = 0; level < skel.levelMax; ++level)
+        {
+            planeta::subdivide_level_by_distance(viewerPos, level, skel, skData, sp);
+        }
+        sp.distanceTestDone.clear();
+    }
+
+    /// Point on the surface, in skeleton units
+    Vector3l surface_pos(osp::Vector3d const dir) const
+    {
+        return Vector3l(dir.normalized() * c_radius * std::exp2(double(skData.precision)));
+    }
+
+    std::array<SkVrtxId,     12>    icoVrtx;
+    std::array<SkTriGroupId, 5>     icoGroups;
+    std::array<SkTriId,      20>    icoTri;
+
+    SubdivTriangleSkeleton          skel;
+    SkeletonVertexData              skData;
+    SkeletonSubdivScratchpad        sp;
+};
+
+// Test that skeleton invariants hold between frames when the budget leaves work for later, and
+// that the skeleton ends up the same as without a budget
+TEST(SkeletonSubdiv, BudgetLimited)
+{
+    constexpr std::uint8_t c_levelMax = 10;
+
+    IcoTestPlanet unlimited{c_levelMax, {}};
+    IcoTestPlanet limited  {c_levelMax, {.maxSubdiv = 8, .maxUnsubdiv = 8}};
+
+    for (osp::Vector3d const dir : {osp::Vector3d{0.3, 1.0, 0.2}, osp::Vector3d{-1.0, 0.1, 0.5}})
+    {
+        Vector3l const viewerPos = unlimited.surface_pos(dir);
+
+        unlimited.update(viewerPos);
+        unlimited.skel.debug_check_invariants();
+        ASSERT_FALSE(unlimited.sp.budgetExceeded);
+
+        int frames = 0;
+        do
+        {
+            limited.update(viewerPos);
+            limited.skel.debug_check_invariants();
+            ++frames;
+            ASSERT_LT(frames, 1000);
+        }
+        while (limited.sp.budgetExceeded);
+
+        // Budget must have actually spread the work out over multiple frames
+        EXPECT_GT(frames, 2);
+        EXPECT_EQ(limited.skel.tri_group_ids().size(), unlimited.skel.tri_group_ids().size());
+    }
+}
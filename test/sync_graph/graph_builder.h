@@ -27,6 +27,10 @@
 #include <gtest/gtest.h>
 #include <osp/executor/sync_graph.h>
 
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
 namespace test_graph
 {
 
@@ -38,7 +42,7 @@ using namespace osp::exec;
 struct ArgCycle
 {
     std::string_view name;
-    std::initializer_list<std::string_view> path;
+    std::vector<std::string_view> path;
 };
 
 struct ArgInitialCycle
@@ -50,8 +54,8 @@ struct ArgInitialCycle
 struct ArgSubgraphType
 {
     std::string_view name;
-    std::initializer_list<std::string_view> points;
-    std::initializer_list<ArgCycle> cycles;
+    std::vector<std::string_view> points;
+    std::vector<ArgCycle> cycles;
     ArgInitialCycle initialCycle;
 };
 
@@ -73,14 +77,14 @@ struct ArgSync
     std::string_view name;
     bool debugGraphStraight = false;
     bool debugGraphLongAndUgly = false;
-    std::initializer_list<ArgConnectToPoint> connections;
+    std::vector<ArgConnectToPoint> connections;
 };
 
 struct Args
 {
-    std::initializer_list<ArgSubgraphType> types;
-    std::initializer_list<ArgSubgraph> subgraphs;
-    std::initializer_list<ArgSync> syncs;
+    std::vector<ArgSubgraphType> types;
+    std::vector<ArgSubgraph> subgraphs;
+    std::vector<ArgSync> syncs;
 };
 
 inline SubgraphId find_subgraph(std::string_view debugName, SyncGraph const& graph)
@@ -191,11 +195,15 @@ inline SyncGraph make_test_graph(Args args)
         LGRN_ASSERTM(rSgtype.initialCycle.has_value(), "Initial cycle is missing");
     }
 
+    // Lookup by name is linear, which gets slow for big graphs built for benchmarks
+    std::unordered_map<std::string_view, SubgraphId> subgraphIdByName;
+
     // Make Subgraphs
     for (ArgSubgraph const& argSubgraph : args.subgraphs)
     {
         SubgraphId const subgraphId = out.subgraphIds.create();
         Subgraph &rSubgraph = out.subgraphs[subgraphId];
+        subgraphIdByName.emplace(argSubgraph.name, subgraphId);
 
         rSubgraph.debugName = argSubgraph.name;
 
@@ -218,7 +226,8 @@ inline SyncGraph make_test_graph(Args args)
 
         for (ArgConnectToPoint const& argConnect : argSync.connections)
         {
-            SubgraphId const subgraphId = find_subgraph(argConnect.subgraph, out);
+            auto       const foundIt    = subgraphIdByName.find(argConnect.subgraph);
+            SubgraphId const subgraphId = (foundIt != subgraphIdByName.end()) ? foundIt->second : SubgraphId{};
             LGRN_ASSERTMV(subgraphId.has_value(), "No Subgraph with name found", argConnect.subgraph);
             Subgraph &rSubgraph = out.subgraphs[subgraphId];
 
@@ -29,11 +29,16 @@
 
 #include <osp/executor/sync_graph.h>
 #include <osp/executor/singlethread_sync_graph.h>
+#include <osp/executor/worker_pool.h>
 
 #include <osp/core/keyed_vector.h>
 
 #include <longeron/id_management/id_set_stl.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
 #include <vector>
 
 
@@ -194,6 +199,84 @@ TEST(SyncExec, Basic)
     justLocked.clear();
 }
 
+// Test that SyncGraph::connect keeps each synchronizer's points sorted when connecting out of
+// subgraph order, which SyncGraphExecutor relies on to find a subgraph's points
+TEST(SyncExec, ConnectOutOfOrder)
+{
+    SyncGraph graph = make_test_graph(
+    {
+        .types =
+        {
+            {
+                .name = "2PointLoop",
+                .points = {"A", "B"},
+                .cycles =
+                {
+                    {
+                        .name = "MainCycle",
+                        .path = {"A", "B"}
+                    }
+                },
+                .initialCycle = { .cycle = "MainCycle", .position = 0 }
+            }
+        },
+        .subgraphs =
+        {
+            { .name = "Bulb", .type = "2PointLoop" },
+            { .name = "Fish", .type = "2PointLoop" },
+            { .name = "Rock", .type = "2PointLoop" }
+        },
+        .syncs =
+        {
+            { .name = "Sync_0" },
+            { .name = "Sync_1" }
+        }
+    });
+
+    SynchronizerId const sync0Id = find_sync("Sync_0", graph);
+    SynchronizerId const sync1Id = find_sync("Sync_1", graph);
+    SubgraphId const bulbId = find_subgraph("Bulb", graph);
+    SubgraphId const fishId = find_subgraph("Fish", graph);
+    SubgraphId const rockId = find_subgraph("Rock", graph);
+    LocalPointId const pointA = LocalPointId::from_index(0);
+    LocalPointId const pointB = LocalPointId::from_index(1);
+
+    for (SubgraphId const subgraphId : {rockId, bulbId, fishId})
+    {
+        graph.connect({ .sync = sync0Id, .subgraphPoint = { .subgraph = subgraphId, .point = pointA } });
+    }
+    for (SubgraphId const subgraphId : {fishId, rockId, bulbId})
+    {
+        graph.connect({ .sync = sync1Id, .subgraphPoint = { .subgraph = subgraphId, .point = pointB } });
+    }
+
+    for (SynchronizerId const syncId : {sync0Id, sync1Id})
+    {
+        std::vector<SubgraphPointAddr> const &points = graph.syncs[syncId].connectedPoints;
+        ASSERT_TRUE(std::is_sorted(points.begin(), points.end()));
+    }
+
+    std::vector<SynchronizerId> justLocked;
+    SyncGraphExecutor exec;
+    exec.load(graph);
+    exec.batch(ESyncAction::SetEnable, {sync0Id, sync1Id}, graph);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        while (exec.update(justLocked, graph)) { }
+
+        ASSERT_TRUE(is_locked({sync0Id}, exec, justLocked, graph));
+        exec.batch(ESyncAction::Unlock, {sync0Id}, graph);
+        justLocked.clear();
+
+        while (exec.update(justLocked, graph)) { }
+
+        ASSERT_TRUE(is_locked({sync1Id}, exec, justLocked, graph));
+        exec.batch(ESyncAction::Unlock, {sync1Id}, graph);
+        justLocked.clear();
+    }
+}
+
 TEST(SyncExec, ParallelSize1Loop)
 {
     SyncGraph const graph = make_test_graph(
@@ -914,3 +997,164 @@ TEST(SyncExec, NestedLoop)
     // we can exit the outer loop, but by now I'm too lazy to write more test code.
 }
 
+
+//-----------------------------------------------------------------------------
+
+// Big graph: Many small independent clusters of subgraphs, like a framework with lots of
+// pipelines. Each cluster is two 2-point loops held together by a sync on each point.
+
+struct BigGraphStats
+{
+    std::size_t updates{0};
+    std::size_t locks{0};
+    double      seconds{0.0};
+};
+
+static SyncGraph make_big_graph(std::size_t const clusterCount)
+{
+    // make_test_graph takes string_views, so keep the strings alive until it's done
+    std::vector<std::string> names;
+    names.reserve(clusterCount * 4u);
+
+    Args args
+    {
+        .types =
+        {
+            {
+                .name = "2PointLoop",
+                .points = {"X", "Y"},
+                .cycles = { { .name = "MainCycle", .path = {"X", "Y"} } },
+                .initialCycle = { .cycle = "MainCycle", .position = 0 }
+            }
+        }
+    };
+    args.subgraphs.reserve(clusterCount * 2u);
+    args.syncs.reserve(clusterCount * 2u);
+
+    for (std::size_t i = 0; i < clusterCount; ++i)
+    {
+        std::string_view const a    = names.emplace_back("A" + std::to_string(i));
+        std::string_view const b    = names.emplace_back("B" + std::to_string(i));
+        std::string_view const sx   = names.emplace_back("SX" + std::to_string(i));
+        std::string_view const sy   = names.emplace_back("SY" + std::to_string(i));
+
+        args.subgraphs.push_back({ .name = a, .type = "2PointLoop" });
+        args.subgraphs.push_back({ .name = b, .type = "2PointLoop" });
+        args.syncs.push_back({ .name = sx, .connections = { {.subgraph = a, .point = "X"}, {.subgraph = b, .point = "X"} } });
+        args.syncs.push_back({ .name = sy, .connections = { {.subgraph = a, .point = "Y"}, {.subgraph = b, .point = "Y"} } });
+    }
+
+    return make_test_graph(std::move(args));
+}
+
+/**
+ * @param unlockEvery [in] Only unlock every Nth locked sync per frame, the rest stay locked. Tests
+ *                         how update() scales with how much of the graph is actually moving.
+ */
+static BigGraphStats run_big_graph(SyncGraph const& graph, osp::exec::WorkerPool *pPool, int frames, std::size_t unlockEvery, std::vector<LocalPointId> &rPointsOut)
+{
+    BigGraphStats stats;
+
+    SyncGraphExecutor exec;
+    exec.pPool = pPool;
+    exec.load(graph);
+
+    std::vector<SynchronizerId> allSyncs;
+    for (SynchronizerId const syncId : graph.syncIds)
+    {
+        allSyncs.push_back(syncId);
+    }
+    exec.batch(ESyncAction::SetEnable, allSyncs, graph);
+
+    std::vector<SynchronizerId> justLocked;
+    std::vector<SynchronizerId> stillLocked;
+    std::vector<SynchronizerId> unlock;
+
+    auto const start = std::chrono::steady_clock::now();
+
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        while (exec.update(justLocked, graph))
+        {
+            ++stats.updates;
+        }
+        ++stats.updates;
+
+        stats.locks += justLocked.size();
+        stillLocked.insert(stillLocked.end(), justLocked.begin(), justLocked.end());
+        justLocked.clear();
+
+        unlock.clear();
+        std::erase_if(stillLocked, [&unlock, unlockEvery, frame] (SynchronizerId const syncId)
+        {
+            bool const doUnlock = (syncId.value + std::size_t(frame)) % unlockEvery == 0;
+            if (doUnlock)
+            {
+                unlock.push_back(syncId);
+            }
+            return doUnlock;
+        });
+        exec.batch(ESyncAction::Unlock, unlock, graph);
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    rPointsOut.clear();
+    for (SubgraphId const subgraphId : graph.subgraphIds)
+    {
+        rPointsOut.push_back(exec.perSubgraph[subgraphId].point);
+    }
+
+    return stats;
+}
+
+TEST(SyncExec, BigGraphParallelMatchesSerial)
+{
+    SyncGraph const graph = make_big_graph(256);
+
+    osp::exec::WorkerPool pool{4};
+
+    std::vector<LocalPointId> serialPoints;
+    std::vector<LocalPointId> parallelPoints;
+
+    for (std::size_t const unlockEvery : {1u, 64u})
+    {
+        BigGraphStats const serial   = run_big_graph(graph, nullptr, 16, unlockEvery, serialPoints);
+        BigGraphStats const parallel = run_big_graph(graph, &pool,   16, unlockEvery, parallelPoints);
+
+        // Parallel advancing must give the exact same results
+        ASSERT_EQ(serial.updates, parallel.updates);
+        ASSERT_EQ(serial.locks,   parallel.locks);
+        ASSERT_EQ(serialPoints,   parallelPoints);
+        ASSERT_GT(serial.locks, 0u);
+    }
+}
+
+// Run with --gtest_also_run_disabled_tests
+TEST(SyncExec, DISABLED_BigGraphBenchmark)
+{
+    constexpr std::size_t clusterCount = 8192; // 16384 subgraphs, 16384 syncs
+    constexpr int         frames       = 64;
+
+    SyncGraph const graph = make_big_graph(clusterCount);
+
+    osp::exec::WorkerPool pool{4};
+
+    std::vector<LocalPointId> serialPoints;
+    std::vector<LocalPointId> parallelPoints;
+
+    for (std::size_t const unlockEvery : {1u, 64u})
+    {
+        BigGraphStats const serial   = run_big_graph(graph, nullptr, frames, unlockEvery, serialPoints);
+        BigGraphStats const parallel = run_big_graph(graph, &pool,   frames, unlockEvery, parallelPoints);
+
+        ASSERT_EQ(serialPoints, parallelPoints);
+
+        std::cout << "[ BENCHMARK ] " << clusterCount * 2u << " subgraphs, unlocking 1/" << unlockEvery
+                  << " of locked syncs per frame\n"
+                  << "              serial:   " << double(serial.updates)   / serial.seconds   << " updates/s, "
+                                                << double(serial.locks)     / serial.seconds   << " locks/s\n"
+                  << "              parallel: " << double(parallel.updates) / parallel.seconds << " updates/s, "
+                                                << double(parallel.locks)   / parallel.seconds << " locks/s\n";
+    }
+}
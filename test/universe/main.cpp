@@ -25,11 +25,23 @@
 #include <osp/universe/universe.h>
 #include <osp/universe/coordinates.h>
 #include <osp/core/math_2pow.h>
+#include <osp/executor/worker_pool.h>
+
+#include <adera/universe_demo/simulations.h>
 
 #include <Magnum/Math/Functions.h>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
 using namespace osp;
 using namespace osp::universe;
 
@@ -235,4 +247,769 @@ TEST(Universe, CoordTransformerRotations)
     expect_near_vec(moonToSun.transform_position(moonRay), planet.position, 4);
 }
 
+/**
+ * @brief Expect CoordTransformer::transform_positions to match transform_position
+ *
+ * @param maxError [in] Max difference per component. Rotations are allowed to round differently.
+ */
+static void expect_batch_matches(CoordTransformer const& transformer, std::vector<Vector3g> const& positions, spaceint_t maxError)
+{
+    // Interleaved Vector3g array
+    std::vector<Vector3g> outInterleaved(positions.size());
+    transformer.transform_positions(
+            { .pos    = { reinterpret_cast<std::byte const*>(positions[0].data() + 0),
+                          reinterpret_cast<std::byte const*>(positions[0].data() + 1),
+                          reinterpret_cast<std::byte const*>(positions[0].data() + 2) },
+              .stride = { sizeof(Vector3g), sizeof(Vector3g), sizeof(Vector3g) } },
+            outInterleaved);
+
+    // Separate X, Y, and Z arrays, like how simulations expose posX, posY, and posZ
+    std::vector<spaceint_t> posX, posY, posZ;
+    for (Vector3g const& pos : positions)
+    {
+        posX.push_back(pos.x());
+        posY.push_back(pos.y());
+        posZ.push_back(pos.z());
+    }
+    std::vector<Vector3g> outSeparate(positions.size());
+    transformer.transform_positions(
+            { .pos    = { reinterpret_cast<std::byte const*>(posX.data()),
+                          reinterpret_cast<std::byte const*>(posY.data()),
+                          reinterpret_cast<std::byte const*>(posZ.data()) },
+              .stride = { sizeof(spaceint_t), sizeof(spaceint_t), sizeof(spaceint_t) } },
+            outSeparate);
+
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        Vector3g const expected = transformer.transform_position(positions[i]);
+
+        ASSERT_EQ(outInterleaved[i], outSeparate[i]);
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            ASSERT_LE(std::abs(outInterleaved[i][axis] - expected[axis]), maxError) << "at position " << i;
+        }
+    }
+}
+
+// Test batched CoordTransformer::transform_positions against transform_position
+TEST(Universe, CoordTransformerBatch)
+{
+    std::mt19937_64 gen{42};
+
+    // Random positions within +/- 2^48, well inside what can be scaled up by 2^5 without
+    // overflowing. Count isn't a multiple of the internal block size.
+    std::uniform_int_distribution<spaceint_t> dist{-(spaceint_t(1) << 48), spaceint_t(1) << 48};
+    std::vector<Vector3g> positions(1000);
+    for (Vector3g &rPos : positions)
+    {
+        rPos = {dist(gen), dist(gen), dist(gen)};
+    }
+
+    // Small negative and positive values exercise rounding towards zero when dividing
+    positions[0] = {-1, 1, 0};
+    positions[1] = {-7, 7, -8};
+    positions[2] = {-1025, 1025, -2047};
+
+    CospaceRelationship const planetAndSun
+    {
+        .parentPrecision = 10,
+        .childPrecision  = 15,
+        .childPos        = {sci64(150, 9, 10), sci64(-150, 9, 10), sci64(42, 0, 10)}
+    };
+    CospaceRelationship const moonAndPlanet
+    {
+        .parentPrecision = 15,
+        .childPrecision  = 12,
+        .childPos        = {sci64(-280, 6, 12), sci64(280, 6, 12), sci64(69, 3, 12)}
+    };
+
+    auto const sunToPlanet  = CoordTransformer::from_parent_to_child(planetAndSun);
+    auto const planetToSun  = CoordTransformer::from_child_to_parent(planetAndSun);
+    auto const planetToMoon = CoordTransformer::from_parent_to_child(moonAndPlanet);
+    auto const moonToPlanet = CoordTransformer::from_child_to_parent(moonAndPlanet);
+
+    // Without rotations, results must be bit-exact
+    expect_batch_matches(CoordTransformer{}, positions, 0);
+    expect_batch_matches(planetToSun,  positions, 0);
+    expect_batch_matches(planetToMoon, positions, 0);
+    expect_batch_matches(moonToPlanet, positions, 0);
+    expect_batch_matches(CoordTransformer::from_composite(planetToSun, moonToPlanet), positions, 0);
+
+    // sunToPlanet scales up by 2^5, keep positions small enough to not overflow
+    std::vector<Vector3g> smallPositions = positions;
+    for (Vector3g &rPos : smallPositions)
+    {
+        rPos = rPos / 64;
+    }
+    expect_batch_matches(sunToPlanet, smallPositions, 0);
+
+    // With rotations, results may differ by 1 unit due to rounding. Keep values small enough
+    // that doubles still have fractional precision.
+    CospaceRelationship const rotated
+    {
+        .parentPrecision = 10,
+        .childPrecision  = 15,
+        .childPos        = {sci64(1, 6, 10), sci64(-2, 6, 10), sci64(3, 6, 10)},
+        .childRot        = Quaterniond::rotation(37.0_deg, Vector3d{1.0, 2.0, 3.0}.normalized())
+    };
+
+    expect_batch_matches(CoordTransformer::from_child_to_parent(rotated), smallPositions, 1);
+    expect_batch_matches(CoordTransformer::from_parent_to_child(rotated), smallPositions, 1);
+}
+
+struct TestSatData
+{
+    Vector3g        position;
+    osp::Vector3    velocity;
+    SatelliteId     id;
+};
+
+/**
+ * @brief Make a DataAccessor over interleaved TestSatData, every 7th satellite is null
+ */
+static DataAccessor make_test_accessor(std::vector<TestSatData> &rData, std::size_t count, DefaultComponents const& dc)
+{
+    rData.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        rData[i] = {
+            .position = {spaceint_t(i), -spaceint_t(i) * 3, spaceint_t(i) * 7},
+            .velocity = {float(i) * 0.5f, 1.0f, -float(i)},
+            .id       = (i % 7 == 3) ? SatelliteId{} : SatelliteId{std::uint32_t(i)} };
+    }
+
+    constexpr std::ptrdiff_t stride = sizeof(TestSatData);
+    TestSatData const *pFirst = rData.data();
+
+    DataAccessor out;
+    out.components[dc.posX]  = make_comp(&pFirst->position.data()[0], stride);
+    out.components[dc.posY]  = make_comp(&pFirst->position.data()[1], stride);
+    out.components[dc.posZ]  = make_comp(&pFirst->position.data()[2], stride);
+    out.components[dc.velX]  = make_comp(&pFirst->velocity.data()[0], stride);
+    out.components[dc.velY]  = make_comp(&pFirst->velocity.data()[1], stride);
+    out.components[dc.velZ]  = make_comp(&pFirst->velocity.data()[2], stride);
+    out.components[dc.satId] = make_comp(&pFirst->id, stride);
+    out.count = count;
+    return out;
+}
+
+// Test DefaultComponentViews and non_null_satellite_mask against DataAccessor::iterate
+TEST(Universe, DataAccessorViews)
+{
+    UCtxComponentTypes const compTypes;
+    DefaultComponents  const &dc = compTypes.defaults;
+
+    std::vector<TestSatData> data;
+    DataAccessor const accessor = make_test_accessor(data, 200, dc); // not a multiple of 64
+
+    DefaultComponentViews const v = view_defaults(accessor, dc);
+
+    EXPECT_TRUE(v.has_pos());
+    EXPECT_TRUE(v.has_vel());
+    EXPECT_FALSE(v.has_veld());
+    EXPECT_FALSE(v.has_rot());
+    EXPECT_FALSE(v.radius.has_value());
+
+    auto iter = accessor.iterate(std::array{dc.posX, dc.posY, dc.posZ, dc.velX, dc.satId});
+    for (std::size_t i = 0; i < accessor.count; ++i, iter.next())
+    {
+        ASSERT_EQ(v.posX[i],  iter.get<spaceint_t>(0));
+        ASSERT_EQ(v.posY[i],  iter.get<spaceint_t>(1));
+        ASSERT_EQ(v.posZ[i],  iter.get<spaceint_t>(2));
+        ASSERT_EQ(v.velX[i],  iter.get<float>(3));
+        ASSERT_EQ(v.satId[i], iter.get<SatelliteId>(4));
+    }
+
+    BitVector_t mask;
+    non_null_satellite_mask(v.satId, accessor.count, mask);
+
+    std::size_t visited = 0;
+    for (std::size_t const i : mask.ones())
+    {
+        ASSERT_LT(i, accessor.count);
+        ASSERT_TRUE(data[i].id.has_value());
+        ++visited;
+    }
+
+    std::size_t const nonNull = std::count_if(data.begin(), data.end(),
+                                              [] (TestSatData const& sat) { return sat.id.has_value(); });
+    EXPECT_EQ(visited, nonNull);
+}
+
+/**
+ * @brief Sum positions and velocities of non-null satellites using DataAccessor::iterate,
+ *        skipping nulls per-element
+ */
+static double sum_with_iterate(DataAccessor const& accessor, DefaultComponents const& dc)
+{
+    double sum = 0.0;
+    auto iter = accessor.iterate(std::array{
+            dc.posX, dc.posY, dc.posZ,
+            dc.velX, dc.velY, dc.velZ,
+            dc.satId});
+    for (std::size_t i = 0; i < accessor.count; ++i, iter.next())
+    {
+        if ( ! iter.get<SatelliteId>(6).has_value() )
+        {
+            continue;
+        }
+        sum += double(iter.get<spaceint_t>(0) + iter.get<spaceint_t>(1) + iter.get<spaceint_t>(2))
+             + double(iter.get<float>(3) + iter.get<float>(4) + iter.get<float>(5));
+    }
+    return sum;
+}
+
+/**
+ * @brief Same as sum_with_iterate, but with DefaultComponentViews and the null satellite bitmask
+ */
+static double sum_with_views(DataAccessor const& accessor, DefaultComponents const& dc, BitVector_t &rMask)
+{
+    double sum = 0.0;
+    DefaultComponentViews const v = view_defaults(accessor, dc);
+    non_null_satellite_mask(v.satId, accessor.count, rMask);
+    for (std::size_t const i : rMask.ones())
+    {
+        sum += double(v.posX[i] + v.posY[i] + v.posZ[i])
+             + double(v.velX[i] + v.velY[i] + v.velZ[i]);
+    }
+    return sum;
+}
+
+// Compare reading satellites through DataAccessor::iterate with DefaultComponentViews
+TEST(Universe, DataAccessorViewsMatchIterate)
+{
+    UCtxComponentTypes const compTypes;
+    DefaultComponents  const &dc = compTypes.defaults;
+
+    std::vector<TestSatData> data;
+    DataAccessor const accessor = make_test_accessor(data, 100000, dc);
+
+    BitVector_t mask;
+    EXPECT_EQ(sum_with_iterate(accessor, dc), sum_with_views(accessor, dc, mask));
+}
+
+// Time DataAccessor::iterate against DefaultComponentViews.
+// Run with --gtest_also_run_disabled_tests
+TEST(Universe, DISABLED_DataAccessorViewsBenchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    UCtxComponentTypes const compTypes;
+    DefaultComponents  const &dc = compTypes.defaults;
+
+    constexpr std::size_t   satCount  = 100000;
+    constexpr int           repeats   = 20;
+
+    std::vector<TestSatData> data;
+    DataAccessor const accessor = make_test_accessor(data, satCount, dc);
+
+    double iterSum = 0.0;
+    auto const iterStart = Clock::now();
+    for (int r = 0; r < repeats; ++r)
+    {
+        iterSum += sum_with_iterate(accessor, dc);
+    }
+    auto const iterTime = Clock::now() - iterStart;
+
+    double viewSum = 0.0;
+    BitVector_t mask;
+    auto const viewStart = Clock::now();
+    for (int r = 0; r < repeats; ++r)
+    {
+        viewSum += sum_with_views(accessor, dc, mask);
+    }
+    auto const viewTime = Clock::now() - viewStart;
+
+    EXPECT_EQ(iterSum, viewSum);
+
+    std::cout << "[ BENCHMARK ] " << satCount << " satellites\n"
+              << "              DataAccessor::iterate:  " << duration_cast<microseconds>(iterTime).count() / repeats << "us per pass\n"
+              << "              DefaultComponentViews:  " << duration_cast<microseconds>(viewTime).count() / repeats << "us per pass\n";
+}
+
+/**
+ * @brief Expect tree positions, descendant counts, and parents of a cospace tree to agree
+ */
+static void expect_valid_cospace_tree(UCtxCoordSpaces const& cs, std::size_t const expectSize)
+{
+    if (expectSize == 0)
+    {
+        ASSERT_EQ(cs.treeToId.size(), 1u);
+        ASSERT_FALSE(cs.treeToId[0].has_value());
+        return;
+    }
+
+    ASSERT_EQ(cs.treeToId.size(), expectSize);
+    ASSERT_EQ(cs.treeDescendants.size(), expectSize);
+    ASSERT_EQ(cs.treeDescendants[0] + 1, expectSize);
+    ASSERT_FALSE(cs.parentOf[cs.treeToId[0]].has_value());
+
+    for (UCtxCoordSpaces::TreePos_t pos = 0; pos < cs.treeToId.size(); ++pos)
+    {
+        CoSpaceId const cospace = cs.treeToId[pos];
+        ASSERT_EQ(cs.treeposOf[cospace], pos);
+
+        UCtxCoordSpaces::TreePos_t const childLast = pos + 1 + cs.treeDescendants[pos];
+        ASSERT_LE(childLast, cs.treeToId.size());
+        for (auto child = pos + 1; child < childLast; child += 1 + cs.treeDescendants[child])
+        {
+            ASSERT_EQ(cs.parentOf[cs.treeToId[child]], cospace);
+        }
+    }
+}
+
+// Test inserting and removing cospace subtrees in batches
+TEST(Universe, CospaceTreeInsertRemove)
+{
+    UCtxCoordSpaces cs;
+    auto const make_cospace = [&cs] ()
+    {
+        CoSpaceId const out = cs.ids.create();
+        cs.resize();
+        return out;
+    };
+
+    CoSpaceId const root = make_cospace();
+    cs.insert({}, root);
+    expect_valid_cospace_tree(cs, 1);
+
+    std::mt19937 gen{42};
+    std::size_t treeSize = 1;
+
+    for (int round = 0; round < 50; ++round)
+    {
+        // Parents are either already in the tree, or added earlier in the same batch
+        std::vector<UCtxCoordSpaces::Insert> batch;
+        for (int i = 0; i < 20; ++i)
+        {
+            CoSpaceId const parent = (batch.empty() || gen() % 2 == 0)
+                                   ? cs.treeToId[gen() % cs.treeToId.size()]
+                                   : batch[gen() % batch.size()].addme;
+            batch.push_back({parent, make_cospace()});
+        }
+        cs.insert(batch);
+        treeSize += batch.size();
+        expect_valid_cospace_tree(cs, treeSize);
+
+        // Remove a few random subtrees. These may be nested in each other.
+        std::vector<CoSpaceId> toRemove;
+        std::vector<bool> removed(cs.treeToId.size(), false);
+        for (int i = 0; i < 3; ++i)
+        {
+            auto const pos = UCtxCoordSpaces::TreePos_t(1 + gen() % (cs.treeToId.size() - 1));
+            toRemove.push_back(cs.treeToId[pos]);
+            std::fill_n(removed.begin() + pos, 1 + cs.treeDescendants[pos], true);
+        }
+        cs.remove(toRemove);
+        treeSize -= std::size_t(std::count(removed.begin(), removed.end(), true));
+        expect_valid_cospace_tree(cs, treeSize);
+
+        for (CoSpaceId const cospace : toRemove)
+        {
+            EXPECT_EQ(cs.treeposOf[cospace], lgrn::id_null<UCtxCoordSpaces::TreePos_t>());
+        }
+    }
+
+    // Removing the root empties the tree
+    cs.remove(std::array{root});
+    expect_valid_cospace_tree(cs, 0);
+
+    // Add many children one level deep, such as one cospace per vessel
+    constexpr std::size_t bulkCount = 20000;
+    CoSpaceId const root2 = make_cospace();
+    cs.insert({}, root2);
+
+    std::vector<UCtxCoordSpaces::Insert> bulk;
+    for (std::size_t i = 0; i < bulkCount; ++i)
+    {
+        bulk.push_back({root2, make_cospace()});
+    }
+
+    cs.insert(bulk);
+    expect_valid_cospace_tree(cs, 1 + bulkCount);
+
+    std::vector<CoSpaceId> bulkRemove;
+    for (std::size_t i = 0; i < bulkCount; i += 2)
+    {
+        bulkRemove.push_back(bulk[i].addme);
+    }
+
+    cs.remove(bulkRemove);
+    expect_valid_cospace_tree(cs, 1 + bulkCount / 2);
+}
+
+// Time inserting and removing many cospaces one level deep, batched and one at a time.
+// Run with --gtest_also_run_disabled_tests
+TEST(Universe, DISABLED_CospaceTreeInsertRemoveBenchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    constexpr std::size_t bulkCount = 20000;
+
+    for (bool const batched : {true, false})
+    {
+        UCtxCoordSpaces cs;
+        auto const make_cospace = [&cs] ()
+        {
+            CoSpaceId const out = cs.ids.create();
+            cs.resize();
+            return out;
+        };
+
+        CoSpaceId const root = make_cospace();
+        cs.insert({}, root);
+
+        std::vector<UCtxCoordSpaces::Insert> bulk;
+        for (std::size_t i = 0; i < bulkCount; ++i)
+        {
+            bulk.push_back({root, make_cospace()});
+        }
+
+        std::vector<CoSpaceId> bulkRemove;
+        for (std::size_t i = 0; i < bulkCount; i += 2)
+        {
+            bulkRemove.push_back(bulk[i].addme);
+        }
+
+        auto const insertStart = Clock::now();
+        if (batched)
+        {
+            cs.insert(bulk);
+        }
+        else
+        {
+            for (UCtxCoordSpaces::Insert const& insert : bulk)
+            {
+                cs.insert(insert.parent, insert.addme);
+            }
+        }
+        auto const insertTime = Clock::now() - insertStart;
+
+        auto const removeStart = Clock::now();
+        if (batched)
+        {
+            cs.remove(bulkRemove);
+        }
+        else
+        {
+            for (CoSpaceId const cospace : bulkRemove)
+            {
+                cs.remove(std::array{cospace});
+            }
+        }
+        auto const removeTime = Clock::now() - removeStart;
+
+        expect_valid_cospace_tree(cs, 1 + bulkCount / 2);
+
+        std::cout << "[ BENCHMARK ] " << (batched ? "Batched:" : "One at a time:") << "\n"
+                  << "              Insert " << bulkCount << " cospaces: " << duration_cast<microseconds>(insertTime).count() << "us\n"
+                  << "              Remove " << bulkCount / 2 << " cospaces: " << duration_cast<microseconds>(removeTime).count() << "us\n";
+    }
+}
+
+// Test marking satellites as stolen and masking them out of accessor iteration
+TEST(Universe, StolenSatellites)
+{
+    constexpr std::size_t count = 300;
+
+    UCtxStolenSatellites::OfAccessor stolen;
+    EXPECT_FALSE(stolen.has(0));
+
+    stolen.steal(5);
+    stolen.steal(60, 10);   // crosses a 64-bit boundary
+    stolen.steal(128, 128); // two whole ints
+
+    BitVector_t mask;
+    bitvector_resize(mask, count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        mask.ints()[i / 64] |= bitint_t(1) << (i % 64);
+    }
+    stolen.remove_stolen(mask);
+
+    std::vector<std::size_t> remaining;
+    for (std::size_t const i : mask.ones())
+    {
+        remaining.push_back(i);
+    }
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        bool const expectStolen = (i == 5) || (i >= 60 && i < 70) || (i >= 128 && i < 256);
+        EXPECT_EQ(stolen.has(i), expectStolen);
+        EXPECT_EQ(std::find(remaining.begin(), remaining.end(), i) == remaining.end(), expectStolen);
+    }
+
+    // Indices past the end of the bitset are not stolen
+    EXPECT_FALSE(stolen.has(100000));
+
+    stolen.allStolen = true;
+    EXPECT_TRUE(stolen.has(100000));
+    stolen.remove_stolen(mask);
+    for ([[maybe_unused]] std::size_t const i : mask.ones())
+    {
+        ADD_FAILURE() << "stolen satellite not masked out";
+    }
+
+    stolen.clear();
+    EXPECT_FALSE(stolen.has(5));
+    EXPECT_FALSE(stolen.has(100000));
+}
+
+/**
+ * @brief Queue DataSource changes that add all satellites to accessor 0, then move some
+ *        components of even and odd satellites to other accessors
+ *
+ * Intermediate DataSources end up unused and are deleted when the changes are applied.
+ */
+static void add_test_datasource_changes(UCtxDataSources &rDataSrcs, std::size_t const satCount)
+{
+    auto const components = [] (std::initializer_list<std::uint32_t> comps)
+    {
+        ComponentTypeIdSet_t out{};
+        for (std::uint32_t const comp : comps)
+        {
+            out.insert(ComponentTypeId{comp});
+        }
+        return out;
+    };
+
+    rDataSrcs.datasrcOf.resize(satCount);
+
+    std::vector<SatelliteId> allSats;
+    std::vector<SatelliteId> evenSats;
+    std::vector<SatelliteId> oddSats;
+    for (std::uint32_t i = 0; i < satCount; ++i)
+    {
+        allSats.push_back(SatelliteId{i});
+        (i % 2 == 0 ? evenSats : oddSats).push_back(SatelliteId{i});
+    }
+
+    rDataSrcs.changes = {
+        { .satsAffected = allSats,  .components = components({0, 1, 2}), .accessor = DataAccessorId{0} },
+        { .satsAffected = evenSats, .components = components({3}),       .accessor = DataAccessorId{1} },
+        { .satsAffected = oddSats,  .components = components({1}),       .accessor = DataAccessorId{2} },
+        { .satsAffected = allSats,  .components = components({4}),       .accessor = DataAccessorId{3} }
+    };
+}
+
+static void release_all_datasources(UCtxDataSources &rDataSrcs)
+{
+    for (DataSourceOwner_t &rOwner : rDataSrcs.datasrcOf)
+    {
+        rDataSrcs.refCounts.ref_release(std::exchange(rOwner, {}));
+    }
+}
+
+// Test moving many satellites between DataSources, for a few satellite counts
+TEST(Universe, DataSourceChanges)
+{
+    auto const entry = [] (std::uint32_t accessor, std::initializer_list<std::uint32_t> comps)
+    {
+        DataSource::Entry out{ .accessor = DataAccessorId{accessor} };
+        for (std::uint32_t const comp : comps)
+        {
+            out.components.insert(ComponentTypeId{comp});
+        }
+        return out;
+    };
+
+    for (std::size_t const satCount : {1000u, 10000u, 50000u})
+    {
+        UCtxDataSources dataSrcs;
+        add_test_datasource_changes(dataSrcs, satCount);
+
+        dataSrcs.apply_changes();
+        dataSrcs.changes.clear();
+
+        DataSource evenExpect{{ entry(0, {0, 1, 2}), entry(1, {3}), entry(3, {4}) }};
+        DataSource oddExpect {{ entry(0, {0, 2}),    entry(2, {1}), entry(3, {4}) }};
+        evenExpect.sort();
+        oddExpect .sort();
+
+        DataSourceId const evenDsId = dataSrcs.find_datasource(evenExpect);
+        DataSourceId const oddDsId  = dataSrcs.find_datasource(oddExpect);
+        ASSERT_TRUE(evenDsId.has_value());
+        ASSERT_TRUE(oddDsId.has_value());
+        EXPECT_EQ(dataSrcs.ids.size(), 2u);
+        EXPECT_EQ(dataSrcs.index.size(), 2u);
+
+        for (std::uint32_t i = 0; i < satCount; ++i)
+        {
+            ASSERT_EQ(dataSrcs.datasrcOf[SatelliteId{i}].value(), (i % 2 == 0) ? evenDsId : oddDsId);
+        }
+
+        release_all_datasources(dataSrcs);
+    }
+}
+
+// Time moving many satellites between DataSources, and how it scales with satellite count.
+// Run with --gtest_also_run_disabled_tests
+TEST(Universe, DISABLED_DataSourceChangesBenchmark)
+{
+    using Clock = std::chrono::steady_clock;
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    for (std::size_t const satCount : {1000u, 10000u, 100000u, 1000000u})
+    {
+        UCtxDataSources dataSrcs;
+        add_test_datasource_changes(dataSrcs, satCount);
+
+        auto const start = Clock::now();
+        dataSrcs.apply_changes();
+        auto const time = Clock::now() - start;
+        dataSrcs.changes.clear();
+
+        EXPECT_EQ(dataSrcs.ids.size(), 2u);
+
+        std::cout << "[ BENCHMARK ] DataSource changes, " << satCount << " satellites: "
+                  << duration_cast<microseconds>(time).count() << "us\n";
+
+        release_all_datasources(dataSrcs);
+    }
+}
+
+/**
+ * @return Mean and max of |a - b| / |b| over the accelerations of all satellites
+ */
+static std::pair<double, double> accel_error(adera::SimpleGravitySim const& a, adera::SimpleGravitySim const& b)
+{
+    double sum = 0.0;
+    double max = 0.0;
+    for (std::size_t i = 0; i < b.m_data.size(); ++i)
+    {
+        double const error = (a.m_data[i].accel - b.m_data[i].accel).length() / b.m_data[i].accel.length();
+        sum += error;
+        max = std::max(max, error);
+    }
+    return {sum / double(b.m_data.size()), max};
+}
+
+/**
+ * @brief Make a SimpleGravitySim with satellites at random positions within a 2000km cube
+ */
+static adera::SimpleGravitySim make_random_gravity_sim(std::uint32_t const satCount)
+{
+    using adera::SimpleGravitySim;
+
+    std::mt19937 gen{123};
+    std::uniform_real_distribution<double> posDist{-1.0e6 * 1024.0, 1.0e6 * 1024.0};
+    std::uniform_real_distribution<float>  massDist{1.0f, 100.0f};
+
+    SimpleGravitySim out
+    {
+        .m_metersPerPosUnit = 1.0/1024.0,
+        .m_secPerTimeUnit   = 0.001
+    };
+    for (std::uint32_t i = 0; i < satCount; ++i)
+    {
+        out.m_data.push_back(SimpleGravitySim::SatData{
+            .position = {spaceint_t(posDist(gen)), spaceint_t(posDist(gen)), spaceint_t(posDist(gen))},
+            .mass     = massDist(gen),
+            .id       = SatelliteId{i}
+        });
+    }
+    return out;
+}
+
+// Compare accuracy of SimpleGravitySim's Barnes-Hut and direct-sum accelerations
+TEST(Universe, SimpleGravityBarnesHut)
+{
+    using adera::SimpleGravitySim;
+
+    SimpleGravitySim direct = make_random_gravity_sim(2000);
+
+    // Two satellites at the same position must not produce NaNs
+    direct.m_data.push_back(direct.m_data[0]);
+
+    direct.calc_accel_direct();
+
+    SimpleGravitySim tree = direct;
+    tree.m_method = SimpleGravitySim::Method::BarnesHut;
+
+    // Opening angle of 0 never approximates, same as direct-sum up to summation order
+    tree.m_openingAngle = 0.0;
+    tree.calc_accel_barnes_hut();
+    auto const [exactMean, exactMax] = accel_error(tree, direct);
+    EXPECT_LT(exactMax, 1e-9);
+
+    for (double const theta : {0.3, 0.5, 1.0})
+    {
+        tree.m_openingAngle = theta;
+
+        tree.calc_accel_barnes_hut();
+
+        auto const [mean, max] = accel_error(tree, direct);
+        EXPECT_LT(mean, theta * theta * 0.1);
+    }
+
+    // Parallel results must match single-threaded exactly
+    osp::exec::WorkerPool pool{3};
+    SimpleGravitySim treeParallel = tree;
+    treeParallel.calc_accel_barnes_hut(&pool);
+    for (std::size_t i = 0; i < tree.m_data.size(); ++i)
+    {
+        ASSERT_EQ(treeParallel.m_data[i].accel, tree.m_data[i].accel);
+    }
+
+    // Stepping moves satellites and keeps everything finite
+    Vector3g const before = tree.m_data[1].position;
+    tree.m_data[1].velocity = {1000.0, 0.0, 0.0};
+    tree.update(15, &pool);
+    EXPECT_NE(tree.m_data[1].position, before);
+    for (SimpleGravitySim::SatData const& sat : tree.m_data)
+    {
+        ASSERT_FALSE(std::isnan(sat.velocity.x()) || std::isnan(sat.velocity.y()) || std::isnan(sat.velocity.z()));
+    }
+}
+
+// Time SimpleGravitySim's Barnes-Hut against direct-sum accelerations.
+// Run with --gtest_also_run_disabled_tests
+TEST(Universe, DISABLED_SimpleGravityBarnesHutBenchmark)
+{
+    using adera::SimpleGravitySim;
+    using Clock = std::chrono::steady_clock;
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    constexpr std::uint32_t satCount = 20000;
+
+    SimpleGravitySim direct = make_random_gravity_sim(satCount);
+
+    auto const directStart = Clock::now();
+    direct.calc_accel_direct();
+    auto const directTime = Clock::now() - directStart;
+
+    std::cout << "[ BENCHMARK ] " << satCount << " satellites\n"
+              << "              Direct-sum: " << duration_cast<microseconds>(directTime).count() << "us\n";
+
+    SimpleGravitySim tree = direct;
+    tree.m_method = SimpleGravitySim::Method::BarnesHut;
+
+    osp::exec::WorkerPool pool{3};
+
+    for (double const theta : {0.3, 0.5, 1.0})
+    {
+        tree.m_openingAngle = theta;
+
+        auto const treeStart = Clock::now();
+        tree.calc_accel_barnes_hut();
+        auto const treeTime = Clock::now() - treeStart;
+
+        auto const [mean, max] = accel_error(tree, direct);
+
+        auto const parallelStart = Clock::now();
+        tree.calc_accel_barnes_hut(&pool);
+        auto const parallelTime = Clock::now() - parallelStart;
+
+        std::cout << "              Barnes-Hut theta=" << theta << ": " << duration_cast<microseconds>(treeTime).count()
+                  << "us, parallel " << duration_cast<microseconds>(parallelTime).count()
+                  << "us, mean error " << mean << ", max error " << max << "\n";
+    }
+}
+
 // TODO: Test CoordTransformer for hopping across nested rotated coordinate spaces